@@ -25,6 +25,10 @@
 #include "kis_selection.h"
 #include <kis_iterator_ng.h>
 #include <KisGlobalResourcesInterface.h>
+#include <kis_convolution_painter.h>
+#include <kis_convolution_kernel.h>
+
+#include <QThread>
 
 void KisBlurBenchmark::initTestCase()
 {
@@ -77,5 +81,125 @@ void KisBlurBenchmark::benchmarkFilter()
 }
 
 
+namespace {
+const QRect gaussianTestRect(0, 0, 1024, 1024);
+
+KisPaintDeviceSP applyGaussian(KisPaintDeviceSP src, qreal radius, KisConvolutionPainter::EnginePreference engine)
+{
+    KisPaintDeviceSP dev = new KisPaintDevice(*src);
+
+    KisConvolutionPainter painter(dev, engine);
+    painter.applyGaussian(dev, gaussianTestRect.topLeft(), gaussianTestRect.topLeft(), gaussianTestRect.size(),
+                          radius, radius, BORDER_IGNORE);
+
+    return dev;
+}
+}
+
+void KisBlurBenchmark::benchmarkGaussian_data()
+{
+    QTest::addColumn<qreal>("radius");
+    QTest::addColumn<int>("engine");
+
+    for (qreal radius : {10.0, 50.0, 100.0, 250.0, 500.0}) {
+        if (KisConvolutionPainter::supportsFFTW()) {
+            QTest::addRow("fftw-%d", int(radius)) << radius << int(KisConvolutionPainter::FFTW);
+        }
+        QTest::addRow("iir-%d", int(radius)) << radius << int(KisConvolutionPainter::IIR);
+    }
+}
+
+void KisBlurBenchmark::benchmarkGaussian()
+{
+    QFETCH(qreal, radius);
+    QFETCH(int, engine);
+
+    QBENCHMARK_ONCE {
+        applyGaussian(m_device, radius, KisConvolutionPainter::EnginePreference(engine));
+    }
+}
+
+void KisBlurBenchmark::testGaussianIIRAccuracy_data()
+{
+    QTest::addColumn<qreal>("radius");
+
+    for (qreal radius : {10.0, 50.0, 100.0, 250.0}) {
+        QTest::addRow("%d", int(radius)) << radius;
+    }
+}
+
+void KisBlurBenchmark::testGaussianIIRAccuracy()
+{
+    QFETCH(qreal, radius);
+
+    if (!KisConvolutionPainter::supportsFFTW()) {
+        QSKIP("FFTW is not available, nothing to compare with");
+    }
+
+    KisPaintDeviceSP fftDev = applyGaussian(m_device, radius, KisConvolutionPainter::FFTW);
+    KisPaintDeviceSP iirDev = applyGaussian(m_device, radius, KisConvolutionPainter::IIR);
+
+    const int pixelSize = m_colorSpace->pixelSize();
+
+    KisSequentialConstIterator fftIt(fftDev, gaussianTestRect);
+    KisSequentialConstIterator iirIt(iirDev, gaussianTestRect);
+
+    int maxDifference = 0;
+    qreal sumDifference = 0;
+    int numValues = 0;
+
+    while (fftIt.nextPixel() && iirIt.nextPixel()) {
+        const quint8 *fftPtr = fftIt.oldRawData();
+        const quint8 *iirPtr = iirIt.oldRawData();
+
+        for (int i = 0; i < pixelSize; i++) {
+            const int difference = qAbs(int(fftPtr[i]) - int(iirPtr[i]));
+            maxDifference = qMax(maxDifference, difference);
+            sumDifference += difference;
+            numValues++;
+        }
+    }
+
+    qDebug() << "Radius:" << radius
+             << "max difference:" << maxDifference
+             << "mean difference:" << sumDifference / numValues;
+}
+
+void KisBlurBenchmark::benchmarkSpatialConvolution_data()
+{
+    QTest::addColumn<int>("kernelSize");
+    QTest::addColumn<int>("numThreads");
+
+    for (int kernelSize : {3, 7, 15}) {
+        for (int numThreads : {1, 2, 4, 8, 16}) {
+            if (numThreads > QThread::idealThreadCount()) break;
+
+            QTest::addRow("kernel-%d-threads-%d", kernelSize, numThreads) << kernelSize << numThreads;
+        }
+    }
+}
+
+void KisBlurBenchmark::benchmarkSpatialConvolution()
+{
+    QFETCH(int, kernelSize);
+    QFETCH(int, numThreads);
+
+    const QRect rc(0, 0, GMP_IMAGE_WIDTH, GMP_IMAGE_HEIGHT);
+
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix(kernelSize, kernelSize);
+    matrix.fill(1.0);
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0, matrix.sum());
+
+    KisConvolutionPainter::setSpatialThreadsLimit(numThreads);
+
+    KisPaintDeviceSP dst = new KisPaintDevice(m_colorSpace);
+
+    QBENCHMARK_ONCE {
+        KisConvolutionPainter painter(dst, KisConvolutionPainter::SPATIAL);
+        painter.applyMatrix(kernel, m_device, rc.topLeft(), rc.topLeft(), rc.size(), BORDER_IGNORE);
+    }
+
+    KisConvolutionPainter::setSpatialThreadsLimit(0);
+}
 
 SIMPLE_TEST_MAIN(KisBlurBenchmark)
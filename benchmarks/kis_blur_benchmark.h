@@ -27,6 +27,15 @@ private Q_SLOTS:
     void cleanupTestCase();
     
     void benchmarkFilter();
+
+    void benchmarkGaussian_data();
+    void benchmarkGaussian();
+
+    void testGaussianIIRAccuracy_data();
+    void testGaussianIIRAccuracy();
+
+    void benchmarkSpatialConvolution_data();
+    void benchmarkSpatialConvolution();
     
 };
 
@@ -28,8 +28,12 @@
 #include <KoCompositeOpAlphaDarken.h>
 #include <KoCompositeOpOver.h>
 #include <KoCompositeOpCopy2.h>
+#include <KoCompositeOpGeneric.h>
+#include <KoCompositeOpRegistry.h>
 #include <KoOptimizedCompositeOpFactory.h>
 #include <KoAlphaDarkenParamsWrapper.h>
+#include <KoColorModelStandardIds.h>
+#include <KoConfig.h>
 
 // for posix_memalign()
 #include <stdlib.h>
@@ -162,6 +166,27 @@ struct RandomGenerator<double> : RandomGenerator<float>
     }
 };
 
+#ifdef HAVE_OPENEXR
+template <>
+struct RandomGenerator<half>
+{
+    RandomGenerator(int seed)
+        : m_floatRnd(seed)
+    {
+    }
+
+    half operator() () {
+        return half(m_floatRnd());
+    }
+
+    half unit() {
+        return KoColorSpaceMathsTraits<half>::unitValue;
+    }
+
+    RandomGenerator<float> m_floatRnd;
+};
+#endif
+
 
 template <typename channel_type>
 void generateDataLine(uint seed, int numPixels, quint8 *srcPixels, quint8 *dstPixels, quint8 *mask, AlphaRange srcAlphaRange, AlphaRange dstAlphaRange)
@@ -227,7 +252,8 @@ QVector<Tile> generateTiles(int size,
                             const int dstAlignmentShift,
                             AlphaRange srcAlphaRange,
                             AlphaRange dstAlphaRange,
-                            const quint32 pixelSize)
+                            const quint32 pixelSize,
+                            bool halfFloat = false)
 {
     QVector<Tile> tiles(size);
 
@@ -260,6 +286,10 @@ QVector<Tile> generateTiles(int size,
 
         if (pixelSize == 4) {
             generateDataLine<quint8>(1, numPixels, tiles[i].src, tiles[i].dst, tiles[i].mask, srcAlphaRange, dstAlphaRange);
+        } else if (pixelSize == 8 && halfFloat) {
+#ifdef HAVE_OPENEXR
+            generateDataLine<half>(1, numPixels, tiles[i].src, tiles[i].dst, tiles[i].mask, srcAlphaRange, dstAlphaRange);
+#endif
         } else if (pixelSize == 8) {
             generateDataLine<quint16>(1, numPixels, tiles[i].src, tiles[i].dst, tiles[i].mask, srcAlphaRange, dstAlphaRange);
         } else if (pixelSize == 16) {
@@ -316,6 +346,27 @@ struct PixelEqualPremultiplied
     }
 };
 
+template<typename channel_type>
+struct PixelEqualRelative : public PixelEqualDirect<channel_type>
+{
+};
+
+template<>
+struct PixelEqualRelative<float>
+{
+    bool operator() (float c1, float a1,
+                     float c2, float a2,
+                     float prec) {
+
+        Q_UNUSED(a1);
+        Q_UNUSED(a2);
+
+        // dodge-like blending modes may generate values much higher
+        // than the unit value, so the precision should be relative
+        return qAbs(c1 - c2) <= prec * qMax(1.0f, qAbs(c2));
+    }
+};
+
 template <typename channel_type, template<typename> class Compare = PixelEqualDirect>
 inline bool comparePixels(channel_type *p1, channel_type *p2, channel_type prec) {
     Compare<channel_type> comp;
@@ -364,8 +415,9 @@ bool compareTwoOps(bool haveMask, const KoCompositeOp *op1, const KoCompositeOp
 {
     Q_ASSERT(op1->colorSpace()->pixelSize() == op2->colorSpace()->pixelSize());
     const quint32 pixelSize = op1->colorSpace()->pixelSize();
+    const bool halfFloat = op1->colorSpace()->colorDepthId() == Float16BitsColorDepthID;
     const int alignment = 16;
-    QVector<Tile> tiles = generateTiles(2, alignment, alignment, ALPHA_RANDOM, ALPHA_RANDOM, op1->colorSpace()->pixelSize());
+    QVector<Tile> tiles = generateTiles(2, alignment, alignment, ALPHA_RANDOM, ALPHA_RANDOM, pixelSize, halfFloat);
 
     KoCompositeOp::ParameterInfo params;
     params.dstRowStride  = 4 * rowStride;
@@ -392,6 +444,13 @@ bool compareTwoOps(bool haveMask, const KoCompositeOp *op1, const KoCompositeOp
     if (pixelSize == 4) {
         compareResult = compareTwoOpsPixels<quint8, Compare>(tiles, 10);
     }
+#ifdef HAVE_OPENEXR
+    else if (pixelSize == 8 && halfFloat) {
+        // the legacy ops round to half after every arithmetic operation,
+        // so allow a few ulps of difference
+        compareResult = compareTwoOpsPixels<half, Compare>(tiles, half(5e-3f));
+    }
+#endif
     else if (pixelSize == 8) {
         compareResult = compareTwoOpsPixels<quint16, Compare>(tiles, 90);
     }
@@ -407,6 +466,32 @@ bool compareTwoOps(bool haveMask, const KoCompositeOp *op1, const KoCompositeOp
     return compareResult;
 }
 
+template<class Traits>
+KoCompositeOp* createLegacyGenericSCOp(const KoColorSpace *cs, const QString &id)
+{
+    using Arg = typename Traits::channels_type;
+
+    if (id == COMPOSITE_MULT) {
+        return new KoCompositeOpGenericSC<Traits, &cfMultiply<Arg>>(cs, id, KoCompositeOp::categoryArithmetic());
+    } else if (id == COMPOSITE_SCREEN) {
+        return new KoCompositeOpGenericSC<Traits, &cfScreen<Arg>>(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_OVERLAY) {
+        return new KoCompositeOpGenericSC<Traits, &cfOverlay<Arg>>(cs, id, KoCompositeOp::categoryMix());
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        return new KoCompositeOpGenericSC<Traits, &cfSoftLight<Arg>>(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_DODGE) {
+        return new KoCompositeOpGenericSC<Traits, &cfColorDodge<Arg>>(cs, id, KoCompositeOp::categoryLight());
+    } else if (id == COMPOSITE_BURN) {
+        return new KoCompositeOpGenericSC<Traits, &cfColorBurn<Arg>>(cs, id, KoCompositeOp::categoryDark());
+    } else if (id == COMPOSITE_ADD || id == COMPOSITE_LINEAR_DODGE) {
+        return new KoCompositeOpGenericSC<Traits, &cfAddition<Arg>>(cs, id, KoCompositeOp::categoryArithmetic());
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return new KoCompositeOpGenericSC<Traits, &cfSubtract<Arg>>(cs, id, KoCompositeOp::categoryArithmetic());
+    }
+
+    return 0;
+}
+
 QString getTestName(bool haveMask,
                     const int srcAlignmentShift,
                     const int dstAlignmentShift,
@@ -448,7 +533,9 @@ void benchmarkCompositeOp(const KoCompositeOp *op,
     QString testName = getTestName(haveMask, srcAlignmentShift, dstAlignmentShift, srcAlphaRange, dstAlphaRange);
 
     QVector<Tile> tiles =
-        generateTiles(numTiles, srcAlignmentShift, dstAlignmentShift, srcAlphaRange, dstAlphaRange, op->colorSpace()->pixelSize());
+        generateTiles(numTiles, srcAlignmentShift, dstAlignmentShift, srcAlphaRange, dstAlphaRange,
+                      op->colorSpace()->pixelSize(),
+                      op->colorSpace()->colorDepthId() == Float16BitsColorDepthID);
 
     const int tileOffset = 4 * (processRect.y() * rowStride + processRect.x());
 
@@ -885,6 +972,109 @@ void KisCompositionBenchmark::compareRgbF32CopyOps()
     delete opAct;
 }
 
+void KisCompositionBenchmark::compareRgbF16AlphaDarkenOps()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *opAct = KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs);
+    KoCompositeOp *opExp = new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(cs);
+
+    QVERIFY(compareTwoOps(true, opAct, opExp));
+
+    delete opExp;
+    delete opAct;
+#endif
+}
+
+void KisCompositionBenchmark::compareRgbF16OverOps()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *opAct = KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    KoCompositeOp *opExp = new KoCompositeOpOver<KoRgbF16Traits>(cs);
+
+    QVERIFY(compareTwoOps(true, opAct, opExp));
+
+    delete opExp;
+    delete opAct;
+#endif
+}
+
+void KisCompositionBenchmark::compareRgbF16CopyOps()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *opAct = KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    KoCompositeOp *opExp = new KoCompositeOpCopy2<KoRgbF16Traits>(cs);
+
+    QVERIFY(compareTwoOps(false, opAct, opExp));
+
+    delete opExp;
+    delete opAct;
+#endif
+}
+
+void KisCompositionBenchmark::compareGenericSCOps_data()
+{
+    QTest::addColumn<QString>("compositeOpId");
+    QTest::addColumn<QString>("colorDepthId");
+    QTest::addColumn<bool>("haveMask");
+
+    const QStringList compositeOpIds = {
+        COMPOSITE_MULT,
+        COMPOSITE_SCREEN,
+        COMPOSITE_OVERLAY,
+        COMPOSITE_SOFT_LIGHT_PHOTOSHOP,
+        COMPOSITE_DODGE,
+        COMPOSITE_BURN,
+        COMPOSITE_ADD,
+        COMPOSITE_LINEAR_DODGE,
+        COMPOSITE_SUBTRACT
+    };
+
+    const QStringList colorDepthIds = {"U8", "U16", "F32"};
+
+    Q_FOREACH (const QString &compositeOpId, compositeOpIds) {
+        Q_FOREACH (const QString &colorDepthId, colorDepthIds) {
+            const QString name = QString("%1-%2").arg(compositeOpId).arg(colorDepthId);
+            QTest::newRow((name + "-mask").toLatin1().data()) << compositeOpId << colorDepthId << true;
+            QTest::newRow((name + "-nomask").toLatin1().data()) << compositeOpId << colorDepthId << false;
+        }
+    }
+}
+
+void KisCompositionBenchmark::compareGenericSCOps()
+{
+    QFETCH(QString, compositeOpId);
+    QFETCH(QString, colorDepthId);
+    QFETCH(bool, haveMask);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", colorDepthId, "");
+
+    KoCompositeOp *opAct = 0;
+    KoCompositeOp *opExp = 0;
+
+    if (colorDepthId == "U8") {
+        opAct = KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, compositeOpId);
+        opExp = createLegacyGenericSCOp<KoBgrU8Traits>(cs, compositeOpId);
+    } else if (colorDepthId == "U16") {
+        opAct = KoOptimizedCompositeOpFactory::createGenericSCOpU64(cs, compositeOpId);
+        opExp = createLegacyGenericSCOp<KoBgrU16Traits>(cs, compositeOpId);
+    } else {
+        opAct = KoOptimizedCompositeOpFactory::createGenericSCOp128(cs, compositeOpId);
+        opExp = createLegacyGenericSCOp<KoRgbF32Traits>(cs, compositeOpId);
+    }
+
+    QVERIFY(opAct);
+    QVERIFY(opExp);
+    QCOMPARE(opAct->id(), compositeOpId);
+
+    QVERIFY(compareTwoOps<PixelEqualRelative>(haveMask, opAct, opExp));
+
+    delete opExp;
+    delete opAct;
+}
+
 void KisCompositionBenchmark::testRgb8CompositeAlphaDarkenLegacy()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -1013,6 +1203,66 @@ void KisCompositionBenchmark::testRgbF32CompositeCopyOptimized()
     delete op;
 }
 
+void KisCompositionBenchmark::testRgbF16CompositeAlphaDarkenLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeAlphaDarkenOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeOverLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpOver<KoRgbF16Traits>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeOverOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeCopyLegacy()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = new KoCompositeOpCopy2<KoRgbF16Traits>(cs);
+    benchmarkCompositeOp(op, "RGBF16 Legacy");
+    delete op;
+#endif
+}
+
+void KisCompositionBenchmark::testRgbF16CompositeCopyOptimized()
+{
+#ifdef HAVE_OPENEXR
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", "F16", "");
+    KoCompositeOp *op = KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    benchmarkCompositeOp(op, "RGBF16 Optimized");
+    delete op;
+#endif
+}
+
 void KisCompositionBenchmark::testRgb8CompositeAlphaDarkenReal_Aligned()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
@@ -47,6 +47,13 @@ private Q_SLOTS:
     void compareRgbU16CopyOps();
     void compareRgbF32CopyOps();
 
+    void compareRgbF16AlphaDarkenOps();
+    void compareRgbF16OverOps();
+    void compareRgbF16CopyOps();
+
+    void compareGenericSCOps_data();
+    void compareGenericSCOps();
+
     void testRgb8CompositeAlphaDarkenLegacy();
     void testRgb8CompositeAlphaDarkenOptimized();
 
@@ -71,6 +78,15 @@ private Q_SLOTS:
     void testRgbF32CompositeCopyLegacy();
     void testRgbF32CompositeCopyOptimized();
 
+    void testRgbF16CompositeAlphaDarkenLegacy();
+    void testRgbF16CompositeAlphaDarkenOptimized();
+
+    void testRgbF16CompositeOverLegacy();
+    void testRgbF16CompositeOverOptimized();
+
+    void testRgbF16CompositeCopyLegacy();
+    void testRgbF16CompositeCopyOptimized();
+
     void testRgb8CompositeAlphaDarkenReal_Aligned();
     void testRgb8CompositeOverReal_Aligned();
 
@@ -8,7 +8,11 @@
 #include "kis_benchmark_values.h"
 
 #include <simpletest.h>
+#include <QBuffer>
+#include <QThread>
 #include <kis_datamanager.h>
+#include <kis_paint_device_writer.h>
+#include <tiles3/kis_tile_data_store.h>
 
 // RGBA
 #define PIXEL_SIZE 4
@@ -187,4 +191,275 @@ void KisDatamanagerBenchmark::benchmarkMemCpy()
 }
 
 
+namespace {
+
+class KisBufferPaintDeviceWriter : public KisPaintDeviceWriter
+{
+public:
+    KisBufferPaintDeviceWriter(QBuffer *buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    bool write(const QByteArray &data) override {
+        return m_buffer->write(data) == data.size();
+    }
+
+    bool write(const char* data, qint64 length) override {
+        return m_buffer->write(data, length) == length;
+    }
+
+private:
+    QBuffer *m_buffer;
+};
+
+/**
+ * Fills the datamanager with the data that is compressible, but
+ * not trivially (like a uniform color), so the compression takes
+ * time comparable to the real-life paintings
+ */
+void fillWithPaintingLikeData(KisDataManager &dm)
+{
+    const int dataSize = PIXEL_SIZE * TEST_IMAGE_WIDTH * TEST_IMAGE_HEIGHT;
+    quint8 *bytes = new quint8[dataSize];
+
+    quint32 seed = 1;
+    quint8 *ptr = bytes;
+    for (int y = 0; y < TEST_IMAGE_HEIGHT; y++) {
+        for (int x = 0; x < TEST_IMAGE_WIDTH; x++) {
+            seed = seed * 1103515245 + 12345;
+            const quint8 noise = (seed >> 16) & 0x7;
+
+            ptr[0] = quint8(x >> 4) + noise;
+            ptr[1] = quint8(y >> 4) + noise;
+            ptr[2] = quint8((x + y) >> 5);
+            ptr[3] = 255;
+            ptr += PIXEL_SIZE;
+        }
+    }
+
+    dm.writeBytes(bytes, 0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT);
+    delete[] bytes;
+}
+
+void addThreadsRows()
+{
+    QTest::addColumn<int>("numThreads");
+
+    const int maxThreads = QThread::idealThreadCount();
+    for (int i = 1; i < maxThreads; i *= 2) {
+        QTest::newRow(QString("threads-%1").arg(i).toLatin1()) << i;
+    }
+    QTest::newRow(QString("threads-%1").arg(maxThreads).toLatin1()) << maxThreads;
+}
+
+/**
+ * Saves \p dm into \p data as if it was written by a data manager
+ * with \p tileSize tiles. The pixels are stored uncompressed.
+ */
+void writeTilesOfSize(KisDataManager &dm, const QSize &tileSize, QByteArray &data)
+{
+    const QRect rc = dm.extent();
+    const int cols = (rc.width() + tileSize.width() - 1) / tileSize.width();
+    const int rows = (rc.height() + tileSize.height() - 1) / tileSize.height();
+    const int tileDataSize = PIXEL_SIZE * tileSize.width() * tileSize.height();
+
+    data = QString("VERSION 2\n"
+                   "TILEWIDTH %1\n"
+                   "TILEHEIGHT %2\n"
+                   "PIXELSIZE %3\n"
+                   "DATA %4\n")
+        .arg(tileSize.width()).arg(tileSize.height())
+        .arg(PIXEL_SIZE).arg(cols * rows).toLatin1();
+
+    QByteArray pixels(tileDataSize, 0);
+
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < cols; col++) {
+            const int x = rc.x() + col * tileSize.width();
+            const int y = rc.y() + row * tileSize.height();
+
+            dm.readBytes((quint8*)pixels.data(), x, y, tileSize.width(), tileSize.height());
+
+            data += QString("%1,%2,LZF,%3\n").arg(x).arg(y).arg(tileDataSize + 1).toLatin1();
+            data += char(0); // raw data flag
+            data += pixels;
+        }
+    }
+}
+
+}
+
+void KisDatamanagerBenchmark::benchmarkWriteTiles_data()
+{
+    addThreadsRows();
+}
+
+void KisDatamanagerBenchmark::benchmarkWriteTiles()
+{
+    QFETCH(int, numThreads);
+
+    quint8 *p = new quint8[PIXEL_SIZE];
+    memset(p, 0, PIXEL_SIZE);
+    KisDataManager dm(PIXEL_SIZE, p);
+    fillWithPaintingLikeData(dm);
+
+    KisTiledDataManager::setSerializationThreadsLimit(numThreads);
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    KisBufferPaintDeviceWriter writer(&buffer);
+
+    QBENCHMARK {
+        buffer.seek(0);
+        QVERIFY(dm.write(writer));
+    }
+
+    KisTiledDataManager::setSerializationThreadsLimit(0);
+
+    qDebug() << "Compressed size:" << buffer.pos() / 1024 << "KiB";
+
+    delete[] p;
+}
+
+void KisDatamanagerBenchmark::benchmarkReadTiles_data()
+{
+    addThreadsRows();
+}
+
+void KisDatamanagerBenchmark::benchmarkReadTiles()
+{
+    QFETCH(int, numThreads);
+
+    quint8 *p = new quint8[PIXEL_SIZE];
+    memset(p, 0, PIXEL_SIZE);
+
+    QBuffer buffer;
+
+    {
+        KisDataManager dm(PIXEL_SIZE, p);
+        fillWithPaintingLikeData(dm);
+
+        buffer.open(QIODevice::WriteOnly);
+        KisBufferPaintDeviceWriter writer(&buffer);
+        QVERIFY(dm.write(writer));
+        buffer.close();
+    }
+
+    KisTiledDataManager::setSerializationThreadsLimit(numThreads);
+
+    KisDataManager dm(PIXEL_SIZE, p);
+
+    buffer.open(QIODevice::ReadOnly);
+
+    QBENCHMARK {
+        buffer.seek(0);
+        QVERIFY(dm.read(&buffer));
+    }
+
+    KisTiledDataManager::setSerializationThreadsLimit(0);
+
+    delete[] p;
+}
+void KisDatamanagerBenchmark::benchmarkReadTilesOfSize_data()
+{
+    QTest::addColumn<int>("tileEdge");
+
+    QTest::newRow("64") << 64;
+    QTest::newRow("128") << 128;
+    QTest::newRow("256") << 256;
+}
+
+void KisDatamanagerBenchmark::benchmarkReadTilesOfSize()
+{
+    QFETCH(int, tileEdge);
+
+    quint8 *p = new quint8[PIXEL_SIZE];
+    memset(p, 0, PIXEL_SIZE);
+
+    QByteArray data;
+
+    {
+        KisDataManager dm(PIXEL_SIZE, p);
+        fillWithPaintingLikeData(dm);
+        writeTilesOfSize(dm, QSize(tileEdge, tileEdge), data);
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    KisDataManager dm(PIXEL_SIZE, p, tileEdge);
+
+    QBENCHMARK {
+        buffer.seek(0);
+        QVERIFY(dm.read(&buffer));
+    }
+
+    delete[] p;
+}
+
+void KisDatamanagerBenchmark::benchmarkTileSizeMemory_data()
+{
+    QTest::addColumn<int>("tileEdge");
+    QTest::addColumn<int>("dabSize");
+
+    QTest::newRow("64-full") << 64 << 0;
+    QTest::newRow("128-full") << 128 << 0;
+    QTest::newRow("256-full") << 256 << 0;
+    QTest::newRow("64-strokes") << 64 << 16;
+    QTest::newRow("128-strokes") << 128 << 16;
+    QTest::newRow("256-strokes") << 256 << 16;
+}
+
+void KisDatamanagerBenchmark::benchmarkTileSizeMemory()
+{
+    QFETCH(int, tileEdge);
+    QFETCH(int, dabSize);
+
+    quint8 *p = new quint8[PIXEL_SIZE];
+    memset(p, 0, PIXEL_SIZE);
+
+    QByteArray dab(PIXEL_SIZE * dabSize * dabSize, char(128));
+
+    auto fillDataManager = [&] (KisDataManager &dm) {
+        if (!dabSize) {
+            fillWithPaintingLikeData(dm);
+            return;
+        }
+
+        // a few diagonal strokes, that is what a sparse layer usually looks like
+        for (int stroke = 0; stroke < 8; stroke++) {
+            const int startX = stroke * TEST_IMAGE_WIDTH / 8;
+            for (int y = 0; y < TEST_IMAGE_HEIGHT - dabSize; y += dabSize / 4) {
+                const int x = (startX + y / 2) % (TEST_IMAGE_WIDTH - dabSize);
+                dm.writeBytes((quint8*)dab.data(), x, y, dabSize, dabSize);
+            }
+        }
+    };
+
+    {
+        KisTileDataStore *store = KisTileDataStore::instance();
+        const qint32 tilesBefore = store->numTiles();
+        const qint64 metricBefore = store->memoryMetric();
+
+        KisDataManager dm(PIXEL_SIZE, p, tileEdge);
+        fillDataManager(dm);
+
+        const qint32 numTiles = store->numTiles() - tilesBefore;
+        const qint64 memory = (store->memoryMetric() - metricBefore) *
+            KisTileData::WIDTH * KisTileData::HEIGHT;
+
+        qDebug() << "Tile size:" << tileEdge
+                 << "tiles:" << numTiles
+                 << "memory:" << memory / 1024 << "KiB";
+    }
+
+    QBENCHMARK {
+        KisDataManager dm(PIXEL_SIZE, p, tileEdge);
+        fillDataManager(dm);
+    }
+
+    delete[] p;
+}
+
 SIMPLE_TEST_MAIN(KisDatamanagerBenchmark)
@@ -24,6 +24,15 @@ private Q_SLOTS:
     void benchmarkExtent();
     void benchmarkClear();
     void benchmarkMemCpy();
+
+    void benchmarkWriteTiles_data();
+    void benchmarkWriteTiles();
+    void benchmarkReadTiles_data();
+    void benchmarkReadTiles();
+    void benchmarkReadTilesOfSize_data();
+    void benchmarkReadTilesOfSize();
+    void benchmarkTileSizeMemory_data();
+    void benchmarkTileSizeMemory();
 };
 
 #endif
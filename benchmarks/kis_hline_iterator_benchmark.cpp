@@ -177,6 +177,35 @@ void KisHLineIteratorBenchmark::benchmarkTwoIteratorsNoMemCpy(){
     
 }
 
+void KisHLineIteratorBenchmark::benchmarkTileSize_data()
+{
+    QTest::addColumn<int>("tileSize");
+
+    QTest::newRow("64") << 64;
+    QTest::newRow("128") << 128;
+    QTest::newRow("256") << 256;
+}
+
+void KisHLineIteratorBenchmark::benchmarkTileSize()
+{
+    QFETCH(int, tileSize);
+
+    KisPaintDevice dev(m_colorSpace);
+    dev.setTileSize(tileSize);
+    dev.fill(0, 0, TEST_IMAGE_WIDTH, TEST_IMAGE_HEIGHT, m_color->data());
+
+    QBENCHMARK{
+        KisHLineIteratorSP it = dev.createHLineIteratorNG(0, 0, TEST_IMAGE_WIDTH);
+        for (int j = 0; j < TEST_IMAGE_HEIGHT; j++) {
+            int numPixels = 0;
+            do {
+                numPixels = it->nConseqPixels();
+                memset(it->rawData(), 128, numPixels * m_colorSpace->pixelSize());
+            } while (it->nextPixels(numPixels));
+            it->nextRow();
+        }
+    }
+}
 
 
 SIMPLE_TEST_MAIN(KisHLineIteratorBenchmark)
@@ -44,6 +44,10 @@ private Q_SLOTS:
     void benchmarkConstNoMemCpy();
     // copy from one device to another
     void benchmarkTwoIteratorsNoMemCpy();
+
+    // iteration over the devices with different tile sizes
+    void benchmarkTileSize_data();
+    void benchmarkTileSize();
     
 
     
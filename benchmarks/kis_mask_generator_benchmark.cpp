@@ -9,6 +9,11 @@
 #include "kis_mask_generator_benchmark.h"
 
 #include "kis_circle_mask_generator.h"
+#include "kis_curve_circle_mask_generator.h"
+#include "kis_curve_rect_mask_generator.h"
+#include "kis_cubic_curve.h"
+#include "kis_gauss_circle_mask_generator.h"
+#include "kis_gauss_rect_mask_generator.h"
 #include "kis_rect_mask_generator.h"
 
 void KisMaskGeneratorBenchmark::benchmarkCircle()
@@ -81,4 +86,85 @@ void KisMaskGeneratorBenchmark::benchmarkSquare()
     }
 }
 
+template<class MaskGenerator>
+void benchmarkApplicatorImpl(MaskGenerator &gen, int size, bool forceScalar)
+{
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisFixedPaintDeviceSP dev = new KisFixedPaintDevice(cs);
+    dev->setRect(QRect(0, 0, size, size));
+    dev->initialize();
+
+    MaskProcessingData data(dev, cs, nullptr,
+                            0.0, 1.0,
+                            0.5 * size, 0.5 * size, 0);
+
+    gen.resetMaskApplicator(forceScalar);
+
+    KisBrushMaskApplicatorBase *applicator = gen.applicator();
+    applicator->initializeData(&data);
+
+    QVector<QRect> rects = KritaUtils::splitRectIntoPatches(dev->bounds(), QSize(63, 63));
+
+    QBENCHMARK{
+        Q_FOREACH (const QRect &rc, rects) {
+            applicator->process(rc);
+        }
+    }
+}
+
+void KisMaskGeneratorBenchmark::benchmarkApplicator_data()
+{
+    QTest::addColumn<QString>("shape");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("spikes");
+    QTest::addColumn<bool>("forceScalar");
+
+    const QStringList shapes = {"circle", "gauss-circle", "curve-circle",
+                                "rect", "gauss-rect", "curve-rect"};
+
+    Q_FOREACH (const QString &shape, shapes) {
+        for (int size : {50, 300, 1000}) {
+            for (int spikes : {2, 5}) {
+                for (bool forceScalar : {true, false}) {
+                    QTest::addRow("%s-%d-spikes%d-%s",
+                                  shape.toLatin1().data(), size, spikes,
+                                  forceScalar ? "scalar" : "vector")
+                        << shape << size << spikes << forceScalar;
+                }
+            }
+        }
+    }
+}
+
+void KisMaskGeneratorBenchmark::benchmarkApplicator()
+{
+    QFETCH(QString, shape);
+    QFETCH(int, size);
+    QFETCH(int, spikes);
+    QFETCH(bool, forceScalar);
+
+    KisCubicCurve curve;
+    curve.fromString("0,1;1,0");
+
+    if (shape == "circle") {
+        KisCircleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    } else if (shape == "gauss-circle") {
+        KisGaussCircleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    } else if (shape == "curve-circle") {
+        KisCurveCircleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, curve, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    } else if (shape == "rect") {
+        KisRectangleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    } else if (shape == "gauss-rect") {
+        KisGaussRectangleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    } else if (shape == "curve-rect") {
+        KisCurveRectangleMaskGenerator gen(size, 1.0, 0.5, 0.5, spikes, curve, true);
+        benchmarkApplicatorImpl(gen, size, forceScalar);
+    }
+}
+
 SIMPLE_TEST_MAIN(KisMaskGeneratorBenchmark)
@@ -9,12 +9,14 @@
 #include "kis_benchmark_values.h"
 
 #include <KoColor.h>
+#include <KoColorSpaceRegistry.h>
 
 #include <kis_group_layer.h>
 #include <kis_paint_device.h>
 #include <KisDocument.h>
 #include <kis_image.h>
 #include <KisPart.h>
+#include <kis_updater_context.h>
 
 void KisProjectionBenchmark::initTestCase()
 {
@@ -37,6 +39,39 @@ void KisProjectionBenchmark::benchmarkProjection()
     }
 }
 
+/**
+ * Recalculates the projection of an already loaded image and reports
+ * how the time of the update threads is split between the merging of
+ * the layers and the scheduling of the merge jobs
+ */
+void KisProjectionBenchmark::benchmarkRefreshGraph()
+{
+    KisDocument *doc = KisPart::instance()->createDocument();
+    doc->loadNativeFormat(QString(FILES_DATA_DIR) + '/' + "load_test.kra");
+    KisImageSP image = doc->image();
+    image->waitForDone();
+
+    KisUpdaterContext::resetStatistics();
+    KisUpdaterContext::setCollectStatistics(true);
+
+    QBENCHMARK {
+        image->refreshGraphAsync();
+        image->waitForDone();
+    }
+
+    KisUpdaterContext::setCollectStatistics(false);
+
+    const KisUpdaterContext::Statistics stats = KisUpdaterContext::statistics();
+    const qint64 totalTime = qMax(stats.jobsTime + stats.schedulingTime, qint64(1));
+
+    qDebug() << "Merge jobs:" << stats.numJobs << "stolen:" << stats.numStolenJobs;
+    qDebug() << "Time spent in the merge jobs:" << stats.jobsTime / 1000000 << "ms";
+    qDebug() << "Time spent in the scheduler:" << stats.schedulingTime / 1000000 << "ms"
+             << QString("(%1%)").arg(100.0 * stats.schedulingTime / totalTime, 0, 'f', 1);
+
+    delete doc;
+}
+
 void KisProjectionBenchmark::benchmarkLoading()
 {
     QBENCHMARK{
@@ -46,5 +81,48 @@ void KisProjectionBenchmark::benchmarkLoading()
     }
 }
 
+void KisProjectionBenchmark::benchmarkConvertColorSpace_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("single-threaded") << 1;
+    QTest::newRow("multi-threaded") << 0;
+}
+
+/**
+ * Converts the whole image into 16-bit RGBA and back, the
+ * tiles of every layer are converted by \p numThreads threads
+ * (0 means QThread::idealThreadCount())
+ */
+void KisProjectionBenchmark::benchmarkConvertColorSpace()
+{
+    QFETCH(int, numThreads);
+
+    KisDocument *doc = KisPart::instance()->createDocument();
+    doc->loadNativeFormat(QString(FILES_DATA_DIR) + '/' + "load_test.kra");
+    KisImageSP image = doc->image();
+    image->waitForDone();
+
+    const KoColorSpace *srcCs = image->colorSpace();
+    const KoColorSpace *dstCs = KoColorSpaceRegistry::instance()->rgb16();
+
+    KisPaintDevice::setColorSpaceConversionThreadsLimit(numThreads);
+
+    QBENCHMARK {
+        image->convertImageColorSpace(dstCs,
+                                      KoColorConversionTransformation::internalRenderingIntent(),
+                                      KoColorConversionTransformation::internalConversionFlags());
+        image->waitForDone();
+
+        image->convertImageColorSpace(srcCs,
+                                      KoColorConversionTransformation::internalRenderingIntent(),
+                                      KoColorConversionTransformation::internalConversionFlags());
+        image->waitForDone();
+    }
+
+    KisPaintDevice::setColorSpaceConversionThreadsLimit(0);
+
+    delete doc;
+}
 
 SIMPLE_TEST_MAIN(KisProjectionBenchmark)
@@ -19,7 +19,11 @@ private Q_SLOTS:
     void cleanupTestCase();
 
     void benchmarkProjection();
+    void benchmarkRefreshGraph();
     void benchmarkLoading();
+
+    void benchmarkConvertColorSpace_data();
+    void benchmarkConvertColorSpace();
 };
 
 #endif
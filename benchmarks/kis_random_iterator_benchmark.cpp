@@ -16,6 +16,9 @@
 #include <simpletest.h>
 #include <kis_random_accessor_ng.h>
 
+#include <QThreadPool>
+#include <QtConcurrent>
+
 
 void KisRandomIteratorBenchmark::initTestCase()
 {
@@ -222,5 +225,70 @@ void KisRandomIteratorBenchmark::benchmarkTwoIteratorsNoMemCpy()
     }
 }
 
+void KisRandomIteratorBenchmark::benchmarkConcurrentRead_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    for (int numThreads = 1; numThreads <= 32; numThreads *= 2) {
+        QTest::addRow("%d threads", numThreads) << numThreads;
+    }
+}
+
+void KisRandomIteratorBenchmark::benchmarkConcurrentRead()
+{
+    concurrentReadImpl(QPoint());
+}
+
+void KisRandomIteratorBenchmark::benchmarkConcurrentReadDefaultTiles_data()
+{
+    benchmarkConcurrentRead_data();
+}
+
+void KisRandomIteratorBenchmark::benchmarkConcurrentReadDefaultTiles()
+{
+    concurrentReadImpl(QPoint(2 * TEST_IMAGE_WIDTH, 2 * TEST_IMAGE_HEIGHT));
+}
+
+void KisRandomIteratorBenchmark::concurrentReadImpl(const QPoint &offset)
+{
+    QFETCH(int, numThreads);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numThreads);
+
+    /**
+     * Every thread walks the whole image with its own accessor, but
+     * starts from a different row, so all the threads hit the same
+     * tiles at the same time, just like the updater threads do when
+     * they process a big paint device.
+     */
+    auto readImage = [this, numThreads, offset] (int threadIndex) {
+        KisRandomConstAccessorSP it = m_device->createRandomConstAccessorNG();
+        const int startRow = threadIndex * TEST_IMAGE_HEIGHT / numThreads;
+        quint8 sum = 0;
+
+        for (int i = 0; i < TEST_IMAGE_HEIGHT; i++) {
+            const int y = (startRow + i) % TEST_IMAGE_HEIGHT;
+            for (int j = 0; j < TEST_IMAGE_WIDTH; j += 8) {
+                it->moveTo(offset.x() + j, offset.y() + y);
+                sum += *it->rawDataConst();
+            }
+        }
+
+        return sum;
+    };
+
+    QBENCHMARK {
+        QVector<QFuture<quint8>> futures;
+        for (int i = 0; i < numThreads; i++) {
+            futures << QtConcurrent::run(&pool, readImage, i);
+        }
+
+        Q_FOREACH (QFuture<quint8> future, futures) {
+            future.waitForFinished();
+        }
+    }
+}
+
 
 SIMPLE_TEST_MAIN(KisRandomIteratorBenchmark)
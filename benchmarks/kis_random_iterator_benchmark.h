@@ -46,6 +46,16 @@ private Q_SLOTS:
     void benchmarkNoMemCpy();
     void benchmarkConstNoMemCpy();
     void benchmarkTwoIteratorsNoMemCpy();
+
+    // many threads reading the same device concurrently
+    void benchmarkConcurrentRead_data();
+    void benchmarkConcurrentRead();
+    // the same, but the threads read the area without any tiles
+    void benchmarkConcurrentReadDefaultTiles_data();
+    void benchmarkConcurrentReadDefaultTiles();
+
+private:
+    void concurrentReadImpl(const QPoint &offset);
 };
 
 #endif
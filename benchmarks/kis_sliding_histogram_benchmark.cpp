@@ -0,0 +1,151 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_sliding_histogram_benchmark.h"
+
+#include <vector>
+
+#include <KoColorSpace.h>
+#include <KoColorSpaceRegistry.h>
+
+#include <kis_paint_device.h>
+#include <kis_sequential_iterator.h>
+#include <KisSlidingWindowHistogram.h>
+
+#include "filter/kis_filter_registry.h"
+#include "filter/kis_filter_configuration.h"
+#include "filter/kis_filter.h"
+
+#include "krita_utils.h"
+#include <KisGlobalResourcesInterface.h>
+
+namespace {
+const QSize benchmarkSize(1024, 1024);
+}
+
+void KisSlidingHistogramBenchmark::initTestCase()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    m_device = new KisPaintDevice(cs);
+
+    srand(31524744);
+
+    KisSequentialIterator it(m_device, QRect(QPoint(), benchmarkSize));
+    while (it.nextPixel()) {
+        quint8 *ptr = it.rawData();
+        for (int i = 0; i < 4; i++) {
+            ptr[i] = rand() % 256;
+        }
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMedian_data()
+{
+    QTest::addColumn<int>("radius");
+    QTest::addColumn<bool>("useBruteForce");
+
+    for (int radius : {1, 3, 10, 30, 100}) {
+        QTest::addRow("sliding-%d", radius) << radius << false;
+
+        // the brute-force version is too slow for bigger radii
+        if (radius <= 30) {
+            QTest::addRow("brute-force-%d", radius) << radius << true;
+        }
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkMedian()
+{
+    QFETCH(int, radius);
+    QFETCH(bool, useBruteForce);
+
+    const int numBins = 256;
+
+    KisSlidingWindowHistogram histogram(numBins, 0, radius);
+    const QSize srcSize = histogram.sourceSize(benchmarkSize);
+
+    std::vector<qint16> bins(srcSize.width() * srcSize.height());
+    for (auto it = bins.begin(); it != bins.end(); ++it) {
+        *it = rand() % numBins;
+    }
+
+    std::vector<quint8> result(benchmarkSize.width() * benchmarkSize.height());
+
+    if (!useBruteForce) {
+        QBENCHMARK_ONCE {
+            histogram.process(benchmarkSize, bins.data(), nullptr,
+                [&] (int x, int y) {
+                    result[y * benchmarkSize.width() + x] = histogram.medianBin();
+                });
+        }
+    } else {
+        QBENCHMARK_ONCE {
+            std::vector<int> counts(numBins);
+            const int windowSize = 2 * radius + 1;
+
+            for (int y = 0; y < benchmarkSize.height(); y++) {
+                for (int x = 0; x < benchmarkSize.width(); x++) {
+                    std::fill(counts.begin(), counts.end(), 0);
+
+                    for (int dy = 0; dy < windowSize; dy++) {
+                        const qint16 *binPtr = bins.data() + (y + dy) * srcSize.width() + x;
+                        for (int dx = 0; dx < windowSize; dx++) {
+                            counts[binPtr[dx]]++;
+                        }
+                    }
+
+                    const int rank = (windowSize * windowSize - 1) / 2;
+                    int accumulated = 0;
+                    int bin = 0;
+                    for (; bin < numBins; bin++) {
+                        accumulated += counts[bin];
+                        if (accumulated > rank) break;
+                    }
+
+                    result[y * benchmarkSize.width() + x] = bin;
+                }
+            }
+        }
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkOilPaint_data()
+{
+    QTest::addColumn<int>("brushSize");
+    QTest::addColumn<int>("smooth");
+
+    for (int brushSize : {1, 3, 5}) {
+        for (int smooth : {30, 255}) {
+            QTest::addRow("brush-%d-smooth-%d", brushSize, smooth) << brushSize << smooth;
+        }
+    }
+}
+
+void KisSlidingHistogramBenchmark::benchmarkOilPaint()
+{
+    QFETCH(int, brushSize);
+    QFETCH(int, smooth);
+
+    KisFilterSP filter = KisFilterRegistry::instance()->value("oilpaint");
+    QVERIFY(filter);
+
+    KisFilterConfigurationSP config = filter->defaultConfiguration(KisGlobalResourcesInterface::instance());
+    config->setProperty("brushSize", brushSize);
+    config->setProperty("smooth", smooth);
+
+    KisPaintDeviceSP dev = new KisPaintDevice(*m_device);
+
+    QVector<QRect> rects = KritaUtils::splitRectIntoPatches(QRect(QPoint(), benchmarkSize),
+                                                            KritaUtils::optimalPatchSize());
+
+    QBENCHMARK_ONCE {
+        Q_FOREACH (const QRect &rc, rects) {
+            filter->process(dev, rc, config);
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisSlidingHistogramBenchmark)
@@ -0,0 +1,31 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_SLIDING_HISTOGRAM_BENCHMARK_H
+#define KIS_SLIDING_HISTOGRAM_BENCHMARK_H
+
+#include <simpletest.h>
+
+#include <kis_types.h>
+
+class KisSlidingHistogramBenchmark : public QObject
+{
+    Q_OBJECT
+
+private:
+    KisPaintDeviceSP m_device;
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void benchmarkMedian_data();
+    void benchmarkMedian();
+
+    void benchmarkOilPaint_data();
+    void benchmarkOilPaint();
+};
+
+#endif // KIS_SLIDING_HISTOGRAM_BENCHMARK_H
@@ -40,6 +40,10 @@ inline double drand48()
 
 #include <KisGlobalResourcesInterface.h>
 
+#include <KisRunnableBasedStrokeStrategy.h>
+#include <KisRunnableStrokeJobData.h>
+#include <kis_updater_context.h>
+
 //#define SAVE_OUTPUT
 
 static const int LINES = 20;
@@ -621,5 +625,74 @@ void KisStrokeBenchmark::becnhmarkPresetCloning()
     }
 }
 
+class SchedulerBenchmarkStrokeStrategy : public KisRunnableBasedStrokeStrategy
+{
+public:
+    SchedulerBenchmarkStrokeStrategy()
+        : KisRunnableBasedStrokeStrategy(QLatin1String("scheduler-benchmark-stroke"))
+    {
+        enableJob(JOB_DOSTROKE);
+    }
+};
+
+void KisStrokeBenchmark::benchmarkSchedulerOverhead_data()
+{
+    QTest::addColumn<int>("jobSize");
+
+    QTest::newRow("1px") << 1;
+    QTest::newRow("16px") << 16;
+    QTest::newRow("64px") << 64;
+    QTest::newRow("256px") << 256;
+}
+
+/**
+ * Runs a lot of small concurrent jobs through the image's scheduler
+ * and reports how much time the update threads spend on the jobs
+ * themselves and how much on the scheduling
+ */
+void KisStrokeBenchmark::benchmarkSchedulerOverhead()
+{
+    QFETCH(int, jobSize);
+
+    const int numJobs = 1024;
+    const QRect bounds = m_image->bounds();
+    KisPaintDeviceSP dev = m_layer->paintDevice();
+    const KoColor color(Qt::red, m_colorSpace);
+
+    KisUpdaterContext::resetStatistics();
+    KisUpdaterContext::setCollectStatistics(true);
+
+    QBENCHMARK {
+        KisStrokeId id = m_image->startStroke(new SchedulerBenchmarkStrokeStrategy());
+
+        for (int i = 0; i < numJobs; i++) {
+            const QRect rc(bounds.x() + (i * jobSize) % qMax(1, bounds.width() - jobSize),
+                           bounds.y() + (i * 7) % qMax(1, bounds.height() - jobSize),
+                           jobSize, jobSize);
+
+            m_image->addJob(id,
+                new KisRunnableStrokeJobData(
+                    [dev, rc, color] () {
+                        dev->fill(rc, color);
+                    },
+                    KisStrokeJobData::CONCURRENT));
+        }
+
+        m_image->endStroke(id);
+        m_image->waitForDone();
+    }
+
+    KisUpdaterContext::setCollectStatistics(false);
+
+    const KisUpdaterContext::Statistics stats = KisUpdaterContext::statistics();
+    const qint64 numJobsExecuted = qMax(stats.numJobs, qint64(1));
+
+    qDebug() << "Scheduler statistics for" << jobSize << "px jobs:";
+    qDebug() << "    jobs executed:" << stats.numJobs << "stolen:" << stats.numStolenJobs;
+    qDebug() << "    pixel work:" << stats.jobsTime / numJobsExecuted << "ns/job";
+    qDebug() << "    scheduling:" << stats.schedulingTime / numJobsExecuted << "ns/job"
+             << QString("(%1%)").arg(100.0 * stats.schedulingTime /
+                                     qMax(stats.jobsTime + stats.schedulingTime, qint64(1)), 0, 'f', 1);
+}
 
 SIMPLE_TEST_MAIN(KisStrokeBenchmark)
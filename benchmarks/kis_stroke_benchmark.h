@@ -131,6 +131,9 @@ private Q_SLOTS:
     void benchmarkRand48();
 
     void becnhmarkPresetCloning();
+
+    void benchmarkSchedulerOverhead_data();
+    void benchmarkSchedulerOverhead();
 };
 
 #endif
@@ -0,0 +1,165 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_compression_benchmark.h"
+
+#include <simpletest.h>
+#include <QElapsedTimer>
+
+#include <KisDocument.h>
+#include <KisPart.h>
+#include <kis_image.h>
+#include <kis_group_layer.h>
+#include <kis_paint_device.h>
+#include <kis_layer_utils.h>
+
+#include <tiles3/kis_tile_data.h>
+#include <tiles3/swap/kis_abstract_compression.h>
+#include <tiles3/swap/kis_tile_compressor_2.h>
+
+
+void KisTileCompressionBenchmark::initTestCase()
+{
+    KisDocument *doc = KisPart::instance()->createDocument();
+    doc->loadNativeFormat(QString(FILES_DATA_DIR) + '/' + "load_test.kra");
+
+    QVector<KisPaintDeviceSP> devices;
+
+    KisLayerUtils::recursiveApplyNodes(doc->image()->root(),
+        [&devices] (KisNodeSP node) {
+            if (node->paintDevice()) {
+                devices << node->paintDevice();
+            }
+        });
+
+    Q_FOREACH (KisPaintDeviceSP dev, devices) {
+        const int pixelSize = dev->pixelSize();
+        const int tileDataSize = pixelSize * KisTileData::WIDTH * KisTileData::HEIGHT;
+        const QRect bounds = dev->exactBounds();
+
+        QByteArray tile(tileDataSize, 0);
+
+        for (int y = bounds.top(); y <= bounds.bottom(); y += KisTileData::HEIGHT) {
+            for (int x = bounds.left(); x <= bounds.right(); x += KisTileData::WIDTH) {
+                dev->readBytes((quint8*)tile.data(), x, y, KisTileData::WIDTH, KisTileData::HEIGHT);
+
+                QByteArray linearized(tileDataSize, 0);
+                KisAbstractCompression::linearizeColors((quint8*)tile.data(),
+                                                        (quint8*)linearized.data(),
+                                                        tileDataSize, pixelSize);
+                m_tiles << linearized;
+            }
+        }
+    }
+
+    delete doc;
+
+    qDebug() << "Loaded" << m_tiles.size() << "tiles";
+}
+
+void KisTileCompressionBenchmark::cleanupTestCase()
+{
+    m_tiles.clear();
+}
+
+void KisTileCompressionBenchmark::benchmarkCompression_data()
+{
+    QTest::addColumn<QString>("compressionName");
+
+    Q_FOREACH (const QString &name, KisTileCompressor2::supportedCompressions()) {
+        QTest::newRow(name.toLatin1()) << name;
+    }
+}
+
+void KisTileCompressionBenchmark::benchmarkCompression()
+{
+    QFETCH(QString, compressionName);
+
+    QScopedPointer<KisAbstractCompression> compression(
+        KisTileCompressor2::createCompression(compressionName));
+    QVERIFY(compression);
+
+    qint64 totalSize = 0;
+    qint64 compressedSize = 0;
+    QByteArray output;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Q_FOREACH (const QByteArray &tile, m_tiles) {
+        output.resize(compression->outputBufferSize(tile.size()));
+        compressedSize += compression->compress((const quint8*)tile.constData(), tile.size(),
+                                                (quint8*)output.data(), output.size());
+        totalSize += tile.size();
+    }
+
+    const qint64 elapsed = qMax(qint64(1), timer.nsecsElapsed());
+
+    qDebug() << compressionName
+             << "ratio:" << double(totalSize) / qMax(qint64(1), compressedSize)
+             << "compression MB/s:" << double(totalSize) / elapsed * 1e9 / (1024 * 1024);
+
+    QBENCHMARK {
+        Q_FOREACH (const QByteArray &tile, m_tiles) {
+            compression->compress((const quint8*)tile.constData(), tile.size(),
+                                  (quint8*)output.data(), output.size());
+        }
+    }
+}
+
+void KisTileCompressionBenchmark::benchmarkDecompression_data()
+{
+    benchmarkCompression_data();
+}
+
+void KisTileCompressionBenchmark::benchmarkDecompression()
+{
+    QFETCH(QString, compressionName);
+
+    QScopedPointer<KisAbstractCompression> compression(
+        KisTileCompressor2::createCompression(compressionName));
+    QVERIFY(compression);
+
+    QVector<QByteArray> compressedTiles;
+    qint64 totalSize = 0;
+
+    Q_FOREACH (const QByteArray &tile, m_tiles) {
+        QByteArray output(compression->outputBufferSize(tile.size()), 0);
+        const qint32 bytes = compression->compress((const quint8*)tile.constData(), tile.size(),
+                                                   (quint8*)output.data(), output.size());
+        output.resize(bytes);
+        compressedTiles << output;
+        totalSize += tile.size();
+    }
+
+    QByteArray result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < compressedTiles.size(); i++) {
+        result.resize(m_tiles[i].size());
+        const qint32 bytes =
+            compression->decompress((const quint8*)compressedTiles[i].constData(), compressedTiles[i].size(),
+                                    (quint8*)result.data(), result.size());
+        QCOMPARE(bytes, m_tiles[i].size());
+        QVERIFY(result == m_tiles[i]);
+    }
+
+    const qint64 elapsed = qMax(qint64(1), timer.nsecsElapsed());
+
+    qDebug() << compressionName
+             << "decompression MB/s:" << double(totalSize) / elapsed * 1e9 / (1024 * 1024);
+
+    QBENCHMARK {
+        for (int i = 0; i < compressedTiles.size(); i++) {
+            compression->decompress((const quint8*)compressedTiles[i].constData(), compressedTiles[i].size(),
+                                    (quint8*)result.data(), m_tiles[i].size());
+        }
+    }
+}
+
+SIMPLE_TEST_MAIN(KisTileCompressionBenchmark)
@@ -0,0 +1,36 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILE_COMPRESSION_BENCHMARK_H
+#define KIS_TILE_COMPRESSION_BENCHMARK_H
+
+#include <simpletest.h>
+
+class KisTileCompressionBenchmark : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkCompression_data();
+    void benchmarkCompression();
+
+    void benchmarkDecompression_data();
+    void benchmarkDecompression();
+
+private:
+    /**
+     * Tiles of all the layers of the test document, every tile
+     * is stored in a linearized form, exactly as KisTileCompressor2
+     * passes it to the codec
+     */
+    QVector<QByteArray> m_tiles;
+};
+
+#endif
@@ -0,0 +1,7 @@
+/* config-tile-compression.h.  Generated by cmake from config-tile-compression.h.cmake */
+
+/* Define if you have LZ4, the fast tile compression codec */
+#cmakedefine HAVE_LZ4 1
+
+/* Define if you have Zstandard, the high-ratio tile compression codec */
+#cmakedefine HAVE_ZSTD 1
@@ -2,3 +2,5 @@
 /* Defines if your system has the FFTW3 library */
 #cmakedefine HAVE_FFTW3 1
 
+/* Defines if the FFTW3 library has threads support */
+#cmakedefine HAVE_FFTW3_THREADS 1
@@ -44,6 +44,11 @@ private:
     KisLocklessStack<Action> m_migrationReclaimActions;
 
     void releasePoolSafely(KisLocklessStack<Action> *pool, bool force = false) {
+        // update() is called on every read access to the map, so avoid
+        // writing into the shared stack header when there is nothing
+        // to release; it is the most common case
+        if (!force && pool->isEmpty()) return;
+
         KisLocklessStack<Action> tmp;
         tmp.mergeFrom(*pool);
         if (tmp.isEmpty()) return;
@@ -0,0 +1,318 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisFFTWPlanCache.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QGlobalStatic>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include <kis_debug.h>
+
+#include "config_convolution.h"
+
+
+Q_GLOBAL_STATIC(KisFFTWPlanCache, s_instance)
+
+namespace {
+
+/**
+ * FFTW's planner (and wisdom) is not reentrant, only the execution of the
+ * plans is. The lock is shared by all the cache operations that touch the
+ * planner, including destruction of the plans.
+ */
+QMutex s_plannerLock;
+
+const int maxCachedPlans = 32;
+
+/**
+ * Measuring a plan takes roughly as long as a few dozens of transforms of
+ * the same size, so we do that only for the sizes that are actually reused
+ * and not too big to be measured in a reasonable time.
+ */
+const int maxMeasuredSize = 1024 * 1024;
+
+/**
+ * The planner lock is held for the whole measurement, so the time limit
+ * bounds the time other threads may wait for it to create or destroy
+ * their plans.
+ */
+const double maxMeasurementTime = 2.0; // seconds
+
+/**
+ * Smaller transforms do not get any benefit from the threaded planner
+ */
+const int minThreadedSize = 512 * 512;
+
+QString wisdomFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/fftw_wisdom";
+}
+
+void appendWisdomChar(char c, void *data)
+{
+    reinterpret_cast<QByteArray*>(data)->append(c);
+}
+
+}
+
+
+struct KisFFTWPlanCache::Private
+{
+    struct Entry {
+        int width {0};
+        int height {0};
+        PlansSP plans;
+        int numRequests {0};
+        bool isBeingMeasured {false};
+    };
+
+    QMutex lock;
+
+    /// most recently used entries go first
+    QList<Entry> entries;
+
+    QThreadPool measurementPool;
+
+    PlansSP createPlans(int width, int height, bool measure);
+    void addPlans(int width, int height, PlansSP plans);
+    void measurePlans(int width, int height);
+    void loadWisdom();
+    void saveWisdom(const QByteArray &wisdom);
+};
+
+KisFFTWPlanCache::Plans::~Plans()
+{
+    QMutexLocker l(&s_plannerLock);
+
+    if (forward) {
+        fftw_destroy_plan(forward);
+    }
+
+    if (backward) {
+        fftw_destroy_plan(backward);
+    }
+}
+
+KisFFTWPlanCache::KisFFTWPlanCache()
+    : m_d(new Private)
+{
+    QMutexLocker l(&s_plannerLock);
+
+#ifdef HAVE_FFTW3_THREADS
+    if (!fftw_init_threads()) {
+        warnKrita << "KisFFTWPlanCache: failed to initialize FFTW threads";
+    }
+#endif
+
+#ifdef FFTW_NO_TIMELIMIT
+    fftw_set_timelimit(maxMeasurementTime);
+#endif
+
+    m_d->loadWisdom();
+
+    // the measurements serialize on the planner lock anyway
+    m_d->measurementPool.setMaxThreadCount(1);
+}
+
+KisFFTWPlanCache::~KisFFTWPlanCache()
+{
+    m_d->measurementPool.clear();
+    m_d->measurementPool.waitForDone();
+}
+
+KisFFTWPlanCache *KisFFTWPlanCache::instance()
+{
+    return s_instance;
+}
+
+KisFFTWPlanCache::PlansSP KisFFTWPlanCache::plans(int width, int height)
+{
+    {
+        QMutexLocker l(&m_d->lock);
+
+        for (int i = 0; i < m_d->entries.size(); i++) {
+            Private::Entry &entry = m_d->entries[i];
+            if (entry.width != width || entry.height != height) continue;
+
+            entry.numRequests++;
+
+            const bool shouldMeasure =
+                !entry.plans->isMeasured &&
+                !entry.isBeingMeasured &&
+                width * height <= maxMeasuredSize;
+
+            if (shouldMeasure) {
+                /**
+                 * Measuring takes much longer than the transform itself,
+                 * so the caller gets the estimated plans right away and
+                 * the measured ones are used by the following requests
+                 */
+                entry.isBeingMeasured = true;
+                QtConcurrent::run(&m_d->measurementPool,
+                                  [this, width, height] () {
+                                      m_d->measurePlans(width, height);
+                                  });
+            }
+
+            m_d->entries.move(i, 0);
+            return m_d->entries.first().plans;
+        }
+    }
+
+    PlansSP plans = m_d->createPlans(width, height, false);
+
+    if (plans) {
+        m_d->addPlans(width, height, plans);
+    }
+
+    return plans;
+}
+
+void KisFFTWPlanCache::Private::addPlans(int width, int height, PlansSP plans)
+{
+    // evicted plans are released after unlocking, their destruction
+    // needs the planner lock
+    QList<PlansSP> evictedPlans;
+
+    QMutexLocker l(&lock);
+
+    Entry entry;
+    entry.width = width;
+    entry.height = height;
+    entry.plans = plans;
+    entry.numRequests = 1;
+
+    for (int i = 0; i < entries.size(); i++) {
+        const Entry &oldEntry = entries[i];
+
+        if (oldEntry.width == width && oldEntry.height == height) {
+            entry.numRequests = oldEntry.numRequests;
+            evictedPlans << oldEntry.plans;
+            entries.removeAt(i);
+            break;
+        }
+    }
+
+    entries.prepend(entry);
+
+    if (entries.size() > maxCachedPlans) {
+        evictedPlans << entries.takeLast().plans;
+    }
+
+    l.unlock();
+}
+
+void KisFFTWPlanCache::Private::measurePlans(int width, int height)
+{
+    PlansSP plans = createPlans(width, height, true);
+
+    /**
+     * Measuring may fail if the planner cannot allocate the scratch
+     * buffer, the entry just keeps the estimated plans then.
+     */
+    if (plans) {
+        addPlans(width, height, plans);
+    }
+}
+
+KisFFTWPlanCache::PlansSP KisFFTWPlanCache::Private::createPlans(int width, int height, bool measure)
+{
+    const int rowStride = width + ((width % 2) ? 1 : 2);
+    const size_t numComplexValues = size_t(height) * (width / 2 + 1);
+    KIS_SAFE_ASSERT_RECOVER_NOOP(size_t(height) * rowStride == 2 * numComplexValues);
+
+    /**
+     * The planner may overwrite the arrays it is given while measuring,
+     * so the plans are always created on a scratch buffer.
+     */
+    fftw_complex *scratch = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * numComplexValues);
+    if (!scratch) return PlansSP();
+
+    PlansSP plans(new Plans());
+    QByteArray wisdom;
+
+    QMutexLocker l(&s_plannerLock);
+
+#ifdef HAVE_FFTW3_THREADS
+    fftw_plan_with_nthreads(width * height >= minThreadedSize ? QThread::idealThreadCount() : 1);
+#endif
+
+    if (!measure) {
+#ifdef FFTW_WISDOM_ONLY
+        const unsigned wisdomFlags = FFTW_MEASURE | FFTW_WISDOM_ONLY;
+        plans->forward = fftw_plan_dft_r2c_2d(height, width, (double*)scratch, scratch, wisdomFlags);
+        plans->backward = fftw_plan_dft_c2r_2d(height, width, scratch, (double*)scratch, wisdomFlags);
+#endif
+
+        if (plans->forward && plans->backward) {
+            plans->isMeasured = true;
+        } else {
+            if (!plans->forward) {
+                plans->forward = fftw_plan_dft_r2c_2d(height, width, (double*)scratch, scratch, FFTW_ESTIMATE);
+            }
+            if (!plans->backward) {
+                plans->backward = fftw_plan_dft_c2r_2d(height, width, scratch, (double*)scratch, FFTW_ESTIMATE);
+            }
+        }
+    } else {
+        plans->forward = fftw_plan_dft_r2c_2d(height, width, (double*)scratch, scratch, FFTW_MEASURE);
+        plans->backward = fftw_plan_dft_c2r_2d(height, width, scratch, (double*)scratch, FFTW_MEASURE);
+        plans->isMeasured = true;
+
+        fftw_export_wisdom(appendWisdomChar, &wisdom);
+    }
+
+    fftw_free(scratch);
+
+    l.unlock();
+
+    if (!wisdom.isEmpty()) {
+        saveWisdom(wisdom);
+    }
+
+    if (!plans->forward || !plans->backward) {
+        plans.reset();
+    }
+
+    return plans;
+}
+
+void KisFFTWPlanCache::Private::loadWisdom()
+{
+    QFile file(wisdomFilePath());
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    const QByteArray wisdom = file.readAll();
+
+    if (!fftw_import_wisdom_from_string(wisdom.constData())) {
+        warnKrita << "KisFFTWPlanCache: failed to load FFTW wisdom from" << file.fileName();
+    }
+}
+
+void KisFFTWPlanCache::Private::saveWisdom(const QByteArray &wisdom)
+{
+    const QString filePath = wisdomFilePath();
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(wisdom) != wisdom.size() ||
+        !file.commit()) {
+
+        warnKrita << "KisFFTWPlanCache: failed to save FFTW wisdom to" << filePath;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISFFTWPLANCACHE_H
+#define KISFFTWPLANCACHE_H
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+
+#include <fftw3.h>
+
+#include "kritaimage_export.h"
+
+/**
+ * A process-wide cache of FFTW plans used by KisConvolutionWorkerFFT.
+ *
+ * The plans are keyed by the size of the transform and are created for
+ * in-place transforms with the row stride of the convolution worker, that
+ * is, `width + (width % 2 ? 1 : 2)` doubles. They are never executed on the
+ * arrays they were created for, so the caller should always use the
+ * new-array execute functions (fftw_execute_dft_r2c() and
+ * fftw_execute_dft_c2r()) on buffers allocated with fftw_malloc().
+ *
+ * The first request for a size gets an FFTW_ESTIMATE plan, unless the
+ * wisdom already knows a better one. When the size is requested again
+ * (e.g. a filter mask is recalculated on every frame of an animation),
+ * the cache starts measuring a proper plan in a background thread and
+ * keeps returning the estimated plan until the measured one is ready.
+ * The result is stored in the wisdom file, so that the next session can
+ * reuse it without planning.
+ *
+ * If FFTW was built with threads support, the plans for big transforms
+ * are created for the threaded planner.
+ */
+class KRITAIMAGE_EXPORT KisFFTWPlanCache
+{
+public:
+    struct KRITAIMAGE_EXPORT Plans {
+        Plans() = default;
+        ~Plans();
+
+        fftw_plan forward {nullptr};
+        fftw_plan backward {nullptr};
+        bool isMeasured {false};
+
+    private:
+        Q_DISABLE_COPY(Plans)
+    };
+
+    using PlansSP = QSharedPointer<Plans>;
+
+public:
+    KisFFTWPlanCache();
+    ~KisFFTWPlanCache();
+
+    static KisFFTWPlanCache* instance();
+
+    /**
+     * @return a pair of forward (r2c) and backward (c2r) plans for a
+     * transform of \p height rows and \p width columns. The plans stay
+     * valid while the returned pointer is alive, even if the cache evicts
+     * them.
+     */
+    PlansSP plans(int width, int height);
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISFFTWPLANCACHE_H
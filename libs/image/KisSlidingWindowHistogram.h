@@ -0,0 +1,303 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISSLIDINGWINDOWHISTOGRAM_H
+#define KISSLIDINGWINDOWHISTOGRAM_H
+
+#include <QtGlobal>
+#include <QSize>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <kis_assert.h>
+
+/**
+ * A histogram of a square window of (2 * radius + 1)^2 pixels that slides
+ * over an image, as used by rank (median) and mode (oil paint) filters.
+ *
+ * The caller prepares a bin index for every pixel of the source area and,
+ * optionally, a few float values per pixel (e.g. normalized channels). The
+ * engine accumulates the number of pixels and the sums of their values per
+ * bin, so that a filter can find the interesting bin (the median or the
+ * most frequent one) and the average of the pixels that fell into it.
+ *
+ * Two strategies are used, both give the same histograms:
+ *
+ * - for big windows the histogram is built from per-column histograms
+ *   (Perreault & Hébert, "Median Filtering in Constant Time"): when moving
+ *   to the next row every column histogram gets one pixel added and one
+ *   removed, and when moving to the next pixel the window histogram gets
+ *   one column histogram added and one removed. The cost per pixel depends
+ *   on the number of bins only, not on the radius.
+ *
+ * - for small windows, when a column has fewer pixels than the histogram
+ *   has bins, the pixels of the entering and leaving columns are added and
+ *   removed one by one (Huang's algorithm), which is cheaper then.
+ *
+ * The sums are accumulated in doubles, so that adding and removing values
+ * doesn't accumulate any rounding error for the usual channel depths.
+ *
+ * The engine is not thread-safe, use a separate object for every thread.
+ */
+class KisSlidingWindowHistogram
+{
+public:
+    KisSlidingWindowHistogram(int numBins, int numValues, int radius)
+        : m_numBins(numBins),
+          m_numValues(numValues),
+          m_radius(radius),
+          m_usePerColumnHistograms(2 * radius + 1 > numBins),
+          m_counts(numBins),
+          m_sums(numBins * numValues)
+    {
+        KIS_SAFE_ASSERT_RECOVER_NOOP(numBins > 0);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(numValues >= 0);
+        KIS_SAFE_ASSERT_RECOVER_NOOP(radius >= 0);
+    }
+
+    int numBins() const {
+        return m_numBins;
+    }
+
+    int numValues() const {
+        return m_numValues;
+    }
+
+    int radius() const {
+        return m_radius;
+    }
+
+    /**
+     * @return the size of the source area needed to process an area of
+     * \p size pixels
+     */
+    QSize sourceSize(const QSize &size) const {
+        return size + QSize(2 * m_radius, 2 * m_radius);
+    }
+
+    /**
+     * Slides the window over an area of \p size pixels and calls
+     * \p func(x, y) for every pixel of it in row-major order. The
+     * histogram of the window centered at (x, y) is available through
+     * the query methods of the engine during the call.
+     *
+     * \p bins contains the bins of the source area of sourceSize(size)
+     * pixels in row-major order, that is, pixel (x, y) of the area
+     * corresponds to the pixel (x + radius, y + radius) of the source.
+     * A bin of -1 means that the pixel should not be counted at all.
+     *
+     * \p values contains numValues() values for every pixel of the source
+     * area. It may be null if numValues() is zero.
+     */
+    template <class Func>
+    void process(const QSize &size, const qint16 *bins, const float *values, Func func)
+    {
+        if (size.isEmpty()) return;
+
+        if (m_usePerColumnHistograms) {
+            processPerColumn(size, bins, values, func);
+        } else {
+            processPerPixel(size, bins, values, func);
+        }
+    }
+
+    /// number of pixels in \p bin for the current window
+    int count(int bin) const {
+        return m_counts[bin];
+    }
+
+    /// number of counted pixels in the current window
+    int totalCount() const {
+        return m_totalCount;
+    }
+
+    /// sums of numValues() values of the pixels in \p bin
+    const double* sums(int bin) const {
+        return m_sums.data() + bin * m_numValues;
+    }
+
+    /**
+     * @return the bin with the biggest number of pixels, if there are
+     * several ones, the lowest is returned. If the window has no counted
+     * pixels, -1 is returned.
+     */
+    int mostFrequentBin() const {
+        if (!m_totalCount) return -1;
+        return int(std::max_element(m_counts.begin(), m_counts.end()) - m_counts.begin());
+    }
+
+    /**
+     * @return the bin of the lower median of the window, that is, the bin
+     * of the pixel with rank (totalCount() - 1) / 2 in the sorted window. If
+     * the window has no counted pixels, -1 is returned.
+     */
+    int medianBin() const {
+        return rankBin((m_totalCount - 1) / 2);
+    }
+
+    /**
+     * @return the bin of the pixel with rank \p rank in the sorted window
+     * or -1 if the rank is out of range
+     */
+    int rankBin(int rank) const {
+        if (rank < 0 || rank >= m_totalCount) return -1;
+
+        int accumulated = 0;
+        for (int bin = 0; bin < m_numBins; bin++) {
+            accumulated += m_counts[bin];
+            if (accumulated > rank) return bin;
+        }
+
+        return -1;
+    }
+
+private:
+    void resetWindow() {
+        std::fill(m_counts.begin(), m_counts.end(), 0);
+        std::fill(m_sums.begin(), m_sums.end(), 0.0);
+        m_totalCount = 0;
+    }
+
+    template <int sign>
+    inline void addPixel(int *counts, double *sums, qint16 bin, const float *values, int *totalCount) {
+        if (bin < 0) return;
+
+        counts[bin] += sign;
+        *totalCount += sign;
+
+        double *binSums = sums + bin * m_numValues;
+        for (int i = 0; i < m_numValues; i++) {
+            binSums[i] += sign * double(values[i]);
+        }
+    }
+
+    template <class Func>
+    void processPerPixel(const QSize &size, const qint16 *bins, const float *values, Func func)
+    {
+        const QSize srcSize = sourceSize(size);
+        const int srcStride = srcSize.width();
+        const int windowSize = 2 * m_radius + 1;
+
+        auto addColumn = [&] (int column, int firstRow, auto sign) {
+            const qint16 *binPtr = bins + firstRow * srcStride + column;
+            const float *valuesPtr = values + (firstRow * srcStride + column) * m_numValues;
+
+            for (int i = 0; i < windowSize; i++) {
+                addPixel<decltype(sign)::value>(m_counts.data(), m_sums.data(), *binPtr, valuesPtr, &m_totalCount);
+                binPtr += srcStride;
+                valuesPtr += srcStride * m_numValues;
+            }
+        };
+
+        using Add = std::integral_constant<int, 1>;
+        using Remove = std::integral_constant<int, -1>;
+
+        for (int y = 0; y < size.height(); y++) {
+            resetWindow();
+
+            for (int column = 0; column < windowSize; column++) {
+                addColumn(column, y, Add());
+            }
+
+            func(0, y);
+
+            for (int x = 1; x < size.width(); x++) {
+                addColumn(x - 1, y, Remove());
+                addColumn(x + 2 * m_radius, y, Add());
+
+                func(x, y);
+            }
+        }
+    }
+
+    template <class Func>
+    void processPerColumn(const QSize &size, const qint16 *bins, const float *values, Func func)
+    {
+        const QSize srcSize = sourceSize(size);
+        const int srcStride = srcSize.width();
+        const int windowSize = 2 * m_radius + 1;
+        const int sumsPerColumn = m_numBins * m_numValues;
+
+        m_columnCounts.assign(size_t(srcStride) * m_numBins, 0);
+        m_columnSums.assign(size_t(srcStride) * sumsPerColumn, 0.0);
+        m_columnTotals.assign(srcStride, 0);
+
+        auto updateColumns = [&] (int row, auto sign) {
+            const qint16 *binPtr = bins + row * srcStride;
+            const float *valuesPtr = values + row * srcStride * m_numValues;
+
+            for (int column = 0; column < srcStride; column++) {
+                addPixel<decltype(sign)::value>(m_columnCounts.data() + column * m_numBins,
+                                                m_columnSums.data() + column * sumsPerColumn,
+                                                *binPtr, valuesPtr,
+                                                &m_columnTotals[column]);
+                binPtr++;
+                valuesPtr += m_numValues;
+            }
+        };
+
+        auto addColumnHistogram = [&] (int column, auto sign) {
+            const int *counts = m_columnCounts.data() + column * m_numBins;
+            for (int bin = 0; bin < m_numBins; bin++) {
+                m_counts[bin] += decltype(sign)::value * counts[bin];
+            }
+
+            const double *sums = m_columnSums.data() + column * sumsPerColumn;
+            for (int i = 0; i < sumsPerColumn; i++) {
+                m_sums[i] += decltype(sign)::value * sums[i];
+            }
+
+            m_totalCount += decltype(sign)::value * m_columnTotals[column];
+        };
+
+        using Add = std::integral_constant<int, 1>;
+        using Remove = std::integral_constant<int, -1>;
+
+        for (int row = 0; row < windowSize; row++) {
+            updateColumns(row, Add());
+        }
+
+        for (int y = 0; y < size.height(); y++) {
+            if (y > 0) {
+                updateColumns(y - 1, Remove());
+                updateColumns(y + 2 * m_radius, Add());
+            }
+
+            resetWindow();
+
+            for (int column = 0; column < windowSize; column++) {
+                addColumnHistogram(column, Add());
+            }
+
+            func(0, y);
+
+            for (int x = 1; x < size.width(); x++) {
+                addColumnHistogram(x - 1, Remove());
+                addColumnHistogram(x + 2 * m_radius, Add());
+
+                func(x, y);
+            }
+        }
+    }
+
+private:
+    const int m_numBins;
+    const int m_numValues;
+    const int m_radius;
+    const bool m_usePerColumnHistograms;
+
+    std::vector<int> m_counts;
+    std::vector<double> m_sums;
+    int m_totalCount {0};
+
+    std::vector<int> m_columnCounts;
+    std::vector<double> m_columnSums;
+    std::vector<int> m_columnTotals;
+};
+
+#endif // KISSLIDINGWINDOWHISTOGRAM_H
@@ -0,0 +1,297 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisTiledHistogram.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <KoColorSpace.h>
+
+#include "kis_paint_device.h"
+#include "kis_iterator_ng.h"
+#include "kis_assert.h"
+
+namespace {
+/**
+ * The tile should be big enough to keep the memory used by the per-tile
+ * histograms low (1 KiB per channel), but small enough to make a stroke
+ * dab invalidate only a tiny part of the image.
+ */
+const int TileSize = 256;
+const int NumBins = 256;
+
+struct Tile
+{
+    QVector<quint32> bins;
+    quint64 count {0};
+    bool isDirty {true};
+};
+}
+
+struct KisTiledHistogram::Private
+{
+    mutable QMutex mutex;
+
+    const KisPaintDevice *device {nullptr};
+    const KoColorSpace *colorSpace {nullptr};
+    QRect bounds;
+    int samplingStep {1};
+
+    int numColumns {0};
+    int numRows {0};
+    QVector<Tile> tiles;
+
+    QVector<quint64> totals;
+    quint64 count {0};
+
+    /**
+     * Increased on every reset, so that the tiles calculated for the
+     * previous geometry could be dropped
+     */
+    quint64 generation {0};
+
+    void reset();
+
+    QRect tileRect(int index) const {
+        const int column = index % numColumns;
+        const int row = index / numColumns;
+
+        return QRect(bounds.x() + column * TileSize,
+                     bounds.y() + row * TileSize,
+                     TileSize, TileSize) & bounds;
+    }
+};
+
+void KisTiledHistogram::Private::reset()
+{
+    generation++;
+
+    numColumns = bounds.isEmpty() ? 0 : (bounds.width() + TileSize - 1) / TileSize;
+    numRows = bounds.isEmpty() ? 0 : (bounds.height() + TileSize - 1) / TileSize;
+
+    tiles.clear();
+    tiles.resize(numColumns * numRows);
+
+    totals.fill(0, colorSpace ? colorSpace->channelCount() * NumBins : 0);
+    count = 0;
+}
+
+KisTiledHistogram::KisTiledHistogram()
+    : m_d(new Private)
+{
+}
+
+KisTiledHistogram::~KisTiledHistogram()
+{
+}
+
+void KisTiledHistogram::prepare(KisPaintDeviceSP device, const QRect &bounds, int samplingStep)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    const KoColorSpace *colorSpace = device ? device->colorSpace() : nullptr;
+    samplingStep = qMax(1, samplingStep);
+
+    if (m_d->device == device.data() &&
+        m_d->bounds == bounds &&
+        m_d->samplingStep == samplingStep &&
+        (m_d->colorSpace == colorSpace ||
+         (m_d->colorSpace && colorSpace && *m_d->colorSpace == *colorSpace))) {
+
+        return;
+    }
+
+    m_d->device = device.data();
+    m_d->colorSpace = colorSpace;
+    m_d->bounds = bounds;
+    m_d->samplingStep = samplingStep;
+    m_d->reset();
+}
+
+void KisTiledHistogram::addDirtyRect(const QRect &rc)
+{
+    QMutexLocker l(&m_d->mutex);
+
+    const QRect dirtyRect = rc & m_d->bounds;
+    if (dirtyRect.isEmpty()) return;
+
+    const int firstColumn = (dirtyRect.left() - m_d->bounds.left()) / TileSize;
+    const int lastColumn = (dirtyRect.right() - m_d->bounds.left()) / TileSize;
+    const int firstRow = (dirtyRect.top() - m_d->bounds.top()) / TileSize;
+    const int lastRow = (dirtyRect.bottom() - m_d->bounds.top()) / TileSize;
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            m_d->tiles[row * m_d->numColumns + column].isDirty = true;
+        }
+    }
+}
+
+void KisTiledHistogram::invalidate()
+{
+    QMutexLocker l(&m_d->mutex);
+    m_d->reset();
+}
+
+QVector<int> KisTiledHistogram::dirtyTiles() const
+{
+    QMutexLocker l(&m_d->mutex);
+
+    QVector<int> result;
+
+    for (int i = 0; i < m_d->tiles.size(); i++) {
+        if (m_d->tiles[i].isDirty) {
+            result.append(i);
+        }
+    }
+
+    return result;
+}
+
+void KisTiledHistogram::updateTile(KisPaintDeviceSP device, int tileIndex)
+{
+    QRect rc;
+    const KoColorSpace *colorSpace = nullptr;
+    int samplingStep = 1;
+    quint64 generation = 0;
+
+    {
+        QMutexLocker l(&m_d->mutex);
+
+        KIS_SAFE_ASSERT_RECOVER_RETURN(tileIndex >= 0 && tileIndex < m_d->tiles.size());
+        KIS_SAFE_ASSERT_RECOVER_RETURN(device && m_d->colorSpace && *device->colorSpace() == *m_d->colorSpace);
+
+        /**
+         * Reset the flag before the calculation, so that if the tile is
+         * changed while being calculated, it would be recalculated again
+         * on the next update.
+         */
+        m_d->tiles[tileIndex].isDirty = false;
+
+        rc = m_d->tileRect(tileIndex);
+        colorSpace = m_d->colorSpace;
+        samplingStep = m_d->samplingStep;
+        generation = m_d->generation;
+    }
+
+    const quint32 pixelSize = colorSpace->pixelSize();
+
+    QVector<quint32> bins(colorSpace->channelCount() * NumBins, 0);
+    quint64 count = 0;
+
+    KisSequentialConstIterator it(device, rc);
+
+    if (samplingStep == 1) {
+        int numConseqPixels = it.nConseqPixels();
+        while (it.nextPixels(numConseqPixels)) {
+            numConseqPixels = it.nConseqPixels();
+            colorSpace->addPixelsToU8Histograms(it.rawDataConst(), numConseqPixels, bins.data());
+            count += numConseqPixels;
+        }
+    } else {
+        int toSkip = samplingStep;
+
+        int numConseqPixels = it.nConseqPixels();
+        while (it.nextPixels(numConseqPixels)) {
+            numConseqPixels = it.nConseqPixels();
+
+            const quint8 *pixel = it.rawDataConst();
+            for (int i = 0; i < numConseqPixels; i++) {
+                if (--toSkip == 0) {
+                    colorSpace->addPixelsToU8Histograms(pixel, 1, bins.data());
+                    count++;
+                    toSkip = samplingStep;
+                }
+                pixel += pixelSize;
+            }
+        }
+    }
+
+    QMutexLocker l(&m_d->mutex);
+
+    if (generation != m_d->generation) return;
+
+    Tile &tile = m_d->tiles[tileIndex];
+
+    if (!tile.bins.isEmpty()) {
+        for (int i = 0; i < tile.bins.size(); i++) {
+            m_d->totals[i] -= tile.bins[i];
+        }
+        m_d->count -= tile.count;
+    }
+
+    for (int i = 0; i < bins.size(); i++) {
+        m_d->totals[i] += bins[i];
+    }
+    m_d->count += count;
+
+    tile.bins.swap(bins);
+    tile.count = count;
+}
+
+const KoColorSpace *KisTiledHistogram::colorSpace() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->colorSpace;
+}
+
+quint64 KisTiledHistogram::count() const
+{
+    QMutexLocker l(&m_d->mutex);
+    return m_d->count;
+}
+
+QVector<quint32> KisTiledHistogram::channelBins(int channel) const
+{
+    QMutexLocker l(&m_d->mutex);
+
+    QVector<quint32> result(NumBins, 0);
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE((channel + 1) * NumBins <= m_d->totals.size(), result);
+
+    const quint64 *channelTotals = m_d->totals.constData() + channel * NumBins;
+    for (int i = 0; i < NumBins; i++) {
+        result[i] = static_cast<quint32>(channelTotals[i]);
+    }
+
+    return result;
+}
+
+KisTiledHistogram::ChannelStatistics KisTiledHistogram::channelStatistics(int channel) const
+{
+    QMutexLocker l(&m_d->mutex);
+
+    ChannelStatistics result;
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN_VALUE((channel + 1) * NumBins <= m_d->totals.size(), result);
+
+    const quint64 *channelTotals = m_d->totals.constData() + channel * NumBins;
+
+    quint64 count = 0;
+    qreal total = 0.0;
+    int min = -1;
+    int max = -1;
+
+    for (int i = 0; i < NumBins; i++) {
+        if (!channelTotals[i]) continue;
+
+        if (min < 0) {
+            min = i;
+        }
+        max = i;
+        count += channelTotals[i];
+        total += qreal(i) * channelTotals[i];
+    }
+
+    if (count > 0) {
+        result.min = min;
+        result.max = max;
+        result.mean = total / count;
+    }
+
+    return result;
+}
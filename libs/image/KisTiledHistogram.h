@@ -0,0 +1,110 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISTILEDHISTOGRAM_H
+#define KISTILEDHISTOGRAM_H
+
+#include <QScopedPointer>
+#include <QVector>
+#include <QRect>
+
+#include "kis_types.h"
+#include "kritaimage_export.h"
+
+class KoColorSpace;
+
+/**
+ * 8-bit histograms of all the channels of a paint device that can be
+ * updated incrementally.
+ *
+ * The area of the device is split into a grid of fixed-size tiles and the
+ * histogram of every tile is stored separately. When the device changes,
+ * the changed area is passed to addDirtyRect() and only the tiles touched
+ * by it are rescanned by updateTile(). Different tiles can be updated from
+ * different threads concurrently, e.g. from the concurrent jobs of a stroke.
+ *
+ * The histogram of a channel has 256 bins and uses the same channel
+ * positions and the same scaling as KoColorSpace::scaleToU8().
+ */
+class KRITAIMAGE_EXPORT KisTiledHistogram
+{
+public:
+    struct ChannelStatistics
+    {
+        /// the lowest non-empty bin
+        int min {0};
+        /// the highest non-empty bin
+        int max {0};
+        /// the mean value of the channel in bin units, that is 0...255
+        qreal mean {0.0};
+    };
+
+public:
+    KisTiledHistogram();
+    ~KisTiledHistogram();
+
+    /**
+     * Prepares the histogram for calculation over the area \p bounds of
+     * \p device. When the device, its color space, the bounds or the
+     * sampling step differ from the ones used previously, the histogram is
+     * reset and all the tiles are marked as dirty.
+     *
+     * The device is used only for identification and is not stored.
+     *
+     * \p samplingStep defines that only every samplingStep-th pixel of a
+     * tile is added to the histogram, which allows to estimate histograms
+     * of huge images quickly.
+     */
+    void prepare(KisPaintDeviceSP device, const QRect &bounds, int samplingStep = 1);
+
+    /**
+     * Marks all the tiles intersecting \p rc as dirty
+     */
+    void addDirtyRect(const QRect &rc);
+
+    /**
+     * Resets the histogram and marks all the tiles as dirty
+     */
+    void invalidate();
+
+    /**
+     * \return the indexes of the tiles that should be recalculated
+     */
+    QVector<int> dirtyTiles() const;
+
+    /**
+     * Rescans the tile \p tileIndex of \p device and updates the
+     * histogram. If the histogram is reset while the tile is being
+     * calculated, the result is dropped.
+     */
+    void updateTile(KisPaintDeviceSP device, int tileIndex);
+
+    /**
+     * \return the color space of the device passed to prepare()
+     */
+    const KoColorSpace* colorSpace() const;
+
+    /**
+     * \return the number of the sampled pixels in all clean tiles
+     */
+    quint64 count() const;
+
+    /**
+     * \return the histogram of the channel at position \p channel
+     */
+    QVector<quint32> channelBins(int channel) const;
+
+    /**
+     * \return min/max and mean of the channel at position \p channel
+     */
+    ChannelStatistics channelStatistics(int channel) const;
+
+private:
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISTILEDHISTOGRAM_H
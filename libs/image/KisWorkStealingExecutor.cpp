@@ -0,0 +1,312 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisWorkStealingExecutor.h"
+
+#include <deque>
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QRunnable>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "kis_assert.h"
+
+namespace {
+/**
+ * The time an idle worker waits for new jobs before exiting,
+ * the same as the default expiry timeout of QThreadPool
+ */
+const int IDLE_TIMEOUT = 30000;
+
+QAtomicInteger<qint64> s_numStolenJobs;
+}
+
+struct KisWorkStealingExecutor::Worker : public QThread
+{
+    Worker(KisWorkStealingExecutor::Private *_pool, int _index)
+        : pool(_pool),
+          index(_index)
+    {
+    }
+
+    void run() override;
+
+    void push(QRunnable *runnable) {
+        QMutexLocker l(&queueLock);
+        queue.push_back(runnable);
+    }
+
+    /**
+     * The owner takes the most recent job, it is most probably
+     * still in the cache...
+     */
+    QRunnable* popLocal() {
+        QMutexLocker l(&queueLock);
+        if (queue.empty()) return 0;
+
+        QRunnable *runnable = queue.back();
+        queue.pop_back();
+        return runnable;
+    }
+
+    /**
+     * ...and the thieves take the oldest one
+     */
+    QRunnable* steal() {
+        QMutexLocker l(&queueLock);
+        if (queue.empty()) return 0;
+
+        QRunnable *runnable = queue.front();
+        queue.pop_front();
+        return runnable;
+    }
+
+    KisWorkStealingExecutor::Private *pool;
+    const int index;
+
+    QMutex queueLock;
+    std::deque<QRunnable*> queue;
+
+    // guarded by Private::idleLock
+    bool isActive = false;
+};
+
+struct KisWorkStealingExecutor::Private
+{
+    Private(KisWorkStealingExecutor *_q) : q(_q) {}
+
+    KisWorkStealingExecutor *q;
+    QVector<Worker*> workers;
+
+    QAtomicInt numPendingJobs;
+    QAtomicInt numUnfinishedJobs;
+    QAtomicInt numSleepingWorkers;
+    QAtomicInt numActiveWorkers;
+    QAtomicInt nextWorker;
+
+    QMutex idleLock;
+    QWaitCondition idleCondition;
+    QWaitCondition doneCondition;
+    bool shouldExit = false;
+
+    static thread_local Worker *currentWorker;
+
+    QRunnable* fetchJob(Worker *worker);
+    void runJob(QRunnable *runnable);
+    bool waitForJobs(Worker *worker);
+
+    void stopWorkers();
+};
+
+thread_local KisWorkStealingExecutor::Worker *KisWorkStealingExecutor::Private::currentWorker = 0;
+
+void KisWorkStealingExecutor::Worker::run()
+{
+    Private::currentWorker = this;
+
+    while (1) {
+        QRunnable *runnable = pool->fetchJob(this);
+
+        if (runnable) {
+            pool->runJob(runnable);
+        } else if (!pool->waitForJobs(this)) {
+            break;
+        }
+    }
+
+    Private::currentWorker = 0;
+}
+
+QRunnable* KisWorkStealingExecutor::Private::fetchJob(Worker *worker)
+{
+    QRunnable *runnable = worker->popLocal();
+
+    if (!runnable) {
+        const int numWorkers = workers.size();
+
+        for (int i = 1; i < numWorkers; i++) {
+            Worker *victim = workers[(worker->index + i) % numWorkers];
+            runnable = victim->steal();
+
+            if (runnable) {
+                s_numStolenJobs.ref();
+                break;
+            }
+        }
+    }
+
+    if (runnable) {
+        numPendingJobs.deref();
+    }
+
+    return runnable;
+}
+
+void KisWorkStealingExecutor::Private::runJob(QRunnable *runnable)
+{
+    const bool autoDelete = runnable->autoDelete();
+
+    runnable->run();
+
+    if (autoDelete) {
+        delete runnable;
+    }
+
+    if (!numUnfinishedJobs.deref()) {
+        QMutexLocker l(&idleLock);
+        doneCondition.wakeAll();
+    }
+}
+
+bool KisWorkStealingExecutor::Private::waitForJobs(Worker *worker)
+{
+    QMutexLocker l(&idleLock);
+
+    /**
+     * The counter is incremented *before* checking for the pending
+     * jobs, and start() increments the number of pending jobs *before*
+     * checking the counter. Both the operations are ordered, so at least
+     * one of the sides will notice the other one.
+     */
+    numSleepingWorkers.fetchAndAddOrdered(1);
+
+    bool hasJobs = numPendingJobs.fetchAndAddOrdered(0) > 0;
+
+    if (!hasJobs && !shouldExit) {
+        idleCondition.wait(&idleLock, IDLE_TIMEOUT);
+        hasJobs = numPendingJobs.fetchAndAddOrdered(0) > 0;
+    }
+
+    numSleepingWorkers.fetchAndAddOrdered(-1);
+
+    if (!hasJobs) {
+        /**
+         * We are still under the lock, so start() will notice that
+         * the worker has gone and will restart it if needed
+         */
+        worker->isActive = false;
+        numActiveWorkers.deref();
+    }
+
+    return hasJobs;
+}
+
+void KisWorkStealingExecutor::Private::stopWorkers()
+{
+    {
+        QMutexLocker l(&idleLock);
+        shouldExit = true;
+        idleCondition.wakeAll();
+    }
+
+    Q_FOREACH (Worker *worker, workers) {
+        worker->wait();
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_NOOP(!numPendingJobs);
+
+    qDeleteAll(workers);
+    workers.clear();
+
+    shouldExit = false;
+}
+
+KisWorkStealingExecutor::KisWorkStealingExecutor()
+    : m_d(new Private(this))
+{
+}
+
+KisWorkStealingExecutor::~KisWorkStealingExecutor()
+{
+    waitForDone();
+    m_d->stopWorkers();
+}
+
+void KisWorkStealingExecutor::setMaxThreadCount(int value)
+{
+    if (value == m_d->workers.size()) return;
+
+    /**
+     * The workers iterate over the list of workers when stealing,
+     * so it can be changed only when all of them have stopped
+     */
+    waitForDone();
+    m_d->stopWorkers();
+
+    for (int i = 0; i < value; i++) {
+        m_d->workers.append(new Worker(m_d.data(), i));
+    }
+}
+
+int KisWorkStealingExecutor::maxThreadCount() const
+{
+    return m_d->workers.size();
+}
+
+void KisWorkStealingExecutor::start(QRunnable *runnable)
+{
+    const int numWorkers = m_d->workers.size();
+    KIS_SAFE_ASSERT_RECOVER_RETURN(numWorkers > 0);
+
+    Worker *worker = Private::currentWorker;
+
+    if (!worker || worker->pool != m_d.data()) {
+        const int index = m_d->nextWorker.fetchAndAddRelaxed(1);
+        worker = m_d->workers[quint32(index) % numWorkers];
+    }
+
+    m_d->numUnfinishedJobs.ref();
+    worker->push(runnable);
+    m_d->numPendingJobs.fetchAndAddOrdered(1);
+
+    // fast path: all the workers are awake and will find the job themselves
+    if (m_d->numSleepingWorkers.fetchAndAddOrdered(0) <= 0 &&
+        m_d->numActiveWorkers.fetchAndAddOrdered(0) >= numWorkers) {
+
+        return;
+    }
+
+    QMutexLocker l(&m_d->idleLock);
+
+    if (m_d->numSleepingWorkers > 0) {
+        m_d->idleCondition.wakeOne();
+    } else {
+        Q_FOREACH (Worker *w, m_d->workers) {
+            if (!w->isActive) {
+                // the thread might still be in the process of exiting
+                w->wait();
+
+                w->isActive = true;
+                m_d->numActiveWorkers.ref();
+                w->start();
+                break;
+            }
+        }
+    }
+}
+
+void KisWorkStealingExecutor::waitForDone()
+{
+    QMutexLocker l(&m_d->idleLock);
+
+    while (m_d->numUnfinishedJobs.loadAcquire() > 0) {
+        m_d->doneCondition.wait(&m_d->idleLock);
+    }
+}
+
+KisWorkStealingExecutor* KisWorkStealingExecutor::currentExecutor()
+{
+    Worker *worker = Private::currentWorker;
+    return worker ? worker->pool->q : 0;
+}
+
+qint64 KisWorkStealingExecutor::numStolenJobs()
+{
+    return s_numStolenJobs.loadAcquire();
+}
@@ -0,0 +1,80 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISWORKSTEALINGEXECUTOR_H
+#define KISWORKSTEALINGEXECUTOR_H
+
+#include "kritaimage_export.h"
+
+#include <QScopedPointer>
+
+class QRunnable;
+
+/**
+ * A thread pool used by KisUpdaterContext to run the update job items.
+ *
+ * Every worker thread owns a queue of runnables. A runnable started
+ * from within a worker thread is pushed into the queue of this very
+ * worker (and is most probably executed by it right after the current
+ * job, while its data is still in the cache), a runnable started from
+ * the outside is distributed between the workers in a round-robin
+ * manner. When the worker's own queue is empty, it tries to steal the
+ * oldest runnable from the queues of the other workers. So, in contrast
+ * to QThreadPool, there is no global queue with a global lock. The lock
+ * of the pool is taken only when a worker goes to sleep or needs to be
+ * woken up.
+ *
+ * Just like in QThreadPool, the threads are created lazily and exit
+ * after being idle for some time.
+ */
+class KRITAIMAGE_EXPORT KisWorkStealingExecutor
+{
+public:
+    KisWorkStealingExecutor();
+    ~KisWorkStealingExecutor();
+
+    /**
+     * Sets the maximum number of the worker threads. Does nothing if
+     * the number doesn't change, otherwise waits for the runnables in
+     * flight to finish and restarts the workers. No new runnables
+     * should be started during the call.
+     */
+    void setMaxThreadCount(int value);
+    int maxThreadCount() const;
+
+    /**
+     * Adds \p runnable to the pool. If runnable->autoDelete() is set,
+     * it is deleted by the pool after execution.
+     */
+    void start(QRunnable *runnable);
+
+    /**
+     * Blocks the caller until all the runnables are executed
+     */
+    void waitForDone();
+
+    /**
+     * Returns the executor the calling thread is a worker of, or null
+     * if the thread doesn't belong to any executor. Lets the code running
+     * inside a job split its work into more runnables of the same pool
+     * instead of spawning threads of its own.
+     */
+    static KisWorkStealingExecutor* currentExecutor();
+
+    /**
+     * The number of runnables that were executed by a thread different
+     * from the one they were queued to, summed over all the executors
+     * of the application. Used for benchmarking only.
+     */
+    static qint64 numStolenJobs();
+
+private:
+    struct Worker;
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISWORKSTEALINGEXECUTOR_H
@@ -203,9 +203,31 @@ private:
 /*                     KisAsyncMerger                                */
 /*********************************************************************/
 
+/**
+ * Asks the swap to load the areas the walker is going to read, that
+ * is the need rects of the originals. The leaves are processed from
+ * the top of the stack, so they are queued in the same order. The
+ * prefetcher loads the tiles of the upper leaves while the merger
+ * is busy with the lower ones.
+ */
+void KisAsyncMerger::prefetchSwappedData(KisBaseRectsWalker &walker)
+{
+    const KisMergeWalker::LeafStack &leafStack = walker.leafStack();
+
+    for (auto it = leafStack.crbegin(); it != leafStack.crend(); ++it) {
+        KisPaintDeviceSP original = it->m_leaf->original();
+        if (original) {
+            original->prefetchSwappedData(
+                it->m_leaf->projectionPlane()->needRectForOriginal(it->m_applyRect));
+        }
+    }
+}
+
 void KisAsyncMerger::startMerge(KisBaseRectsWalker &walker, bool notifyClones) {
     KisMergeWalker::LeafStack &leafStack = walker.leafStack();
 
+    prefetchSwappedData(walker);
+
     const bool useTempProjections = walker.needRectVaries();
 
     while(!leafStack.isEmpty()) {
@@ -18,6 +18,7 @@ public:
     void startMerge(KisBaseRectsWalker &walker, bool notifyClones = true);
 
 private:
+    inline void prefetchSwappedData(KisBaseRectsWalker &walker);
     inline void resetProjection();
     inline void setupProjection(KisProjectionLeafSP currentLeaf, const QRect& rect, bool useTempProjection);
     inline void writeProjection(KisProjectionLeafSP topmostLeaf, bool useTempProjection, const QRect &rect);
@@ -75,6 +75,7 @@ void FastRowProcessor<KisCircleMaskGenerator>::process<xsimd::current_arch>(floa
 
         float_v xr = x_ * vCosa - vSinaY_;
         float_v yr = x_ * vSina + vCosaY_;
+        fixRotation<xsimd::current_arch>(xr, yr);
 
         const float_v n = xsimd::pow2(xr * vXCoeff) + xsimd::pow2(yr * vYCoeff);
         const float_m outsideMask = n > vOne;
@@ -151,8 +152,9 @@ void FastRowProcessor<KisGaussCircleMaskGenerator>::process<xsimd::current_arch>
     for (size_t i = 0; i < static_cast<size_t>(width); i += float_v::size) {
         const float_v x_ = currentIndices - vCenterX;
 
-        const float_v xr = x_ * vCosa - vSinaY_;
-        const float_v yr = x_ * vSina + vCosaY_;
+        float_v xr = x_ * vCosa - vSinaY_;
+        float_v yr = x_ * vSina + vCosaY_;
+        fixRotation<xsimd::current_arch>(xr, yr);
 
         float_v dist =
             xsimd::sqrt(xsimd::pow2(xr) + xsimd::pow2(yr * vYCoeff));
@@ -234,8 +236,9 @@ void FastRowProcessor<KisCurveCircleMaskGenerator>::process<xsimd::current_arch>
     for (size_t i = 0; i < static_cast<size_t>(width); i += float_v::size) {
         const float_v x_ = currentIndices - vCenterX;
 
-        const float_v xr = x_ * vCosa - vSinaY_;
-        const float_v yr = x_ * vSina + vCosaY_;
+        float_v xr = x_ * vCosa - vSinaY_;
+        float_v yr = x_ * vSina + vCosaY_;
+        fixRotation<xsimd::current_arch>(xr, yr);
 
         float_v dist = xsimd::pow2(xr * vXCoeff) + xsimd::pow2(yr * vYCoeff);
 
@@ -328,6 +331,12 @@ void FastRowProcessor<KisRectangleMaskGenerator>::process<xsimd::current_arch>(f
         float_v xr = xsimd::abs(x_ * vCosa - vSinaY_);
         float_v yr = xsimd::abs(x_ * vSina + vCosaY_);
 
+        if (spikes > 2) {
+            fixRotation<xsimd::current_arch>(xr, yr);
+            xr = xsimd::abs(xr);
+            yr = xsimd::abs(yr);
+        }
+
         const float_v nxr = xr * vXCoeff;
         const float_v nyr = yr * vYCoeff;
 
@@ -412,6 +421,7 @@ void FastRowProcessor<KisGaussRectangleMaskGenerator>::process<xsimd::current_ar
 
         float_v xr = x_ * vCosa - vSinaY_;
         float_v yr = xsimd::abs(x_ * vSina + vCosaY_);
+        fixRotation<xsimd::current_arch>(xr, yr);
 
         // check if we need to apply fader on values
         float_m excludeMask = d->fadeMaker.needFade(xr, yr);
@@ -493,6 +503,7 @@ void FastRowProcessor<KisCurveRectangleMaskGenerator>::process<xsimd::current_ar
 
         float_v xr = x_ * vCosa - vSinaY_;
         float_v yr = xsimd::abs(x_ * vSina + vCosaY_);
+        fixRotation<xsimd::current_arch>(xr, yr);
 
         // check if we need to apply fader on values
         float_m excludeMask = d->fadeMaker.needFade(xr, yr);
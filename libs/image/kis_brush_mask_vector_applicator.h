@@ -13,19 +13,57 @@
 
 #if defined HAVE_XSIMD
 
+#include <cmath>
+
 #include "kis_brush_mask_scalar_applicator.h"
 
 template<class V>
 struct FastRowProcessor {
     FastRowProcessor(V *maskGenerator)
         : d(maskGenerator->d.data())
+        , spikes(maskGenerator->spikes())
+        , spikesAngle(static_cast<float>(M_PI / spikes))
     {
     }
 
     template<typename _impl>
     void process(float *buffer, int width, float y, float cosa, float sina, float centerX, float centerY);
 
+    /**
+     * A vector version of KisMaskGenerator::fixRotation(). Instead of
+     * rotating the point by one spike at a time, the number of the
+     * rotations is calculated from the angle and applied at once.
+     */
+    template<typename _impl>
+    inline void fixRotation(xsimd::batch<float, _impl> &xr, xsimd::batch<float, _impl> &yr) const
+    {
+        using float_v = xsimd::batch<float, _impl>;
+
+        if (spikes <= 2) return;
+
+        // the scalar version gets the absolute value of y before folding
+        yr = xsimd::abs(yr);
+
+        const float_v vSpikesAngle(spikesAngle);
+        const float_v vSpikesStep(2.0f * spikesAngle);
+
+        const float_v angle = xsimd::atan2(yr, xr);
+        const float_v steps = xsimd::max(xsimd::ceil((angle - vSpikesAngle) / vSpikesStep), float_v(0.0f));
+
+        if (xsimd::all(steps == float_v(0.0f))) return;
+
+        const auto sincos = xsimd::sincos(steps * vSpikesStep);
+        const float_v sn = sincos.first;
+        const float_v cs = sincos.second;
+
+        const float_v sx = xr;
+        xr = cs * sx + sn * yr;
+        yr = cs * yr - sn * sx;
+    }
+
     typename V::Private *d;
+    const int spikes;
+    const float spikesAngle;
 };
 
 template<class MaskGenerator, typename _impl>
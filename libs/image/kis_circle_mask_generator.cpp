@@ -60,7 +60,7 @@ KisCircleMaskGenerator::~KisCircleMaskGenerator()
 
 bool KisCircleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return !shouldSupersample();
 }
 
 KisBrushMaskApplicatorBase* KisCircleMaskGenerator::applicator()
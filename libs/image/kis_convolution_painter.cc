@@ -38,6 +38,8 @@
 
 #include "kis_convolution_worker.h"
 #include "kis_convolution_worker_spatial.h"
+#include "kis_convolution_worker_iir.h"
+#include "kis_gaussian_kernel.h"
 
 #include "config_convolution.h"
 
@@ -45,6 +47,16 @@
 #include "kis_convolution_worker_fft.h"
 #endif
 
+namespace {
+QAtomicInt s_spatialThreadsLimit(0);
+
+/**
+ * The recursive filter is not precise enough for small sigmas, and
+ * for the small kernels the explicit convolution is fast anyway.
+ */
+const int iirThresholdSize = 64;
+const qreal iirMinSigma = 2.0;
+}
 
 bool KisConvolutionPainter::useFFTImplementation(const KisConvolutionKernelSP kernel) const
 {
@@ -97,6 +109,17 @@ bool KisConvolutionPainter::supportsFFTW()
 }
 
 
+void KisConvolutionPainter::setSpatialThreadsLimit(int value)
+{
+    s_spatialThreadsLimit.storeRelease(value);
+}
+
+int KisConvolutionPainter::spatialThreadsLimit()
+{
+    return s_spatialThreadsLimit.loadAcquire();
+}
+
+
 KisConvolutionPainter::KisConvolutionPainter()
     : KisPainter(),
       m_enginePreference(NONE)
@@ -140,20 +163,7 @@ void KisConvolutionPainter::applyMatrix(const KisConvolutionKernelSP kernel, con
     // Determine whether we convolve border pixels, or not.
     switch (borderOp) {
     case BORDER_REPEAT: {
-        /**
-         * We don't use defaultBounds->topLevelWrapRect(), because
-         * the main purpose of this wrapping is "getting expected
-         * results when applying to the the layer". If a mask is bigger
-         * than the image, then it should be wrapped around the mask
-         * instead.
-         */
-        const QRect boundsRect = src->defaultBounds()->bounds();
-        const QRect requestedRect = QRect(srcPos, areaSize);
-        QRect dataRect = requestedRect | boundsRect;
-
-        KIS_SAFE_ASSERT_RECOVER(boundsRect != KisDefaultBounds().bounds()) {
-            dataRect = requestedRect | src->exactBounds();
-        }
+        const QRect dataRect = borderDataRect(src, srcPos, areaSize);
 
         /**
          * FIXME: Implementation can return empty destination device
@@ -183,6 +193,76 @@ void KisConvolutionPainter::applyMatrix(const KisConvolutionKernelSP kernel, con
     }
 }
 
+QRect KisConvolutionPainter::borderDataRect(const KisPaintDeviceSP src, QPoint srcPos, QSize areaSize) const
+{
+    /**
+     * We don't use defaultBounds->topLevelWrapRect(), because
+     * the main purpose of this wrapping is "getting expected
+     * results when applying to the the layer". If a mask is bigger
+     * than the image, then it should be wrapped around the mask
+     * instead.
+     */
+    const QRect boundsRect = src->defaultBounds()->bounds();
+    const QRect requestedRect = QRect(srcPos, areaSize);
+    QRect dataRect = requestedRect | boundsRect;
+
+    KIS_SAFE_ASSERT_RECOVER(boundsRect != KisDefaultBounds().bounds()) {
+        dataRect = requestedRect | src->exactBounds();
+    }
+
+    return dataRect;
+}
+
+bool KisConvolutionPainter::useIIRForGaussian(qreal xRadius, qreal yRadius)
+{
+    auto isSupported = [] (qreal radius) {
+        return radius <= 0.0 || KisGaussianKernel::sigmaFromRadius(radius) >= iirMinSigma;
+    };
+
+    return isSupported(xRadius) && isSupported(yRadius) &&
+        qMax(KisGaussianKernel::kernelSizeFromRadius(qMax(xRadius, 0.0)),
+             KisGaussianKernel::kernelSizeFromRadius(qMax(yRadius, 0.0))) > iirThresholdSize;
+}
+
+void KisConvolutionPainter::applyGaussian(const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize,
+                                          qreal xRadius, qreal yRadius,
+                                          KisConvolutionBorderOp borderOp)
+{
+    const bool useIIR =
+        m_enginePreference == IIR ||
+        (m_enginePreference == NONE && useIIRForGaussian(xRadius, yRadius));
+
+    if (!useIIR) {
+        KisConvolutionKernelSP kernel = KisGaussianKernel::createUniform2DKernel(qMax(xRadius, 0.0), qMax(yRadius, 0.0));
+        applyMatrix(kernel, src, srcPos, dstPos, areaSize, borderOp);
+        return;
+    }
+
+    const qreal xSigma = xRadius > 0.0 ? KisGaussianKernel::sigmaFromRadius(xRadius) : 0.0;
+    const qreal ySigma = yRadius > 0.0 ? KisGaussianKernel::sigmaFromRadius(yRadius) : 0.0;
+
+    if (src->defaultBounds()->wrapAroundMode()) {
+        borderOp = BORDER_IGNORE;
+    }
+
+    switch (borderOp) {
+    case BORDER_REPEAT: {
+        const QRect dataRect = borderDataRect(src, srcPos, areaSize);
+
+        if(dataRect.isValid()) {
+            KisConvolutionWorkerIIR<RepeatIteratorFactory> worker(this, progressUpdater(), xSigma, ySigma);
+            worker.execute(KisConvolutionKernelSP(), src, srcPos, dstPos, areaSize, dataRect);
+        }
+        break;
+    }
+    case BORDER_IGNORE:
+    default: {
+        KisConvolutionWorkerIIR<StandardIteratorFactory> worker(this, progressUpdater(), xSigma, ySigma);
+        worker.execute(KisConvolutionKernelSP(), src, srcPos, dstPos, areaSize, QRect());
+    }
+    }
+}
+
 bool KisConvolutionPainter::needsTransaction(const KisConvolutionKernelSP kernel) const
 {
     return !useFFTImplementation(kernel);
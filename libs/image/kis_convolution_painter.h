@@ -38,7 +38,8 @@ public:
     enum EnginePreference {
         NONE,
         SPATIAL,
-        FFTW
+        FFTW,
+        IIR ///< recursive Gaussian filter, supported by applyGaussian() only
     };
 
 
@@ -71,6 +72,28 @@ public:
     void applyMatrix(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize,
                      KisConvolutionBorderOp borderOp = BORDER_REPEAT);
 
+    /**
+     * Blur all channels of \p src with a Gaussian with radii \p xRadius and
+     * \p yRadius (see KisGaussianKernel::sigmaFromRadius()).
+     *
+     * With IIR preference the blur is done by a recursive filter, whose
+     * cost per pixel doesn't depend on the radius. It is also chosen
+     * automatically for big radii when no preference is set. Otherwise, an
+     * explicit kernel is built and passed to applyMatrix().
+     *
+     * The painter reads the same extra area around \p areaSize as
+     * applyMatrix() does with the Gaussian kernel of this size.
+     */
+    void applyGaussian(const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize,
+                       qreal xRadius, qreal yRadius,
+                       KisConvolutionBorderOp borderOp = BORDER_REPEAT);
+
+    /**
+     * \return true if applyGaussian() with no engine preference will use
+     * the recursive filter for the radii
+     */
+    static bool useIIRForGaussian(qreal xRadius, qreal yRadius);
+
     /**
      * The caller should ask if the painter needs an explicit transaction iff
      * the source and destination devices coincide. Otherwise, the transaction is
@@ -80,6 +103,15 @@ public:
 
     static bool supportsFFTW();
 
+    /**
+     * The spatial engine splits big areas into bands and convolves them
+     * concurrently. The method limits the number of the threads used for
+     * that. Zero value (default) means that QThread::idealThreadCount()
+     * threads are used. Used mostly for benchmarking.
+     */
+    static void setSpatialThreadsLimit(int value);
+    static int spatialThreadsLimit();
+
 protected:
     friend class KisConvolutionPainterTest;
 
@@ -93,6 +125,8 @@ private:
 
      bool useFFTImplementation(const KisConvolutionKernelSP kernel) const;
 
+     QRect borderDataRect(const KisPaintDeviceSP src, QPoint srcPos, QSize areaSize) const;
+
 private:
     EnginePreference m_enginePreference;
 };
@@ -14,6 +14,7 @@
 
 #include "kis_convolution_worker.h"
 #include "kis_math_toolbox.h"
+#include "KisFFTWPlanCache.h"
 
 #include <QMutex>
 #include <QVector>
@@ -81,6 +82,16 @@ public:
         m_fftLength = m_fftHeight * (m_fftWidth / 2 + 1);
         m_extraMem = (m_fftWidth % 2) ? 1 : 2;
 
+        /**
+         * The plans are shared between all the workers and are only
+         * executed here on our own buffers, so no locking is needed.
+         * Both kernel and channel buffers are allocated with fftw_malloc(),
+         * so they have the alignment the plans expect.
+         */
+        KisFFTWPlanCache::PlansSP plans =
+            KisFFTWPlanCache::instance()->plans(m_fftWidth, m_fftHeight);
+        KIS_SAFE_ASSERT_RECOVER_RETURN(plans);
+
         // create and fill kernel
         m_kernelFFT = (fftw_complex *)fftw_malloc(sizeof(fftw_complex) * m_fftLength);
         memset(m_kernelFFT, 0, sizeof(fftw_complex) * m_fftLength);
@@ -114,37 +125,23 @@ public:
         // calculate number off fft operations required for progress reporting
         const float progressPerFFT = (100 - 30) / (double)(convChannelList.count() * 2 + 1);
 
-        // perform FFT
-        fftw_plan fftwPlanForward, fftwPlanBackward;
-
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftwPlanForward = fftw_plan_dft_r2c_2d(m_fftHeight, m_fftWidth, (double*)m_kernelFFT, m_kernelFFT, FFTW_ESTIMATE);
-        fftwPlanBackward = fftw_plan_dft_c2r_2d(m_fftHeight, m_fftWidth, m_kernelFFT, (double*)m_kernelFFT, FFTW_ESTIMATE);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
-
-        fftw_execute(fftwPlanForward);
+        fftw_execute_dft_r2c(plans->forward, (double*)m_kernelFFT, m_kernelFFT);
         addToProgress(progressPerFFT);
         if (isInterrupted()) return;
 
         for (auto k = m_channelFFT.begin(); k != m_channelFFT.end(); ++k)
         {
-            fftw_execute_dft_r2c(fftwPlanForward, (double*)(*k), *k);
+            fftw_execute_dft_r2c(plans->forward, (double*)(*k), *k);
             addToProgress(progressPerFFT);
             if (isInterrupted()) return;
 
             fftMultiply(*k, m_kernelFFT);
 
-            fftw_execute_dft_c2r(fftwPlanBackward, *k, (double*)*k);
+            fftw_execute_dft_c2r(plans->backward, *k, (double*)*k);
             addToProgress(progressPerFFT);
             if (isInterrupted()) return;
         }
 
-        KisConvolutionWorkerFFTLock::fftwMutex.lock();
-        fftw_destroy_plan(fftwPlanForward);
-        fftw_destroy_plan(fftwPlanBackward);
-        KisConvolutionWorkerFFTLock::fftwMutex.unlock();
-
-
         writeResultToDevice(QRect(dstPos.x(), dstPos.y(), areaSize.width(), areaSize.height()),
                             cacheRowStride, halfKernelWidth, halfKernelHeight,
                             info, dataRect);
@@ -0,0 +1,405 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_CONVOLUTION_WORKER_IIR_H
+#define KIS_CONVOLUTION_WORKER_IIR_H
+
+#include <limits>
+
+#include <KoChannelInfo.h>
+
+#include "kis_convolution_worker.h"
+#include "kis_math_toolbox.h"
+#include "kis_selection.h"
+
+#include <QVector>
+
+
+/**
+ * Coefficients of the recursive Gaussian filter by Young and van Vliet
+ * ("Recursive implementation of the Gaussian filter", 1995). The filter
+ * is applied as a causal and an anti-causal third-order pass, so its cost
+ * doesn't depend on sigma.
+ *
+ * The approximation is good enough for sigma >= 2.0, for smaller values
+ * an explicit kernel should be used.
+ */
+struct KisRecursiveGaussianCoeffs
+{
+    KisRecursiveGaussianCoeffs(qreal sigma)
+    {
+        const qreal q =
+            sigma >= 2.5 ?
+            0.98711 * sigma - 0.96330 :
+            3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+
+        const qreal q2 = q * q;
+        const qreal q3 = q2 * q;
+
+        const qreal b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+
+        b1 = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+        b2 = -(1.4281 * q2 + 1.26661 * q3) / b0;
+        b3 = (0.422205 * q3) / b0;
+        B = 1.0 - (b1 + b2 + b3);
+    }
+
+    float B {0.0};
+    float b1 {0.0};
+    float b2 {0.0};
+    float b3 {0.0};
+};
+
+
+template<class _IteratorFactory_>
+class KisConvolutionWorkerIIR : public KisConvolutionWorker<_IteratorFactory_>
+{
+public:
+    /**
+     * The worker applies a Gaussian with standard deviations \p xSigma
+     * and \p ySigma. A zero sigma disables the blur in that direction.
+     */
+    KisConvolutionWorkerIIR(KisPainter *painter, KoUpdater *progress, qreal xSigma, qreal ySigma)
+        : KisConvolutionWorker<_IteratorFactory_>(painter, progress),
+          m_xSigma(xSigma),
+          m_ySigma(ySigma)
+    {
+    }
+
+    ~KisConvolutionWorkerIIR()
+    {
+    }
+
+    /**
+     * The filter is fully defined by the sigmas passed to the
+     * constructor, so \p kernel is not used.
+     */
+    void execute(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, const QRect& dataRect) override
+    {
+        Q_UNUSED(kernel);
+
+        // Make the area we cover as small as possible
+        if (this->m_painter->selection())
+        {
+            QRect r = this->m_painter->selection()->selectedRect().intersected(QRect(srcPos, areaSize));
+            dstPos += r.topLeft() - srcPos;
+            srcPos = r.topLeft();
+            areaSize = r.size();
+        }
+
+        if (areaSize.width() == 0 || areaSize.height() == 0)
+            return;
+
+        addToProgress(0);
+        if (isInterrupted()) return;
+
+        const int halfWidth = m_xSigma > 0.0 ? 3 * std::ceil(m_xSigma) : 0;
+        const int halfHeight = m_ySigma > 0.0 ? 3 * std::ceil(m_ySigma) : 0;
+
+        m_cacheWidth = areaSize.width() + 2 * halfWidth;
+        m_cacheHeight = areaSize.height() + 2 * halfHeight;
+
+        QList<KoChannelInfo*> convChannelList = this->convolvableChannelList(src);
+        CacheInfo info(convChannelList);
+
+        m_channelCache.resize(convChannelList.count());
+        for (auto it = m_channelCache.begin(); it != m_channelCache.end(); ++it) {
+            it->resize(m_cacheWidth * m_cacheHeight);
+        }
+
+        fillCacheFromDevice(src,
+                            QRect(srcPos.x() - halfWidth,
+                                  srcPos.y() - halfHeight,
+                                  m_cacheWidth,
+                                  m_cacheHeight),
+                            info, dataRect);
+
+        addToProgress(10);
+        if (isInterrupted()) return;
+
+        const float progressPerPass = (100 - 30) / (double)(convChannelList.count() * 2);
+
+        for (auto it = m_channelCache.begin(); it != m_channelCache.end(); ++it) {
+            if (m_xSigma > 0.0) {
+                applyHorizontal(it->data(), KisRecursiveGaussianCoeffs(m_xSigma));
+            }
+            addToProgress(progressPerPass);
+            if (isInterrupted()) return;
+
+            if (m_ySigma > 0.0) {
+                applyVertical(it->data(), KisRecursiveGaussianCoeffs(m_ySigma));
+            }
+            addToProgress(progressPerPass);
+            if (isInterrupted()) return;
+        }
+
+        writeResultToDevice(QRect(dstPos, areaSize), halfWidth, halfHeight, info, dataRect);
+
+        addToProgress(20);
+        cleanUp();
+    }
+
+private:
+    struct CacheInfo {
+        CacheInfo(const QList<KoChannelInfo*> &_convChannelList)
+            : convChannelList(_convChannelList)
+        {
+            KisMathToolbox mathToolbox;
+
+            for (int i = 0; i < convChannelList.count(); ++i) {
+                minClamp.append(mathToolbox.minChannelValue(convChannelList[i]));
+                maxClamp.append(mathToolbox.maxChannelValue(convChannelList[i]));
+
+                if (convChannelList[i]->channelType() == KoChannelInfo::ALPHA) {
+                    alphaCachePos = i;
+                    alphaRealPos = convChannelList[i]->pos();
+                }
+            }
+
+            toDoubleFuncPtr.resize(convChannelList.count());
+            fromDoubleFuncPtr.resize(convChannelList.count());
+            fromDoubleCheckNullFuncPtr.resize(convChannelList.count());
+
+            bool result = mathToolbox.getToDoubleChannelPtr(convChannelList, toDoubleFuncPtr);
+            result &= mathToolbox.getFromDoubleChannelPtr(convChannelList, fromDoubleFuncPtr);
+            result &= mathToolbox.getFromDoubleCheckNullChannelPtr(convChannelList, fromDoubleCheckNullFuncPtr);
+
+            KIS_ASSERT(result);
+        }
+
+        inline int numChannels() const {
+            return convChannelList.size();
+        }
+
+        QVector<qreal> minClamp;
+        QVector<qreal> maxClamp;
+
+        QList<KoChannelInfo*> convChannelList;
+
+        QVector<PtrToDouble> toDoubleFuncPtr;
+        QVector<PtrFromDouble> fromDoubleFuncPtr;
+        QVector<PtrFromDoubleCheckNull> fromDoubleCheckNullFuncPtr;
+
+        int alphaCachePos {-1};
+        int alphaRealPos {-1};
+    };
+
+    void fillCacheFromDevice(KisPaintDeviceSP src,
+                             const QRect &rect,
+                             const CacheInfo &info,
+                             const QRect &dataRect)
+    {
+        typename _IteratorFactory_::HLineConstIterator hitSrc =
+            _IteratorFactory_::createHLineConstIterator(src,
+                                                        rect.x(), rect.y(), rect.width(),
+                                                        dataRect);
+
+        const int channelCount = info.numChannels();
+        int cachePos = 0;
+
+        for (int y = 0; y < rect.height(); ++y) {
+            for (int x = 0; x < rect.width(); ++x, ++cachePos) {
+                const quint8 *data = hitSrc->oldRawData();
+
+                // the color channels are blurred premultiplied by alpha
+                const double alphaValue = info.alphaRealPos >= 0 ?
+                    info.toDoubleFuncPtr[info.alphaCachePos](data, info.alphaRealPos) : 1.0;
+
+                for (int k = 0; k < channelCount; ++k) {
+                    if (k != info.alphaCachePos) {
+                        const quint32 channelPos = info.convChannelList[k]->pos();
+                        m_channelCache[k][cachePos] = info.toDoubleFuncPtr[k](data, channelPos) * alphaValue;
+                    } else {
+                        m_channelCache[k][cachePos] = alphaValue;
+                    }
+                }
+
+                hitSrc->nextPixel();
+            }
+
+            hitSrc->nextRow();
+        }
+    }
+
+    void applyHorizontal(float *data, const KisRecursiveGaussianCoeffs &c)
+    {
+        for (int y = 0; y < m_cacheHeight; ++y) {
+            float *row = data + y * m_cacheWidth;
+
+            // the border values are repeated outside the row
+            float p1 = row[0];
+            float p2 = p1;
+            float p3 = p1;
+
+            for (int x = 0; x < m_cacheWidth; ++x) {
+                const float value = c.B * row[x] + c.b1 * p1 + c.b2 * p2 + c.b3 * p3;
+                row[x] = value;
+                p3 = p2;
+                p2 = p1;
+                p1 = value;
+            }
+
+            p1 = row[m_cacheWidth - 1];
+            p2 = p1;
+            p3 = p1;
+
+            for (int x = m_cacheWidth - 1; x >= 0; --x) {
+                const float value = c.B * row[x] + c.b1 * p1 + c.b2 * p2 + c.b3 * p3;
+                row[x] = value;
+                p3 = p2;
+                p2 = p1;
+                p1 = value;
+            }
+        }
+    }
+
+    /**
+     * The vertical pass processes the whole rows at once, so the memory
+     * is accessed sequentially and the inner loop can be vectorized by
+     * the compiler.
+     */
+    void applyVertical(float *data, const KisRecursiveGaussianCoeffs &c)
+    {
+        const int width = m_cacheWidth;
+        const int height = m_cacheHeight;
+
+        QVector<float> border(width);
+
+        auto filterRow = [&c, width] (float *row, const float *p1, const float *p2, const float *p3) {
+            for (int x = 0; x < width; ++x) {
+                row[x] = c.B * row[x] + c.b1 * p1[x] + c.b2 * p2[x] + c.b3 * p3[x];
+            }
+        };
+
+        // causal pass, the first row is repeated above the area
+        std::copy(data, data + width, border.begin());
+
+        for (int y = 0; y < height; ++y) {
+            const float *p1 = y >= 1 ? data + (y - 1) * width : border.constData();
+            const float *p2 = y >= 2 ? data + (y - 2) * width : border.constData();
+            const float *p3 = y >= 3 ? data + (y - 3) * width : border.constData();
+
+            filterRow(data + y * width, p1, p2, p3);
+        }
+
+        // anti-causal pass, the last row is repeated below the area
+        std::copy(data + (height - 1) * width, data + height * width, border.begin());
+
+        for (int y = height - 1; y >= 0; --y) {
+            const float *p1 = y + 1 < height ? data + (y + 1) * width : border.constData();
+            const float *p2 = y + 2 < height ? data + (y + 2) * width : border.constData();
+            const float *p3 = y + 3 < height ? data + (y + 3) * width : border.constData();
+
+            filterRow(data + y * width, p1, p2, p3);
+        }
+    }
+
+    inline void limitValue(qreal *value, qreal lowBound, qreal highBound) {
+        if (*value > highBound) {
+            *value = highBound;
+        } else if (!(*value >= lowBound)) {  // value < lowBound or value == NaN
+            // IEEE compliant comparisons with NaN are always false
+            *value = lowBound;
+        }
+    }
+
+    void writeResultToDevice(const QRect &rect,
+                             const int halfWidth,
+                             const int halfHeight,
+                             const CacheInfo &info,
+                             const QRect &dataRect)
+    {
+        typename _IteratorFactory_::HLineIterator hitDst =
+            _IteratorFactory_::createHLineIterator(this->m_painter->device(),
+                                                   rect.x(), rect.y(), rect.width(),
+                                                   dataRect);
+
+        const int channelCount = info.numChannels();
+
+        for (int y = 0; y < rect.height(); ++y) {
+            int cachePos = (y + halfHeight) * m_cacheWidth + halfWidth;
+
+            for (int x = 0; x < rect.width(); ++x, ++cachePos) {
+                quint8 *dstPtr = hitDst->rawData();
+
+                if (info.alphaCachePos >= 0) {
+                    const int alphaPos = info.alphaCachePos;
+
+                    bool alphaIsNullInDstSpace = false;
+                    qreal alphaValue = m_channelCache[alphaPos][cachePos];
+                    limitValue(&alphaValue, info.minClamp[alphaPos], info.maxClamp[alphaPos]);
+                    info.fromDoubleCheckNullFuncPtr[alphaPos](dstPtr, info.alphaRealPos, alphaValue, &alphaIsNullInDstSpace);
+
+                    if (!alphaIsNullInDstSpace &&
+                        alphaValue > std::numeric_limits<qreal>::epsilon()) {
+
+                        const qreal alphaValueInv = 1.0 / alphaValue;
+
+                        for (int k = 0; k < channelCount; ++k) {
+                            if (k == alphaPos) continue;
+
+                            qreal value = m_channelCache[k][cachePos] * alphaValueInv;
+                            limitValue(&value, info.minClamp[k], info.maxClamp[k]);
+                            info.fromDoubleFuncPtr[k](dstPtr, info.convChannelList[k]->pos(), value);
+                        }
+                    } else {
+                        for (int k = 0; k < channelCount; ++k) {
+                            if (k == alphaPos) continue;
+
+                            info.fromDoubleFuncPtr[k](dstPtr, info.convChannelList[k]->pos(), 0.0);
+                        }
+                    }
+                } else {
+                    for (int k = 0; k < channelCount; ++k) {
+                        qreal value = m_channelCache[k][cachePos];
+                        limitValue(&value, info.minClamp[k], info.maxClamp[k]);
+                        info.fromDoubleFuncPtr[k](dstPtr, info.convChannelList[k]->pos(), value);
+                    }
+                }
+
+                hitDst->nextPixel();
+            }
+
+            hitDst->nextRow();
+        }
+    }
+
+    void addToProgress(float amount)
+    {
+        m_currentProgress += amount;
+
+        if (this->m_progress) {
+            this->m_progress->setProgress((int)m_currentProgress);
+        }
+    }
+
+    bool isInterrupted()
+    {
+        if (this->m_progress && this->m_progress->interrupted()) {
+            cleanUp();
+            return true;
+        }
+
+        return false;
+    }
+
+    void cleanUp()
+    {
+        m_channelCache.clear();
+    }
+
+private:
+    qreal m_xSigma {0.0};
+    qreal m_ySigma {0.0};
+
+    int m_cacheWidth {0};
+    int m_cacheHeight {0};
+    float m_currentProgress {0.0};
+
+    QVector<QVector<float>> m_channelCache;
+};
+
+#endif
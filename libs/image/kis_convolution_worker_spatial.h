@@ -8,8 +8,23 @@
 #ifndef KIS_CONVOLUTION_WORKER_SPATIAL_H
 #define KIS_CONVOLUTION_WORKER_SPATIAL_H
 
+#include <algorithm>
+#include <functional>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtMath>
+
 #include "kis_convolution_worker.h"
+#include "kis_convolution_painter.h"
 #include "kis_math_toolbox.h"
+#include "kis_selection.h"
+#include "KisWorkStealingExecutor.h"
 
 template <class _IteratorFactory_>
 class KisConvolutionWorkerSpatial : public KisConvolutionWorker<_IteratorFactory_>
@@ -47,6 +62,187 @@ public:
     }
 
     void execute(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, const QRect& dataRect) override {
+        // Make the area we cover as small as possible
+        if (this->m_painter->selection()) {
+            QRect r = this->m_painter->selection()->selectedRect().intersected(QRect(srcPos, areaSize));
+            dstPos += r.topLeft() - srcPos;
+            srcPos = r.topLeft();
+            areaSize = r.size();
+        }
+
+        if (areaSize.width() == 0 || areaSize.height() == 0)
+            return;
+
+        const int numThreads = numParallelThreads(src, areaSize);
+
+        if (numThreads > 1) {
+            executeParallel(kernel, src, srcPos, dstPos, areaSize, dataRect, numThreads);
+        } else {
+            executeImpl(kernel, src, srcPos, dstPos, areaSize, dataRect);
+        }
+    }
+
+private:
+    /**
+     * The big areas are split into horizontal bands, which are processed
+     * concurrently. Every band is processed by its own worker with its own
+     * cache of pixels, the bands overlap only in the source area.
+     *
+     * When the source and the destination devices coincide, the bands
+     * would read the pixels already written by the neighbours, so the
+     * parallel mode is used only when the source is read from a
+     * transaction.
+     */
+    int numParallelThreads(const KisPaintDeviceSP src, const QSize &areaSize) const {
+        KisPaintDeviceSP dst = this->m_painter->device();
+
+        const int minParallelArea = 512 * 512;
+        const int minBandHeight = dst->dataManager()->tileHeight();
+
+        if (areaSize.width() * areaSize.height() < minParallelArea ||
+            areaSize.height() < 2 * minBandHeight) {
+
+            return 1;
+        }
+
+        if (src->dataManager() == dst->dataManager() &&
+            !src->dataManager()->hasCurrentMemento()) {
+
+            return 1;
+        }
+
+        int numThreads = KisConvolutionPainter::spatialThreadsLimit();
+        if (numThreads <= 0) {
+            numThreads = QThread::idealThreadCount();
+        }
+
+        return qBound(1, numThreads, areaSize.height() / minBandHeight);
+    }
+
+    /**
+     * The bands are aligned to the rows of tiles of the destination
+     * device, so two threads never write into the same tile.
+     */
+    static QVector<QRect> splitIntoBands(const QRect &rc, int numThreads, int tileSize) {
+        // a few bands per thread to balance the load
+        const int bandHeight = qMax(tileSize, rc.height() / (2 * numThreads) / tileSize * tileSize);
+
+        QVector<QRect> bands;
+
+        int top = rc.top();
+        while (top <= rc.bottom()) {
+            int nextTop = qFloor(qreal(top + bandHeight) / tileSize) * tileSize;
+            if (nextTop <= top) {
+                nextTop = top + bandHeight;
+            }
+            nextTop = qMin(nextTop, rc.bottom() + 1);
+
+            bands.append(QRect(rc.left(), top, rc.width(), nextTop - top));
+            top = nextTop;
+        }
+
+        return bands;
+    }
+
+    struct BandsState {
+        QVector<QRect> bands;
+        int nextBand = 0;
+        int numActiveBands = 0;
+        int numProcessedBands = 0;
+        bool isInterrupted = false;
+
+        QMutex lock;
+        QWaitCondition bandDone;
+    };
+
+    struct BandsRunnable : public QRunnable {
+        BandsRunnable(std::function<void()> func) : m_func(func) {}
+        void run() override { m_func(); }
+
+    private:
+        std::function<void()> m_func;
+    };
+
+    /**
+     * The calling thread processes the bands itself, and the helper
+     * runnables started in the pool just join it when they get a free
+     * thread. So the caller never waits for the runnables that haven't
+     * started yet, which makes it safe to be called from inside an
+     * update job: the helpers go to the executor of the updater context
+     * instead of nesting a thread pool of its own into it. The helpers
+     * that start after all the bands are taken exit without touching
+     * anything but the shared state.
+     */
+    void executeParallel(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, const QRect& dataRect, int numThreads) {
+        KisPainter *painter = this->m_painter;
+        const int tileSize = painter->device()->dataManager()->tileHeight();
+
+        QSharedPointer<BandsState> state(new BandsState());
+        state->bands = splitIntoBands(QRect(dstPos, areaSize), numThreads, tileSize);
+        const QPoint srcOffset = srcPos - dstPos;
+
+        KoUpdater *progress = this->m_progress;
+        if (progress) {
+            progress->setRange(0, state->bands.size());
+            progress->setValue(0);
+        }
+
+        auto processBands = [state, painter, progress, kernel, src, srcOffset, dataRect] () {
+            while (1) {
+                int index = 0;
+
+                {
+                    QMutexLocker l(&state->lock);
+                    if (state->isInterrupted ||
+                        state->nextBand >= state->bands.size()) {
+
+                        break;
+                    }
+
+                    index = state->nextBand++;
+                    state->numActiveBands++;
+                }
+
+                const QRect &band = state->bands[index];
+
+                KisConvolutionWorkerSpatial<_IteratorFactory_> worker(painter, nullptr);
+                worker.executeImpl(kernel, src, band.topLeft() + srcOffset, band.topLeft(), band.size(), dataRect);
+
+                QMutexLocker l(&state->lock);
+                state->numActiveBands--;
+                state->numProcessedBands++;
+
+                // KoUpdater is not thread-safe
+                if (progress) {
+                    progress->setValue(state->numProcessedBands);
+                    state->isInterrupted |= progress->interrupted();
+                }
+
+                state->bandDone.wakeAll();
+            }
+        };
+
+        KisWorkStealingExecutor *executor = KisWorkStealingExecutor::currentExecutor();
+
+        for (int i = 1; i < numThreads; i++) {
+            BandsRunnable *runnable = new BandsRunnable(processBands);
+
+            if (executor) {
+                executor->start(runnable);
+            } else {
+                QThreadPool::globalInstance()->start(runnable);
+            }
+        }
+
+        processBands();
+
+        QMutexLocker l(&state->lock);
+        while (state->numActiveBands > 0) {
+            state->bandDone.wait(&state->lock);
+        }
+    }
+
+    void executeImpl(const KisConvolutionKernelSP kernel, const KisPaintDeviceSP src, QPoint srcPos, QPoint dstPos, QSize areaSize, const QRect& dataRect) {
         // store some kernel characteristics
         m_kw = kernel->width();
         m_kh = kernel->height();
@@ -67,17 +263,17 @@ public:
             }
         }
 
-        // Make the area we cover as small as possible
-        if (this->m_painter->selection()) {
-            QRect r = this->m_painter->selection()->selectedRect().intersected(QRect(srcPos, areaSize));
-            dstPos += r.topLeft() - srcPos;
-            srcPos = r.topLeft();
-            areaSize = r.size();
+        // the cache is traversed in the reversed order of the kernel
+        m_nonZeroWeights.clear();
+        m_nonZeroCacheIndexes.clear();
+        for (quint32 pIndex = 0; pIndex < m_cacheSize; ++pIndex) {
+            const qreal weight = m_kernelData[m_cacheSize - pIndex - 1];
+            if (weight != 0.0) {
+                m_nonZeroWeights.append(weight);
+                m_nonZeroCacheIndexes.append(pIndex);
+            }
         }
 
-        if (areaSize.width() == 0 || areaSize.height() == 0)
-            return;
-
         // Don't convolve with an even sized kernel
         Q_ASSERT((m_kw & 0x01) == 1 || (m_kh & 0x01) == 1 || kernel->factor() != 0);
 
@@ -120,6 +316,8 @@ public:
         if (!mathToolbox.getFromDoubleChannelPtr(m_convChannelList, m_fromDoubleFuncPtr))
             return;
 
+        m_totals.resize(m_convolveChannelsNo);
+
         m_kernelFactor = kernel->factor() ? 1.0 / kernel->factor() : 1;
         m_maxClamp = new qreal[m_convChannelList.count()];
         m_minClamp = new qreal[m_convChannelList.count()];
@@ -247,14 +445,33 @@ public:
         }
     }
 
-    template <bool additionalMultiplierActive>
-    inline qreal convolveOneChannelFromCache(quint8* dstPtr, quint32 channel, qreal additionalMultiplier = 0.0) {
-        qreal interimConvoResult = 0;
+    /**
+     * Accumulates all the channels in one pass over the cache. The
+     * channels of a pixel are stored contiguously, so the inner loop can
+     * be vectorized by the compiler. The zero weights of the kernel are
+     * skipped, which speeds up sparse kernels, like edge detection.
+     */
+    inline void accumulateCache() {
+        qreal *totals = m_totals.data();
+        std::fill(totals, totals + m_convolveChannelsNo, 0.0);
 
-        for (quint32 pIndex = 0; pIndex < m_cacheSize; ++pIndex) {
-            qreal cacheValue = m_pixelPtrCache[pIndex][channel];
-            interimConvoResult += m_kernelData[m_cacheSize - pIndex - 1] * cacheValue;
+        const int numWeights = m_nonZeroWeights.size();
+        const qreal *weights = m_nonZeroWeights.constData();
+        const quint32 *indexes = m_nonZeroCacheIndexes.constData();
+
+        for (int i = 0; i < numWeights; ++i) {
+            const qreal weight = weights[i];
+            const qreal *cacheValues = m_pixelPtrCache[indexes[i]];
+
+            for (quint32 k = 0; k < m_convolveChannelsNo; ++k) {
+                totals[k] += weight * cacheValues[k];
+            }
         }
+    }
+
+    template <bool additionalMultiplierActive>
+    inline qreal convolveOneChannelFromCache(quint8* dstPtr, quint32 channel, qreal additionalMultiplier = 0.0) {
+        const qreal interimConvoResult = m_totals[channel];
 
         qreal channelPixelValue;
         if (additionalMultiplierActive) {
@@ -272,6 +489,8 @@ public:
     }
 
     inline void convolveCache(quint8* dstPtr) {
+        accumulateCache();
+
         if (m_alphaCachePos >= 0) {
             qreal alphaValue = convolveOneChannelFromCache<false>(dstPtr, m_alphaCachePos);
 
@@ -368,6 +587,10 @@ private:
     QList<KoChannelInfo *> m_convChannelList;
     QVector<PtrToDouble> m_toDoubleFuncPtr;
     QVector<PtrFromDouble> m_fromDoubleFuncPtr;
+
+    QVector<qreal> m_nonZeroWeights;
+    QVector<quint32> m_nonZeroCacheIndexes;
+    QVector<qreal> m_totals;
 };
 
 
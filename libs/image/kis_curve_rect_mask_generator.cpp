@@ -114,7 +114,7 @@ void KisCurveRectangleMaskGenerator::setSoftness(qreal softness)
 
 bool KisCurveRectangleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return !shouldSupersample();
 }
 
 KisBrushMaskApplicatorBase* KisCurveRectangleMaskGenerator::applicator()
@@ -41,8 +41,11 @@ public:
      *
      * Note that if pixelSize > size of the defPixel array, we will happily read beyond the
      * defPixel array.
+     *
+     * The data is split into square tiles of \p tileSize pixels.
      */
-KisDataManager(quint32 pixelSize, const quint8 *defPixel) : ACTUAL_DATAMGR(pixelSize, defPixel) {}
+    KisDataManager(quint32 pixelSize, const quint8 *defPixel, qint32 tileSize = KisTileData::WIDTH)
+        : ACTUAL_DATAMGR(pixelSize, defPixel, tileSize) {}
     KisDataManager(const KisDataManager& dm) : ACTUAL_DATAMGR(dm) { }
 
     ~KisDataManager() override {
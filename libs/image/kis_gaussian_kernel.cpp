@@ -110,7 +110,17 @@ void KisGaussianKernel::applyGaussian(KisPaintDeviceSP device,
     QPoint srcTopLeft = rect.topLeft();
 
 
-    if (KisConvolutionPainter::supportsFFTW()) {
+    if (KisConvolutionPainter::useIIRForGaussian(xRadius, yRadius)) {
+        /**
+         * The recursive filter caches the whole area before writing
+         * the result, so it doesn't need a transaction
+         */
+        KisConvolutionPainter painter(device, KisConvolutionPainter::IIR);
+        painter.setChannelFlags(channelFlags);
+        painter.setProgress(progressUpdater);
+        painter.applyGaussian(device, srcTopLeft, srcTopLeft, rect.size(), xRadius, yRadius, borderOp);
+
+    } else if (KisConvolutionPainter::supportsFFTW()) {
         KisConvolutionPainter painter(device, KisConvolutionPainter::FFTW);
         painter.setChannelFlags(channelFlags);
         painter.setProgress(progressUpdater);
@@ -19,6 +19,7 @@
 #include "kis_processing_visitor.h"
 #include "kis_debug.h"
 #include "kis_image.h"
+#include "kis_image_config.h"
 #include "kis_paint_device.h"
 #include "kis_default_bounds.h"
 #include "kis_clone_layer.h"
@@ -191,6 +192,12 @@ void KisGroupLayer::resetCache(const KoColorSpace *colorSpace)
     if (!m_d->paintDevice) {
 
         KisPaintDeviceSP dev = new KisPaintDevice(this, colorSpace, new KisDefaultBounds(image()));
+
+        const int tileSize = KisImageConfig(true).projectionTileSize();
+        if (tileSize > dev->tileSize()) {
+            dev->setTileSize(tileSize);
+        }
+
         dev->setX(this->x());
         dev->setY(this->y());
         m_d->paintDevice = dev;
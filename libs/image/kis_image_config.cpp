@@ -22,6 +22,7 @@
 #include <QDir>
 
 #include "kis_global.h"
+#include "config-tile-compression.h"
 #include <cmath>
 #include <QTemporaryFile>
 
@@ -167,6 +168,101 @@ void KisImageConfig::setSwapWindowSize(int value)
     m_config.writeEntry("swapWindowSize", value);
 }
 
+int KisImageConfig::swapWindowsCount() const
+{
+    return m_config.readEntry("swapWindowsCount", 4);
+}
+
+void KisImageConfig::setSwapWindowsCount(int value)
+{
+    m_config.writeEntry("swapWindowsCount", value);
+}
+
+bool KisImageConfig::tileArenaUseHugePages(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("tileArenaUseHugePages", true) : true;
+}
+
+void KisImageConfig::setTileArenaUseHugePages(bool value)
+{
+    m_config.writeEntry("tileArenaUseHugePages", value);
+}
+
+bool KisImageConfig::tileArenaInterleaveNuma(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("tileArenaInterleaveNuma", false) : false;
+}
+
+void KisImageConfig::setTileArenaInterleaveNuma(bool value)
+{
+    m_config.writeEntry("tileArenaInterleaveNuma", value);
+}
+
+bool KisImageConfig::tileDeduplicationEnabled(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("tileDeduplicationEnabled", false) : false;
+}
+
+void KisImageConfig::setTileDeduplicationEnabled(bool value)
+{
+    m_config.writeEntry("tileDeduplicationEnabled", value);
+}
+
+QString KisImageConfig::swapCompression(bool requestDefault) const
+{
+#ifdef HAVE_LZ4
+    const QString defaultValue = "LZ4";
+#else
+    const QString defaultValue = "LZF";
+#endif
+
+    return !requestDefault ?
+        m_config.readEntry("swapCompression", defaultValue) : defaultValue;
+}
+
+void KisImageConfig::setSwapCompression(const QString &value)
+{
+    m_config.writeEntry("swapCompression", value);
+}
+
+QString KisImageConfig::tileCompression(bool requestDefault) const
+{
+    const QString defaultValue = "LZF";
+
+    return !requestDefault ?
+        m_config.readEntry("tileCompression", defaultValue) : defaultValue;
+}
+
+void KisImageConfig::setTileCompression(const QString &value)
+{
+    m_config.writeEntry("tileCompression", value);
+}
+
+int KisImageConfig::projectionTileSize(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("projectionTileSize", 64) : 64;
+}
+
+void KisImageConfig::setProjectionTileSize(int value)
+{
+    m_config.writeEntry("projectionTileSize", value);
+}
+
+int KisImageConfig::highBitDepthTileSize(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("highBitDepthTileSize", 64) : 64;
+}
+
+void KisImageConfig::setHighBitDepthTileSize(int value)
+{
+    m_config.writeEntry("highBitDepthTileSize", value);
+}
+
 int KisImageConfig::tilesHardLimit() const
 {
     qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
@@ -190,6 +286,14 @@ int KisImageConfig::poolLimit() const
     return totalRAM() * hp * pp;
 }
 
+int KisImageConfig::compressedSwapLimit() const
+{
+    qreal hp = qreal(memoryHardLimitPercent()) / 100.0;
+    qreal cp = qreal(memoryCompressedSwapPercent()) / 100.0;
+
+    return totalRAM() * hp * cp;
+}
+
 qreal KisImageConfig::memoryHardLimitPercent(bool requestDefault) const
 {
     return !requestDefault ?
@@ -223,6 +327,28 @@ void KisImageConfig::setMemoryPoolLimitPercent(qreal value)
     m_config.writeEntry("memoryPoolLimitPercent", value);
 }
 
+qreal KisImageConfig::memoryCompressedSwapPercent(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("memoryCompressedSwapPercent", 10.0) : 10.0;
+}
+
+void KisImageConfig::setMemoryCompressedSwapPercent(qreal value)
+{
+    m_config.writeEntry("memoryCompressedSwapPercent", value);
+}
+
+qreal KisImageConfig::compressedSwapMinRatio(bool requestDefault) const
+{
+    return !requestDefault ?
+        m_config.readEntry("compressedSwapMinRatio", 2.0) : 2.0;
+}
+
+void KisImageConfig::setCompressedSwapMinRatio(qreal value)
+{
+    m_config.writeEntry("compressedSwapMinRatio", value);
+}
+
 QString KisImageConfig::safelyGetWritableTempLocation(const QString &suffix, const QString &configKey, bool requestDefault) const
 {
 #ifdef Q_OS_MACOS
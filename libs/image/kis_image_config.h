@@ -46,16 +46,97 @@ public:
     int swapWindowSize() const;
     void setSwapWindowSize(int value);
 
+    /**
+     * The number of windows of the swap file mapped into memory
+     * simultaneously
+     */
+    int swapWindowsCount() const;
+    void setSwapWindowsCount(int value);
+
+    /**
+     * Whether the memory blocks of the tiles' pools should be backed
+     * by transparent huge pages (Linux only). Read once on the first
+     * allocation of a tile.
+     */
+    bool tileArenaUseHugePages(bool requestDefault = false) const;
+    void setTileArenaUseHugePages(bool value);
+
+    /**
+     * Whether the memory blocks of the tiles' pools should be
+     * interleaved over all the NUMA nodes of the machine instead of
+     * being placed on the node that touches them first (Linux only)
+     */
+    bool tileArenaInterleaveNuma(bool requestDefault = false) const;
+    void setTileArenaInterleaveNuma(bool value);
+
+    /**
+     * Whether the pooler thread should periodically look for tiles
+     * with identical content in different paint devices (and
+     * animation frames) and make them share a single copy-on-write
+     * tile data
+     */
+    bool tileDeduplicationEnabled(bool requestDefault = false) const;
+    void setTileDeduplicationEnabled(bool value);
+
+    /**
+     * The codec used for compressing the tiles in the swap file.
+     * Prefers the fastest decompressor available.
+     */
+    QString swapCompression(bool requestDefault = false) const;
+    void setSwapCompression(const QString &value);
+
+    /**
+     * The codec used for compressing the tiles of the layers when
+     * the document is saved. Anything but "LZF" makes the document
+     * unreadable by the older versions of Krita.
+     */
+    QString tileCompression(bool requestDefault = false) const;
+    void setTileCompression(const QString &value);
+
+    /**
+     * The size of the tiles of the projections of the group layers
+     * and of the image itself. The projections are usually as big as
+     * the image, so bigger tiles reduce the number of tiles, mementos
+     * and locks handled while they are updated. Can be 64, 128 or 256.
+     */
+    int projectionTileSize(bool requestDefault = false) const;
+    void setProjectionTileSize(int value);
+
+    /**
+     * The size of the tiles of the paint devices in color spaces
+     * with at least 8 bytes per pixel, e.g. 16-bit integer and 32-bit
+     * float RGBA. Read once on the creation of the first paint device.
+     * Krita versions that support 64x64 tiles only cannot load the
+     * layers saved with bigger tiles.
+     *
+     * \see projectionTileSize()
+     */
+    int highBitDepthTileSize(bool requestDefault = false) const;
+    void setHighBitDepthTileSize(int value);
+
     int tilesHardLimit() const; // MiB
     int tilesSoftLimit() const; // MiB
     int poolLimit() const; // MiB
+    int compressedSwapLimit() const; // MiB
 
     qreal memoryHardLimitPercent(bool requestDefault = false) const; // % of total RAM
     qreal memorySoftLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent() * (1 - 0.01 * memoryPoolLimitPercent())
     qreal memoryPoolLimitPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent()
+    qreal memoryCompressedSwapPercent(bool requestDefault = false) const; // % of memoryHardLimitPercent()
     void setMemoryHardLimitPercent(qreal value);
     void setMemorySoftLimitPercent(qreal value);
     void setMemoryPoolLimitPercent(qreal value);
+    void setMemoryCompressedSwapPercent(qreal value);
+
+    /**
+     * The swapped out tiles are kept compressed in memory until
+     * they occupy more than compressedSwapLimit(), then the oldest
+     * ones are moved to the swap file. The tiles whose compression
+     * ratio is lower than this value are written to the swap file
+     * directly.
+     */
+    qreal compressedSwapMinRatio(bool requestDefault = false) const;
+    void setCompressedSwapMinRatio(qreal value);
 
     static int totalRAM(); // MiB
 
@@ -144,10 +144,21 @@ KisMemoryStatisticsServer::fetchMemoryStatistics(KisImageSP image) const
     stats.poolSize = tileStats.poolSize;
 
     stats.swapSize = tileStats.swapSize;
+    stats.swapFileSize = tileStats.swapFileSize;
+    stats.swapMappedSize = tileStats.swapMappedSize;
+    stats.swapWindowHits = tileStats.swapWindowHits;
+    stats.swapWindowMisses = tileStats.swapWindowMisses;
+    stats.compressedSwapSize = tileStats.compressedSwapSize;
+    stats.compressedSwapDataSize = tileStats.compressedSwapDataSize;
+
+    stats.arenaSize = tileStats.arenaSize;
+    stats.arenaUsedSize = tileStats.arenaUsedSize;
+    stats.arenaHugePagesSize = tileStats.arenaHugePagesSize;
 
     KisImageConfig cfg(true);
 
     stats.tilesHardLimit = cfg.tilesHardLimit() * MiB;
+    stats.compressedSwapLimit = qint64(cfg.compressedSwapLimit()) * MiB;
     stats.tilesSoftLimit = cfg.tilesSoftLimit() * MiB;
     stats.tilesPoolLimit = cfg.poolLimit() * MiB;
     stats.totalMemoryLimit = stats.tilesHardLimit + stats.tilesPoolLimit;
@@ -33,6 +33,17 @@ public:
               poolSize(0),
 
               swapSize(0),
+              swapFileSize(0),
+              swapMappedSize(0),
+              swapWindowHits(0),
+              swapWindowMisses(0),
+              compressedSwapSize(0),
+              compressedSwapDataSize(0),
+              compressedSwapLimit(0),
+
+              arenaSize(0),
+              arenaUsedSize(0),
+              arenaHugePagesSize(0),
 
               totalMemoryLimit(0),
               tilesHardLimit(0),
@@ -52,6 +63,22 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+        qint64 swapFileSize;
+        qint64 swapMappedSize;
+        qint64 swapWindowHits;
+        qint64 swapWindowMisses;
+
+        /**
+         * The memory used by the swapped tiles kept compressed in
+         * RAM and the size of these tiles in uncompressed form
+         */
+        qint64 compressedSwapSize;
+        qint64 compressedSwapDataSize;
+        qint64 compressedSwapLimit;
+
+        qint64 arenaSize;
+        qint64 arenaUsedSize;
+        qint64 arenaHugePagesSize;
 
         qint64 totalMemoryLimit;
         qint64 tilesHardLimit;
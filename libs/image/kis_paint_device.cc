@@ -57,6 +57,7 @@
 #include "kis_transform_worker.h"
 #include "kis_filter_strategy.h"
 #include "krita_utils.h"
+#include "kis_image_config.h"
 
 
 struct KisPaintDeviceSPStaticRegistrar {
@@ -66,6 +67,10 @@ struct KisPaintDeviceSPStaticRegistrar {
 };
 static KisPaintDeviceSPStaticRegistrar __registrar;
 
+namespace {
+QAtomicInt s_colorSpaceConversionThreadsLimit(0);
+}
+
 
 
 struct KisPaintDevice::Private
@@ -101,6 +106,8 @@ public:
     KisPaintDeviceStrategy* currentStrategy();
 
     void init(const KoColorSpace *cs, const quint8 *defaultPixel);
+    void setTileSize(qint32 tileSize);
+    static qint32 preferredTileSize(const KoColorSpace *cs);
     void convertColorSpace(const KoColorSpace *dstColorSpace,
                            KoColorConversionTransformation::Intent renderingIntent,
                            KoColorConversionTransformation::ConversionFlags conversionFlags,
@@ -1043,15 +1050,43 @@ KUndo2Command *KisPaintDevice::Private::reincarnateWithDetachedHistory(bool copy
 
 void KisPaintDevice::Private::init(const KoColorSpace *cs, const quint8 *defaultPixel)
 {
+    const qint32 tileSize = preferredTileSize(cs);
+
     QList<Data*> dataObjects = allDataObjects();
     Q_FOREACH (Data *data, dataObjects) {
         if (!data) continue;
 
-        KisDataManagerSP dataManager = new KisDataManager(cs->pixelSize(), defaultPixel);
+        KisDataManagerSP dataManager = new KisDataManager(cs->pixelSize(), defaultPixel, tileSize);
         data->init(cs, dataManager);
     }
 }
 
+void KisPaintDevice::Private::setTileSize(qint32 tileSize)
+{
+    QList<Data*> dataObjects = allDataObjects();
+    Q_FOREACH (Data *data, dataObjects) {
+        if (!data) continue;
+
+        data->setTileSize(tileSize);
+    }
+}
+
+qint32 KisPaintDevice::Private::preferredTileSize(const KoColorSpace *cs)
+{
+    /**
+     * Pixels of 16-bit and 32-bit float RGBA color spaces take 8 and 16
+     * bytes, so the devices in such color spaces occupy a lot of tiles.
+     * The option affects only the newly created devices, the existing
+     * ones keep their tile size together with their history.
+     */
+    if (cs->pixelSize() < 8) return KisTileData::WIDTH;
+
+    const qint32 highBitDepthTileSize = KisImageConfig(true).highBitDepthTileSize();
+
+    return KisTiledDataManager::isTileSizeSupported(highBitDepthTileSize) ?
+        highBitDepthTileSize : KisTileData::WIDTH;
+}
+
 KisPaintDevice::KisPaintDevice(const KoColorSpace * colorSpace, const QString& name)
     : QObject(0)
     , m_d(new Private(this))
@@ -1517,6 +1552,11 @@ void KisPaintDevice::purgeDefaultPixels()
     dm->purge(dm->extent());
 }
 
+void KisPaintDevice::prefetchSwappedData(const QRect &rc) const
+{
+    m_d->dataManager()->prefetchTiles(rc);
+}
+
 void KisPaintDevice::setDefaultPixel(const KoColor &defPixel)
 {
     KoColor color(defPixel);
@@ -1588,6 +1628,16 @@ void KisPaintDevice::convertTo(const KoColorSpace *dstColorSpace,
     m_d->convertColorSpace(dstColorSpace, renderingIntent, conversionFlags, parentCommand, progressUpdater);
 }
 
+void KisPaintDevice::setColorSpaceConversionThreadsLimit(int value)
+{
+    s_colorSpaceConversionThreadsLimit.storeRelease(value);
+}
+
+int KisPaintDevice::colorSpaceConversionThreadsLimit()
+{
+    return s_colorSpaceConversionThreadsLimit.loadAcquire();
+}
+
 bool KisPaintDevice::setProfile(const KoColorProfile * profile, KUndo2Command *parentCommand)
 {
     return m_d->assignProfile(profile, parentCommand);
@@ -2038,6 +2088,21 @@ quint32 KisPaintDevice::pixelSize() const
     return _pixelSize;
 }
 
+qint32 KisPaintDevice::tileSize() const
+{
+    return m_d->dataManager()->tileWidth();
+}
+
+void KisPaintDevice::setTileSize(qint32 tileSize)
+{
+    if (!KisTiledDataManager::isTileSizeSupported(tileSize)) {
+        warnKrita << "Unsupported tile size" << tileSize << "of the paint device" << this;
+        return;
+    }
+
+    m_d->setTileSize(tileSize);
+}
+
 quint32 KisPaintDevice::channelCount() const
 {
     quint32 _channelCount = m_d->colorSpace()->channelCount();
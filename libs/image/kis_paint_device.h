@@ -283,6 +283,15 @@ public:
      */
     void purgeDefaultPixels();
 
+    /**
+     * Announces that the pixels in \p rc are going to be accessed
+     * soon. If some of the tiles of the device have been swapped
+     * out, they are loaded back into memory asynchronously, so the
+     * upcoming job doesn't stall on reading the swap file. The call
+     * doesn't block and doesn't change the device.
+     */
+    void prefetchSwappedData(const QRect &rc) const;
+
     /**
      * Sets the default pixel. New data will be initialised with this pixel. The pixel is copied: the
      * caller still owns the pointer and needs to delete it to avoid memory leaks.
@@ -482,6 +491,16 @@ public:
                    KUndo2Command *parentCommand = nullptr,
                    KoUpdater *progressUpdater = nullptr);
 
+    /**
+     * convertTo() splits the device into tile-aligned patches and
+     * converts them concurrently. The method limits the number of the
+     * threads used for that. Zero value (default) means that
+     * QThread::idealThreadCount() threads are used. Used mostly for
+     * benchmarking.
+     */
+    static void setColorSpaceConversionThreadsLimit(int value);
+    static int colorSpaceConversionThreadsLimit();
+
     /**
      * Changes the profile of the colorspace of this paint device to the given
      * profile. If the given profile is 0, nothing happens.
@@ -738,6 +757,20 @@ public:
      */
     quint32 channelCount() const;
 
+    /**
+     * Return the size of the tiles the pixels of the device are
+     * stored in
+     */
+    qint32 tileSize() const;
+
+    /**
+     * Moves the pixels of all the frames of the device into tiles of
+     * \p tileSize pixels, see KisTiledDataManager. The history of the
+     * device is lost, so it should be called right after the device
+     * has been created. The change is not undoable.
+     */
+    void setTileSize(qint32 tileSize);
+
     /**
      * @return interstroke data that is atteched to the paint device.
      *
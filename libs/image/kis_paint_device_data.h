@@ -8,11 +8,21 @@
 #ifndef __KIS_PAINT_DEVICE_DATA_H
 #define __KIS_PAINT_DEVICE_DATA_H
 
+#include <QMutex>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <KisRegion.h>
+#include <KoColorConversionCache.h>
+#include <KoColorConversionTransformation.h>
+#include <KoColorSpaceRegistry.h>
+
 #include "KisInterstrokeData.h"
 #include "KisSequentialIteratorProgress.h"
 #include "KoAlwaysInline.h"
 #include "kis_command_utils.h"
 #include "kundo2command.h"
+#include "krita_utils.h"
 
 struct DirectDataAccessPolicy {
     DirectDataAccessPolicy(KisDataManager *dataManager, KisIteratorCompleteListener *completionListener)
@@ -44,6 +54,12 @@ class KisPaintDeviceData;
 
 class KisPaintDeviceData
 {
+    /**
+     * The size of the patches the device is split into when converted
+     * into another color space. Should be a multiple of the tile size.
+     */
+    static const int CONVERSION_PATCH_SIZE = 256;
+
 public:
     KisPaintDeviceData(KisPaintDevice *paintDevice)
         : m_cache(paintDevice),
@@ -57,7 +73,8 @@ public:
     KisPaintDeviceData(KisPaintDevice *paintDevice, const KisPaintDeviceData *rhs, bool cloneContent)
         : m_dataManager(cloneContent ?
                         new KisDataManager(*rhs->m_dataManager) :
-                        new KisDataManager(rhs->m_dataManager->pixelSize(), rhs->m_dataManager->defaultPixel())),
+                        new KisDataManager(rhs->m_dataManager->pixelSize(), rhs->m_dataManager->defaultPixel(),
+                                           rhs->m_dataManager->tileWidth())),
           m_cache(paintDevice),
           m_x(rhs->m_x),
           m_y(rhs->m_y),
@@ -164,46 +181,79 @@ public:
                                KUndo2Command *parentCommand,
                                KoUpdater *updater = nullptr)
     {
-        using InternalSequentialConstIterator =
-            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-        using InternalSequentialIterator =
-            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, ProxyBasedProgressPolicy>;
-
         if (m_colorSpace == dstColorSpace || *m_colorSpace == *dstColorSpace) {
             return;
         }
 
-        QRect rc = m_dataManager->region().boundingRect();
-
         const int dstPixelSize = dstColorSpace->pixelSize();
         QScopedArrayPointer<quint8> dstDefaultPixel(new quint8[dstPixelSize]);
         memset(dstDefaultPixel.data(), 0, dstPixelSize);
         m_colorSpace->convertPixelsTo(m_dataManager->defaultPixel(), dstDefaultPixel.data(), dstColorSpace, 1, renderingIntent, conversionFlags);
 
-        KisDataManagerSP dstDataManager = new KisDataManager(dstPixelSize, dstDefaultPixel.data());
-
-
-        if (!rc.isEmpty()) {
-            InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc, updater);
-            InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager.data(), cacheInvalidator()), rc, updater);
-
-            int nConseqPixels = srcIt.nConseqPixels();
-
-            // since we are accessing data managers directly, the columns are always aligned
-            KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+        KisDataManagerSP dstDataManager =
+            new KisDataManager(dstPixelSize, dstDefaultPixel.data(), m_dataManager->tileWidth());
+
+        /**
+         * The areas not covered by the tiles have the default pixel,
+         * which has already been converted, so we convert the existing
+         * tiles only. The tiles are grouped into patches that are
+         * converted concurrently.
+         */
+        QVector<QRect> patches;
+        Q_FOREACH (const QRect &rc, m_dataManager->region().rects()) {
+            patches += KritaUtils::splitRectIntoPatches(rc, QSize(CONVERSION_PATCH_SIZE, CONVERSION_PATCH_SIZE));
+        }
 
-            while(srcIt.nextPixels(nConseqPixels) &&
-                  dstIt.nextPixels(nConseqPixels)) {
+        if (!patches.isEmpty()) {
+            QAtomicInt nextPatch(0);
+            QAtomicInt numConvertedPatches(0);
+            QMutex progressLock;
 
-                nConseqPixels = srcIt.nConseqPixels();
+            if (updater) {
+                updater->setRange(0, patches.size());
+            }
 
-                const quint8 *srcData = srcIt.rawDataConst();
-                quint8 *dstData = dstIt.rawData();
+            /**
+             * KoColorConversionTransformation::transform() is reentrant
+             * (LCMS transforms keep their one-pixel cache per call), so
+             * all the workers share the same cached converter.
+             */
+            KoCachedColorConversionTransformation cachedTransform =
+                KoColorSpaceRegistry::instance()->colorConversionCache()->
+                    cachedConverter(m_colorSpace, dstColorSpace, renderingIntent, conversionFlags);
+            const KoColorConversionTransformation *transform = cachedTransform.transformation();
+
+            auto convertPatches = [&] (int &) {
+                int index = 0;
+                while ((index = nextPatch.fetchAndAddOrdered(1)) < patches.size()) {
+                    convertPatch(patches.at(index), transform, dstDataManager.data());
+
+                    const int numConverted = numConvertedPatches.fetchAndAddOrdered(1) + 1;
+
+                    // KoUpdater is not thread-safe, so only one thread reports at a time
+                    if (updater && progressLock.tryLock()) {
+                        updater->setValue(numConverted);
+                        progressLock.unlock();
+                    }
+                }
+            };
+
+            int numThreads = KisPaintDevice::colorSpaceConversionThreadsLimit();
+            if (numThreads <= 0) {
+                numThreads = QThread::idealThreadCount();
+            }
+            numThreads = qBound(1, numThreads, patches.size());
+
+            if (numThreads > 1) {
+                QVector<int> workers(numThreads);
+                QtConcurrent::blockingMap(workers, convertPatches);
+            } else {
+                int worker = 0;
+                convertPatches(worker);
+            }
 
-                m_colorSpace->convertPixelsTo(srcData, dstData,
-                                              dstColorSpace,
-                                              nConseqPixels,
-                                              renderingIntent, conversionFlags);
+            if (updater) {
+                updater->setValue(patches.size());
             }
         }
 
@@ -223,6 +273,37 @@ public:
         }
     }
 
+private:
+    void convertPatch(const QRect &rc,
+                      const KoColorConversionTransformation *transform,
+                      KisDataManager *dstDataManager)
+    {
+        using InternalSequentialConstIterator =
+            KisSequentialIteratorBase<ReadOnlyIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, NoProgressPolicy>;
+        using InternalSequentialIterator =
+            KisSequentialIteratorBase<WritableIteratorPolicy<DirectDataAccessPolicy>, DirectDataAccessPolicy, NoProgressPolicy>;
+
+        InternalSequentialConstIterator srcIt(DirectDataAccessPolicy(m_dataManager.data(), cacheInvalidator()), rc);
+        InternalSequentialIterator dstIt(DirectDataAccessPolicy(dstDataManager, cacheInvalidator()), rc);
+
+        int nConseqPixels = srcIt.nConseqPixels();
+
+        // since we are accessing data managers directly, the columns are always aligned
+        KIS_SAFE_ASSERT_RECOVER_NOOP(srcIt.nConseqPixels() == dstIt.nConseqPixels());
+
+        while(srcIt.nextPixels(nConseqPixels) &&
+              dstIt.nextPixels(nConseqPixels)) {
+
+            nConseqPixels = srcIt.nConseqPixels();
+
+            const quint8 *srcData = srcIt.rawDataConst();
+            quint8 *dstData = dstIt.rawData();
+
+            transform->transform(srcData, dstData, nConseqPixels);
+        }
+    }
+
+public:
     void reincarnateWithDetachedHistory(bool copyContent, KUndo2Command *parentCommand) {
         struct SwitchDataManager : public KUndo2Command
         {
@@ -257,7 +338,8 @@ public:
                 KisDataManagerSP newDm =
                     copyContent ?
                     new KisDataManager(*this->dataManager()) :
-                    new KisDataManager(this->dataManager()->pixelSize(), this->dataManager()->defaultPixel());
+                    new KisDataManager(this->dataManager()->pixelSize(), this->dataManager()->defaultPixel(),
+                                       this->dataManager()->tileWidth());
                 return new SwitchDataManager(this, this->dataManager(), newDm);
             });
     }
@@ -269,11 +351,14 @@ public:
         if (copyContent) {
             m_dataManager = new KisDataManager(*srcData->dataManager());
         } else if (m_dataManager->pixelSize() !=
-                   srcData->dataManager()->pixelSize()) {
+                   srcData->dataManager()->pixelSize() ||
+                   m_dataManager->tileWidth() !=
+                   srcData->dataManager()->tileWidth()) {
             // NOTE: we don't check default pixel value! it is the task of
             //       the higher level!
 
-            m_dataManager = new KisDataManager(srcData->dataManager()->pixelSize(), srcData->dataManager()->defaultPixel());
+            m_dataManager = new KisDataManager(srcData->dataManager()->pixelSize(), srcData->dataManager()->defaultPixel(),
+                                               srcData->dataManager()->tileWidth());
             m_cache.setupCache();
         } else {
             m_dataManager->clear();
@@ -294,6 +379,22 @@ public:
         m_cache.invalidate();
     }
 
+    /**
+     * Moves the pixels into a new data manager with tiles of \p
+     * tileSize pixels. The history of the data manager is lost, so
+     * it should be called for just created devices only.
+     */
+    void setTileSize(qint32 tileSize) {
+        if (m_dataManager->tileWidth() == tileSize) return;
+
+        KisDataManagerSP dstDataManager =
+            new KisDataManager(m_dataManager->pixelSize(), m_dataManager->defaultPixel(), tileSize);
+        dstDataManager->bitBlt(m_dataManager, m_dataManager->extent());
+
+        m_dataManager = dstDataManager;
+        m_cache.invalidate();
+    }
+
     ALWAYS_INLINE KisDataManagerSP dataManager() const {
         return m_dataManager;
     }
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_paint_device_writer.h"
+
+#include "kis_image_config.h"
+
+KisPaintDeviceWriter::KisPaintDeviceWriter()
+    : m_tileCompression(KisImageConfig(true).tileCompression())
+{
+}
+
+KisPaintDeviceWriter::~KisPaintDeviceWriter()
+{
+}
+
+QString KisPaintDeviceWriter::tileCompression() const
+{
+    return m_tileCompression;
+}
@@ -8,11 +8,24 @@
 
 #include <kritaimage_export.h>
 
+#include <QString>
+
 class KRITAIMAGE_EXPORT KisPaintDeviceWriter {
 public:
-    virtual ~KisPaintDeviceWriter() {}
+    KisPaintDeviceWriter();
+    virtual ~KisPaintDeviceWriter();
     virtual bool write(const QByteArray &data) = 0;
     virtual bool write(const char* data, qint64 length) = 0;
+
+    /**
+     * The codec the tiles of the written devices are compressed with.
+     * It is read from KisImageConfig once, when the writer is created,
+     * so all the devices saved with one writer use the same codec.
+     */
+    QString tileCompression() const;
+
+private:
+    QString m_tileCompression;
 };
 
 
@@ -70,7 +70,7 @@ void KisRectangleMaskGenerator::setSoftness(qreal softness)
 
 bool KisRectangleMaskGenerator::shouldVectorize() const
 {
-    return !shouldSupersample() && spikes() == 2;
+    return !shouldSupersample();
 }
 
 KisBrushMaskApplicatorBase* KisRectangleMaskGenerator::applicator()
@@ -11,6 +11,7 @@
 
 #include <QRunnable>
 #include <QReadWriteLock>
+#include <QElapsedTimer>
 
 #include "kis_stroke_job.h"
 #include "kis_spontaneous_job.h"
@@ -74,12 +75,25 @@ private:
         while (1) {
             KIS_SAFE_ASSERT_RECOVER_RETURN(isRunning());
 
+            const bool collectStatistics = KisUpdaterContext::collectStatistics();
+            QElapsedTimer statisticsTimer;
+            qint64 jobStartTime = 0;
+            qint64 jobEndTime = 0;
+
+            if (collectStatistics) {
+                statisticsTimer.start();
+            }
+
             if(m_exclusive) {
                 m_updaterContext->m_exclusiveJobLock.lockForWrite();
             } else {
                 m_updaterContext->m_exclusiveJobLock.lockForRead();
             }
 
+            if (collectStatistics) {
+                jobStartTime = statisticsTimer.nsecsElapsed();
+            }
+
             if(m_atomicType == Type::MERGE) {
                 runMergeJob();
             } else {
@@ -101,6 +115,10 @@ private:
                 }
             }
 
+            if (collectStatistics) {
+                jobEndTime = statisticsTimer.nsecsElapsed();
+            }
+
             setDone();
 
             m_updaterContext->doSomeUsefulWork();
@@ -110,6 +128,11 @@ private:
 
             m_updaterContext->m_exclusiveJobLock.unlock();
 
+            if (collectStatistics) {
+                const qint64 jobTime = jobEndTime - jobStartTime;
+                KisUpdaterContext::addStatistics(jobTime, statisticsTimer.nsecsElapsed() - jobTime);
+            }
+
             // try to exit the loop. Please note, that no one can flip the state from
             // WAITING to EMPTY except ourselves!
             Type expectedValue = Type::WAITING;
@@ -72,6 +72,8 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
           responseTime(0),
           numTickets(0),
           numUpdates(0),
+          numLayerStyleTilesRecalculated(0),
+          numLayerStyleTilesReused(0),
           mousePath(0.0),
           loggingEnabled(false)
     {
@@ -85,6 +87,8 @@ struct Q_DECL_HIDDEN KisUpdateTimeMonitor::Private
     qint64 responseTime;
     qint32 numTickets;
     qint32 numUpdates;
+    qint64 numLayerStyleTilesRecalculated;
+    qint64 numLayerStyleTilesReused;
     QMutex mutex;
 
     qreal mousePath;
@@ -127,6 +131,8 @@ void KisUpdateTimeMonitor::startStrokeMeasure()
     m_d->responseTime = 0;
     m_d->numTickets = 0;
     m_d->numUpdates = 0;
+    m_d->numLayerStyleTilesRecalculated = 0;
+    m_d->numLayerStyleTilesReused = 0;
     m_d->mousePath = 0;
 
     m_d->lastMousePos = QPointF();
@@ -192,7 +198,9 @@ void KisUpdateTimeMonitor::printValues()
            << i18n("Mouse Speed:") << QString::number( mouseSpeed, 'f', 3 ) << "\t"
            << i18n("Jobs/Update:") << QString::number( jobsPerUpdate, 'f', 3 ) << "\t"
            << i18n("Non Update Time:") << QString::number( nonUpdateTime, 'f', 3 ) << "\t"
-           << i18n("Response Time:") << responseTime << endl; // 'endl' will use the correct OS line ending
+           << i18n("Response Time:") << responseTime << "\t"
+           << i18n("Layer Style Tiles Recalculated:") << m_d->numLayerStyleTilesRecalculated << "\t"
+           << i18n("Layer Style Tiles Reused:") << m_d->numLayerStyleTilesReused << endl; // 'endl' will use the correct OS line ending
     logFile.close();
 }
 
@@ -245,3 +253,13 @@ void KisUpdateTimeMonitor::reportUpdateFinished(const QRect &rect)
     }
     m_d->numUpdates++;
 }
+
+void KisUpdateTimeMonitor::reportLayerStyleTiles(int numRecalculated, int numReused)
+{
+    if (!m_d->loggingEnabled) return;
+
+    QMutexLocker locker(&m_d->mutex);
+
+    m_d->numLayerStyleTilesRecalculated += numRecalculated;
+    m_d->numLayerStyleTilesReused += numReused;
+}
@@ -34,6 +34,12 @@ public:
     void reportJobFinished(void *key, const QVector<QRect> &rects);
     void reportUpdateFinished(const QRect &rect);
 
+    /**
+     * Reports how many tiles of a layer style plane were regenerated
+     * and how many were reused from the layer style tile cache
+     */
+    void reportLayerStyleTiles(int numRecalculated, int numReused);
+
 
 private:
     struct Private;
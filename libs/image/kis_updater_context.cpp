@@ -7,13 +7,22 @@
 #include "kis_updater_context.h"
 
 #include <QThread>
-#include <QThreadPool>
+
+#include <atomic>
 
 #include "kis_update_job_item.h"
 #include "kis_stroke_job.h"
 
 const int KisUpdaterContext::useIdealThreadCountTag = -1;
 
+namespace {
+std::atomic<bool> s_collectStatistics {false};
+std::atomic<qint64> s_numJobs {0};
+std::atomic<qint64> s_stolenJobsBase {0};
+std::atomic<qint64> s_jobsTime {0};
+std::atomic<qint64> s_schedulingTime {0};
+}
+
 KisUpdaterContext::KisUpdaterContext(qint32 threadCount, KisUpdateScheduler *parent)
     : m_scheduler(parent)
 {
@@ -222,13 +231,22 @@ void KisUpdaterContext::unlock()
 
 void KisUpdaterContext::setThreadsLimit(int value)
 {
-    m_threadPool.setMaxThreadCount(value);
+    // the settings are reapplied on every config change
+    if (value == m_jobs.size() && value == m_threadPool.maxThreadCount()) return;
 
     for (int i = 0; i < m_jobs.size(); i++) {
         KIS_SAFE_ASSERT_RECOVER_RETURN(!m_jobs[i]->isRunning());
         // don't delete the jobs until all of them are checked!
     }
 
+    /**
+     * The job items leave the running state before their runnables
+     * return from run(), so wait for the executor to finish them
+     * before deleting the items
+     */
+    m_threadPool.waitForDone();
+    m_threadPool.setMaxThreadCount(value);
+
     for (int i = 0; i < m_jobs.size(); i++) {
         delete m_jobs[i];
     }
@@ -273,6 +291,41 @@ void KisUpdaterContext::jobThreadExited()
     }
 }
 
+void KisUpdaterContext::setCollectStatistics(bool value)
+{
+    s_collectStatistics = value;
+}
+
+bool KisUpdaterContext::collectStatistics()
+{
+    return s_collectStatistics.load(std::memory_order_relaxed);
+}
+
+KisUpdaterContext::Statistics KisUpdaterContext::statistics()
+{
+    Statistics stats;
+    stats.numJobs = s_numJobs;
+    stats.numStolenJobs = KisWorkStealingExecutor::numStolenJobs() - s_stolenJobsBase;
+    stats.jobsTime = s_jobsTime;
+    stats.schedulingTime = s_schedulingTime;
+    return stats;
+}
+
+void KisUpdaterContext::resetStatistics()
+{
+    s_numJobs = 0;
+    s_stolenJobsBase = KisWorkStealingExecutor::numStolenJobs();
+    s_jobsTime = 0;
+    s_schedulingTime = 0;
+}
+
+void KisUpdaterContext::addStatistics(qint64 jobsTime, qint64 schedulingTime)
+{
+    s_numJobs.fetch_add(1, std::memory_order_relaxed);
+    s_jobsTime.fetch_add(jobsTime, std::memory_order_relaxed);
+    s_schedulingTime.fetch_add(schedulingTime, std::memory_order_relaxed);
+}
+
 void KisUpdaterContext::setTestingMode(bool value)
 {
     m_testingMode = value;
@@ -9,7 +9,6 @@
 
 #include <QMutex>
 #include <QReadWriteLock>
-#include <QThreadPool>
 #include <QWaitCondition>
 
 #include "kis_base_rects_walker.h"
@@ -17,6 +16,7 @@
 #include "kis_lock_free_lod_counter.h"
 
 #include "KisUpdaterContextSnapshotEx.h"
+#include "KisWorkStealingExecutor.h"
 #include "kis_update_scheduler.h"
 
 class KisUpdateJobItem;
@@ -29,6 +29,27 @@ class KRITAIMAGE_EXPORT KisUpdaterContext
 public:
     static const int useIdealThreadCountTag;
 
+    /**
+     * The time spent by the job items of all the contexts of the
+     * application. Collected only when enabled with
+     * setCollectStatistics(), used for benchmarking the scheduler.
+     */
+    struct Statistics {
+        qint64 numJobs = 0;
+        qint64 numStolenJobs = 0;
+
+        /// nanoseconds spent in the jobs themselves (the pixel work)
+        qint64 jobsTime = 0;
+
+        /// nanoseconds spent on picking up the next jobs and on waiting for the locks
+        qint64 schedulingTime = 0;
+    };
+
+    static void setCollectStatistics(bool value);
+    static bool collectStatistics();
+    static Statistics statistics();
+    static void resetStatistics();
+
 public:
     KisUpdaterContext(qint32 threadCount = useIdealThreadCountTag, KisUpdateScheduler *parent = 0);
     ~KisUpdaterContext();
@@ -153,7 +174,7 @@ protected:
     int m_numRunningThreads = 0;
     QWaitCondition m_waitForDoneCondition;
     QVector<KisUpdateJobItem*> m_jobs;
-    QThreadPool m_threadPool;
+    KisWorkStealingExecutor m_threadPool;
     KisLockFreeLodCounter m_lodCounter;
     KisUpdateScheduler *m_scheduler;
     bool m_testingMode = false;
@@ -171,6 +192,8 @@ private:
 
     void startThread(int index);
 
+    static void addStatistics(qint64 jobsTime, qint64 schedulingTime);
+
 };
 
 class KRITAIMAGE_EXPORT KisTestableUpdaterContext : public KisUpdaterContext
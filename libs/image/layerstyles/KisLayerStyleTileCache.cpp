@@ -0,0 +1,183 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisLayerStyleTileCache.h"
+
+#include <cstring>
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+
+#include <KoColorSpace.h>
+#include <KisRegion.h>
+
+#include "kis_paint_device.h"
+#include "kis_pixel_selection.h"
+#include "kis_update_time_monitor.h"
+
+
+const int KisLayerStyleTileCache::tileSize = 64;
+
+namespace {
+
+inline int tileIndex(int coord)
+{
+    const int size = KisLayerStyleTileCache::tileSize;
+    return coord >= 0 ? coord / size : -((-coord + size - 1) / size);
+}
+
+inline quint64 tileKey(int col, int row)
+{
+    return (quint64(quint32(col)) << 32) | quint32(row);
+}
+
+template <class Func>
+void forEachTile(const QRect &rect, Func func)
+{
+    const int size = KisLayerStyleTileCache::tileSize;
+
+    const int firstCol = tileIndex(rect.left());
+    const int lastCol = tileIndex(rect.right());
+    const int firstRow = tileIndex(rect.top());
+    const int lastRow = tileIndex(rect.bottom());
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            func(tileKey(col, row), QRect(col * size, row * size, size, size));
+        }
+    }
+}
+
+}
+
+struct KisLayerStyleTileCache::Private
+{
+    QMutex lock;
+
+    KisPixelSelectionSP alphaSnapshot;
+    const KoColorSpace *sourceColorSpace {nullptr};
+
+    /// the tiles of the style that don't need to be regenerated
+    QSet<quint64> validTiles;
+
+    QVector<quint8> sourcePixels;
+    QVector<quint8> sourceAlpha;
+    QVector<quint8> snapshotAlpha;
+
+    bool updateSnapshot(KisPaintDeviceSP source, const QRect &tileRect);
+};
+
+KisLayerStyleTileCache::KisLayerStyleTileCache()
+    : m_d(new Private)
+{
+}
+
+KisLayerStyleTileCache::~KisLayerStyleTileCache()
+{
+}
+
+bool KisLayerStyleTileCache::Private::updateSnapshot(KisPaintDeviceSP source, const QRect &tileRect)
+{
+    const int numPixels = tileRect.width() * tileRect.height();
+
+    sourcePixels.resize(numPixels * source->pixelSize());
+    sourceAlpha.resize(numPixels);
+    snapshotAlpha.resize(numPixels);
+
+    source->readBytes(sourcePixels.data(), tileRect);
+    source->colorSpace()->copyOpacityU8(sourcePixels.data(), sourceAlpha.data(), numPixels);
+
+    alphaSnapshot->readBytes(snapshotAlpha.data(), tileRect);
+
+    if (!std::memcmp(sourceAlpha.constData(), snapshotAlpha.constData(), numPixels)) {
+        return false;
+    }
+
+    alphaSnapshot->writeBytes(sourceAlpha.constData(), tileRect);
+    return true;
+}
+
+QVector<QRect> KisLayerStyleTileCache::startUpdate(KisPaintDeviceSP source,
+                                                   const QRect &rect,
+                                                   RectTransform needRect,
+                                                   RectTransform changeRect)
+{
+    if (rect.isEmpty()) return QVector<QRect>();
+
+    QVector<QRect> dirtyRects;
+    int numRecalculated = 0;
+    int numReused = 0;
+
+    {
+        QMutexLocker l(&m_d->lock);
+
+        /**
+         * The style projection is reset by KisMultipleProjection when the
+         * color space of the source changes, and the opacity of the pixels
+         * may have been rounded differently, so just start from scratch.
+         */
+        if (!m_d->alphaSnapshot ||
+            !m_d->sourceColorSpace ||
+            *m_d->sourceColorSpace != *source->colorSpace()) {
+
+            m_d->alphaSnapshot = new KisPixelSelection();
+            m_d->sourceColorSpace = source->colorSpace();
+            m_d->validTiles.clear();
+        }
+
+        forEachTile(needRect(rect),
+            [&] (quint64 key, const QRect &tileRect) {
+                Q_UNUSED(key);
+
+                if (!m_d->updateSnapshot(source, tileRect)) return;
+
+                /**
+                 * The knockout of the source may affect the style right
+                 * under the changed pixels, even when the style itself is
+                 * offset from them.
+                 */
+                forEachTile(changeRect(tileRect) | tileRect,
+                    [&] (quint64 affectedKey, const QRect &) {
+                        m_d->validTiles.remove(affectedKey);
+                    });
+            });
+
+        forEachTile(rect,
+            [&] (quint64 key, const QRect &tileRect) {
+                if (m_d->validTiles.contains(key)) {
+                    numReused++;
+                    return;
+                }
+
+                numRecalculated++;
+                dirtyRects << (tileRect & rect);
+
+                /**
+                 * The tiles that are only partially covered by the update
+                 * stay outdated, their other part will be regenerated by
+                 * the update that covers it.
+                 */
+                if (rect.contains(tileRect)) {
+                    m_d->validTiles.insert(key);
+                }
+            });
+    }
+
+    KisUpdateTimeMonitor::instance()->reportLayerStyleTiles(numRecalculated, numReused);
+
+    if (!numReused) {
+        return {rect};
+    }
+
+    return KisRegion(std::move(dirtyRects)).rects();
+}
+
+void KisLayerStyleTileCache::invalidate()
+{
+    QMutexLocker l(&m_d->lock);
+    m_d->validTiles.clear();
+}
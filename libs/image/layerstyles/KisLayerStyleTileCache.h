@@ -0,0 +1,74 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISLAYERSTYLETILECACHE_H
+#define KISLAYERSTYLETILECACHE_H
+
+#include <functional>
+
+#include <QScopedPointer>
+#include <QVector>
+#include <QRect>
+
+#include "kis_types.h"
+#include "kritaimage_export.h"
+
+/**
+ * Tracks which parts of a layer style projection are still up to date, so
+ * that KisLayerStyleFilterProjectionPlane can regenerate only the tiles
+ * whose source has actually changed.
+ *
+ * The cache keeps an alpha8 snapshot of the source device. On every update
+ * the alpha channel of the source in the needed rect of the style is
+ * compared with the snapshot tile by tile, and the tiles of the style that
+ * may be affected by the difference (that is, the change rect of every
+ * modified source tile) are marked as outdated. The cache doesn't store any
+ * pixels of the style itself: the projection of the style plane (and the
+ * knockout selection of the stroke) are the cached buffers, the caller
+ * should just regenerate the rects returned by startUpdate().
+ *
+ * The cache can be used only for the styles whose result depends on the
+ * alpha channel of the source only, see
+ * KisLayerStyleFilter::dependsOnSourceAlphaOnly().
+ */
+class KRITAIMAGE_EXPORT KisLayerStyleTileCache
+{
+public:
+    using RectTransform = std::function<QRect (const QRect &)>;
+
+    static const int tileSize;
+
+public:
+    KisLayerStyleTileCache();
+    ~KisLayerStyleTileCache();
+
+    /**
+     * Compares the alpha channel of \p source with the snapshot in
+     * needRect(rect) and returns the rects inside \p rect that should be
+     * regenerated. The returned rects are considered up to date after the
+     * call, so the caller must regenerate them before the next update.
+     *
+     * @param needRect the needed rect of the style for the given rect
+     * @param changeRect the change rect of the style for the given rect
+     */
+    QVector<QRect> startUpdate(KisPaintDeviceSP source,
+                               const QRect &rect,
+                               RectTransform needRect,
+                               RectTransform changeRect);
+
+    /**
+     * Marks all the tiles of the style as outdated
+     */
+    void invalidate();
+
+private:
+    Q_DISABLE_COPY(KisLayerStyleTileCache)
+
+    struct Private;
+    const QScopedPointer<Private> m_d;
+};
+
+#endif // KISLAYERSTYLETILECACHE_H
@@ -35,3 +35,9 @@ QString KisLayerStyleFilter::id() const
 {
     return m_d->id.id();
 }
+
+bool KisLayerStyleFilter::dependsOnSourceAlphaOnly(KisPSDLayerStyleSP style) const
+{
+    Q_UNUSED(style);
+    return false;
+}
@@ -51,6 +51,16 @@ public:
      */
     virtual QRect changedRect(const QRect & rect, KisPSDLayerStyleSP style, KisLayerStyleFilterEnvironment *env) const = 0;
 
+    /**
+     * \return true if the result of the filter is defined by the alpha channel
+     * of the source in neededRect() only. Such filters are regenerated only
+     * in the tiles whose source has changed, see KisLayerStyleTileCache. Fills
+     * aligned to the layer or image bounds and random noise don't qualify.
+     *
+     * The default implementation returns false.
+     */
+    virtual bool dependsOnSourceAlphaOnly(KisPSDLayerStyleSP style) const;
+
 protected:
     KisLayerStyleFilter(const KisLayerStyleFilter &rhs);
 
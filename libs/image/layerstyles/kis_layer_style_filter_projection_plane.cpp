@@ -17,6 +17,7 @@
 #include "kis_painter.h"
 #include "kis_multiple_projection.h"
 #include "KisLayerStyleKnockoutBlower.h"
+#include "KisLayerStyleTileCache.h"
 
 
 struct KisLayerStyleFilterProjectionPlane::Private
@@ -48,6 +49,12 @@ struct KisLayerStyleFilterProjectionPlane::Private
     KisLayerStyleKnockoutBlower knockoutBlower;
 
     KisMultipleProjection projection;
+
+    /**
+     * The cloned plane gets a fresh cache, so its projection is
+     * regenerated on the first update
+     */
+    KisLayerStyleTileCache tileCache;
 };
 
 KisLayerStyleFilterProjectionPlane::
@@ -80,13 +87,39 @@ QRect KisLayerStyleFilterProjectionPlane::recalculate(const QRect& rect, KisNode
         return QRect();
     }
 
-    m_d->projection.clear(rect);
-    m_d->filter->processDirectly(m_d->sourceLayer->projection(),
-                                 &m_d->projection,
-                                 &m_d->knockoutBlower,
-                                 rect,
-                                 m_d->style,
-                                 m_d->environment.data());
+    KisPaintDeviceSP source = m_d->sourceLayer->projection();
+    QVector<QRect> dirtyRects;
+
+    /**
+     * The tile cache tracks the pixels of lod0 only, the lodN planes are
+     * regenerated on every update
+     */
+    if (m_d->environment->currentLevelOfDetail() == 0 &&
+        m_d->filter->dependsOnSourceAlphaOnly(m_d->style)) {
+
+        KisLayerStyleFilterEnvironment *env = m_d->environment.data();
+
+        dirtyRects = m_d->tileCache.startUpdate(source, rect,
+            [this, env] (const QRect &rc) {
+                return m_d->filter->neededRect(rc, m_d->style, env);
+            },
+            [this, env] (const QRect &rc) {
+                return m_d->filter->changedRect(rc, m_d->style, env);
+            });
+    } else {
+        dirtyRects << rect;
+    }
+
+    Q_FOREACH (const QRect &dirtyRect, dirtyRects) {
+        m_d->projection.clear(dirtyRect);
+        m_d->filter->processDirectly(source,
+                                     &m_d->projection,
+                                     &m_d->knockoutBlower,
+                                     dirtyRect,
+                                     m_d->style,
+                                     m_d->environment.data());
+    }
+
     return rect;
 }
 
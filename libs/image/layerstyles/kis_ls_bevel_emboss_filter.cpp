@@ -504,3 +504,11 @@ QRect KisLsBevelEmbossFilter::changedRect(const QRect &rect, KisPSDLayerStyleSP
     BevelEmbossRectCalculator d(rect, w.config);
     return d.totalChangeRect(rect, w.config);
 }
+
+bool KisLsBevelEmbossFilter::dependsOnSourceAlphaOnly(KisPSDLayerStyleSP style) const
+{
+    const psd_layer_effects_bevel_emboss *config = style->bevelAndEmboss();
+
+    // the texture pattern is aligned to the layer or image bounds
+    return config->effectEnabled() && !config->textureEnabled();
+}
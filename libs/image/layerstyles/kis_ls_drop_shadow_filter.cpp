@@ -287,3 +287,17 @@ QRect KisLsDropShadowFilter::changedRect(const QRect &rect, KisPSDLayerStyleSP s
     return style->context()->keep_original ?
         d.finalChangeRect() : rect | d.finalChangeRect();
 }
+
+bool KisLsDropShadowFilter::dependsOnSourceAlphaOnly(KisPSDLayerStyleSP style) const
+{
+    const psd_layer_effects_shadow_base *config = getShadowStruct(style);
+    if (!config->effectEnabled()) return false;
+
+    /**
+     * The noise and the jitter are taken from a random selection that is
+     * regenerated when the updated area grows, so they don't depend on the
+     * position only.
+     */
+    return !config->noise() &&
+        (config->fillType() == psd_fill_solid_color || !config->jitter());
+}
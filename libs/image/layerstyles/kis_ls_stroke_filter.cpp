@@ -162,6 +162,14 @@ QRect KisLsStrokeFilter::changedRect(const QRect &rect, KisPSDLayerStyleSP style
     return neededRect(rect, style, env);
 }
 
+bool KisLsStrokeFilter::dependsOnSourceAlphaOnly(KisPSDLayerStyleSP style) const
+{
+    const psd_layer_effects_stroke *config = style->stroke();
+
+    // pattern and gradient fills are aligned to the layer or image bounds
+    return config->effectEnabled() && config->fillType() == psd_fill_solid_color;
+}
+
 KritaUtils::ThresholdMode KisLsStrokeFilter::sourcePlaneOpacityThresholdRequirement(KisPSDLayerStyleSP style) const
 {
     const psd_layer_effects_stroke *config = style->stroke();
@@ -0,0 +1,110 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisSlidingWindowHistogramTest.h"
+
+#include <random>
+
+#include "KisSlidingWindowHistogram.h"
+
+void KisSlidingWindowHistogramTest::testHistogram_data()
+{
+    QTest::addColumn<int>("numBins");
+    QTest::addColumn<int>("radius");
+
+    // the windows that are wider than the number of bins
+    // use per-column histograms
+    QTest::newRow("bins-16-radius-0") << 16 << 0;
+    QTest::newRow("bins-16-radius-2") << 16 << 2;
+    QTest::newRow("bins-16-radius-7") << 16 << 7;
+    QTest::newRow("bins-16-radius-8") << 16 << 8;
+    QTest::newRow("bins-16-radius-20") << 16 << 20;
+    QTest::newRow("bins-256-radius-5") << 256 << 5;
+    QTest::newRow("bins-1-radius-3") << 1 << 3;
+}
+
+void KisSlidingWindowHistogramTest::testHistogram()
+{
+    QFETCH(int, numBins);
+    QFETCH(int, radius);
+
+    const int numValues = 3;
+    const QSize size(37, 23);
+
+    KisSlidingWindowHistogram histogram(numBins, numValues, radius);
+
+    const QSize srcSize = histogram.sourceSize(size);
+    const int numSrcPixels = srcSize.width() * srcSize.height();
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> binDistribution(-1, numBins - 1);
+    std::uniform_real_distribution<float> valueDistribution(0.0f, 1.0f);
+
+    std::vector<qint16> bins(numSrcPixels);
+    std::vector<float> values(numSrcPixels * numValues);
+
+    for (int i = 0; i < numSrcPixels; i++) {
+        bins[i] = qint16(binDistribution(generator));
+        for (int j = 0; j < numValues; j++) {
+            values[i * numValues + j] = valueDistribution(generator);
+        }
+    }
+
+    int numProcessedPixels = 0;
+
+    histogram.process(size, bins.data(), values.data(), [&] (int x, int y) {
+        QCOMPARE(x, numProcessedPixels % size.width());
+        QCOMPARE(y, numProcessedPixels / size.width());
+        numProcessedPixels++;
+
+        std::vector<int> counts(numBins, 0);
+        std::vector<double> sums(numBins * numValues, 0.0);
+        std::vector<int> sortedBins;
+
+        for (int dy = 0; dy <= 2 * radius; dy++) {
+            for (int dx = 0; dx <= 2 * radius; dx++) {
+                const int i = (y + dy) * srcSize.width() + x + dx;
+                if (bins[i] < 0) continue;
+
+                counts[bins[i]]++;
+                sortedBins.push_back(bins[i]);
+
+                for (int j = 0; j < numValues; j++) {
+                    sums[bins[i] * numValues + j] += values[i * numValues + j];
+                }
+            }
+        }
+
+        std::sort(sortedBins.begin(), sortedBins.end());
+
+        QCOMPARE(histogram.totalCount(), int(sortedBins.size()));
+
+        for (int bin = 0; bin < numBins; bin++) {
+            QCOMPARE(histogram.count(bin), counts[bin]);
+
+            for (int j = 0; j < numValues; j++) {
+                QVERIFY(qAbs(histogram.sums(bin)[j] - sums[bin * numValues + j]) < 1e-6);
+            }
+        }
+
+        if (sortedBins.empty()) {
+            QCOMPARE(histogram.mostFrequentBin(), -1);
+            QCOMPARE(histogram.medianBin(), -1);
+        } else {
+            const int expectedMostFrequentBin =
+                int(std::max_element(counts.begin(), counts.end()) - counts.begin());
+
+            QCOMPARE(histogram.mostFrequentBin(), expectedMostFrequentBin);
+            QCOMPARE(histogram.medianBin(), sortedBins[(sortedBins.size() - 1) / 2]);
+            QCOMPARE(histogram.rankBin(0), sortedBins.front());
+            QCOMPARE(histogram.rankBin(int(sortedBins.size()) - 1), sortedBins.back());
+        }
+    });
+
+    QCOMPARE(numProcessedPixels, size.width() * size.height());
+}
+
+SIMPLE_TEST_MAIN(KisSlidingWindowHistogramTest)
@@ -10,6 +10,7 @@
 
 #include <QBitArray>
 #include <QElapsedTimer>
+#include <QtConcurrent>
 
 #include <KoColor.h>
 #include <KoColorSpace.h>
@@ -19,6 +20,7 @@
 #include "kis_paint_device.h"
 #include "kis_convolution_painter.h"
 #include "kis_convolution_kernel.h"
+#include "kis_sequential_iterator.h"
 #include <kis_gaussian_kernel.h>
 #include <kis_mask_generator.h>
 #include <kistest.h>
@@ -452,6 +454,174 @@ void KisConvolutionPainterTest::testGaussianDetailsFFTW()
 
 #include "kis_transaction.h"
 
+void KisConvolutionPainterTest::testGaussianIIR()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect applyRect(0, 0, 200, 200);
+    const qreal radius = 40;
+
+    KisPaintDeviceSP dev = new KisPaintDevice(cs);
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(applyRect);
+    dev->setDefaultBounds(bounds);
+
+    dev->fill(applyRect, KoColor(Qt::white, cs));
+    dev->fill(QRect(20, 30, 60, 100), KoColor(Qt::red, cs));
+    dev->fill(QRect(100, 10, 50, 150), KoColor(Qt::blue, cs));
+    dev->fill(QRect(60, 120, 120, 40), KoColor(Qt::green, cs));
+
+    KisPaintDeviceSP refDev = new KisPaintDevice(*dev);
+
+    {
+        KisConvolutionPainter painter(dev, KisConvolutionPainter::IIR);
+        painter.applyGaussian(dev, applyRect.topLeft(), applyRect.topLeft(), applyRect.size(),
+                              radius, radius, BORDER_REPEAT);
+    }
+
+    {
+        KisPaintDeviceSP interm = new KisPaintDevice(cs);
+        interm->setDefaultBounds(refDev->defaultBounds());
+
+        KisConvolutionKernelSP kernelHoriz = KisGaussianKernel::createHorizontalKernel(radius);
+        KisConvolutionKernelSP kernelVertical = KisGaussianKernel::createVerticalKernel(radius);
+
+        const int verticalHalfSize = kernelVertical->height() / 2;
+
+        KisConvolutionPainter horizPainter(interm, KisConvolutionPainter::SPATIAL);
+        horizPainter.applyMatrix(kernelHoriz, refDev,
+                                 applyRect.topLeft() - QPoint(0, verticalHalfSize),
+                                 applyRect.topLeft() - QPoint(0, verticalHalfSize),
+                                 applyRect.size() + QSize(0, 2 * verticalHalfSize),
+                                 BORDER_REPEAT);
+
+        KisConvolutionPainter verticalPainter(refDev, KisConvolutionPainter::SPATIAL);
+        verticalPainter.applyMatrix(kernelVertical, interm,
+                                    applyRect.topLeft(), applyRect.topLeft(),
+                                    applyRect.size(), BORDER_REPEAT);
+    }
+
+    const QImage result = dev->convertToQImage(0, applyRect);
+    const QImage reference = refDev->convertToQImage(0, applyRect);
+
+    // the recursive filter is only an approximation of the Gaussian
+    QPoint pt;
+    if (!TestUtil::compareQImages(pt, reference, result, 3, 3)) {
+        result.save("test_gaussian_iir_result.png");
+        reference.save("test_gaussian_iir_reference.png");
+        QFAIL(QString("IIR Gaussian differs from the spatial one at %1,%2").arg(pt.x()).arg(pt.y()).toLatin1());
+    }
+}
+
+void KisConvolutionPainterTest::testParallelSpatial()
+{
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect applyRect(10, 20, 700, 650);
+
+    KisPaintDeviceSP src = new KisPaintDevice(cs);
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(QRect(0, 0, 800, 800));
+    src->setDefaultBounds(bounds);
+
+    srand(42);
+    KisSequentialIterator it(src, QRect(0, 0, 800, 800));
+    while (it.nextPixel()) {
+        quint8 *ptr = it.rawData();
+        for (int i = 0; i < 4; i++) {
+            ptr[i] = rand() % 256;
+        }
+    }
+
+    // a sparse kernel to check that zero weights are handled correctly
+    Eigen::Matrix<qreal, Eigen::Dynamic, Eigen::Dynamic> matrix(5, 5);
+    matrix <<
+        0, 0, 1, 0, 0,
+        0, 1, 2, 1, 0,
+        1, 2, -4, 2, 1,
+        0, 1, 2, 1, 0,
+        0, 0, 1, 0, 0;
+    KisConvolutionKernelSP kernel = KisConvolutionKernel::fromMatrix(matrix, 0.1, matrix.sum());
+
+    auto convolve = [&] (int numThreads) {
+        KisConvolutionPainter::setSpatialThreadsLimit(numThreads);
+
+        KisPaintDeviceSP dst = new KisPaintDevice(cs);
+        dst->setDefaultBounds(bounds);
+
+        KisConvolutionPainter painter(dst, KisConvolutionPainter::SPATIAL);
+        painter.applyMatrix(kernel, src, applyRect.topLeft(), applyRect.topLeft(), applyRect.size(), BORDER_REPEAT);
+
+        return dst->convertToQImage(0, applyRect);
+    };
+
+    const QImage sequentialResult = convolve(1);
+    const QImage parallelResult = convolve(4);
+
+    KisConvolutionPainter::setSpatialThreadsLimit(0);
+
+    QPoint pt;
+    if (!TestUtil::compareQImages(pt, sequentialResult, parallelResult)) {
+        sequentialResult.save("test_parallel_spatial_sequential.png");
+        parallelResult.save("test_parallel_spatial_parallel.png");
+        QFAIL(QString("Parallel convolution differs from the sequential one at %1,%2").arg(pt.x()).arg(pt.y()).toLatin1());
+    }
+}
+
+void KisConvolutionPainterTest::testFFTWPlanReuse()
+{
+    if (!KisConvolutionPainter::supportsFFTW()) {
+        QSKIP("FFTW is not available");
+    }
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->rgb8();
+    const QRect applyRect(10, 20, 300, 250);
+
+    KisPaintDeviceSP src = new KisPaintDevice(cs);
+    KisDefaultBoundsBaseSP bounds = new TestUtil::TestingTimedDefaultBounds(QRect(0, 0, 400, 400));
+    src->setDefaultBounds(bounds);
+
+    srand(42);
+    KisSequentialIterator it(src, QRect(0, 0, 400, 400));
+    while (it.nextPixel()) {
+        quint8 *ptr = it.rawData();
+        for (int i = 0; i < 4; i++) {
+            ptr[i] = rand() % 256;
+        }
+    }
+
+    KisConvolutionKernelSP kernel =
+        KisGaussianKernel::createUniform2DKernel(15, 15);
+
+    auto convolve = [&] () {
+        KisPaintDeviceSP dst = new KisPaintDevice(cs);
+        dst->setDefaultBounds(bounds);
+
+        KisConvolutionPainter painter(dst, KisConvolutionPainter::FFTW);
+        painter.applyMatrix(kernel, src, applyRect.topLeft(), applyRect.topLeft(), applyRect.size(), BORDER_REPEAT);
+
+        return dst->convertToQImage(0, applyRect);
+    };
+
+    // the first call creates estimated plans, the second one starts
+    // measuring the plans of the same size in the background, the
+    // following ones use either of them
+    const QImage reference = convolve();
+
+    QVector<QImage> results(8);
+    results[0] = convolve();
+    results[1] = convolve();
+
+    // the rest of the calls share the same plans concurrently
+    QtConcurrent::blockingMap(results.begin() + 2, results.end(),
+                              [&] (QImage &result) { result = convolve(); });
+
+    for (int i = 0; i < results.size(); i++) {
+        QPoint pt;
+        if (!TestUtil::compareQImages(pt, reference, results[i], 1)) {
+            reference.save("test_fftw_plan_reuse_reference.png");
+            results[i].save(QString("test_fftw_plan_reuse_result_%1.png").arg(i));
+            QFAIL(QString("Convolution #%1 differs from the first one at %2,%3").arg(i).arg(pt.x()).arg(pt.y()).toLatin1());
+        }
+    }
+}
+
 void KisConvolutionPainterTest::testDilate()
 {
     const KoColorSpace *cs = KoColorSpaceRegistry::instance()->alpha8();
@@ -47,6 +47,12 @@ private Q_SLOTS:
     void testGaussianDetailsSpatial();
     void testGaussianDetailsFFTW();
 
+    void testGaussianIIR();
+
+    void testParallelSpatial();
+
+    void testFFTWPlanReuse();
+
     void testDilate();
     void testErode();
 
@@ -12,6 +12,9 @@
 #include <KoHistogramProducer.h>
 #include "kis_paint_device.h"
 #include "kis_histogram.h"
+#include "KisTiledHistogram.h"
+#include "kis_iterator_ng.h"
+#include <KoColor.h>
 #include "kis_paint_layer.h"
 #include "kis_types.h"
 #include "testimage.h"
@@ -34,5 +37,75 @@ void KisHistogramTest::testCreation()
     }
 }
 
+namespace {
+void compareWithReference(const KisTiledHistogram &histogram, KisPaintDeviceSP dev, const QRect &bounds)
+{
+    const KoColorSpace *cs = dev->colorSpace();
+    QVector<QVector<quint32>> reference(cs->channelCount(), QVector<quint32>(256, 0));
+
+    KisSequentialConstIterator it(dev, bounds);
+    while (it.nextPixel()) {
+        for (int channel = 0; channel < int(cs->channelCount()); channel++) {
+            reference[channel][cs->scaleToU8(it.rawDataConst(), channel)]++;
+        }
+    }
+
+    QCOMPARE(histogram.count(), quint64(bounds.width() * bounds.height()));
+
+    for (int channel = 0; channel < int(cs->channelCount()); channel++) {
+        QCOMPARE(histogram.channelBins(channel), reference[channel]);
+    }
+}
+
+void updateDirtyTiles(KisTiledHistogram &histogram, KisPaintDeviceSP dev)
+{
+    Q_FOREACH (int tileIndex, histogram.dirtyTiles()) {
+        histogram.updateTile(dev, tileIndex);
+    }
+    QVERIFY(histogram.dirtyTiles().isEmpty());
+}
+}
+
+void KisHistogramTest::testTiledHistogram()
+{
+    const QRect bounds(0, 0, 600, 300);
+
+    QList<const KoColorSpace*> colorSpaces({KoColorSpaceRegistry::instance()->rgb8(),
+                                            KoColorSpaceRegistry::instance()->rgb16()});
+
+    Q_FOREACH (const KoColorSpace *cs, colorSpaces) {
+        KisPaintDeviceSP dev = new KisPaintDevice(cs);
+        dev->fill(QRect(0, 0, 300, 300), KoColor(Qt::red, cs));
+        dev->fill(QRect(300, 0, 300, 300), KoColor(QColor(10, 120, 230, 128), cs));
+
+        KisTiledHistogram histogram;
+        histogram.prepare(dev, bounds);
+
+        // 3x2 tiles of 256x256 pixels
+        QCOMPARE(histogram.dirtyTiles().size(), 6);
+
+        updateDirtyTiles(histogram, dev);
+        compareWithReference(histogram, dev, bounds);
+
+        const QRect changedRect(20, 30, 40, 50);
+        dev->fill(changedRect, KoColor(Qt::green, cs));
+        histogram.addDirtyRect(changedRect);
+
+        QCOMPARE(histogram.dirtyTiles(), QVector<int>({0}));
+
+        updateDirtyTiles(histogram, dev);
+        compareWithReference(histogram, dev, bounds);
+
+        KisTiledHistogram::ChannelStatistics stats = histogram.channelStatistics(cs->alphaPos());
+        QCOMPARE(stats.max, 255);
+
+        // preparing the same device once more should not reset the histogram
+        histogram.prepare(dev, bounds);
+        QVERIFY(histogram.dirtyTiles().isEmpty());
+
+        histogram.prepare(dev, bounds, 3);
+        QCOMPARE(histogram.dirtyTiles().size(), 6);
+    }
+}
 
 KISTEST_MAIN(KisHistogramTest)
@@ -659,4 +659,90 @@ void KisLayerStyleProjectionPlaneTest::testBlending()
     KIS_DUMP_DEVICE_2(originalBg, rc, "04_knockout", "dd");
 }
 
+void KisLayerStyleProjectionPlaneTest::testIncrementalUpdate()
+{
+    const QRect imageRect(0, 0, 300, 300);
+    const QRect rFillRect(40, 40, 150, 150);
+    const QRect addedRect(170, 170, 40, 40);
+    const QRect erasedRect(60, 60, 30, 30);
+
+    const KoColorSpace * cs = KoColorSpaceRegistry::instance()->rgb8();
+    KisImageSP image = new KisImage(0, imageRect.width(), imageRect.height(), cs, "styles test");
+
+    KisPaintLayerSP layer = new KisPaintLayer(image, "test", OPACITY_OPAQUE_U8);
+    image->addNode(layer);
+
+    KisPSDLayerStyleSP style(new KisPSDLayerStyle());
+
+    style->dropShadow()->setSize(15);
+    style->dropShadow()->setDistance(15);
+    style->dropShadow()->setOpacity(70);
+    style->dropShadow()->setEffectEnabled(true);
+
+    style->outerGlow()->setSize(15);
+    style->outerGlow()->setSpread(10);
+    style->outerGlow()->setOpacity(70);
+    style->outerGlow()->setEffectEnabled(true);
+
+    style->innerShadow()->setSize(10);
+    style->innerShadow()->setDistance(5);
+    style->innerShadow()->setOpacity(70);
+    style->innerShadow()->setEffectEnabled(true);
+
+    style->stroke()->setColor(KoColor::fromXML("<color channeldepth='U8'><sRGB r='0.0' g='0.0' b='1.0'/></color>"));
+    style->stroke()->setSize(3);
+    style->stroke()->setPosition(psd_stroke_outside);
+    style->stroke()->setEffectEnabled(true);
+
+    {
+        KisPainter gc(layer->paintDevice());
+        gc.setPaintColor(KoColor(Qt::red, cs));
+        gc.setFillStyle(KisPainter::FillStyleForegroundColor);
+        gc.paintEllipse(rFillRect);
+    }
+
+    KisLayerStyleProjectionPlane plane(layer.data(), style);
+    plane.recalculate(imageRect, layer);
+
+    auto checkAgainstFullUpdate = [&] (const QString &step) {
+        KisLayerStyleProjectionPlane referencePlane(layer.data(), style);
+        referencePlane.recalculate(imageRect, layer);
+
+        KisPaintDeviceSP incremental = new KisPaintDevice(cs);
+        {
+            KisPainter painter(incremental);
+            plane.apply(&painter, imageRect);
+        }
+
+        KisPaintDeviceSP reference = new KisPaintDevice(cs);
+        {
+            KisPainter painter(reference);
+            referencePlane.apply(&painter, imageRect);
+        }
+
+        QPoint pt;
+        if (!TestUtil::comparePaintDevices(pt, incremental, reference)) {
+            KIS_DUMP_DEVICE_2(incremental, imageRect, step + "_incremental", "incremental_update");
+            KIS_DUMP_DEVICE_2(reference, imageRect, step + "_reference", "incremental_update");
+            QFAIL(QString("Incremental update differs from the full one at %1, %2 (%3)")
+                  .arg(pt.x()).arg(pt.y()).arg(step).toLatin1());
+        }
+    };
+
+    // the source grows
+    layer->paintDevice()->fill(addedRect, KoColor(Qt::red, cs));
+    plane.recalculate(plane.changeRect(addedRect, KisLayer::N_FILTHY), layer);
+    checkAgainstFullUpdate("01_added");
+
+    // a hole appears in the source
+    layer->paintDevice()->clear(erasedRect);
+    plane.recalculate(plane.changeRect(erasedRect, KisLayer::N_FILTHY), layer);
+    checkAgainstFullUpdate("02_erased");
+
+    // the update covers much more than the changed area
+    layer->paintDevice()->fill(erasedRect, KoColor(Qt::red, cs));
+    plane.recalculate(imageRect, layer);
+    checkAgainstFullUpdate("03_refilled");
+}
+
 KISTEST_MAIN(KisLayerStyleProjectionPlaneTest)
@@ -247,4 +247,42 @@ void KisMaskSimilarityTest::testSoftRectMask()
     KisMaskSimilarityTester::runMaskGenTest(generator,RECT_SOFT);
 }
 
+void KisMaskSimilarityTest::testSpikedMasks()
+{
+    KisCubicCurve pointsCurve;
+    pointsCurve.fromString(QString("0,1;1,0"));
+
+    for (int spikes : {3, 5, 12}) {
+        {
+            KisCircleMaskGenerator generator(499.5, 0.2, 0.5, 0.5, spikes, true);
+            KisMaskSimilarityTester::runMaskGenTest(generator, DEFAULT);
+        }
+        {
+            KisGaussCircleMaskGenerator generator(499.5, 0.2, 1, 1, spikes, true);
+            KisMaskSimilarityTester::runMaskGenTest(generator, CIRC_GAUSS);
+        }
+        {
+            KisCurveCircleMaskGenerator generator(499.5, 0.2, 0.5, 0.5, spikes, pointsCurve, true);
+            KisMaskSimilarityTester::runMaskGenTest(generator, CIRC_SOFT);
+        }
+        {
+            KisRectangleMaskGenerator generator(499.5, 0.1, 0.5, 0.5, spikes, false);
+            KisMaskSimilarityTester::runMaskGenTest(generator, RECT);
+        }
+        {
+            KisGaussRectangleMaskGenerator generator(499.5, 0.2, 0.5, 0.2, spikes, true);
+            KisMaskSimilarityTester::runMaskGenTest(generator, RECT_GAUSS);
+        }
+        {
+            KisCurveRectangleMaskGenerator generator(499.5, 0.2, 0.5, 0.2, spikes, pointsCurve, true);
+            KisMaskSimilarityTester::runMaskGenTest(generator, RECT_SOFT);
+        }
+
+        if (QTest::currentTestFailed()) {
+            QWARN(QString("Failed with %1 spikes").arg(spikes).toLatin1());
+            return;
+        }
+    }
+}
+
 SIMPLE_TEST_MAIN(KisMaskSimilarityTest)
@@ -21,6 +21,8 @@ private Q_SLOTS:
     void testRectMask();
     void testGaussRectMask();
     void testSoftRectMask();
+
+    void testSpikedMasks();
 };
 
 #endif
@@ -284,6 +284,36 @@ void KisPaintDeviceTest::testColorSpaceConversion()
 }
 
 
+void KisPaintDeviceTest::testColorSpaceConversionParallel()
+{
+    QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
+    const KoColorSpace* srcCs = KoColorSpaceRegistry::instance()->rgb8();
+    const KoColorSpace* dstCs = KoColorSpaceRegistry::instance()->lab16();
+
+    KisPaintDeviceSP dev1 = new KisPaintDevice(srcCs);
+    dev1->convertFromQImage(image, 0);
+    dev1->moveTo(10, 10);   // Unalign with tile boundaries
+
+    KisPaintDeviceSP dev2 = new KisPaintDevice(*dev1);
+
+    KisPaintDevice::setColorSpaceConversionThreadsLimit(1);
+    dev1->convertTo(dstCs);
+
+    KisPaintDevice::setColorSpaceConversionThreadsLimit(4);
+    dev2->convertTo(dstCs);
+
+    KisPaintDevice::setColorSpaceConversionThreadsLimit(0);
+
+    QCOMPARE(dev2->exactBounds(), dev1->exactBounds());
+    QVERIFY(*dev2->colorSpace() == *dstCs);
+
+    QPoint pt;
+    if (!TestUtil::comparePaintDevices(pt, dev1, dev2)) {
+        QFAIL(QString("Parallel conversion differs from the serial one at %1,%2").arg(pt.x()).arg(pt.y()).toLatin1());
+    }
+}
+
+
 void KisPaintDeviceTest::testRoundtripConversion()
 {
     QImage image(QString(FILES_DATA_DIR) + '/' + "hakonepa.png");
@@ -2199,6 +2229,30 @@ void KisPaintDeviceTest::testCopyPaintDeviceWithFrames()
     QVERIFY(channel->keyframeAt(10));
 }
 
+void KisPaintDeviceTest::testHighBitDepthTileSize()
+{
+    KisImageConfig cfg(false);
+    const int oldTileSize = cfg.highBitDepthTileSize();
+
+    cfg.setHighBitDepthTileSize(128);
+
+    KisPaintDeviceSP dev8 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb8());
+    KisPaintDeviceSP dev16 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb16());
+
+    QCOMPARE(dev8->tileSize(), 64);
+    QCOMPARE(dev16->tileSize(), 128);
+
+    // the option is applied to new devices only
+    cfg.setHighBitDepthTileSize(64);
+
+    KisPaintDeviceSP newDev16 = new KisPaintDevice(KoColorSpaceRegistry::instance()->rgb16());
+
+    QCOMPARE(newDev16->tileSize(), 64);
+    QCOMPARE(dev16->tileSize(), 128);
+
+    cfg.setHighBitDepthTileSize(oldTileSize);
+}
+
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
@@ -32,6 +32,7 @@ private Q_SLOTS:
     void testMakeClone();
     void testBltPerformance();
     void testColorSpaceConversion();
+    void testColorSpaceConversionParallel();
     void testDeviceDuplication();
     void testTranslate();
     void testOpacity();
@@ -66,6 +67,8 @@ private Q_SLOTS:
     void testLazyFrameCreation();
     void testCopyPaintDeviceWithFrames();
 
+    void testHighBitDepthTileSize();
+
     void testCompositionAssociativity();
 
     void stressTestMemoryFragmentation();
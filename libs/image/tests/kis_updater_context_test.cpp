@@ -17,6 +17,7 @@
 
 #include "kis_merge_walker.h"
 #include "kis_updater_context.h"
+#include "KisWorkStealingExecutor.h"
 #include "kis_image.h"
 
 #include "scheduler_utils.h"
@@ -235,5 +236,99 @@ void KisUpdaterContextTest::stressTestExclusiveJobs()
              << "/" << NUM_CHECKS * NUM_JOBS;
 }
 
+class SpawningRunnable : public QRunnable
+{
+public:
+    SpawningRunnable(KisWorkStealingExecutor &executor, QAtomicInt &counter, int depth)
+        : m_executor(executor),
+          m_counter(counter),
+          m_depth(depth)
+    {
+    }
+
+    void run() override {
+        m_counter.ref();
+
+        // the children are pushed into the queue of the current worker
+        // and should be stolen by the other ones
+        for (int i = 0; i < m_depth; i++) {
+            m_executor.start(new SpawningRunnable(m_executor, m_counter, m_depth - 1));
+        }
+    }
+
+private:
+    KisWorkStealingExecutor &m_executor;
+    QAtomicInt &m_counter;
+    int m_depth;
+};
+
+class CurrentExecutorRunnable : public QRunnable
+{
+public:
+    CurrentExecutorRunnable(QAtomicPointer<KisWorkStealingExecutor> &result)
+        : m_result(result)
+    {
+    }
+
+    void run() override {
+        m_result.storeRelease(KisWorkStealingExecutor::currentExecutor());
+    }
+
+private:
+    QAtomicPointer<KisWorkStealingExecutor> &m_result;
+};
+
+void KisUpdaterContextTest::testWorkStealingExecutor()
+{
+    KisWorkStealingExecutor executor;
+    executor.setMaxThreadCount(4);
+    QCOMPARE(executor.maxThreadCount(), 4);
+
+    QAtomicInt counter;
+
+    // 1 + 6 + 6 * 5 + 6 * 5 * 4 + ... runnables in a single tree
+    const int depth = 6;
+    int expectedCount = 0;
+    for (int i = 0, product = 1; i <= depth; i++) {
+        expectedCount += product;
+        product *= depth - i;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        counter = 0;
+        executor.start(new SpawningRunnable(executor, counter, depth));
+        executor.waitForDone();
+        QCOMPARE(int(counter), expectedCount);
+    }
+
+    // the number of threads can be changed when the pool is idle
+    executor.setMaxThreadCount(2);
+    counter = 0;
+    executor.start(new SpawningRunnable(executor, counter, depth));
+    executor.waitForDone();
+    QCOMPARE(int(counter), expectedCount);
+
+    // ...and when the runnables are still in flight, then it waits for them
+    counter = 0;
+    for (int i = 0; i < 8; i++) {
+        executor.start(new SpawningRunnable(executor, counter, 0));
+    }
+    executor.setMaxThreadCount(3);
+    QCOMPARE(int(counter), 8);
+    QCOMPARE(executor.maxThreadCount(), 3);
+
+    // the same value is a noop
+    executor.setMaxThreadCount(3);
+    QCOMPARE(executor.maxThreadCount(), 3);
+
+    // the jobs can find the executor they are running in
+    QVERIFY(!KisWorkStealingExecutor::currentExecutor());
+
+    QAtomicPointer<KisWorkStealingExecutor> currentExecutor;
+    executor.start(new CurrentExecutorRunnable(currentExecutor));
+    executor.waitForDone();
+    QCOMPARE(currentExecutor.loadAcquire(), &executor);
+}
+
 KISTEST_MAIN(KisUpdaterContextTest)
 
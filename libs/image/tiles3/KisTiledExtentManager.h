@@ -55,6 +55,7 @@ class KRITAIMAGE_EXPORT KisTiledExtentManager
 
 public:
     KisTiledExtentManager();
+    KisTiledExtentManager(qint32 tileWidth, qint32 tileHeight);
 
     void notifyTileAdded(qint32 col, qint32 row);
     void notifyTileRemoved(qint32 col, qint32 row);
@@ -67,6 +68,9 @@ private:
     friend class KisTiledDataManagerTest;
 
 private:
+    const qint32 m_tileWidth;
+    const qint32 m_tileHeight;
+
     mutable QReadWriteLock m_extentLock;
     QRect m_currentExtent;
     Data m_colsData;
@@ -38,13 +38,11 @@ KisHLineIterator2::KisHLineIterator2(KisDataManager *dataManager, qint32 x, qint
     m_row = yToRow(m_y);
     m_yInTile = calcYInTile(m_y, m_row);
 
-    m_leftInLeftmostTile = m_left - m_leftCol * KisTileData::WIDTH;
+    m_leftInLeftmostTile = m_left - m_leftCol * m_tileWidth;
 
     m_tilesCacheSize = m_rightCol - m_leftCol + 1;
     m_tilesCache.resize(m_tilesCacheSize);
 
-    m_tileWidth = m_pixelSize * KisTileData::HEIGHT;
-
     // let's preallocate first row
     for (quint32 i = 0; i < m_tilesCacheSize; i++){
         fetchTileDataForCache(m_tilesCache[i], m_leftCol + i, m_row);
@@ -101,7 +99,7 @@ void KisHLineIterator2::nextRow()
     m_x = m_left;
     ++m_y;
 
-    if (++m_yInTile < KisTileData::HEIGHT) {
+    if (++m_yInTile < m_tileHeight) {
         /* do nothing, usual case */
     } else {
         ++m_row;
@@ -179,9 +177,9 @@ void KisHLineIterator2::switchToTile(qint32 xInTile)
     m_data = m_tilesCache[m_index].data;
     m_oldData = m_tilesCache[m_index].oldData;
 
-    int offset_row = m_pixelSize * (m_yInTile * KisTileData::WIDTH);
+    int offset_row = m_pixelSize * (m_yInTile * m_tileWidth);
     m_data += offset_row;
-    m_rightmostInTile = (m_leftCol + m_index + 1) * KisTileData::WIDTH - 1;
+    m_rightmostInTile = (m_leftCol + m_index + 1) * m_tileWidth - 1;
     int offset_col = m_pixelSize * xInTile;
     m_data  += offset_col;
     m_oldData += offset_row + offset_col;
@@ -124,7 +124,7 @@ void KisMementoManager::registerTileChange(KisTile *tile)
         m_index.addTile(mi);
 
         if(namedTransactionInProgress())
-            m_currentMemento->updateExtent(mi->col(), mi->row());
+            m_currentMemento->updateExtent(tile->extent());
     }
     else {
         mi->reset();
@@ -150,7 +150,7 @@ void KisMementoManager::registerTileDeleted(KisTile *tile)
         m_index.addTile(mi);
 
         if(namedTransactionInProgress())
-            m_currentMemento->updateExtent(mi->col(), mi->row());
+            m_currentMemento->updateExtent(tile->extent());
     }
     else {
         mi->reset();
@@ -12,6 +12,8 @@
 #include "kis_memento_manager.h"
 #include "kis_debug.h"
 
+#include <QHash>
+
 
 void KisTile::init(qint32 col, qint32 row,
                    KisTileData *defaultTileData, KisMementoManager* mm)
@@ -20,8 +22,11 @@ void KisTile::init(qint32 col, qint32 row,
     m_row = row;
     m_lockCounter = 0;
 
-    m_extent = QRect(m_col * KisTileData::WIDTH, m_row * KisTileData::HEIGHT,
-                     KisTileData::WIDTH, KisTileData::HEIGHT);
+    const qint32 tileWidth = defaultTileData->tileWidth();
+    const qint32 tileHeight = defaultTileData->tileHeight();
+
+    m_extent = QRect(m_col * tileWidth, m_row * tileHeight,
+                     tileWidth, tileHeight);
 
     m_tileData = defaultTileData;
     m_tileData->acquire();
@@ -38,22 +43,34 @@ KisTile::KisTile(qint32 col, qint32 row,
     init(col, row, defaultTileData, mm);
 }
 
+/**
+ * The tile data of \p rhs may be switched by the deduplicator at any
+ * moment, so it is fetched with an extra reference, which is dropped
+ * after init() has acquired the data.
+ */
+
 KisTile::KisTile(const KisTile& rhs, qint32 col, qint32 row, KisMementoManager* mm)
         : KisShared()
 {
-    init(col, row, rhs.tileData(), mm);
+    KisTileData *td = rhs.refTileData();
+    init(col, row, td, mm);
+    td->deref();
 }
 
 KisTile::KisTile(const KisTile& rhs, KisMementoManager* mm)
         : KisShared()
 {
-    init(rhs.col(), rhs.row(), rhs.tileData(), mm);
+    KisTileData *td = rhs.refTileData();
+    init(rhs.col(), rhs.row(), td, mm);
+    td->deref();
 }
 
 KisTile::KisTile(const KisTile& rhs)
         : KisShared()
 {
-    init(rhs.col(), rhs.row(), rhs.tileData(), rhs.m_mementoManager);
+    KisTileData *td = rhs.refTileData();
+    init(rhs.col(), rhs.row(), td, rhs.m_mementoManager);
+    td->deref();
 }
 
 KisTile::~KisTile()
@@ -204,6 +221,105 @@ inline void KisTile::safeReleaseOldTileData(KisTileData *td)
     }
 }
 
+KisTileData* KisTile::refTileData() const
+{
+    /**
+     * The old tile data is released in unblockSwapping()
+     * under the barrier lock only, so holding it is enough
+     * to guarantee the object is still alive.
+     */
+    QMutexLocker locker(&m_swapBarrierLock);
+    KisTileData *td = m_tileData;
+    td->ref();
+    return td;
+}
+
+bool KisTile::tryCalculateContentHash(uint &hash) const
+{
+    QMutexLocker locker(&m_swapBarrierLock);
+    if (m_lockCounter > 0) return false;
+
+    KisTileData *td = m_tileData;
+    if (!td->m_swapLock.tryLockForRead()) return false;
+
+    const bool result = td->data();
+
+    if (result) {
+        hash = qHashBits(td->data(), td->dataSize());
+    }
+
+    td->m_swapLock.unlock();
+
+    return result;
+}
+
+bool KisTile::tryMergeTileData(KisTileData *td)
+{
+    /**
+     * The tile data is switched the same way as COW does it: under
+     * the COW mutex, so that nobody else switches it concurrently,
+     * and with the change registered in the memento manager, so that
+     * the history refers to the new data.
+     */
+
+    if (!m_COWMutex.tryLock()) return false;
+
+    const bool result = trySwitchToEqualTileData(td);
+
+    if (result) {
+        KisMementoManager *mm = m_mementoManager.load();
+        if (mm) {
+            mm->registerTileChange(this);
+        }
+    }
+
+    m_COWMutex.unlock();
+
+    return result;
+}
+
+bool KisTile::trySwitchToEqualTileData(KisTileData *td)
+{
+    /**
+     * Holding the barrier lock with zero lock counter guarantees
+     * that nobody can access our tile data while we are switching
+     * it. Both tile datas should also be locked to avoid swapping
+     * them out. The candidate is locked in write mode, so nobody is
+     * writing into it either. After it is acquired by us, it becomes
+     * shared, so all the further writers will COW it.
+     */
+
+    QMutexLocker locker(&m_swapBarrierLock);
+    if (m_lockCounter > 0 || m_tileData == td) return false;
+
+    KisTileData *oldTileData = m_tileData;
+    if (oldTileData->pixelSize() != td->pixelSize() ||
+        oldTileData->tileWidth() != td->tileWidth() ||
+        oldTileData->tileHeight() != td->tileHeight()) return false;
+
+    if (!oldTileData->m_swapLock.tryLockForRead()) return false;
+
+    bool result = false;
+
+    if (oldTileData->data() && td->m_swapLock.tryLockForWrite()) {
+        if (td->data() && !memcmp(td->data(), oldTileData->data(), td->dataSize())) {
+            td->acquire();
+            result = true;
+        }
+
+        td->m_swapLock.unlock();
+    }
+
+    oldTileData->m_swapLock.unlock();
+
+    if (result) {
+        m_tileData = td;
+        oldTileData->release();
+    }
+
+    return result;
+}
+
 void KisTile::lockForRead() const
 {
 #ifdef DEAD_TILES_SANITY_CHECK
@@ -298,9 +414,13 @@ void KisTile::debugDumpTile()
     lockForRead();
     quint8 *data = this->data();
 
-    for (int i = 0; i < KisTileData::HEIGHT; i++) {
-        for (int j = 0; j < KisTileData::WIDTH; j++) {
-            dbgTiles << data[(i*KisTileData::WIDTH+j)*pixelSize()];
+    const qint32 tileWidth = m_tileData->tileWidth();
+    const qint32 tileHeight = m_tileData->tileHeight();
+    const qint32 pixelSize = m_tileData->pixelSize();
+
+    for (int i = 0; i < tileHeight; i++) {
+        for (int j = 0; j < tileWidth; j++) {
+            dbgTiles << data[(i * tileWidth + j) * pixelSize];
         }
     }
     unlockForRead();
@@ -110,6 +110,9 @@ public:
         m_nextTile = next;
     }
 
+    /**
+     * The pixel size of the tile data, see KisTileData::pixelSize()
+     */
     inline qint32 pixelSize() const {
         /* don't lock here as pixelSize is constant */
         return m_tileData->pixelSize();
@@ -119,6 +122,29 @@ public:
         return m_tileData;
     }
 
+    /**
+     * Returns the current tile data of the tile with an extra
+     * reference taken. Unlike tileData() it is safe to call while
+     * other threads are COW'ing the tile. The caller should
+     * deref() the tile data when it is not needed anymore.
+     */
+    KisTileData* refTileData() const;
+
+    /**
+     * Calculates a hash of the pixels of the tile. Fails if the tile
+     * is being accessed by someone or its data is swapped out.
+     * Used by KisTileDataDeduplicator.
+     */
+    bool tryCalculateContentHash(uint &hash) const;
+
+    /**
+     * Makes the tile share \p td instead of its own tile data, if
+     * their content is identical. Fails if either of the tile datas
+     * is being accessed or swapped out. The change is registered in the
+     * memento manager like a usual COW. Used by KisTileDataDeduplicator.
+     */
+    bool tryMergeTileData(KisTileData *td);
+
 private:
     void init(qint32 col, qint32 row,
               KisTileData *defaultTileData, KisMementoManager* mm);
@@ -128,6 +154,8 @@ private:
 
     inline void safeReleaseOldTileData(KisTileData *td);
 
+    bool trySwitchToEqualTileData(KisTileData *td);
+
 private:
     KisTileData *m_tileData;
     mutable QStack<KisTileData*> m_oldTileData;
@@ -8,18 +8,86 @@
 
 #include "kis_tile_data.h"
 #include "kis_tile_data_store.h"
+#include "kis_tile_data_arena.h"
 
 #include <kis_debug.h>
 
 #include <boost/pool/singleton_pool.hpp>
 #include "kis_tile_data_store_iterators.h"
 
-// BPP == bytes per pixel
-#define TILE_SIZE_4BPP (4 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
-#define TILE_SIZE_8BPP (8 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+namespace {
 
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_4BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 256, 4096> BoostPool4BPP;
-typedef boost::singleton_pool<KisTileData, TILE_SIZE_8BPP, boost::default_user_allocator_new_delete, boost::details::pool::default_mutex, 128, 2048> BoostPool8BPP;
+template <int dataSize, int nextSize, int maxSize>
+using ArenaPool = boost::singleton_pool<KisTileData, dataSize, KisTileDataArena, boost::details::pool::default_mutex, nextSize, maxSize>;
+
+/**
+ * Every pool starts with a 4 MiB block and grows up to 64 MiB blocks
+ */
+typedef ArenaPool<TILE_SIZE_4BPP, 256, 4096> BoostPool4BPP;
+typedef ArenaPool<TILE_SIZE_8BPP, 128, 2048> BoostPool8BPP;
+typedef ArenaPool<TILE_SIZE_16BPP, 64, 1024> BoostPool16BPP;
+
+/**
+ * The tiles of the scaled data managers are 4 or 16 times bigger (see
+ * KisTiledDataManager::isTileSizeSupported()). Some of their sizes match
+ * the pools above, the rest get the pools of their own.
+ */
+typedef ArenaPool<4 * TILE_SIZE_8BPP, 32, 512> BoostPool8BPPx4;
+typedef ArenaPool<4 * TILE_SIZE_16BPP, 16, 256> BoostPool16BPPx4;
+typedef ArenaPool<16 * TILE_SIZE_8BPP, 8, 128> BoostPool8BPPx16;
+typedef ArenaPool<16 * TILE_SIZE_16BPP, 4, 64> BoostPool16BPPx16;
+
+template <class T>
+struct PoolTag {
+    typedef T Pool;
+};
+
+/**
+ * Calls \p func with the tag of the pool the buffers of \p dataSize
+ * are cut from. Returns false if the buffers of this size are not pooled.
+ */
+template <typename Func>
+inline bool withPool(qint32 dataSize, Func func)
+{
+    switch (dataSize) {
+    case TILE_SIZE_4BPP:
+        func(PoolTag<BoostPool4BPP>());
+        return true;
+    case TILE_SIZE_8BPP:
+        func(PoolTag<BoostPool8BPP>());
+        return true;
+    case TILE_SIZE_16BPP:
+        func(PoolTag<BoostPool16BPP>());
+        return true;
+    case 4 * TILE_SIZE_8BPP:
+        func(PoolTag<BoostPool8BPPx4>());
+        return true;
+    case 4 * TILE_SIZE_16BPP:
+        func(PoolTag<BoostPool16BPPx4>());
+        return true;
+    case 16 * TILE_SIZE_8BPP:
+        func(PoolTag<BoostPool8BPPx16>());
+        return true;
+    case 16 * TILE_SIZE_16BPP:
+        func(PoolTag<BoostPool16BPPx16>());
+        return true;
+    default:
+        return false;
+    }
+}
+
+inline void purgeAllPools()
+{
+    BoostPool4BPP::purge_memory();
+    BoostPool8BPP::purge_memory();
+    BoostPool16BPP::purge_memory();
+    BoostPool8BPPx4::purge_memory();
+    BoostPool16BPPx4::purge_memory();
+    BoostPool8BPPx16::purge_memory();
+    BoostPool16BPPx16::purge_memory();
+}
+
+}
 
 const qint32 KisTileData::WIDTH = __TILE_DATA_WIDTH;
 const qint32 KisTileData::HEIGHT = __TILE_DATA_HEIGHT;
@@ -38,31 +106,37 @@ void SimpleCache::clear()
 
     while (m_4Pool.pop(ptr)) {
         BoostPool4BPP::free(ptr);
+        KisTileDataArena::addUsedSize(-TILE_SIZE_4BPP);
     }
 
     while (m_8Pool.pop(ptr)) {
         BoostPool8BPP::free(ptr);
+        KisTileDataArena::addUsedSize(-TILE_SIZE_8BPP);
     }
 
     while (m_16Pool.pop(ptr)) {
-        free(ptr);
+        BoostPool16BPP::free(ptr);
+        KisTileDataArena::addUsedSize(-TILE_SIZE_16BPP);
     }
 }
 
 
-KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store, bool checkFreeMemory)
+KisTileData::KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store,
+                         bool checkFreeMemory, qint32 tileWidth, qint32 tileHeight)
     : m_state(NORMAL),
       m_mementoFlag(0),
       m_age(0),
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(pixelSize),
+      m_tileWidth(tileWidth),
+      m_tileHeight(tileHeight),
       m_store(store)
 {
     if (checkFreeMemory) {
         m_store->checkFreeMemory();
     }
-    m_data = allocateData(m_pixelSize);
+    m_data = allocateData(dataSize());
 
     fillWithPixel(defPixel);
 }
@@ -86,14 +160,16 @@ KisTileData::KisTileData(const KisTileData& rhs, bool checkFreeMemory)
       m_usersCount(0),
       m_refCount(0),
       m_pixelSize(rhs.m_pixelSize),
+      m_tileWidth(rhs.m_tileWidth),
+      m_tileHeight(rhs.m_tileHeight),
       m_store(rhs.m_store)
 {
     if (checkFreeMemory) {
         m_store->checkFreeMemory();
     }
-    m_data = allocateData(m_pixelSize);
+    m_data = allocateData(dataSize());
 
-    memcpy(m_data, rhs.data(), m_pixelSize * WIDTH * HEIGHT);
+    memcpy(m_data, rhs.data(), dataSize());
 }
 
 
@@ -105,8 +181,9 @@ KisTileData::~KisTileData()
 void KisTileData::fillWithPixel(const quint8 *defPixel)
 {
     quint8 *it = m_data;
+    const int numPixels = m_tileWidth * m_tileHeight;
 
-    for (int i = 0; i < WIDTH * HEIGHT; i++, it += m_pixelSize) {
+    for (int i = 0; i < numPixels; i++, it += m_pixelSize) {
         memcpy(it, defPixel, m_pixelSize);
     }
 }
@@ -114,7 +191,7 @@ void KisTileData::fillWithPixel(const quint8 *defPixel)
 void KisTileData::releaseMemory()
 {
     if (m_data) {
-        freeData(m_data, m_pixelSize);
+        freeData(m_data, dataSize());
         m_data = 0;
     }
 
@@ -129,43 +206,39 @@ void KisTileData::releaseMemory()
 void KisTileData::allocateMemory()
 {
     Q_ASSERT(!m_data);
-    m_data = allocateData(m_pixelSize);
+    m_data = allocateData(dataSize());
 }
 
-quint8* KisTileData::allocateData(const qint32 pixelSize)
+quint8* KisTileData::allocateData(const qint32 dataSize)
 {
     quint8 *ptr = 0;
 
-    if (!m_cache.pop(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            ptr = (quint8*)BoostPool4BPP::malloc();
-            break;
-        case 8:
-            ptr = (quint8*)BoostPool8BPP::malloc();
-            break;
-        default:
-            ptr = (quint8*) malloc(pixelSize * WIDTH * HEIGHT);
-            break;
+    if (!m_cache.pop(dataSize, ptr)) {
+        const bool pooled = withPool(dataSize, [&ptr] (auto tag) {
+            ptr = (quint8*)decltype(tag)::Pool::malloc();
+        });
+
+        if (pooled) {
+            KisTileDataArena::addUsedSize(dataSize);
+        } else {
+            ptr = (quint8*) malloc(dataSize);
         }
     }
 
     return ptr;
 }
 
-void KisTileData::freeData(quint8* ptr, const qint32 pixelSize)
+void KisTileData::freeData(quint8* ptr, const qint32 dataSize)
 {
-    if (!m_cache.push(pixelSize, ptr)) {
-        switch (pixelSize) {
-        case 4:
-            BoostPool4BPP::free(ptr);
-            break;
-        case 8:
-            BoostPool8BPP::free(ptr);
-            break;
-        default:
+    if (!m_cache.push(dataSize, ptr)) {
+        const bool pooled = withPool(dataSize, [ptr] (auto tag) {
+            decltype(tag)::Pool::free(ptr);
+        });
+
+        if (pooled) {
+            KisTileDataArena::addUsedSize(-dataSize);
+        } else {
             free(ptr);
-            break;
         }
     }
 }
@@ -198,9 +271,7 @@ void KisTileData::releaseInternalPools()
             }
 
             // check if the tile data has actually been pooled
-            if (item->m_pixelSize != 4 &&
-                item->m_pixelSize != 8) {
-
+            if (!withPool(item->dataSize(), [] (auto) {})) {
                 continue;
             }
 
@@ -212,7 +283,7 @@ void KisTileData::releaseInternalPools()
                     break;
                 }
 
-                const int chunkSize = item->m_pixelSize * WIDTH * HEIGHT;
+                const int chunkSize = item->dataSize();
                 dataObjects << item;
                 memoryChunks << QByteArray((const char*)item->m_data, chunkSize);
             }
@@ -222,17 +293,17 @@ void KisTileData::releaseInternalPools()
         if (!failedToLock) {
             // purge the pools memory
             m_cache.clear();
-            BoostPool4BPP::purge_memory();
-            BoostPool8BPP::purge_memory();
+            purgeAllPools();
+            KisTileDataArena::resetUsedSize();
 
             auto it = dataObjects.begin();
             auto chunkIt = memoryChunks.constBegin();
 
             for (; it != dataObjects.end(); ++it, ++chunkIt) {
                 KisTileData *item = *it;
-                const int chunkSize = item->m_pixelSize * WIDTH * HEIGHT;
+                const int chunkSize = item->dataSize();
 
-                item->m_data = allocateData(item->m_pixelSize);
+                item->m_data = allocateData(chunkSize);
                 memcpy(item->m_data, chunkIt->data(), chunkSize);
 
                 item->m_swapLock.unlock();
@@ -25,13 +25,29 @@ inline quint8* KisTileData::data() const {
 
 void KisTileData::setData(const quint8 *data) {
     Q_ASSERT(m_data);
-    memcpy(m_data, data, m_pixelSize*WIDTH*HEIGHT);
+    memcpy(m_data, data, dataSize());
 }
 
 inline quint32 KisTileData::pixelSize() const {
     return m_pixelSize;
 }
 
+inline qint32 KisTileData::tileWidth() const {
+    return m_tileWidth;
+}
+
+inline qint32 KisTileData::tileHeight() const {
+    return m_tileHeight;
+}
+
+inline qint32 KisTileData::dataSize() const {
+    return m_pixelSize * m_tileWidth * m_tileHeight;
+}
+
+inline qint32 KisTileData::memoryMetric() const {
+    return dataSize() / (WIDTH * HEIGHT);
+}
+
 inline bool KisTileData::acquire() {
     /**
      * We need to ensure the clones in the stack are
@@ -0,0 +1,245 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_data_arena.h"
+
+#include <new>
+#include <QAtomicInteger>
+#include <QMutex>
+#include <QHash>
+#include <QDir>
+
+#include "kis_debug.h"
+
+#ifdef Q_OS_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct BlockInfo {
+    char *mappedAddress = 0;
+    KisTileDataArena::size_type mappedSize = 0;
+    bool mmapped = false;
+    bool hugePages = false;
+};
+
+struct ArenaState
+{
+    ArenaState()
+        : useHugePages(true),
+          interleaveNuma(false)
+    {
+        numNumaNodes = detectNumaNodes();
+    }
+
+    static int detectNumaNodes() {
+#ifdef Q_OS_LINUX
+        QDir dir("/sys/devices/system/node");
+        return qMax(1, dir.entryList(QStringList() << "node*", QDir::Dirs).size());
+#else
+        return 1;
+#endif
+    }
+
+    // the defaults match the ones of KisImageConfig
+    QAtomicInt useHugePages;
+    QAtomicInt interleaveNuma;
+    int numNumaNodes = 1;
+
+    QMutex lock;
+    QHash<char*, BlockInfo> blocks;
+};
+
+/**
+ * The pools are destroyed on exit in unspecified order relative to
+ * other static objects, so the state is never destroyed. The memory
+ * is reclaimed by the system anyway.
+ */
+ArenaState* arenaState()
+{
+    static ArenaState *state = new ArenaState();
+    return state;
+}
+
+QAtomicInteger<qint64> s_arenaSize;
+QAtomicInteger<qint64> s_hugePagesSize;
+QAtomicInteger<qint64> s_usedSize;
+QAtomicInteger<qint64> s_numBlocks;
+
+#ifdef Q_OS_LINUX
+
+const KisTileDataArena::size_type HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+inline KisTileDataArena::size_type alignUp(KisTileDataArena::size_type value,
+                                           KisTileDataArena::size_type alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+void interleaveOverNodes(char *ptr, KisTileDataArena::size_type size, int numNodes)
+{
+#ifdef SYS_mbind
+    // we don't link to libnuma, so just define the policy ourselves
+    const int MPOL_INTERLEAVE_POLICY = 3;
+
+    const int maxNodes = sizeof(unsigned long) * 8;
+    const unsigned long nodeMask =
+        numNodes >= maxNodes ? ~0UL : (1UL << numNodes) - 1;
+
+    if (syscall(SYS_mbind, ptr, size, MPOL_INTERLEAVE_POLICY,
+                &nodeMask, maxNodes, 0) != 0) {
+
+        warnTiles << "Failed to interleave tile arena over NUMA nodes";
+    }
+#else
+    Q_UNUSED(ptr);
+    Q_UNUSED(size);
+    Q_UNUSED(numNodes);
+#endif
+}
+
+bool mapBlock(KisTileDataArena::size_type bytes, bool useHugePages, BlockInfo &info)
+{
+    const KisTileDataArena::size_type pageSize = sysconf(_SC_PAGESIZE);
+    const KisTileDataArena::size_type alignment = useHugePages ? HUGE_PAGE_SIZE : pageSize;
+    const KisTileDataArena::size_type size = alignUp(bytes, alignment);
+
+    /**
+     * mmap() guarantees the alignment of a normal page only, so map
+     * a bigger block and trim it to the huge page boundaries
+     */
+    const KisTileDataArena::size_type reservedSize =
+        useHugePages ? size + HUGE_PAGE_SIZE : size;
+
+    char *ptr = (char*) mmap(0, reservedSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (ptr == MAP_FAILED) return false;
+
+    if (useHugePages) {
+        char *alignedPtr = (char*) alignUp(quintptr(ptr), HUGE_PAGE_SIZE);
+
+        const KisTileDataArena::size_type head = alignedPtr - ptr;
+        const KisTileDataArena::size_type tail = reservedSize - head - size;
+
+        if (head) munmap(ptr, head);
+        if (tail) munmap(alignedPtr + size, tail);
+
+        ptr = alignedPtr;
+
+#ifdef MADV_HUGEPAGE
+        madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+
+    info.mappedAddress = ptr;
+    info.mappedSize = size;
+    info.mmapped = true;
+    info.hugePages = useHugePages;
+
+    return true;
+}
+
+#endif /* Q_OS_LINUX */
+
+}
+
+char* KisTileDataArena::malloc(const size_type bytes)
+{
+    ArenaState *state = arenaState();
+
+    BlockInfo info;
+
+#ifdef Q_OS_LINUX
+    if (mapBlock(bytes, state->useHugePages.loadAcquire(), info)) {
+        if (state->interleaveNuma.loadAcquire() && state->numNumaNodes > 1) {
+            interleaveOverNodes(info.mappedAddress, info.mappedSize, state->numNumaNodes);
+        }
+    }
+#endif
+
+    if (!info.mappedAddress) {
+        info.mappedAddress = new (std::nothrow) char[bytes];
+        info.mappedSize = bytes;
+
+        if (!info.mappedAddress) return 0;
+    }
+
+    {
+        QMutexLocker l(&state->lock);
+        state->blocks.insert(info.mappedAddress, info);
+    }
+
+    s_arenaSize.fetchAndAddRelaxed(info.mappedSize);
+    s_numBlocks.fetchAndAddRelaxed(1);
+    if (info.hugePages) {
+        s_hugePagesSize.fetchAndAddRelaxed(info.mappedSize);
+    }
+
+    return info.mappedAddress;
+}
+
+void KisTileDataArena::free(char *const block)
+{
+    ArenaState *state = arenaState();
+
+    BlockInfo info;
+
+    {
+        QMutexLocker l(&state->lock);
+        info = state->blocks.take(block);
+    }
+
+    KIS_SAFE_ASSERT_RECOVER_RETURN(info.mappedAddress == block);
+
+    s_arenaSize.fetchAndSubRelaxed(info.mappedSize);
+    s_numBlocks.fetchAndSubRelaxed(1);
+    if (info.hugePages) {
+        s_hugePagesSize.fetchAndSubRelaxed(info.mappedSize);
+    }
+
+#ifdef Q_OS_LINUX
+    if (info.mmapped) {
+        munmap(block, info.mappedSize);
+        return;
+    }
+#endif
+
+    delete[] block;
+}
+
+void KisTileDataArena::setOptions(bool useHugePages, bool interleaveNuma)
+{
+    ArenaState *state = arenaState();
+
+    state->useHugePages.storeRelease(useHugePages);
+    state->interleaveNuma.storeRelease(interleaveNuma);
+}
+
+KisTileDataArena::Statistics KisTileDataArena::statistics()
+{
+    Statistics stats;
+
+    stats.arenaSize = s_arenaSize.loadAcquire();
+    stats.hugePagesSize = s_hugePagesSize.loadAcquire();
+    stats.usedSize = s_usedSize.loadAcquire();
+    stats.numBlocks = s_numBlocks.loadAcquire();
+
+    return stats;
+}
+
+void KisTileDataArena::addUsedSize(qint64 value)
+{
+    s_usedSize.fetchAndAddRelaxed(value);
+}
+
+void KisTileDataArena::resetUsedSize()
+{
+    s_usedSize.storeRelease(0);
+}
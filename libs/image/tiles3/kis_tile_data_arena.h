@@ -0,0 +1,75 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILE_DATA_ARENA_H_
+#define KIS_TILE_DATA_ARENA_H_
+
+#include <cstddef>
+#include <QtGlobal>
+
+#include "kritaimage_export.h"
+
+/**
+ * The allocator of the big memory blocks the tile data pools are
+ * cut from. It implements boost's UserAllocator concept, so it is
+ * passed directly to the boost::singleton_pool'ed allocators of
+ * KisTileData.
+ *
+ * On Linux the blocks are mapped with mmap() and aligned to the
+ * size of a huge page, so the kernel can back them with transparent
+ * huge pages. That reduces TLB misses when the updater threads walk
+ * over big paint devices.
+ *
+ * NUMA placement is controlled by KisImageConfig::tileArenaInterleaveNuma().
+ * By default the kernel's first-touch policy is used, that is the
+ * memory is placed on the node of the thread that initializes the
+ * tile first. When interleaving is enabled, the pages of every block
+ * are spread evenly over all the nodes, so that the threads of every
+ * socket see the same average latency. It is usually better for the
+ * projections that are composited by all the threads of the machine.
+ *
+ * On other platforms the blocks are allocated with operator new.
+ */
+class KRITAIMAGE_EXPORT KisTileDataArena
+{
+public:
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    static char* malloc(const size_type bytes);
+    static void free(char *const block);
+
+    /**
+     * Sets the options of the arena. KisTileDataStore passes them
+     * from KisImageConfig on initialization, so the allocator itself
+     * never touches the config. Only the blocks allocated after the
+     * call are affected.
+     */
+    static void setOptions(bool useHugePages, bool interleaveNuma);
+
+    struct Statistics {
+        /// the total size of the blocks allocated by the arena
+        qint64 arenaSize = 0;
+        /// the part of arenaSize that is advised to use huge pages
+        qint64 hugePagesSize = 0;
+        /// the size of the tiles' buffers cut from the blocks
+        qint64 usedSize = 0;
+        /// the number of blocks allocated by the arena
+        qint64 numBlocks = 0;
+    };
+
+    static Statistics statistics();
+
+    /**
+     * Used by KisTileData to keep track of the number of bytes
+     * actually used by the tiles. The rest of the arena is
+     * fragmentation of the pools.
+     */
+    static void addUsedSize(qint64 value);
+    static void resetUsedSize();
+};
+
+#endif /* KIS_TILE_DATA_ARENA_H_ */
@@ -0,0 +1,224 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_tile_data_deduplicator.h"
+
+#include <QGlobalStatic>
+
+#include "kis_tiled_data_manager.h"
+#include "kis_tile_data.h"
+#include "kis_tile.h"
+#include "kis_debug.h"
+#include "kis_image_config.h"
+
+Q_GLOBAL_STATIC(KisTileDataDeduplicator, s_instance)
+
+namespace {
+
+/**
+ * The number of tiles processed while holding the lock of the data
+ * manager, that is about 1 MiB of RGBA8 pixels
+ */
+const int tilesPerChunk = 64;
+
+}
+
+KisTileDataDeduplicator::KisTileDataDeduplicator()
+    : m_enabled(KisImageConfig(true).tileDeduplicationEnabled())
+{
+}
+
+KisTileDataDeduplicator* KisTileDataDeduplicator::instance()
+{
+    return s_instance;
+}
+
+void KisTileDataDeduplicator::setEnabled(bool value)
+{
+    m_enabled.storeRelease(value);
+}
+
+bool KisTileDataDeduplicator::isEnabled() const
+{
+    return m_enabled.loadAcquire();
+}
+
+bool KisTileDataDeduplicator::registerDataManager(KisTiledDataManager *dm)
+{
+    if (!isEnabled()) return false;
+
+    QMutexLocker l(&m_lock);
+    m_dataManagers.insert(dm);
+    return true;
+}
+
+void KisTileDataDeduplicator::unregisterDataManager(KisTiledDataManager *dm)
+{
+    QMutexLocker l(&m_lock);
+    m_dataManagers.remove(dm);
+
+    /**
+     * The tiles of the data manager are still referenced by the pass,
+     * so we should wait until it releases them. The pass checks the
+     * cancellation flag after every chunk, so it doesn't take long.
+     */
+    if (m_currentDataManager == dm) {
+        m_currentDataManagerCancelled = true;
+
+        while (m_currentDataManager == dm) {
+            m_processingFinished.wait(&m_lock);
+        }
+    }
+}
+
+KisTileDataDeduplicator::Statistics KisTileDataDeduplicator::statistics() const
+{
+    QMutexLocker l(&m_statisticsLock);
+    return m_statistics;
+}
+
+int KisTileDataDeduplicator::deduplicate()
+{
+    QMutexLocker passLocker(&m_passLock);
+
+    ContentIndex index;
+    int numMerged = 0;
+    qint64 releasedMemory = 0;
+
+    QList<KisTiledDataManager*> dataManagers;
+
+    {
+        QMutexLocker l(&m_lock);
+        dataManagers = m_dataManagers.values();
+    }
+
+    Q_FOREACH (KisTiledDataManager *dm, dataManagers) {
+        {
+            QMutexLocker l(&m_lock);
+
+            // the data manager might have been destroyed after the snapshot
+            if (!m_dataManagers.contains(dm)) continue;
+
+            m_currentDataManager = dm;
+            m_currentDataManagerCancelled = false;
+        }
+
+        const int tileDataSize = dm->pixelSize() * dm->tileWidth() * dm->tileHeight();
+        int merged = 0;
+
+        {
+            TilesList tiles;
+
+            if (fetchTiles(dm, &tiles)) {
+                for (int i = 0; i < tiles.size(); i += tilesPerChunk) {
+                    {
+                        QMutexLocker l(&m_lock);
+                        if (m_currentDataManagerCancelled) break;
+                    }
+
+                    merged += deduplicateTiles(dm, tiles, i,
+                                               qMin(i + tilesPerChunk, tiles.size()),
+                                               index);
+                }
+            }
+
+            // the tiles should be released while the data manager is alive
+        }
+
+        {
+            QMutexLocker l(&m_lock);
+            m_currentDataManager = nullptr;
+            m_processingFinished.wakeAll();
+        }
+
+        numMerged += merged;
+        releasedMemory += qint64(merged) * tileDataSize;
+    }
+
+    // the candidates were ref'ed when added into the index
+    Q_FOREACH (KisTileData *td, index) {
+        td->deref();
+    }
+
+    if (numMerged) {
+        QMutexLocker l(&m_statisticsLock);
+        m_statistics.numMergedTiles += numMerged;
+        m_statistics.releasedMemory += releasedMemory;
+    }
+
+    return numMerged;
+}
+
+bool KisTileDataDeduplicator::fetchTiles(KisTiledDataManager *dm, TilesList *tiles)
+{
+    /**
+     * Don't stall the painting, the data manager will be processed
+     * in the next pass
+     */
+    if (!dm->m_lock.tryLockForWrite()) return false;
+
+    tiles->reserve(dm->m_hashTable->numTiles());
+
+    {
+        KisTileHashTableIterator iter(dm->m_hashTable);
+        KisTileSP tile;
+
+        while ((tile = iter.tile())) {
+            tiles->append(tile);
+            iter.next();
+        }
+    }
+
+    dm->m_lock.unlock();
+
+    return true;
+}
+
+int KisTileDataDeduplicator::deduplicateTiles(KisTiledDataManager *dm, const TilesList &tiles,
+                                              int begin, int end, ContentIndex &index)
+{
+    /**
+     * The lock is released between the chunks, so the data manager is
+     * never blocked for longer than hashing of a single chunk takes.
+     * The tiles that have been removed from the data manager in the
+     * meantime are still alive, merging them is harmless.
+     */
+    if (!dm->m_lock.tryLockForWrite()) return 0;
+
+    int numMerged = 0;
+
+    for (int i = begin; i < end; i++) {
+        const KisTileSP &tile = tiles[i];
+        uint hash = 0;
+
+        if (!tile->tryCalculateContentHash(hash)) continue;
+
+        bool merged = false;
+
+        ContentIndex::iterator it = index.find(hash);
+        for (; it != index.end() && it.key() == hash; ++it) {
+            // the tiles might already be shared via bitBlt()
+            if (it.value() == tile->tileData()) {
+                merged = true;
+                break;
+            }
+
+            if (tile->tryMergeTileData(it.value())) {
+                merged = true;
+                numMerged++;
+                break;
+            }
+        }
+
+        if (!merged) {
+            index.insert(hash, tile->refTileData());
+        }
+    }
+
+    dm->m_lock.unlock();
+
+    return numMerged;
+}
@@ -0,0 +1,119 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_TILE_DATA_DEDUPLICATOR_H_
+#define KIS_TILE_DATA_DEDUPLICATOR_H_
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSet>
+#include <QHash>
+#include <QVector>
+#include <QWaitCondition>
+
+#include "kis_shared_ptr.h"
+
+#include "kritaimage_export.h"
+
+class KisTiledDataManager;
+class KisTileData;
+class KisTile;
+
+/**
+ * Finds the tiles with identical content in all the data managers
+ * of the application and makes them share a single KisTileData
+ * object. The shared data is then copied-on-write as usual, when
+ * one of the tiles is changed.
+ *
+ * It helps when the image has a lot of identical pixels split into
+ * different paint devices, e.g. duplicated layers that were only
+ * partially edited or the frames of an animation that differ in a
+ * small area only.
+ *
+ * The pass is run by KisTileDataPooler from time to time when
+ * enabled with KisImageConfig::tileDeduplicationEnabled(). All the
+ * locks are taken in a "try" mode, so the tiles that are being
+ * accessed at the moment are just skipped. The tiles of a data
+ * manager are processed in small chunks, so its lock is never held
+ * for long.
+ */
+class KRITAIMAGE_EXPORT KisTileDataDeduplicator
+{
+public:
+    KisTileDataDeduplicator();
+
+    static KisTileDataDeduplicator* instance();
+
+    /**
+     * The data managers are registered only while the deduplication is
+     * enabled, so the managers created before enabling it are not
+     * processed.
+     */
+    void setEnabled(bool value);
+    bool isEnabled() const;
+
+    /**
+     * \return true if the data manager has been registered and
+     * unregisterDataManager() should be called on its destruction
+     */
+    bool registerDataManager(KisTiledDataManager *dm);
+
+    /**
+     * Removes the data manager from the list. If the data manager is
+     * being processed at the moment, the pass is cancelled and the call
+     * waits until the current chunk of tiles is finished.
+     */
+    void unregisterDataManager(KisTiledDataManager *dm);
+
+    struct Statistics {
+        /// the total number of tiles merged since the application start
+        qint64 numMergedTiles = 0;
+        /// the total amount of memory released by merging
+        qint64 releasedMemory = 0;
+    };
+
+    Statistics statistics() const;
+
+    /**
+     * Runs a single pass of deduplication over all the registered
+     * data managers.
+     *
+     * \return the number of tiles merged in this pass
+     */
+    int deduplicate();
+
+private:
+    typedef QMultiHash<uint, KisTileData*> ContentIndex;
+    typedef QVector<KisSharedPtr<KisTile>> TilesList;
+
+    bool fetchTiles(KisTiledDataManager *dm, TilesList *tiles);
+    int deduplicateTiles(KisTiledDataManager *dm, const TilesList &tiles,
+                         int begin, int end, ContentIndex &index);
+
+private:
+    QAtomicInt m_enabled;
+
+    /**
+     * Serializes the passes, they may be started by the pooler and by
+     * the user of the class concurrently
+     */
+    QMutex m_passLock;
+
+    /**
+     * Guards the list of the data managers and the currently processed
+     * one. It is never held while processing the tiles.
+     */
+    QMutex m_lock;
+    QWaitCondition m_processingFinished;
+    QSet<KisTiledDataManager*> m_dataManagers;
+    KisTiledDataManager *m_currentDataManager = nullptr;
+    bool m_currentDataManagerCancelled = false;
+
+    mutable QMutex m_statisticsLock;
+    Statistics m_statistics;
+};
+
+#endif /* KIS_TILE_DATA_DEDUPLICATOR_H_ */
@@ -24,6 +24,11 @@ class KisTileDataStore;
 #define __TILE_DATA_WIDTH 64
 #define __TILE_DATA_HEIGHT 64
 
+// BPP == bytes per pixel of a default sized tile
+#define TILE_SIZE_4BPP (4 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+#define TILE_SIZE_8BPP (8 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+#define TILE_SIZE_16BPP (16 * __TILE_DATA_WIDTH * __TILE_DATA_HEIGHT)
+
 typedef KisLocklessStack<KisTileData*> KisTileDataCache;
 
 typedef QLinkedList<KisTileData*> KisTileDataList;
@@ -37,17 +42,17 @@ public:
     SimpleCache() = default;
     ~SimpleCache();
 
-    bool push(int pixelSize, quint8 *&ptr)
+    bool push(int dataSize, quint8 *&ptr)
     {
         QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
+        switch (dataSize) {
+        case TILE_SIZE_4BPP:
             m_4Pool.push(ptr);
             break;
-        case 8:
+        case TILE_SIZE_8BPP:
             m_8Pool.push(ptr);
             break;
-        case 16:
+        case TILE_SIZE_16BPP:
             m_16Pool.push(ptr);
             break;
         default:
@@ -57,15 +62,15 @@ public:
         return true;
     }
 
-    bool pop(int pixelSize, quint8 *&ptr)
+    bool pop(int dataSize, quint8 *&ptr)
     {
         QReadLocker l(&m_cacheLock);
-        switch (pixelSize) {
-        case 4:
+        switch (dataSize) {
+        case TILE_SIZE_4BPP:
             return m_4Pool.pop(ptr);
-        case 8:
+        case TILE_SIZE_8BPP:
             return m_8Pool.pop(ptr);
-        case 16:
+        case TILE_SIZE_16BPP:
             return m_16Pool.pop(ptr);
         default:
             return false;
@@ -88,7 +93,9 @@ private:
 class KRITAIMAGE_EXPORT KisTileData
 {
 public:
-    KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store, bool checkFreeMemory = true);
+    KisTileData(qint32 pixelSize, const quint8 *defPixel, KisTileDataStore *store,
+                bool checkFreeMemory = true,
+                qint32 tileWidth = WIDTH, qint32 tileHeight = HEIGHT);
 
 private:
     KisTileData(const KisTileData& rhs, bool checkFreeMemory = true);
@@ -107,8 +114,31 @@ public:
      */
     inline quint8* data() const;
     inline void setData(const quint8 *data);
+
     inline quint32 pixelSize() const;
 
+    /**
+     * The dimensions of the tile, the tile data belongs to. They are
+     * WIDTH x HEIGHT unless the data manager uses bigger tiles.
+     */
+    inline qint32 tileWidth() const;
+    inline qint32 tileHeight() const;
+
+    /**
+     * The size of the data in bytes,
+     * pixelSize() * tileWidth() * tileHeight()
+     */
+    inline qint32 dataSize() const;
+
+    /**
+     * The size of the data in the units of the memory metric of the
+     * store, that is, dataSize() / (WIDTH * HEIGHT). For the tiles
+     * of the usual size it is equal to the pixel size.
+     *
+     * \see KisTileDataStore::memoryMetric()
+     */
+    inline qint32 memoryMetric() const;
+
     /**
      * Increments usersCount of a TD and refs shared pointer counter
      * Used by KisTile for COW
@@ -211,8 +241,8 @@ public:
 private:
     void fillWithPixel(const quint8 *defPixel);
 
-    static quint8* allocateData(const qint32 pixelSize);
-    static void freeData(quint8 *ptr, const qint32 pixelSize);
+    static quint8* allocateData(const qint32 dataSize);
+    static void freeData(quint8 *ptr, const qint32 dataSize);
 private:
     friend class KisTileDataPooler;
     friend class KisTileDataPoolerTest;
@@ -226,6 +256,7 @@ private:
 private:
     friend class KisTile;
     friend class KisTileDataStore;
+    friend class KisSwappedDataStore;
 
     friend class KisTileDataStoreIterator;
     friend class KisTileDataStoreReverseIterator;
@@ -302,6 +333,8 @@ private:
 
 
     qint32 m_pixelSize;
+    qint32 m_tileWidth;
+    qint32 m_tileHeight;
     //qint32 m_timeStamp;
 
     KisTileDataStore *m_store;
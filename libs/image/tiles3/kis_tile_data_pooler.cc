@@ -12,12 +12,14 @@
 #include "kis_debug.h"
 #include "kis_tile_data_pooler.h"
 #include "kis_image_config.h"
+#include "kis_tile_data_deduplicator.h"
 
 
 const qint32 KisTileDataPooler::MAX_NUM_CLONES = 16;
 const qint32 KisTileDataPooler::MAX_TIMEOUT = 60000; // 01m00s
 const qint32 KisTileDataPooler::MIN_TIMEOUT = 100; // 00m00.100s
 const qint32 KisTileDataPooler::TIMEOUT_FACTOR = 2;
+const qint32 KisTileDataPooler::DEDUPLICATION_INTERVAL = 10000; // 00m10s
 
 //#define DEBUG_POOLER
 
@@ -203,11 +205,31 @@ void KisTileDataPooler::run()
 
         m_store->endIteration(iter);
 
+        tryDeduplicateTiles();
+
         DEBUG_TILE_STATISTICS();
         DEBUG_SIMPLE_ACTION("cycle finished");
     }
 }
 
+void KisTileDataPooler::tryDeduplicateTiles()
+{
+    if (!KisTileDataDeduplicator::instance()->isEnabled()) return;
+
+    /**
+     * The pass hashes every tile in the memory, so it should not be
+     * run on every cycle of the pooler
+     */
+    if (m_deduplicationTimer.isValid() &&
+        m_deduplicationTimer.elapsed() < DEDUPLICATION_INTERVAL) {
+
+        return;
+    }
+
+    KisTileDataDeduplicator::instance()->deduplicate();
+    m_deduplicationTimer.start();
+}
+
 void KisTileDataPooler::forceUpdateMemoryStats()
 {
     KIS_SAFE_ASSERT_RECOVER_RETURN(!isRunning());
@@ -249,11 +271,11 @@ qint64 KisTileDataPooler::lastHistoricalMemoryMetric() const
 }
 
 inline int KisTileDataPooler::clonesMetric(KisTileData *td, int numClones) {
-    return numClones * td->pixelSize();
+    return numClones * td->memoryMetric();
 }
 
 inline int KisTileDataPooler::clonesMetric(KisTileData *td) {
-    return td->m_clonesStack.size() * td->pixelSize();
+    return td->m_clonesStack.size() * td->memoryMetric();
 }
 
 inline void KisTileDataPooler::tryFreeOrphanedClones(KisTileData *td)
@@ -314,9 +336,9 @@ void KisTileDataPooler::getLists(Iter *iter,
 
         // statistics gathering
         if (item->historical()) {
-            statHistoricalMemory += item->pixelSize();
+            statHistoricalMemory += item->memoryMetric();
         } else {
-            statRealMemory += item->pixelSize();
+            statRealMemory += item->memoryMetric();
         }
     }
 
@@ -405,4 +427,5 @@ void KisTileDataPooler::debugTileStatistics()
 void KisTileDataPooler::testingRereadConfig()
 {
     m_memoryLimit = MiB_TO_METRIC(KisImageConfig(true).poolLimit());
+    KisTileDataDeduplicator::instance()->setEnabled(KisImageConfig(true).tileDeduplicationEnabled());
 }
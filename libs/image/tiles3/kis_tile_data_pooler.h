@@ -9,6 +9,7 @@
 #include <QObject>
 #include <QThread>
 #include <QSemaphore>
+#include <QElapsedTimer>
 
 #include "kritaimage_export.h"
 
@@ -46,11 +47,13 @@ protected:
     static const qint32 MAX_TIMEOUT;
     static const qint32 MIN_TIMEOUT;
     static const qint32 TIMEOUT_FACTOR;
+    static const qint32 DEDUPLICATION_INTERVAL;
 
     void waitForWork();
     qint32 numClonesNeeded(KisTileData *td) const;
     void cloneTileData(KisTileData *td, qint32 numClones) const;
     void run() override;
+    void tryDeduplicateTiles();
 
     inline int clonesMetric(KisTileData *td, int numClones);
     inline int clonesMetric(KisTileData *td);
@@ -83,6 +86,7 @@ protected:
     qint32 m_lastPoolMemoryMetric;
     qint32 m_lastRealMemoryMetric;
     qint32 m_lastHistoricalMemoryMetric;
+    QElapsedTimer m_deduplicationTimer;
 };
 
 
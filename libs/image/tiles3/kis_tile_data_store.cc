@@ -8,10 +8,13 @@
 // to disable assert when the leak tracker is active
 #include "config-memory-leak-tracker.h"
 
+#include <QElapsedTimer>
 #include <QGlobalStatic>
 
 #include "kis_tile_data_store.h"
 #include "kis_tile_data.h"
+#include "kis_tile_data_arena.h"
+#include "kis_image_config.h"
 #include "kis_debug.h"
 
 #include "kis_tile_data_store_iterators.h"
@@ -58,17 +61,22 @@ qint64 __preclone_miss_age = 0;
 KisTileDataStore::KisTileDataStore()
     : m_pooler(this),
       m_swapper(this),
+      m_prefetcher(this),
       m_numTiles(0),
       m_memoryMetric(0),
       m_counter(1),
       m_clockIndex(1)
 {
+    readArenaConfig();
+
     m_pooler.start();
     m_swapper.start();
+    m_prefetcher.start(QThread::LowPriority);
 }
 
 KisTileDataStore::~KisTileDataStore()
 {
+    m_prefetcher.terminatePrefetcher();
     m_pooler.terminatePooler();
     m_swapper.terminateSwapper();
 
@@ -100,6 +108,22 @@ KisTileDataStore::MemoryStatistics KisTileDataStore::memoryStatistics()
 
     stats.swapSize = m_swappedStore.totalMemoryMetric() * metricCoeff;
 
+    const KisMemoryWindow::Statistics swapFileStats = m_swappedStore.swapFileStatistics();
+    stats.swapFileSize = swapFileStats.fileSize;
+    stats.swapMappedSize = swapFileStats.mappedSize;
+    stats.swapWindowHits = swapFileStats.numHits;
+    stats.swapWindowMisses = swapFileStats.numMisses;
+
+    const KisSwappedDataStore::CompressedTierStatistics compressedStats =
+        m_swappedStore.compressedTierStatistics();
+    stats.compressedSwapSize = compressedStats.compressedSize;
+    stats.compressedSwapDataSize = compressedStats.memoryMetric * metricCoeff;
+
+    const KisTileDataArena::Statistics arenaStats = KisTileDataArena::statistics();
+    stats.arenaSize = arenaStats.arenaSize;
+    stats.arenaUsedSize = arenaStats.usedSize;
+    stats.arenaHugePagesSize = arenaStats.hugePagesSize;
+
     return stats;
 }
 
@@ -125,7 +149,7 @@ inline void KisTileDataStore::registerTileDataImp(KisTileData *td)
     m_tileDataMap.getGC().unlockRawPointerAccess();
 
     m_numTiles.ref();
-    m_memoryMetric += td->pixelSize();
+    m_memoryMetric += td->memoryMetric();
 }
 
 void KisTileDataStore::registerTileData(KisTileData *td)
@@ -151,7 +175,7 @@ inline void KisTileDataStore::unregisterTileDataImp(KisTileData *td)
     td->m_tileNumber = -1;
     m_tileDataMap.erase(index);
     m_numTiles.deref();
-    m_memoryMetric -= td->pixelSize();
+    m_memoryMetric -= td->memoryMetric();
 
     m_tileDataMap.getGC().unlockRawPointerAccess();
 }
@@ -162,9 +186,9 @@ void KisTileDataStore::unregisterTileData(KisTileData *td)
     unregisterTileDataImp(td);
 }
 
-KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *defPixel)
+KisTileData *KisTileDataStore::allocTileData(qint32 pixelSize, const quint8 *defPixel, qint32 tileWidth, qint32 tileHeight)
 {
-    KisTileData *td = new KisTileData(pixelSize, defPixel, this);
+    KisTileData *td = new KisTileData(pixelSize, defPixel, this, true, tileWidth, tileHeight);
     registerTileData(td);
     return td;
 }
@@ -361,8 +385,16 @@ void KisTileDataStore::debugClear()
     m_memoryMetric = 0;
 }
 
+void KisTileDataStore::readArenaConfig()
+{
+    KisImageConfig config(true);
+    KisTileDataArena::setOptions(config.tileArenaUseHugePages(),
+                                 config.tileArenaInterleaveNuma());
+}
+
 void KisTileDataStore::testingRereadConfig()
 {
+    readArenaConfig();
     m_pooler.testingRereadConfig();
     m_swapper.testingRereadConfig();
     kickPooler();
@@ -377,3 +409,16 @@ void KisTileDataStore::testingResumePooler()
 {
     m_pooler.start();
 }
+
+bool KisTileDataStore::testingWaitForPrefetcher(int timeout)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (m_prefetcher.numPendingTiles() > 0) {
+        if (timer.elapsed() > timeout) return false;
+        QThread::msleep(1);
+    }
+
+    return true;
+}
@@ -15,6 +15,7 @@
 
 #include "kis_tile_data_pooler.h"
 #include "swap/kis_tile_data_swapper.h"
+#include "swap/kis_tile_data_prefetcher.h"
 #include "swap/kis_swapped_data_store.h"
 #include "3rdparty/lock_free_map/concurrent_map.h"
 
@@ -42,6 +43,18 @@ public:
         qint64 poolSize;
 
         qint64 swapSize;
+
+        qint64 swapFileSize;
+        qint64 swapMappedSize;
+        qint64 swapWindowHits;
+        qint64 swapWindowMisses;
+
+        qint64 compressedSwapSize;
+        qint64 compressedSwapDataSize;
+
+        qint64 arenaSize;
+        qint64 arenaUsedSize;
+        qint64 arenaHugePagesSize;
     };
 
     MemoryStatistics memoryStatistics();
@@ -77,6 +90,26 @@ public:
         return m_memoryMetric.loadAcquire();
     }
 
+    /**
+     * Returns the metric of the memory occupied by the tiles in
+     * memory *and* by the compressed swap tier, which lives
+     * in memory as well. The swapper checks the limits against it.
+     */
+    inline qint64 residentMemoryMetric() const
+    {
+        return memoryMetric() + m_swappedStore.compressedTierMemoryMetric();
+    }
+
+    /**
+     * Moves the compressed swapped tiles into the swap file
+     * to free \a metric of memory
+     * \see KisSwappedDataStore::spillCompressedTier()
+     */
+    inline qint64 spillCompressedSwap(qint64 metric)
+    {
+        return m_swappedStore.spillCompressedTier(metric);
+    }
+
     KisTileDataStoreIterator* beginIteration();
     void endIteration(KisTileDataStoreIterator* iterator);
 
@@ -86,9 +119,11 @@ public:
     KisTileDataStoreClockIterator* beginClockIteration();
     void endIteration(KisTileDataStoreClockIterator* iterator);
 
-    inline KisTileData* createDefaultTileData(qint32 pixelSize, const quint8 *defPixel)
+    inline KisTileData* createDefaultTileData(qint32 pixelSize, const quint8 *defPixel,
+                                              qint32 tileWidth = KisTileData::WIDTH,
+                                              qint32 tileHeight = KisTileData::HEIGHT)
     {
-        return allocTileData(pixelSize, defPixel);
+        return allocTileData(pixelSize, defPixel, tileWidth, tileHeight);
     }
 
     // Called by The Memento Manager after every commit
@@ -107,6 +142,19 @@ public:
      */
     bool trySwapTileData(KisTileData *td);
 
+    /**
+     * Asynchronously loads swapped-out tile data into memory.
+     * Every object in \p tileData should have an extra reference
+     * taken by the caller (KisTileData::ref()), the store releases
+     * it when the data is loaded.
+     *
+     * \see KisTileDataPrefetcher
+     */
+    inline void prefetchTileData(const QVector<KisTileData*> &tileData)
+    {
+        m_prefetcher.prefetch(tileData);
+    }
+
 
     /**
      * WARN: The following three method are only for usage
@@ -133,11 +181,12 @@ public:
     void unregisterTileData(KisTileData *td);
 
 private:
-    KisTileData *allocTileData(qint32 pixelSize, const quint8 *defPixel);
+    KisTileData *allocTileData(qint32 pixelSize, const quint8 *defPixel, qint32 tileWidth, qint32 tileHeight);
 
     inline void registerTileDataImp(KisTileData *td);
     inline void unregisterTileDataImp(KisTileData *td);
     void freeRegisteredTiles();
+    void readArenaConfig();
 
     friend class DeadlockyThread;
     friend class KisLowMemoryTests;
@@ -147,12 +196,18 @@ private:
     friend class KisTiledDataManagerTest;
     void testingSuspendPooler();
     void testingResumePooler();
+    /**
+     * Waits until the prefetcher swaps in all the queued tiles
+     * \return false if it didn't happen in \p timeout milliseconds
+     */
+    bool testingWaitForPrefetcher(int timeout = 5000);
 
     friend class KisLowMemoryBenchmark;
     void testingRereadConfig();
 private:
     KisTileDataPooler m_pooler;
     KisTileDataSwapper m_swapper;
+    KisTileDataPrefetcher m_prefetcher;
 
     friend class KisTileDataStoreTest;
     friend class KisTileDataPoolerTest;
@@ -123,6 +123,19 @@ private:
         TileType *d;
     };
 
+    struct DefaultTileDataReclaimer {
+        DefaultTileDataReclaimer(KisTileData *data) : d(data) {}
+
+        void destroy()
+        {
+            d->release();
+            delete this;
+        }
+
+    private:
+        KisTileData *d;
+    };
+
     inline quint32 calculateHashImpl(qint32 col, qint32 row)
     {
         if (col == 0 && row == 0) {
@@ -175,6 +188,8 @@ private:
         m_map.getGC().update();
     }
 
+    inline TileTypeSP createDefaultTile(qint32 col, qint32 row);
+
     inline bool erase(quint32 idx)
     {
         m_map.getGC().lockRawPointerAccess();
@@ -202,14 +217,21 @@ private:
     mutable LockFreeTileMap m_map;
 
     /**
-     * We still need something to guard changes in m_defaultTileData,
-     * otherwise there will be concurrent read/writes, resulting in broken memory.
+     * m_iteratorLock is taken by the writers only: when a new tile is
+     * added into the table or when the table is iterated. The readers
+     * never touch it.
      */
-    QReadWriteLock m_defaultPixelDataLock;
     mutable QReadWriteLock m_iteratorLock;
 
     QAtomicInt m_numTiles;
-    KisTileData *m_defaultTileData;
+
+    /**
+     * The default tile data is read without any locks. The readers
+     * access it with raw-pointer access locked in the GC, and the
+     * writer releases the old object via the GC, so it cannot be
+     * freed while someone is still reading it.
+     */
+    QAtomicPointer<KisTileData> m_defaultTileData;
     KisMementoManager *m_mementoManager;
 };
 
@@ -278,7 +300,7 @@ template <class T>
 KisTileHashTableTraits2<T>::KisTileHashTableTraits2(const KisTileHashTableTraits2<T> &ht, KisMementoManager *mm)
     : KisTileHashTableTraits2(mm)
 {
-    setDefaultTileData(ht.m_defaultTileData);
+    setDefaultTileData(ht.m_defaultTileData.loadAcquire());
 
     QWriteLocker locker(&ht.m_iteratorLock);
     typename ConcurrentMap<quint32, TileType*>::Iterator iter(ht.m_map);
@@ -334,8 +356,7 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getT
         /// manager
         newTile = false;
 
-        QReadLocker locker(&m_defaultPixelDataLock);
-        return new TileType(col, row, m_defaultTileData, 0);
+        return createDefaultTile(col, row);
     }
 
     // we are going to assign a raw-pointer tile from the table
@@ -349,10 +370,7 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getT
         // raw-pointer lock held
         m_map.getGC().unlockRawPointerAccess();
 
-        {
-            QReadLocker locker(&m_defaultPixelDataLock);
-            tile = new TileType(col, row, m_defaultTileData, 0);
-        }
+        tile = createDefaultTile(col, row);
 
         TileTypeSP::ref(&tile, tile.data());
         TileType *discardedTile = 0;
@@ -414,8 +432,7 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getR
         /// getTileLazy())
         existingTile = false;
 
-        QReadLocker locker(&m_defaultPixelDataLock);
-        return new TileType(col, row, m_defaultTileData, 0);
+        return createDefaultTile(col, row);
     }
 
     m_map.getGC().lockRawPointerAccess();
@@ -425,8 +442,7 @@ typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::getR
     existingTile = tile;
 
     if (!existingTile) {
-        QReadLocker locker(&m_defaultPixelDataLock);
-        tile = new TileType(col, row, m_defaultTileData, 0);
+        tile = createDefaultTile(col, row);
     }
 
     m_map.getGC().update();
@@ -490,32 +506,52 @@ void KisTileHashTableTraits2<T>::clear()
 template <class T>
 inline void KisTileHashTableTraits2<T>::setDefaultTileData(KisTileData *defaultTileData)
 {
-    QWriteLocker locker(&m_defaultPixelDataLock);
-
-    if (m_defaultTileData) {
-        m_defaultTileData->release();
-        m_defaultTileData = 0;
-    }
-
     if (defaultTileData) {
         defaultTileData->acquire();
-        m_defaultTileData = defaultTileData;
     }
+
+    KisTileData *oldTileData = m_defaultTileData.fetchAndStoreOrdered(defaultTileData);
+
+    if (oldTileData) {
+        // someone might still be reading the old object,
+        // so release it only when the readers are gone
+        m_map.getGC().enqueue(&DefaultTileDataReclaimer::destroy, new DefaultTileDataReclaimer(oldTileData));
+    }
+
+    // garbage collection must **not** be run with locks held
+    m_map.getGC().update();
 }
 
 template <class T>
 inline KisTileData* KisTileHashTableTraits2<T>::defaultTileData()
 {
-    QReadLocker locker(&m_defaultPixelDataLock);
-    return m_defaultTileData;
+    return m_defaultTileData.loadAcquire();
 }
 
 template <class T>
 inline KisTileData* KisTileHashTableTraits2<T>::refAndFetchDefaultTileData()
 {
-    QReadLocker locker(&m_defaultPixelDataLock);
-    m_defaultTileData->ref();
-    return m_defaultTileData;
+    m_map.getGC().lockRawPointerAccess();
+    KisTileData *defaultTileData = m_defaultTileData.loadAcquire();
+    defaultTileData->ref();
+    m_map.getGC().unlockRawPointerAccess();
+
+    return defaultTileData;
+}
+
+template <class T>
+inline typename KisTileHashTableTraits2<T>::TileTypeSP KisTileHashTableTraits2<T>::createDefaultTile(qint32 col, qint32 row)
+{
+    /**
+     * The tile constructor may free memory (dropping clones of the
+     * tile data), so don't call it with raw-pointer access locked.
+     * Just hold an extra reference to the default tile data instead.
+     */
+    KisTileData *defaultTileData = refAndFetchDefaultTileData();
+    TileTypeSP tile = new TileType(col, row, defaultTileData, 0);
+    defaultTileData->deref();
+
+    return tile;
 }
 
 
@@ -8,21 +8,117 @@
 
 #include <QRect>
 #include <QVector>
+#include <QThread>
+#include <QtConcurrent>
 
 #include "kis_tile.h"
 #include "kis_tiled_data_manager.h"
 #include "kis_tile_data_wrapper.h"
 #include "kis_tiled_data_manager_p.h"
 #include "kis_memento_manager.h"
+#include "kis_tile_data_deduplicator.h"
 #include "swap/kis_legacy_tile_compressor.h"
 #include "swap/kis_tile_compressor_factory.h"
 
 #include "kis_paint_device_writer.h"
+#include "kis_assert.h"
 
 #include "kis_global.h"
 
 
-/* The data area is divided into tiles each say 64x64 pixels (defined at compiletime)
+namespace {
+
+/**
+ * The number of tiles a single worker thread (de)compresses in one
+ * go when the data manager is saved or loaded in parallel. The tiles
+ * are processed in batches of (numThreads * TILES_PER_WORKER) tiles,
+ * so the value also limits the amount of memory occupied by the
+ * intermediate buffers.
+ */
+const int TILES_PER_WORKER = 64;
+
+QAtomicInt s_serializationThreadsLimit(0);
+
+int serializationThreadsForTiles(quint32 numTiles)
+{
+    int numThreads = s_serializationThreadsLimit.loadAcquire();
+    if (numThreads <= 0) {
+        numThreads = QThread::idealThreadCount();
+    }
+
+    // small devices are not worth the overhead of spawning jobs
+    return numTiles >= quint32(2 * TILES_PER_WORKER) ? qMax(1, numThreads) : 1;
+}
+
+struct TilesSlice {
+    qint32 version = 0;
+    QString compressionName;
+    KisTileSP *tiles = nullptr;
+    QByteArray *buffers = nullptr;
+    int size = 0;
+    bool result = true;
+};
+
+QVector<TilesSlice> splitIntoSlices(qint32 version, const QString &compressionName,
+                                    KisTileSP *tiles, QByteArray *buffers,
+                                    int numTiles, int numSlices)
+{
+    QVector<TilesSlice> slices;
+    const int sliceSize = (numTiles + numSlices - 1) / numSlices;
+
+    for (int i = 0; i < numTiles; i += sliceSize) {
+        TilesSlice slice;
+        slice.version = version;
+        slice.compressionName = compressionName;
+        slice.tiles = tiles + i;
+        slice.buffers = buffers + i;
+        slice.size = qMin(sliceSize, numTiles - i);
+        slices.append(slice);
+    }
+
+    return slices;
+}
+
+/**
+ * Every slice uses its own compressor, because the compressors keep
+ * their working buffers inside and are not reentrant
+ */
+void compressTilesSlice(TilesSlice &slice)
+{
+    KisAbstractTileCompressorSP compressor =
+        KisTileCompressorFactory::create(slice.version, slice.compressionName);
+
+    for (int i = 0; i < slice.size; i++) {
+        if (!compressor->compressTile(slice.tiles[i], slice.buffers[i])) {
+            warnFile << "Failed to compress tile";
+            slice.result = false;
+        }
+    }
+}
+
+void decompressTilesSlice(TilesSlice &slice)
+{
+    KisAbstractTileCompressorSP compressor =
+        KisTileCompressorFactory::create(slice.version);
+
+    for (int i = 0; i < slice.size; i++) {
+        // the tile has failed to be read from the stream
+        if (!slice.tiles[i]) continue;
+
+        if (!compressor->decompressTile(slice.tiles[i], slice.buffers[i])) {
+            slice.result = false;
+        }
+
+        // release the memory as soon as possible
+        slice.tiles[i] = 0;
+        slice.buffers[i] = QByteArray();
+    }
+}
+
+}
+
+/* The data area is divided into tiles each say 64x64 pixels (defined when the
+ * data manager is created, KisTileData::WIDTH x KisTileData::HEIGHT by default)
  * The tiles are laid out in a matrix that can have negative indexes.
  * The matrix grows automatically if needed (a call for writeacces to a tile
  * outside the current extent)
@@ -31,8 +127,14 @@
  */
 
 KisTiledDataManager::KisTiledDataManager(quint32 pixelSize,
-                                         const quint8 *defaultPixel)
+                                         const quint8 *defaultPixel,
+                                         qint32 tileSize)
+    : m_tileWidth(isTileSizeSupported(tileSize) ? tileSize : KisTileData::WIDTH),
+      m_tileHeight(isTileSizeSupported(tileSize) ? tileSize : KisTileData::HEIGHT),
+      m_extentManager(m_tileWidth, m_tileHeight)
 {
+    KIS_SAFE_ASSERT_RECOVER_NOOP(isTileSizeSupported(tileSize));
+
     /* See comment in destructor for details */
     m_mementoManager = new KisMementoManager();
     m_hashTable = new KisTileHashTable(m_mementoManager);
@@ -40,10 +142,16 @@ KisTiledDataManager::KisTiledDataManager(quint32 pixelSize,
     m_pixelSize = pixelSize;
     m_defaultPixel = new quint8[m_pixelSize];
     setDefaultPixel(defaultPixel);
+
+    m_registeredForDeduplication =
+        KisTileDataDeduplicator::instance()->registerDataManager(this);
 }
 
 KisTiledDataManager::KisTiledDataManager(const KisTiledDataManager &dm)
-    : KisShared()
+    : KisShared(),
+      m_tileWidth(dm.m_tileWidth),
+      m_tileHeight(dm.m_tileHeight),
+      m_extentManager(m_tileWidth, m_tileHeight)
 {
     /* See comment in destructor for details */
 
@@ -54,7 +162,15 @@ KisTiledDataManager::KisTiledDataManager(const KisTiledDataManager &dm)
     m_mementoManager->setDefaultTileData(defaultTileData);
     defaultTileData->deref();
 
-    m_hashTable = new KisTileHashTable(*dm.m_hashTable, m_mementoManager);
+    {
+        /**
+         * KisTileDataDeduplicator takes the write lock of the data
+         * manager before switching the tile datas, so the source is
+         * not deduplicated while its tiles are being copied
+         */
+        QReadLocker locker(&dm.m_lock);
+        m_hashTable = new KisTileHashTable(*dm.m_hashTable, m_mementoManager);
+    }
 
     m_pixelSize = dm.m_pixelSize;
     m_defaultPixel = new quint8[m_pixelSize];
@@ -64,6 +180,9 @@ KisTiledDataManager::KisTiledDataManager(const KisTiledDataManager &dm)
      */
     memcpy(m_defaultPixel, dm.m_defaultPixel, m_pixelSize);
     recalculateExtent();
+
+    m_registeredForDeduplication =
+        KisTileDataDeduplicator::instance()->registerDataManager(this);
 }
 
 KisTiledDataManager::~KisTiledDataManager()
@@ -76,6 +195,13 @@ KisTiledDataManager::~KisTiledDataManager()
      * Manager should be alive during  that destruction. We could  use shared
      * pointers instead, but they create too much overhead.
      */
+    if (m_registeredForDeduplication) {
+        // the deduplicator might have already been destroyed on exit
+        if (KisTileDataDeduplicator *deduplicator = KisTileDataDeduplicator::instance()) {
+            deduplicator->unregisterDataManager(this);
+        }
+    }
+
     delete m_hashTable;
     delete m_mementoManager;
 
@@ -90,7 +216,7 @@ void KisTiledDataManager::setDefaultPixel(const quint8 *defaultPixel)
 
 void KisTiledDataManager::setDefaultPixelImpl(const quint8 *defaultPixel)
 {
-    KisTileData *td = KisTileDataStore::instance()->createDefaultTileData(pixelSize(), defaultPixel);
+    KisTileData *td = KisTileDataStore::instance()->createDefaultTileData(pixelSize(), defaultPixel, m_tileWidth, m_tileHeight);
     m_hashTable->setDefaultTileData(td);
     m_mementoManager->setDefaultTileData(td);
 
@@ -103,21 +229,43 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
 
     bool retval = true;
 
-    if(CURRENT_VERSION == LEGACY_VERSION) {
+    /**
+     * The tiles compressed with anything but LZF cannot be read by
+     * older versions of Krita, so we bump the version only when
+     * the user explicitly asked for a different codec. The codec
+     * names are case-insensitive in the config, but are compared
+     * upper-cased here. The writer reads the config once per save.
+     */
+    QString compressionName = store.tileCompression().toUpper();
+    if (!KisTileCompressor2::supportedCompressions().contains(compressionName)) {
+        compressionName = KisTileCompressor2::defaultCompressionName();
+    }
+
+    const qint32 version =
+        compressionName == KisTileCompressor2::defaultCompressionName() ?
+        CURRENT_VERSION : MULTICODEC_VERSION;
+
+    if(version == LEGACY_VERSION) {
         char str[80];
         sprintf(str, "%d\n", m_hashTable->numTiles());
         retval = store.write(str, strlen(str));
     }
     else {
-        retval = writeTilesHeader(store, m_hashTable->numTiles());
+        retval = writeTilesHeader(store, version, m_hashTable->numTiles());
     }
 
 
+    const int numThreads = serializationThreadsForTiles(m_hashTable->numTiles());
+
+    if (numThreads > 1) {
+        return writeTilesParallel(store, version, compressionName, numThreads);
+    }
+
     KisTileHashTableConstIterator iter(m_hashTable);
     KisTileSP tile;
 
     KisAbstractTileCompressorSP compressor =
-        KisTileCompressorFactory::create(CURRENT_VERSION);
+        KisTileCompressorFactory::create(version, compressionName);
 
     while ((tile = iter.tile())) {
         retval = compressor->writeTile(tile, store);
@@ -130,6 +278,82 @@ bool KisTiledDataManager::write(KisPaintDeviceWriter &store)
 
     return retval;
 }
+
+bool KisTiledDataManager::writeTilesParallel(KisPaintDeviceWriter &store, qint32 version,
+                                             const QString &compressionName, int numThreads)
+{
+    QVector<KisTileSP> tiles;
+    tiles.reserve(m_hashTable->numTiles());
+
+    {
+        KisTileHashTableConstIterator iter(m_hashTable);
+        KisTileSP tile;
+
+        while ((tile = iter.tile())) {
+            tiles.append(tile);
+            iter.next();
+        }
+    }
+
+    /**
+     * The tiles are compressed in batches. While the calling thread
+     * writes the compressed batch into the store, the worker threads
+     * are already compressing the next one. Only the writing into the
+     * store stays serial, so the order of the tiles is preserved.
+     */
+
+    const int batchSize = numThreads * TILES_PER_WORKER;
+    const int numBatches = (tiles.size() + batchSize - 1) / batchSize;
+
+    QVector<QByteArray> buffers[2];
+    QVector<TilesSlice> slices[2];
+    QFuture<void> futures[2];
+
+    auto startBatch = [&] (int batch) {
+        const int slot = batch & 1;
+        const int start = batch * batchSize;
+        const int size = qMin(batchSize, tiles.size() - start);
+
+        buffers[slot].resize(size);
+        slices[slot] = splitIntoSlices(version, compressionName,
+                                       tiles.data() + start,
+                                       buffers[slot].data(),
+                                       size, numThreads);
+        futures[slot] = QtConcurrent::map(slices[slot], compressTilesSlice);
+    };
+
+    bool retval = true;
+
+    if (numBatches > 0) {
+        startBatch(0);
+    }
+
+    for (int batch = 0; batch < numBatches && retval; batch++) {
+        const int slot = batch & 1;
+        futures[slot].waitForFinished();
+
+        if (batch + 1 < numBatches) {
+            startBatch(batch + 1);
+        }
+
+        Q_FOREACH (const TilesSlice &slice, slices[slot]) {
+            retval &= slice.result;
+        }
+
+        for (auto it = buffers[slot].constBegin(); retval && it != buffers[slot].constEnd(); ++it) {
+            retval = store.write(*it);
+            if (!retval) {
+                warnFile << "Failed to write tile";
+            }
+        }
+    }
+
+    futures[0].waitForFinished();
+    futures[1].waitForFinished();
+
+    return retval;
+}
+
 bool KisTiledDataManager::read(QIODevice *stream)
 {
     clear();
@@ -149,6 +373,9 @@ bool KisTiledDataManager::read(QIODevice *stream)
     quint32 numTiles;
     qint32 tilesVersion = LEGACY_VERSION;
 
+    // the legacy format has no header, its tiles are always 64x64
+    QSize tileSize(KisTileData::WIDTH, KisTileData::HEIGHT);
+
     if (line[0] == 'V') {
         QList<QByteArray> lineItems = line.split(' ');
 
@@ -157,7 +384,7 @@ bool KisTiledDataManager::read(QIODevice *stream)
 
         tilesVersion = lineItems.takeFirst().toInt();
 
-        if(!processTilesHeader(stream, numTiles))
+        if(!processTilesHeader(stream, numTiles, tileSize))
             return false;
     }
     else {
@@ -168,17 +395,128 @@ bool KisTiledDataManager::read(QIODevice *stream)
         KisTileCompressorFactory::create(tilesVersion);
 
     bool readSuccess = true;
+
+    const int numThreads = serializationThreadsForTiles(numTiles);
+
+    if (tileSize != QSize(m_tileWidth, m_tileHeight)) {
+        readSuccess = readTilesOfSize(stream, numTiles, tilesVersion, tileSize);
+    } else if (numThreads > 1) {
+        readSuccess = readTilesParallel(stream, numTiles, tilesVersion, numThreads);
+    } else {
+        for (quint32 i = 0; i < numTiles; i++) {
+            if (!compressor->readTile(stream, this)) {
+                readSuccess = false;
+            }
+        }
+    }
+
+    m_mementoManager->commit();
+    return readSuccess;
+}
+
+bool KisTiledDataManager::readTilesOfSize(QIODevice *stream, quint32 numTiles, qint32 version, const QSize &tileSize)
+{
+    KisAbstractTileCompressorSP compressor =
+        KisTileCompressorFactory::create(version);
+
+    /**
+     * The tiles were saved by a data manager with different tile
+     * dimensions, so they cannot be mapped onto our tiles
+     * directly. Just decompress every stored tile into a buffer
+     * and copy the pixels into our own grid.
+     */
+
+    QRect tileRect;
+    QByteArray pixels;
+
+    bool readSuccess = true;
+
     for (quint32 i = 0; i < numTiles; i++) {
-        if (!compressor->readTile(stream, this)) {
+        if (!compressor->readTileOfSize(stream, pixelSize(), tileSize, tileRect, pixels)) {
             readSuccess = false;
+            continue;
         }
+
+        writeBytesBody((const quint8*)pixels.constData(),
+                       tileRect.x(), tileRect.y(),
+                       tileRect.width(), tileRect.height());
     }
 
-    m_mementoManager->commit();
     return readSuccess;
 }
 
-bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles)
+bool KisTiledDataManager::readTilesParallel(QIODevice *stream, quint32 numTiles, qint32 version, int numThreads)
+{
+    KisAbstractTileCompressorSP compressor =
+        KisTileCompressorFactory::create(version);
+
+    /**
+     * The stream can be read sequentially only, so the calling thread
+     * fetches the raw data of the next batch of tiles while the worker
+     * threads are decompressing the previous one.
+     */
+
+    const quint32 batchSize = numThreads * TILES_PER_WORKER;
+
+    QVector<KisTileSP> tiles[2];
+    QVector<QByteArray> buffers[2];
+    QVector<TilesSlice> slices[2];
+    QFuture<void> futures[2];
+
+    bool readSuccess = true;
+
+    auto collectResults = [&] (int slot) {
+        futures[slot].waitForFinished();
+
+        Q_FOREACH (const TilesSlice &slice, slices[slot]) {
+            readSuccess &= slice.result;
+        }
+        slices[slot].clear();
+    };
+
+    int slot = 0;
+
+    for (quint32 start = 0; start < numTiles; start += batchSize) {
+        const int size = qMin(batchSize, numTiles - start);
+
+        collectResults(slot);
+
+        tiles[slot].resize(size);
+        buffers[slot].resize(size);
+
+        for (int i = 0; i < size; i++) {
+            if (!compressor->readRawTile(stream, this, tiles[slot][i], buffers[slot][i])) {
+                tiles[slot][i] = 0;
+                readSuccess = false;
+            }
+        }
+
+        slices[slot] = splitIntoSlices(version, QString(),
+                                       tiles[slot].data(),
+                                       buffers[slot].data(),
+                                       size, numThreads);
+        futures[slot] = QtConcurrent::map(slices[slot], decompressTilesSlice);
+
+        slot ^= 1;
+    }
+
+    collectResults(0);
+    collectResults(1);
+
+    return readSuccess;
+}
+
+void KisTiledDataManager::setSerializationThreadsLimit(int value)
+{
+    s_serializationThreadsLimit.storeRelease(value);
+}
+
+int KisTiledDataManager::serializationThreadsLimit()
+{
+    return s_serializationThreadsLimit.loadAcquire();
+}
+
+bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, qint32 version, quint32 numTiles)
 {
     QString buffer;
 
@@ -187,9 +525,9 @@ bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32
                      "TILEHEIGHT %3\n"
                      "PIXELSIZE %4\n"
                      "DATA %5\n")
-        .arg(CURRENT_VERSION)
-        .arg(KisTileData::WIDTH)
-        .arg(KisTileData::HEIGHT)
+        .arg(version)
+        .arg(m_tileWidth)
+        .arg(m_tileHeight)
         .arg(pixelSize())
         .arg(numTiles);
 
@@ -206,14 +544,19 @@ bool KisTiledDataManager::writeTilesHeader(KisPaintDeviceWriter &store, quint32
     } while(0)                                                  \
 
 
-bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles)
+bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTiles, QSize &tileSize)
 {
     /**
      * We assume that there is only one version of this header
      * possible. In case we invent something new, it'll be quite easy
      * to modify the behavior
+     *
+     * The tiles may have dimensions different from ours, in such
+     * a case they are reshuffled into our tiles on loading.
      */
 
+    const qint32 maxTileEdge = 4096;
+
     const qint32 maxLineLength = 25;
     const qint32 totalNumTests = 4;
     bool foundDataMark = false;
@@ -226,12 +569,14 @@ bool KisTiledDataManager::processTilesHeader(QIODevice *stream, quint32 &numTile
         takeOneLine(stream, maxLineLength, keyword, value);
 
         if (keyword == "TILEWIDTH") {
-            if(value != KisTileData::WIDTH)
+            if(value <= 0 || value > maxTileEdge)
                 goto wrongString;
+            tileSize.setWidth(value);
         }
         else if (keyword == "TILEHEIGHT") {
-            if(value != KisTileData::HEIGHT)
+            if(value <= 0 || value > maxTileEdge)
                 goto wrongString;
+            tileSize.setHeight(value);
         }
         else if (keyword == "PIXELSIZE") {
             if((quint32)value != pixelSize())
@@ -264,7 +609,7 @@ void KisTiledDataManager::purge(const QRect& area)
 {
     QList<KisTileSP> tilesToDelete;
     {
-        const qint32 tileDataSize = KisTileData::HEIGHT * KisTileData::WIDTH * pixelSize();
+        const qint32 tileDataSize = m_tileHeight * m_tileWidth * pixelSize();
         KisTileData *tileData = m_hashTable->refAndFetchDefaultTileData();
         tileData->blockSwapping();
         const quint8 *defaultData = tileData->data();
@@ -336,27 +681,27 @@ void KisTiledDataManager::clear(QRect clearRect, const quint8 *clearPixel)
     qint32 firstRow = yToRow(clearRect.top());
     qint32 lastRow = yToRow(clearRect.bottom());
 
-    const quint32 rowStride = KisTileData::WIDTH * pixelSize;
+    const quint32 rowStride = m_tileWidth * pixelSize;
 
     // Generate one row
     quint8 *clearPixelData = 0;
-    quint32 maxRunLength = qMin(clearRect.width(), KisTileData::WIDTH);
+    quint32 maxRunLength = qMin(clearRect.width(), m_tileWidth);
     clearPixelData = duplicatePixel(maxRunLength, clearPixel);
 
     KisTileData *td = 0;
     if (!pixelBytesAreDefault &&
-        clearRect.width() >= KisTileData::WIDTH &&
-        clearRect.height() >= KisTileData::HEIGHT) {
+        clearRect.width() >= m_tileWidth &&
+        clearRect.height() >= m_tileHeight) {
 
-        td = KisTileDataStore::instance()->createDefaultTileData(pixelSize, clearPixel);
+        td = KisTileDataStore::instance()->createDefaultTileData(pixelSize, clearPixel, m_tileWidth, m_tileHeight);
         td->acquire();
     }
 
     for (qint32 row = firstRow; row <= lastRow; ++row) {
         for (qint32 column = firstColumn; column <= lastColumn; ++column) {
 
-            QRect tileRect(column*KisTileData::WIDTH, row*KisTileData::HEIGHT,
-                           KisTileData::WIDTH, KisTileData::HEIGHT);
+            QRect tileRect(column * m_tileWidth, row * m_tileHeight,
+                           m_tileWidth, m_tileHeight);
             QRect clearTileRect = clearRect & tileRect;
 
             if (clearTileRect == tileRect) {
@@ -434,11 +779,16 @@ void KisTiledDataManager::bitBltImpl(KisTiledDataManager *srcDM, const QRect &re
 {
     if (rect.isEmpty()) return;
 
+    if (srcDM->tileWidth() != m_tileWidth || srcDM->tileHeight() != m_tileHeight) {
+        bitBltPixelsImpl<useOldSrcData>(srcDM, rect);
+        return;
+    }
+
     const qint32 pixelSize = this->pixelSize();
     const bool defaultPixelsCoincide =
         !memcmp(srcDM->defaultPixel(), m_defaultPixel, pixelSize);
 
-    const quint32 rowStride = KisTileData::WIDTH * pixelSize;
+    const quint32 rowStride = m_tileWidth * pixelSize;
 
     qint32 firstColumn = xToCol(rect.left());
     qint32 lastColumn = xToCol(rect.right());
@@ -456,8 +806,8 @@ void KisTiledDataManager::bitBltImpl(KisTiledDataManager *srcDM, const QRect &re
                 srcDM->getOldTile(column, row, srcTileExists) :
                 srcDM->getReadOnlyTileLazy(column, row, srcTileExists);
 
-            QRect tileRect(column*KisTileData::WIDTH, row*KisTileData::HEIGHT,
-                           KisTileData::WIDTH, KisTileData::HEIGHT);
+            QRect tileRect(column * m_tileWidth, row * m_tileHeight,
+                           m_tileWidth, m_tileHeight);
             QRect cloneTileRect = rect & tileRect;
 
             if (cloneTileRect == tileRect) {
@@ -511,6 +861,11 @@ void KisTiledDataManager::bitBltRoughImpl(KisTiledDataManager *srcDM, const QRec
 {
     if (rect.isEmpty()) return;
 
+    if (srcDM->tileWidth() != m_tileWidth || srcDM->tileHeight() != m_tileHeight) {
+        bitBltPixelsImpl<useOldSrcData>(srcDM, rect);
+        return;
+    }
+
     const qint32 pixelSize = this->pixelSize();
     const bool defaultPixelsCoincide =
         !memcmp(srcDM->defaultPixel(), m_defaultPixel, pixelSize);
@@ -557,6 +912,59 @@ void KisTiledDataManager::bitBltRoughImpl(KisTiledDataManager *srcDM, const QRec
     }
 }
 
+template<bool useOldSrcData>
+void KisTiledDataManager::bitBltPixelsImpl(KisTiledDataManager *srcDM, const QRect &rect)
+{
+    /**
+     * The tiles of the data managers with different tile sizes
+     * cannot be shared, so just copy the pixels tile-by-tile of the
+     * source data manager
+     */
+
+    const qint32 pixelSize = this->pixelSize();
+    const bool defaultPixelsCoincide =
+        !memcmp(srcDM->defaultPixel(), m_defaultPixel, pixelSize);
+
+    const qint32 srcRowStride = srcDM->tileWidth() * pixelSize;
+
+    qint32 firstColumn = srcDM->xToCol(rect.left());
+    qint32 lastColumn = srcDM->xToCol(rect.right());
+
+    qint32 firstRow = srcDM->yToRow(rect.top());
+    qint32 lastRow = srcDM->yToRow(rect.bottom());
+
+    for (qint32 row = firstRow; row <= lastRow; ++row) {
+        for (qint32 column = firstColumn; column <= lastColumn; ++column) {
+
+            bool srcTileExists = false;
+
+            KisTileSP srcTile = useOldSrcData ?
+                srcDM->getOldTile(column, row, srcTileExists) :
+                srcDM->getReadOnlyTileLazy(column, row, srcTileExists);
+
+            const QRect srcTileRect = srcTile->extent();
+            const QRect cloneRect = rect & srcTileRect;
+
+            if (!srcTileExists && defaultPixelsCoincide) {
+                clear(cloneRect, m_defaultPixel);
+            } else {
+                srcTile->lockForRead();
+
+                const quint8 *srcTileIt = srcTile->data() +
+                    ((cloneRect.y() - srcTileRect.y()) * srcDM->tileWidth() +
+                     cloneRect.x() - srcTileRect.x()) * pixelSize;
+
+                writeBytesBody(srcTileIt,
+                               cloneRect.x(), cloneRect.y(),
+                               cloneRect.width(), cloneRect.height(),
+                               srcRowStride);
+
+                srcTile->unlockForRead();
+            }
+        }
+    }
+}
+
 void KisTiledDataManager::bitBlt(KisTiledDataManager *srcDM, const QRect &rect)
 {
     bitBltImpl<false>(srcDM, rect);
@@ -614,10 +1022,10 @@ void KisTiledDataManager::setExtent(QRect newRect)
                 quint8* ptr;
 
                 /* FIXME: make it faster */
-                for (int y = 0; y < KisTileData::HEIGHT; y++) {
-                    for (int x = 0; x < KisTileData::WIDTH; x++) {
+                for (int y = 0; y < m_tileHeight; y++) {
+                    for (int x = 0; x < m_tileWidth; x++) {
                         if (!intersection.contains(x, y)) {
-                            ptr = data + pixelSize * (y * KisTileData::WIDTH + x);
+                            ptr = data + pixelSize * (y * m_tileWidth + x);
                             memcpy(ptr, m_defaultPixel, pixelSize);
                         }
                     }
@@ -691,6 +1099,48 @@ void KisTiledDataManager::writeBytes(const quint8 *data,
     writeBytesBody(data, x, y, width, height, dataRowStride);
 }
 
+void KisTiledDataManager::prefetchTiles(const QRect &rect) const
+{
+    if (rect.isEmpty()) return;
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+
+    // nothing has been swapped out, so we can avoid walking the tiles
+    if (store->numTiles() == store->numTilesInMemory()) return;
+
+    QVector<KisTileData*> swappedTileData;
+
+    {
+        QReadLocker locker(&m_lock);
+
+        const QRect tilesRect =
+            QRect(QPoint(xToCol(rect.left()), yToRow(rect.top())),
+                  QPoint(xToCol(rect.right()), yToRow(rect.bottom())));
+
+        for (qint32 row = tilesRect.top(); row <= tilesRect.bottom(); row++) {
+            for (qint32 col = tilesRect.left(); col <= tilesRect.right(); col++) {
+                KisTileSP tile = m_hashTable->getExistingTile(col, row);
+                if (!tile) continue;
+
+                KisTileData *td = tile->refTileData();
+
+                /**
+                 * Reading the data pointer without holding the swap
+                 * lock is racy, but it is just a hint. The prefetcher
+                 * rechecks it anyway.
+                 */
+                if (td->data()) {
+                    td->deref();
+                } else {
+                    swappedTileData.append(td);
+                }
+            }
+        }
+    }
+
+    store->prefetchTileData(swappedTileData);
+}
+
 void KisTiledDataManager::readBytes(quint8 *data,
                                     qint32 x, qint32 y,
                                     qint32 width, qint32 height,
@@ -744,9 +1194,9 @@ qint32 KisTiledDataManager::numContiguousColumns(qint32 x, qint32 minY, qint32 m
     Q_UNUSED(maxY);
 
     if (x >= 0) {
-        numColumns = KisTileData::WIDTH - (x % KisTileData::WIDTH);
+        numColumns = m_tileWidth - (x % m_tileWidth);
     } else {
-        numColumns = ((-x - 1) % KisTileData::WIDTH) + 1;
+        numColumns = ((-x - 1) % m_tileWidth) + 1;
     }
 
     return numColumns;
@@ -760,9 +1210,9 @@ qint32 KisTiledDataManager::numContiguousRows(qint32 y, qint32 minX, qint32 maxX
     Q_UNUSED(maxX);
 
     if (y >= 0) {
-        numRows = KisTileData::HEIGHT - (y % KisTileData::HEIGHT);
+        numRows = m_tileHeight - (y % m_tileHeight);
     } else {
-        numRows = ((-y - 1) % KisTileData::HEIGHT) + 1;
+        numRows = ((-y - 1) % m_tileHeight) + 1;
     }
 
     return numRows;
@@ -773,10 +1223,17 @@ qint32 KisTiledDataManager::rowStride(qint32 x, qint32 y) const
     Q_UNUSED(x);
     Q_UNUSED(y);
 
-    return KisTileData::WIDTH * pixelSize();
+    return m_tileWidth * pixelSize();
 }
 
 void KisTiledDataManager::releaseInternalPools()
 {
     KisTileData::releaseInternalPools();
 }
+
+bool KisTiledDataManager::isTileSizeSupported(qint32 tileSize)
+{
+    return tileSize == KisTileData::WIDTH ||
+        tileSize == 2 * KisTileData::WIDTH ||
+        tileSize == 4 * KisTileData::WIDTH;
+}
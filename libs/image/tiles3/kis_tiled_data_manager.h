@@ -9,6 +9,7 @@
 
 #include <QtGlobal>
 #include <QVector>
+#include <QSize>
 #include <KisRegion.h>
 
 #include <kis_shared.h>
@@ -57,11 +58,26 @@ class KRITAIMAGE_EXPORT KisTiledDataManager : public KisShared
 private:
     static const qint32 LEGACY_VERSION = 1;
     static const qint32 CURRENT_VERSION = 2;
+    /**
+     * The same format as CURRENT_VERSION, but the tiles may be
+     * compressed with codecs other than LZF
+     */
+    static const qint32 MULTICODEC_VERSION = 3;
 
 protected:
     /*FIXME:*/
 public:
-    KisTiledDataManager(quint32 pixelSize, const quint8 *defPixel);
+    /**
+     * Creates a data manager with square tiles of \p tileSize
+     * pixels. Bigger tiles decrease the number of tiles, mementos and
+     * locks to be handled for big devices, but increase the amount of
+     * memory wasted on the borders of the devices and the size of
+     * the copy-on-write chunks.
+     *
+     * \see isTileSizeSupported()
+     */
+    KisTiledDataManager(quint32 pixelSize, const quint8 *defPixel,
+                        qint32 tileSize = KisTileData::WIDTH);
     virtual ~KisTiledDataManager();
     KisTiledDataManager(const KisTiledDataManager &dm);
     KisTiledDataManager & operator=(const KisTiledDataManager &dm);
@@ -192,6 +208,35 @@ public:
 
     static void releaseInternalPools();
 
+    /**
+     * Returns true if a data manager can have tiles of size \p
+     * tileSize. The tiles can be KisTileData::WIDTH, 2 *
+     * KisTileData::WIDTH or 4 * KisTileData::WIDTH pixels wide.
+     */
+    static bool isTileSizeSupported(qint32 tileSize);
+
+    /**
+     * The dimensions of the tiles of the data manager
+     */
+    inline qint32 tileWidth() const {
+        return m_tileWidth;
+    }
+
+    inline qint32 tileHeight() const {
+        return m_tileHeight;
+    }
+
+    /**
+     * Sets the number of threads used for compression and
+     * decompression of the tiles when the data manager is saved or
+     * loaded. The tiles are (de)compressed on the global thread pool,
+     * only the actual I/O happens in the calling thread. Zero means
+     * that QThread::idealThreadCount() threads are used, one means
+     * that the tiles are processed in the calling thread only.
+     */
+    static void setSerializationThreadsLimit(int value);
+    static int serializationThreadsLimit();
+
 protected:
     /**
      * Reads and writes the tiles
@@ -226,7 +271,9 @@ public:
      * Clones rect from another datamanager. The cloned area will be
      * shared between both datamanagers as much as possible using
      * copy-on-write. Parts of the rect that cannot be shared
-     * (cross tiles) are deep-copied,
+     * (cross tiles) are deep-copied. If the tile sizes of the data
+     * managers differ, nothing is shared and all the pixels are
+     * deep-copied.
      */
     void bitBlt(KisTiledDataManager *srcDM, const QRect &rect);
 
@@ -240,7 +287,8 @@ public:
      * All the tiles touched by rect will be shared, between both
      * managers, that means it will copy a bigger area than was
      * requested. This method is supposed to be used for bitBlt'ing
-     * into temporary paint devices.
+     * into temporary paint devices. If the tile sizes of the data
+     * managers differ, it falls back to copying exactly \p rect.
      */
     void bitBltRough(KisTiledDataManager *srcDM, const QRect &rect);
 
@@ -249,6 +297,15 @@ public:
      */
     void bitBltRoughOldData(KisTiledDataManager *srcDM, const QRect &rect);
 
+    /**
+     * Announces that the tiles in \p rect are going to be accessed
+     * soon. The tiles that are currently swapped out are loaded
+     * into memory asynchronously in a background thread, so the
+     * caller doesn't stall on reading the swap file later. The
+     * call doesn't block and doesn't create any new tiles.
+     */
+    void prefetchTiles(const QRect &rect) const;
+
     /**
      * write the specified data to x, y. There is no checking on pixelSize!
      */
@@ -336,23 +393,33 @@ private:
     KisMementoManager *m_mementoManager;
     quint8* m_defaultPixel;
     qint32 m_pixelSize;
+    qint32 m_tileWidth;
+    qint32 m_tileHeight;
     KisTiledExtentManager m_extentManager;
 
     mutable QReadWriteLock m_lock;
 
+    bool m_registeredForDeduplication {false};
+
 private:
     // Allow compression routines to calculate (col,row) coordinates
     // and pixel size
     friend class KisAbstractTileCompressor;
     friend class KisTileDataWrapper;
+    friend class KisTileDataDeduplicator;
     qint32 xToCol(qint32 x) const;
     qint32 yToRow(qint32 y) const;
 
 private:
     void setDefaultPixelImpl(const quint8 *defPixel);
 
-    bool writeTilesHeader(KisPaintDeviceWriter &store, quint32 numTiles);
-    bool processTilesHeader(QIODevice *stream, quint32 &numTiles);
+    bool writeTilesHeader(KisPaintDeviceWriter &store, qint32 version, quint32 numTiles);
+    bool processTilesHeader(QIODevice *stream, quint32 &numTiles, QSize &tileSize);
+
+    bool writeTilesParallel(KisPaintDeviceWriter &store, qint32 version,
+                            const QString &compressionName, int numThreads);
+    bool readTilesParallel(QIODevice *stream, quint32 numTiles, qint32 version, int numThreads);
+    bool readTilesOfSize(QIODevice *stream, quint32 numTiles, qint32 version, const QSize &tileSize);
 
     qint32 divideRoundDown(qint32 x, const qint32 y) const;
 
@@ -364,6 +431,8 @@ private:
         void bitBltImpl(KisTiledDataManager *srcDM, const QRect &rect);
     template<bool useOldSrcData>
         void bitBltRoughImpl(KisTiledDataManager *srcDM, const QRect &rect);
+    template<bool useOldSrcData>
+        void bitBltPixelsImpl(KisTiledDataManager *srcDM, const QRect &rect);
 
     void writeBytesBody(const quint8 *data,
                         qint32 x, qint32 y,
@@ -402,12 +471,12 @@ inline qint32 KisTiledDataManager::divideRoundDown(qint32 x, const qint32 y) con
 
 inline qint32 KisTiledDataManager::xToCol(qint32 x) const
 {
-    return divideRoundDown(x, KisTileData::WIDTH);
+    return divideRoundDown(x, m_tileWidth);
 }
 
 inline qint32 KisTiledDataManager::yToRow(qint32 y) const
 {
-    return divideRoundDown(y, KisTileData::HEIGHT);
+    return divideRoundDown(y, m_tileHeight);
 }
 
 // during development the following line helps to check the interface is correct
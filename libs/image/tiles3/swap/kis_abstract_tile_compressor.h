@@ -43,6 +43,53 @@ public:
      */
     virtual bool readTile(QIODevice *stream, KisTiledDataManager *dm) = 0;
 
+    /**
+     * Compresses the \p tile and stores it into \p buffer in exactly
+     * the same format as writeTile() would write it into the store,
+     * including the header.
+     *
+     * The method doesn't access any store, so it can be called from
+     * several threads simultaneously as long as every thread uses its
+     * own compressor object. Used by the datamanager for parallel
+     * saving of the tiles.
+     *
+     * \see writeTile()
+     */
+    virtual bool compressTile(KisTileSP tile, QByteArray &buffer) = 0;
+
+    /**
+     * Reads the header and the (still compressed) data of a single
+     * tile from the \p stream. The tile the data belongs to is
+     * fetched from \p dm and returned in \p tile, the data itself
+     * is returned in \p buffer and should later be passed to
+     * decompressTile().
+     *
+     * \see readTile(), decompressTile()
+     */
+    virtual bool readRawTile(QIODevice *stream, KisTiledDataManager *dm,
+                             KisTileSP &tile, QByteArray &buffer) = 0;
+
+    /**
+     * Decompresses the data fetched by readRawTile() into \p tile.
+     * Just like compressTile() the method is thread-safe as long as
+     * every thread uses its own compressor object.
+     *
+     * \see readRawTile()
+     */
+    virtual bool decompressTile(KisTileSP tile, QByteArray &buffer) = 0;
+
+    /**
+     * Reads a single tile that was saved by a data manager with tile
+     * dimensions \p tileSize, which differ from the tile dimensions
+     * of the data manager the tile is loaded into. The area covered
+     * by the tile is returned in \p tileRect and its decompressed
+     * pixels (with row stride tileSize.width() * \p pixelSize) in
+     * \p pixels.
+     */
+    virtual bool readTileOfSize(QIODevice *stream, qint32 pixelSize,
+                                const QSize &tileSize,
+                                QRect &tileRect, QByteArray &pixels) = 0;
+
     /**
      * Compresses a \p tileData and writes it into the \p buffer.
      * The buffer must be at least tileDataBufferSize() bytes long.
@@ -90,6 +137,10 @@ protected:
     inline qint32 pixelSize(KisTiledDataManager *dm) {
         return dm->pixelSize();
     }
+
+    inline qint32 tileDataSize(KisTiledDataManager *dm) {
+        return dm->pixelSize() * dm->tileWidth() * dm->tileHeight();
+    }
 };
 
 #endif /* __KIS_ABSTRACT_TILE_COMPRESSOR_H */
@@ -8,8 +8,6 @@
 #include "kis_paint_device_writer.h"
 #include <QIODevice>
 
-#define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
-
 KisLegacyTileCompressor::KisLegacyTileCompressor()
 {
 }
@@ -20,7 +18,7 @@ KisLegacyTileCompressor::~KisLegacyTileCompressor()
 
 bool KisLegacyTileCompressor::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(tile->pixelSize());
+    const qint32 tileDataSize = tile->tileData()->dataSize();
 
     const qint32 bufferSize = maxHeaderLength() + 1;
     QScopedArrayPointer<quint8> headerBuffer(new quint8[bufferSize]);
@@ -42,7 +40,7 @@ bool KisLegacyTileCompressor::writeTile(KisTileSP tile, KisPaintDeviceWriter &st
 
 bool KisLegacyTileCompressor::readTile(QIODevice *stream, KisTiledDataManager *dm)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize(dm));
+    const qint32 tileDataSize = this->tileDataSize(dm);
 
     const qint32 bufferSize = maxHeaderLength() + 1;
     quint8 *headerBuffer = new quint8[bufferSize];
@@ -65,13 +63,90 @@ bool KisLegacyTileCompressor::readTile(QIODevice *stream, KisTiledDataManager *d
     return true;
 }
 
+bool KisLegacyTileCompressor::compressTile(KisTileSP tile, QByteArray &buffer)
+{
+    const qint32 tileDataSize = tile->tileData()->dataSize();
+
+    const qint32 bufferSize = maxHeaderLength() + 1;
+    QScopedArrayPointer<quint8> headerBuffer(new quint8[bufferSize]);
+
+    bool retval = writeHeader(tile, headerBuffer.data());
+    if (!retval) {
+        return false;
+    }
+
+    buffer = QByteArray((char *)headerBuffer.data());
+
+    tile->lockForRead();
+    buffer.append((char *)tile->data(), tileDataSize);
+    tile->unlockForRead();
+
+    return true;
+}
+
+bool KisLegacyTileCompressor::readRawTile(QIODevice *stream, KisTiledDataManager *dm,
+                                          KisTileSP &tile, QByteArray &buffer)
+{
+    const qint32 tileDataSize = this->tileDataSize(dm);
+
+    const qint32 bufferSize = maxHeaderLength() + 1;
+    QScopedArrayPointer<quint8> headerBuffer(new quint8[bufferSize]);
+
+    qint32 x, y;
+    qint32 width, height;
+
+    stream->readLine((char *)headerBuffer.data(), bufferSize);
+    sscanf((char *) headerBuffer.data(), "%d,%d,%d,%d", &x, &y, &width, &height);
+
+    qint32 row = yToRow(dm, y);
+    qint32 col = xToCol(dm, x);
+
+    tile = dm->getTile(col, row, true);
+
+    buffer.resize(tileDataSize);
+    stream->read(buffer.data(), tileDataSize);
+
+    return true;
+}
+
+bool KisLegacyTileCompressor::readTileOfSize(QIODevice *stream, qint32 pixelSize,
+                                             const QSize &tileSize,
+                                             QRect &tileRect, QByteArray &pixels)
+{
+    const qint32 dataSize = pixelSize * tileSize.width() * tileSize.height();
+
+    const qint32 bufferSize = maxHeaderLength() + 1;
+    QScopedArrayPointer<quint8> headerBuffer(new quint8[bufferSize]);
+
+    qint32 x, y;
+    qint32 width, height;
+
+    stream->readLine((char *)headerBuffer.data(), bufferSize);
+    if (sscanf((char *) headerBuffer.data(), "%d,%d,%d,%d", &x, &y, &width, &height) != 4) {
+        return false;
+    }
+
+    tileRect = QRect(QPoint(x, y), tileSize);
+
+    pixels.resize(dataSize);
+    return stream->read(pixels.data(), dataSize) == dataSize;
+}
+
+bool KisLegacyTileCompressor::decompressTile(KisTileSP tile, QByteArray &buffer)
+{
+    tile->lockForWrite();
+    bool res = decompressTileData((quint8*)buffer.data(), buffer.size(), tile->tileData());
+    tile->unlockForWrite();
+    return res;
+}
+
 void KisLegacyTileCompressor::compressTileData(KisTileData *tileData,
                                                quint8 *buffer,
                                                qint32 bufferSize,
                                                qint32 &bytesWritten)
 {
     bytesWritten = 0;
-    const qint32 tileDataSize = TILE_DATA_SIZE(tileData->pixelSize());
+    const qint32 tileDataSize = tileData->dataSize();
     Q_UNUSED(bufferSize);
     Q_ASSERT(bufferSize >= tileDataSize);
     memcpy(buffer, tileData->data(), tileDataSize);
@@ -82,7 +157,7 @@ bool KisLegacyTileCompressor::decompressTileData(quint8 *buffer,
                                                  qint32 bufferSize,
                                                  KisTileData *tileData)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(tileData->pixelSize());
+    const qint32 tileDataSize = tileData->dataSize();
     if (bufferSize >= tileDataSize) {
         memcpy(tileData->data(), buffer, tileDataSize);
         return true;
@@ -92,7 +167,7 @@ bool KisLegacyTileCompressor::decompressTileData(quint8 *buffer,
 
 qint32 KisLegacyTileCompressor::tileDataBufferSize(KisTileData *tileData)
 {
-    return TILE_DATA_SIZE(tileData->pixelSize());
+    return tileData->dataSize();
 }
 
 inline qint32 KisLegacyTileCompressor::maxHeaderLength()
@@ -19,6 +19,14 @@ public:
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
     bool readTile(QIODevice *stream, KisTiledDataManager *dm) override;
 
+    bool compressTile(KisTileSP tile, QByteArray &buffer) override;
+    bool readRawTile(QIODevice *stream, KisTiledDataManager *dm,
+                     KisTileSP &tile, QByteArray &buffer) override;
+    bool decompressTile(KisTileSP tile, QByteArray &buffer) override;
+    bool readTileOfSize(QIODevice *stream, qint32 pixelSize,
+                        const QSize &tileSize,
+                        QRect &tileRect, QByteArray &pixels) override;
+
 
     void compressTileData(KisTileData *tileData,quint8 *buffer,
                           qint32 bufferSize, qint32 &bytesWritten) override;
@@ -11,9 +11,10 @@
 
 #define SWP_PREFIX "KRITA_SWAP_FILE_XXXXXX"
 
-KisMemoryWindow::KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize)
-    : m_readWindowEx(writeWindowSize / 4),
-      m_writeWindowEx(writeWindowSize)
+KisMemoryWindow::KisMemoryWindow(const QString &swapDir, quint64 windowSize, int numWindows)
+    : m_windowSize(windowSize),
+      m_windows(qMax(1, numWindows)),
+      m_accessCounter(0)
 {
     m_valid = true;
 
@@ -49,90 +50,131 @@ KisMemoryWindow::~KisMemoryWindow()
 
 quint8* KisMemoryWindow::getReadChunkPtr(const KisChunkData &readChunk)
 {
-    if (!adjustWindow(readChunk, &m_readWindowEx, &m_writeWindowEx)) {
-        return nullptr;
-    }
-
-    return m_readWindowEx.calculatePointer(readChunk);
+    return getChunkPtr(readChunk);
 }
 
 quint8* KisMemoryWindow::getWriteChunkPtr(const KisChunkData &writeChunk)
 {
-    if (!adjustWindow(writeChunk, &m_writeWindowEx, &m_readWindowEx)) {
+    return getChunkPtr(writeChunk);
+}
+
+KisMemoryWindow::Statistics KisMemoryWindow::statistics() const
+{
+    return m_statistics;
+}
+
+quint8* KisMemoryWindow::getChunkPtr(const KisChunkData &requestedChunk)
+{
+    m_accessCounter++;
+
+    MappingWindow *leastRecentlyUsed = &m_windows[0];
+
+    for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+        if (it->contains(requestedChunk)) {
+            it->lastUsed = m_accessCounter;
+            m_statistics.numHits++;
+            return it->calculatePointer(requestedChunk);
+        }
+
+        if (it->lastUsed < leastRecentlyUsed->lastUsed) {
+            leastRecentlyUsed = &(*it);
+        }
+    }
+
+    m_statistics.numMisses++;
+
+    if (!remapWindow(requestedChunk, leastRecentlyUsed)) {
         return nullptr;
     }
 
-    return m_writeWindowEx.calculatePointer(writeChunk);
+    leastRecentlyUsed->lastUsed = m_accessCounter;
+    return leastRecentlyUsed->calculatePointer(requestedChunk);
 }
 
-bool KisMemoryWindow::adjustWindow(const KisChunkData &requestedChunk,
-                                   MappingWindow *adjustingWindow,
-                                   MappingWindow *otherWindow)
+bool KisMemoryWindow::remapWindow(const KisChunkData &requestedChunk,
+                                  MappingWindow *window)
 {
-    if(!(adjustingWindow->window) ||
-       !(requestedChunk.m_begin >= adjustingWindow->chunk.m_begin &&
-         requestedChunk.m_end <= adjustingWindow->chunk.m_end))
-    {
-        m_file.unmap(adjustingWindow->window);
-
-        quint64 windowSize = adjustingWindow->defaultSize;
-        if(requestedChunk.size() > windowSize) {
-            warnKrita <<
-                "KisMemoryWindow: the requested chunk is too "
-                "big to fit into the mapping! "
-                "Adjusting mapping to avoid SIGSEGV...";
-
-            windowSize = requestedChunk.size();
-        }
+    if (window->window) {
+        m_file.unmap(window->window);
+        m_statistics.mappedSize -= window->chunk.size();
+        window->window = 0;
+    }
+
+    /**
+     * Align the windows by half of their size, so that the windows
+     * of consecutive requests don't overlap too much and every chunk
+     * smaller than a half of the window is guaranteed to fit into it
+     */
+    const quint64 alignment = qMax(quint64(1), m_windowSize / 2);
+    const quint64 windowBegin = requestedChunk.m_begin - requestedChunk.m_begin % alignment;
+
+    quint64 windowSize = m_windowSize;
+    if(requestedChunk.m_end - windowBegin + 1 > windowSize) {
+        warnKrita <<
+            "KisMemoryWindow: the requested chunk is too "
+            "big to fit into the mapping! "
+            "Adjusting mapping to avoid SIGSEGV...";
+
+        windowSize = requestedChunk.m_end - windowBegin + 1;
+    }
 
-        adjustingWindow->chunk.setChunk(requestedChunk.m_begin, windowSize);
+    window->chunk.setChunk(windowBegin, windowSize);
 
-        if(adjustingWindow->chunk.m_end >= (quint64)m_file.size()) {
-            // Align by 32 bytes
-            quint64 newSize = (adjustingWindow->chunk.m_end + 1 + 32) & (~31ULL);
+    if(window->chunk.m_end >= (quint64)m_file.size()) {
+        // Align by 32 bytes
+        quint64 newSize = (window->chunk.m_end + 1 + 32) & (~31ULL);
 
 #ifdef Q_OS_WIN32
-            /**
-             * Workaround for Qt's "feature"
-             *
-             * On windows QFSEnginePrivate caches the value of
-             * mapHandle which is limited to the size of the file at
-             * the moment of its (handle's) creation. That is we will
-             * not be able to use it after resizing the file.  The
-             * only way to free the handle is to release all the
-             * mappings we have. Sad but true.
-             */
-            if (otherWindow->chunk.size()) {
-                m_file.unmap(otherWindow->window);
+        /**
+         * Workaround for Qt's "feature"
+         *
+         * On windows QFSEnginePrivate caches the value of
+         * mapHandle which is limited to the size of the file at
+         * the moment of its (handle's) creation. That is we will
+         * not be able to use it after resizing the file.  The
+         * only way to free the handle is to release all the
+         * mappings we have. Sad but true.
+         */
+        for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+            if (it->window) {
+                m_file.unmap(it->window);
             }
-#else
-            Q_UNUSED(otherWindow);
+        }
 #endif
 
-            if (!m_file.resize(newSize)) {
-                return false;
-            }
+        const bool resized = m_file.resize(newSize);
 
 #ifdef Q_OS_WIN32
-            if (otherWindow->chunk.size()) {
-                otherWindow->window = m_file.map(otherWindow->chunk.m_begin,
-                                                 otherWindow->chunk.size());
+        for (auto it = m_windows.begin(); it != m_windows.end(); ++it) {
+            if (it->window) {
+                it->window = m_file.map(it->chunk.m_begin, it->chunk.size());
+                if (!it->window) {
+                    m_statistics.mappedSize -= it->chunk.size();
+                }
             }
+        }
 #endif
+
+        if (!resized) {
+            return false;
         }
 
+        m_statistics.fileSize = newSize;
+    }
+
 #ifdef Q_OS_UNIX
-        // A workaround for https://bugreports.qt-project.org/browse/QTBUG-6330
-        m_file.exists();
+    // A workaround for https://bugreports.qt-project.org/browse/QTBUG-6330
+    m_file.exists();
 #endif
 
-        adjustingWindow->window = m_file.map(adjustingWindow->chunk.m_begin,
-                                             adjustingWindow->chunk.size());
+    window->window = m_file.map(window->chunk.m_begin,
+                                window->chunk.size());
 
-        if (!adjustingWindow->window) {
-            return false;
-        }
+    if (!window->window) {
+        return false;
     }
 
-	return true;
+    m_statistics.mappedSize += window->chunk.size();
+
+    return true;
 }
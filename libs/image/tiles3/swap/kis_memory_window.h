@@ -8,20 +8,57 @@
 #define __KIS_MEMORY_WINDOW_H
 
 #include <QTemporaryFile>
+#include <QVector>
 
 #include "kis_chunk_allocator.h"
 
 
 #define DEFAULT_WINDOW_SIZE (16*MiB)
-
+#define DEFAULT_NUM_WINDOWS 4
+
+/**
+ * Maps the parts of the swap file into memory. The class keeps
+ * several mappings (windows) at once and recycles the least recently
+ * used one when a chunk outside all of them is requested. It lets
+ * the swapper alternate between distant parts of the swap file
+ * (e.g. swapping in the tiles of one layer while swapping out the
+ * tiles of another) without remapping the file on every access.
+ *
+ * The pointer returned by getReadChunkPtr() or getWriteChunkPtr()
+ * is valid until the next call to any of these methods only.
+ */
 class KRITAIMAGE_EXPORT KisMemoryWindow
 {
+public:
+    struct Statistics {
+        Statistics()
+            : fileSize(0),
+              mappedSize(0),
+              numHits(0),
+              numMisses(0)
+        {
+        }
+
+        qint64 fileSize;
+        qint64 mappedSize;
+
+        /**
+         * The number of requests served by an existing mapping and
+         * the number of requests that needed remapping of a window
+         */
+        qint64 numHits;
+        qint64 numMisses;
+    };
+
 public:
     /**
      * @param swapDir If the dir doesn't exist, it'll be created, if it's empty QDir::tempPath will be used.
-     * @param writeWindowSize write window size.
+     * @param windowSize the size of a single mapping window.
+     * @param numWindows the number of windows mapped simultaneously
      */
-    KisMemoryWindow(const QString &swapDir, quint64 writeWindowSize = DEFAULT_WINDOW_SIZE);
+    KisMemoryWindow(const QString &swapDir,
+                    quint64 windowSize = DEFAULT_WINDOW_SIZE,
+                    int numWindows = DEFAULT_NUM_WINDOWS);
     ~KisMemoryWindow();
 
     inline quint8* getReadChunkPtr(KisChunk readChunk) {
@@ -35,36 +72,47 @@ public:
     quint8* getReadChunkPtr(const KisChunkData &readChunk);
     quint8* getWriteChunkPtr(const KisChunkData &writeChunk);
 
+    Statistics statistics() const;
+
 private:
     struct MappingWindow {
-        MappingWindow(quint64 _defaultSize)
+        MappingWindow()
             : chunk(0,0),
               window(0),
-              defaultSize(_defaultSize)
+              lastUsed(0)
         {
         }
 
+        bool contains(const KisChunkData &other) const {
+            return window &&
+                other.m_begin >= chunk.m_begin &&
+                other.m_end <= chunk.m_end;
+        }
+
         quint8* calculatePointer(const KisChunkData &other) const {
             return window + other.m_begin - chunk.m_begin;
         }
 
         KisChunkData chunk;
         quint8 *window;
-        const quint64 defaultSize;
+        quint64 lastUsed;
     };
 
 
 private:
-    bool adjustWindow(const KisChunkData &requestedChunk,
-                      MappingWindow *adjustingWindow,
-                      MappingWindow *otherWindow);
+    quint8* getChunkPtr(const KisChunkData &requestedChunk);
+    bool remapWindow(const KisChunkData &requestedChunk,
+                     MappingWindow *window);
 
 private:
     QTemporaryFile m_file;
 
     bool m_valid;
-    MappingWindow m_readWindowEx;
-    MappingWindow m_writeWindowEx;
+    const quint64 m_windowSize;
+    QVector<MappingWindow> m_windows;
+    quint64 m_accessCounter;
+
+    Statistics m_statistics;
 };
 
 #endif /* __KIS_MEMORY_WINDOW_H */
@@ -8,13 +8,19 @@
 #include "kis_swapped_data_store.h"
 #include "kis_memory_window.h"
 #include "kis_image_config.h"
+#include "kis_assert.h"
 
 #include "kis_tile_compressor_2.h"
 
 //#define COMPRESSOR_VERSION 2
 
 KisSwappedDataStore::KisSwappedDataStore()
-    : m_memoryMetric(0)
+    : m_memoryMetric(0),
+      m_nextSeqNo(0),
+      m_numCompressedTiles(0),
+      m_compressedSize(0),
+      m_compressedSizeMetric(0),
+      m_compressedMemoryMetric(0)
 {
     KisImageConfig config(true);
     const quint64 maxSwapSize = config.maxSwapSize() * MiB;
@@ -22,10 +28,13 @@ KisSwappedDataStore::KisSwappedDataStore()
     const quint64 swapWindowSize = config.swapWindowSize() * MiB;
 
     m_allocator = new KisChunkAllocator(swapSlabSize, maxSwapSize);
-    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize);
+    m_swapSpace = new KisMemoryWindow(config.swapDir(), swapWindowSize, config.swapWindowsCount());
+
+    m_compressedSizeLimit = qint64(config.compressedSwapLimit()) * MiB;
+    m_compressedMinRatio = config.compressedSwapMinRatio();
 
     // FIXME: use a factory after the patch is committed
-    m_compressor = new KisTileCompressor2();
+    m_compressor = new KisTileCompressor2(config.swapCompression());
 }
 
 KisSwappedDataStore::~KisSwappedDataStore()
@@ -40,7 +49,7 @@ quint64 KisSwappedDataStore::numTiles() const
     // We are not acquiring the lock here...
     // Hope QLinkedList will ensure atomic access to it's size...
 
-    return m_allocator->numChunks();
+    return m_allocator->numChunks() + m_numCompressedTiles.loadAcquire();
 }
 
 bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
@@ -61,22 +70,122 @@ bool KisSwappedDataStore::trySwapOutTileData(KisTileData *td)
     qint32 bytesWritten;
     m_compressor->compressTileData(td, (quint8*) m_buffer.data(), m_buffer.size(), bytesWritten);
 
-    KisChunk chunk = m_allocator->getChunk(bytesWritten);
-    quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
-    if (!ptr) {
-        qWarning() << "swap out of tile failed";
-        return false;
-    }
-    memcpy(ptr, m_buffer.data(), bytesWritten);
+    const qint32 tileDataSize = td->dataSize();
+
+    if (m_compressedSizeLimit > 0 &&
+        bytesWritten * m_compressedMinRatio <= tileDataSize) {
+
+        CompressedTile tile;
+        tile.seqNo = m_nextSeqNo++;
+        tile.data = QByteArray(m_buffer.constData(), bytesWritten);
+
+        m_compressedQueue.insert(tile.seqNo, td);
+        m_compressedTiles.insert(td, tile);
+
+        m_numCompressedTiles.ref();
+        m_compressedSize += bytesWritten;
+        m_compressedMemoryMetric += td->memoryMetric();
+
+        td->releaseMemory();
+        td->setSwapChunk(KisChunk());
+
+        spillCompressedTiles(m_compressedSizeLimit);
+        updateCompressedTierMemoryMetric();
+    } else {
+        KisChunk chunk = m_allocator->getChunk(bytesWritten);
+        quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
+        if (!ptr) {
+            qWarning() << "swap out of tile failed";
+            return false;
+        }
+        memcpy(ptr, m_buffer.data(), bytesWritten);
 
-    td->releaseMemory();
-    td->setSwapChunk(chunk);
+        td->releaseMemory();
+        td->setSwapChunk(chunk);
+    }
 
-    m_memoryMetric += td->pixelSize();
+    m_memoryMetric += td->memoryMetric();
 
     return true;
 }
 
+void KisSwappedDataStore::spillCompressedTiles(qint64 sizeLimit)
+{
+    /**
+     * The tiles which were swapped out first are the coldest ones,
+     * so they go to the disk first.
+     *
+     * The callers of the store take the lock of the tile data first
+     * and m_lock after that, so here we can only *try* to lock the
+     * tile data. The tiles which are busy right now (including the
+     * one being swapped out by the caller) are just skipped.
+     */
+
+    QMap<quint64, KisTileData*>::iterator it = m_compressedQueue.begin();
+
+    while (m_compressedSize > sizeLimit &&
+           it != m_compressedQueue.end()) {
+
+        KisTileData *td = it.value();
+
+        QHash<KisTileData*, CompressedTile>::iterator tileIt = m_compressedTiles.find(td);
+        KIS_SAFE_ASSERT_RECOVER(tileIt != m_compressedTiles.end()) {
+            it = m_compressedQueue.erase(it);
+            continue;
+        }
+
+        if (!td->m_swapLock.tryLockForWrite()) {
+            ++it;
+            continue;
+        }
+
+        const QByteArray &data = tileIt->data;
+
+        KisChunk chunk = m_allocator->getChunk(data.size());
+        quint8 *ptr = m_swapSpace->getWriteChunkPtr(chunk);
+        if (!ptr) {
+            qWarning() << "spilling of a compressed tile failed";
+            m_allocator->freeChunk(chunk);
+            td->m_swapLock.unlock();
+            break;
+        }
+        memcpy(ptr, data.constData(), data.size());
+        td->setSwapChunk(chunk);
+
+        td->m_swapLock.unlock();
+
+        m_compressedSize -= data.size();
+        m_compressedMemoryMetric -= td->memoryMetric();
+        m_numCompressedTiles.deref();
+
+        m_compressedTiles.erase(tileIt);
+        it = m_compressedQueue.erase(it);
+    }
+}
+
+void KisSwappedDataStore::updateCompressedTierMemoryMetric()
+{
+    m_compressedSizeMetric.storeRelease(m_compressedSize / (KisTileData::WIDTH * KisTileData::HEIGHT));
+}
+
+qint64 KisSwappedDataStore::compressedTierMemoryMetric() const
+{
+    return m_compressedSizeMetric.loadAcquire();
+}
+
+qint64 KisSwappedDataStore::spillCompressedTier(qint64 metric)
+{
+    QMutexLocker locker(&m_lock);
+
+    const qint64 oldSize = m_compressedSize;
+    const qint64 bytesToFree = metric * KisTileData::WIDTH * KisTileData::HEIGHT;
+
+    spillCompressedTiles(qMax(qint64(0), m_compressedSize - bytesToFree));
+    updateCompressedTierMemoryMetric();
+
+    return (oldSize - m_compressedSize) / (KisTileData::WIDTH * KisTileData::HEIGHT);
+}
+
 void KisSwappedDataStore::swapInTileData(KisTileData *td)
 {
     Q_ASSERT(!td->data());
@@ -84,27 +193,58 @@ void KisSwappedDataStore::swapInTileData(KisTileData *td)
 
     // see comment in swapOutTileData()
 
-    KisChunk chunk = td->swapChunk();
+    QHash<KisTileData*, CompressedTile>::iterator tileIt = m_compressedTiles.find(td);
+
+    if (tileIt != m_compressedTiles.end()) {
+        td->allocateMemory();
 
-    td->allocateMemory();
-    td->setSwapChunk(KisChunk());
+        QByteArray &data = tileIt->data;
+        m_compressor->decompressTileData((quint8*) data.data(), data.size(), td);
 
-    quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
-    Q_ASSERT(ptr);
-    m_compressor->decompressTileData(ptr, chunk.size(), td);
-    m_allocator->freeChunk(chunk);
+        m_compressedSize -= data.size();
+        m_compressedMemoryMetric -= td->memoryMetric();
+        m_numCompressedTiles.deref();
 
-    m_memoryMetric -= td->pixelSize();
+        m_compressedQueue.remove(tileIt->seqNo);
+        m_compressedTiles.erase(tileIt);
+
+        updateCompressedTierMemoryMetric();
+    } else {
+        KisChunk chunk = td->swapChunk();
+
+        td->allocateMemory();
+        td->setSwapChunk(KisChunk());
+
+        quint8 *ptr = m_swapSpace->getReadChunkPtr(chunk);
+        Q_ASSERT(ptr);
+        m_compressor->decompressTileData(ptr, chunk.size(), td);
+        m_allocator->freeChunk(chunk);
+    }
+
+    m_memoryMetric -= td->memoryMetric();
 }
 
 void KisSwappedDataStore::forgetTileData(KisTileData *td)
 {
     QMutexLocker locker(&m_lock);
 
-    m_allocator->freeChunk(td->swapChunk());
-    td->setSwapChunk(KisChunk());
+    QHash<KisTileData*, CompressedTile>::iterator tileIt = m_compressedTiles.find(td);
+
+    if (tileIt != m_compressedTiles.end()) {
+        m_compressedSize -= tileIt->data.size();
+        m_compressedMemoryMetric -= td->memoryMetric();
+        m_numCompressedTiles.deref();
 
-    m_memoryMetric -= td->pixelSize();
+        m_compressedQueue.remove(tileIt->seqNo);
+        m_compressedTiles.erase(tileIt);
+
+        updateCompressedTierMemoryMetric();
+    } else {
+        m_allocator->freeChunk(td->swapChunk());
+        td->setSwapChunk(KisChunk());
+    }
+
+    m_memoryMetric -= td->memoryMetric();
 }
 
 qint64 KisSwappedDataStore::totalMemoryMetric() const
@@ -112,6 +252,32 @@ qint64 KisSwappedDataStore::totalMemoryMetric() const
     return m_memoryMetric;
 }
 
+KisMemoryWindow::Statistics KisSwappedDataStore::swapFileStatistics()
+{
+    QMutexLocker locker(&m_lock);
+    return m_swapSpace->statistics();
+}
+
+KisSwappedDataStore::CompressedTierStatistics KisSwappedDataStore::compressedTierStatistics()
+{
+    QMutexLocker locker(&m_lock);
+
+    CompressedTierStatistics stats;
+    stats.numTiles = m_compressedTiles.size();
+    stats.compressedSize = m_compressedSize;
+    stats.memoryMetric = m_compressedMemoryMetric;
+
+    return stats;
+}
+
+void KisSwappedDataStore::testingSetCompressedTierLimit(qint64 limit)
+{
+    QMutexLocker locker(&m_lock);
+    m_compressedSizeLimit = limit;
+    spillCompressedTiles(m_compressedSizeLimit);
+    updateCompressedTierMemoryMetric();
+}
+
 void KisSwappedDataStore::debugStatistics()
 {
     m_allocator->sanityCheck();
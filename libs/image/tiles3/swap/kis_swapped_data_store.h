@@ -11,16 +11,43 @@
 
 #include <QMutex>
 #include <QByteArray>
+#include <QHash>
+#include <QMap>
+
+#include "kis_memory_window.h"
 
 
 class QMutex;
 class KisTileData;
 class KisAbstractTileCompressor;
 class KisChunkAllocator;
-class KisMemoryWindow;
 
+/**
+ * Stores the data of the swapped out tiles. The data is compressed
+ * and kept in memory first (compressed tier). When the compressed
+ * tier grows over KisImageConfig::compressedSwapLimit(), the tiles
+ * that were swapped out first are moved into the swap file.
+ */
 class KRITAIMAGE_EXPORT KisSwappedDataStore
 {
+public:
+    struct CompressedTierStatistics {
+        CompressedTierStatistics()
+            : numTiles(0),
+              compressedSize(0),
+              memoryMetric(0)
+        {
+        }
+
+        qint64 numTiles;
+
+        /// the amount of memory used by the compressed data
+        qint64 compressedSize;
+
+        /// the metric of the stored tiles in *uncompressed* form
+        qint64 memoryMetric;
+    };
+
 public:
     KisSwappedDataStore();
     ~KisSwappedDataStore();
@@ -59,11 +86,53 @@ public:
      */
     qint64 totalMemoryMetric() const;
 
+    /**
+     * Returns the statistics of the mapping of the swap file
+     */
+    KisMemoryWindow::Statistics swapFileStatistics();
+
+    /**
+     * Returns the statistics of the tiles kept compressed in memory
+     */
+    CompressedTierStatistics compressedTierStatistics();
+
+    /**
+     * Returns the metric of the memory actually occupied by the
+     * compressed tier, that is, of the *compressed* data. The swapper
+     * counts it together with the memory of the tiles in memory.
+     * Doesn't take any locks.
+     */
+    qint64 compressedTierMemoryMetric() const;
+
+    /**
+     * Moves the oldest compressed tiles into the swap file until the
+     * memory occupied by the compressed tier drops by \a metric.
+     * The tiles whose lock cannot be taken right now are skipped.
+     * Returns the metric of the freed memory.
+     */
+    qint64 spillCompressedTier(qint64 metric);
+
     /**
      * Some debugging output
      */
     void debugStatistics();
 
+    /**
+     * Overrides KisImageConfig::compressedSwapLimit() to make the
+     * spilling of the compressed tiles testable
+     */
+    void testingSetCompressedTierLimit(qint64 limit);
+
+private:
+    void spillCompressedTiles(qint64 sizeLimit);
+    void updateCompressedTierMemoryMetric();
+
+private:
+    struct CompressedTile {
+        quint64 seqNo;
+        QByteArray data;
+    };
+
 private:
     QByteArray m_buffer;
     KisAbstractTileCompressor *m_compressor;
@@ -74,6 +143,16 @@ private:
     QMutex m_lock;
 
     qint64 m_memoryMetric;
+
+    QHash<KisTileData*, CompressedTile> m_compressedTiles;
+    QMap<quint64, KisTileData*> m_compressedQueue;
+    quint64 m_nextSeqNo;
+    QAtomicInt m_numCompressedTiles;
+    qint64 m_compressedSize;
+    QAtomicInt m_compressedSizeMetric;
+    qint64 m_compressedMemoryMetric;
+    qint64 m_compressedSizeLimit;
+    qreal m_compressedMinRatio;
 };
 
 #endif /* __KIS_SWAPPED_DATA_STORE_H */
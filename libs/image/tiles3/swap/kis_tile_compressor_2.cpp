@@ -7,25 +7,132 @@
 #include "kis_tile_compressor_2.h"
 #include "kis_lzf_compression.h"
 #include <QIODevice>
+#include <algorithm>
 #include "kis_paint_device_writer.h"
-#define TILE_DATA_SIZE(pixelSize) ((pixelSize) * KisTileData::WIDTH * KisTileData::HEIGHT)
+#include "config-tile-compression.h"
 
-const QString KisTileCompressor2::m_compressionName = "LZF";
+#ifdef HAVE_LZ4
+#include "kis_lz4_compression.h"
+#endif
 
+#ifdef HAVE_ZSTD
+#include "kis_zstd_compression.h"
+#endif
 
-KisTileCompressor2::KisTileCompressor2()
+
+KisTileCompressor2::KisTileCompressor2(const QString &compressionName)
 {
-    m_compression = new KisLzfCompression();
+    std::fill(m_compressions, m_compressions + NUM_DATA_FLAGS, nullptr);
+
+    m_compressionFlag = flagForCompressionName(compressionName);
+
+    if (m_compressionFlag == RAW_DATA_FLAG) {
+        warnTiles << "Unsupported tile compression" << compressionName
+                  << "falling back to" << defaultCompressionName();
+        m_compressionFlag = LZF_DATA_FLAG;
+    }
+
+    m_compressionName = m_compressionFlag == LZF_DATA_FLAG ?
+        defaultCompressionName() : compressionName.toUpper();
+
+    m_compression = compressionForFlag(m_compressionFlag);
 }
 
 KisTileCompressor2::~KisTileCompressor2()
 {
-    delete m_compression;
+    for (int i = 0; i < NUM_DATA_FLAGS; i++) {
+        delete m_compressions[i];
+    }
+}
+
+QString KisTileCompressor2::compressionName() const
+{
+    return m_compressionName;
+}
+
+QString KisTileCompressor2::defaultCompressionName()
+{
+    return "LZF";
+}
+
+QStringList KisTileCompressor2::supportedCompressions()
+{
+    QStringList result;
+    result << "LZF";
+#ifdef HAVE_LZ4
+    result << "LZ4";
+#endif
+#ifdef HAVE_ZSTD
+    result << "ZSTD";
+#endif
+    return result;
+}
+
+KisAbstractCompression* KisTileCompressor2::createCompression(const QString &name)
+{
+    switch (flagForCompressionName(name)) {
+    case LZF_DATA_FLAG:
+        return new KisLzfCompression();
+#ifdef HAVE_LZ4
+    case LZ4_DATA_FLAG:
+        return new KisLz4Compression();
+#endif
+#ifdef HAVE_ZSTD
+    case ZSTD_DATA_FLAG:
+        return new KisZstdCompression();
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+qint8 KisTileCompressor2::flagForCompressionName(const QString &name)
+{
+    const QString upperName = name.toUpper();
+
+    if (upperName == "LZF") {
+        return LZF_DATA_FLAG;
+    }
+#ifdef HAVE_LZ4
+    else if (upperName == "LZ4") {
+        return LZ4_DATA_FLAG;
+    }
+#endif
+#ifdef HAVE_ZSTD
+    else if (upperName == "ZSTD") {
+        return ZSTD_DATA_FLAG;
+    }
+#endif
+
+    return RAW_DATA_FLAG;
+}
+
+KisAbstractCompression* KisTileCompressor2::compressionForFlag(qint8 flag)
+{
+    if (flag <= RAW_DATA_FLAG || flag >= NUM_DATA_FLAGS) {
+        return nullptr;
+    }
+
+    if (!m_compressions[flag]) {
+        switch (flag) {
+        case LZF_DATA_FLAG:
+            m_compressions[flag] = createCompression("LZF");
+            break;
+        case LZ4_DATA_FLAG:
+            m_compressions[flag] = createCompression("LZ4");
+            break;
+        case ZSTD_DATA_FLAG:
+            m_compressions[flag] = createCompression("ZSTD");
+            break;
+        }
+    }
+
+    return m_compressions[flag];
 }
 
 bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(tile->pixelSize());
+    const qint32 tileDataSize = tile->tileData()->dataSize();
     prepareStreamingBuffer(tileDataSize);
 
     qint32 bytesWritten;
@@ -50,36 +157,110 @@ bool KisTileCompressor2::writeTile(KisTileSP tile, KisPaintDeviceWriter &store)
 
 bool KisTileCompressor2::readTile(QIODevice *stream, KisTiledDataManager *dm)
 {
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize(dm));
+    KisTileSP tile;
+
+    if (!readRawTile(stream, dm, tile, m_streamingBuffer)) {
+        return false;
+    }
+
+    return decompressTile(tile, m_streamingBuffer);
+}
+
+bool KisTileCompressor2::compressTile(KisTileSP tile, QByteArray &buffer)
+{
+    const qint32 tileDataSize = tile->tileData()->dataSize();
     prepareStreamingBuffer(tileDataSize);
 
+    qint32 bytesWritten;
+
+    tile->lockForRead();
+    compressTileData(tile->tileData(), (quint8*)m_streamingBuffer.data(),
+                     m_streamingBuffer.size(), bytesWritten);
+    tile->unlockForRead();
+
+    buffer = getHeader(tile, bytesWritten).toLatin1();
+    buffer.append(m_streamingBuffer.constData(), bytesWritten);
+
+    return true;
+}
+
+bool KisTileCompressor2::readRawTile(QIODevice *stream, KisTiledDataManager *dm,
+                                     KisTileSP &tile, QByteArray &buffer)
+{
+    const qint32 tileDataSize = this->tileDataSize(dm);
+
+    qint32 x, y;
+    if (!readHeaderAndData(stream, tileDataSize + 1, x, y, buffer)) {
+        return false;
+    }
+
+    qint32 row = yToRow(dm, y);
+    qint32 col = xToCol(dm, x);
+
+    tile = dm->getTile(col, row, true);
+
+    return true;
+}
+
+bool KisTileCompressor2::readTileOfSize(QIODevice *stream, qint32 pixelSize,
+                                        const QSize &tileSize,
+                                        QRect &tileRect, QByteArray &pixels)
+{
+    const qint32 dataSize = pixelSize * tileSize.width() * tileSize.height();
+
+    qint32 x, y;
+    if (!readHeaderAndData(stream, dataSize + 1, x, y, m_streamingBuffer)) {
+        return false;
+    }
+
+    tileRect = QRect(QPoint(x, y), tileSize);
+    pixels.resize(dataSize);
+
+    return decompressData((quint8*)m_streamingBuffer.data(), m_streamingBuffer.size(),
+                          (quint8*)pixels.data(), dataSize, pixelSize);
+}
+
+bool KisTileCompressor2::readHeaderAndData(QIODevice *stream, qint32 maxDataSize,
+                                           qint32 &x, qint32 &y, QByteArray &buffer)
+{
     QByteArray header = stream->readLine(maxHeaderLength());
 
     QList<QByteArray> headerItems = header.trimmed().split(',');
     if (headerItems.size() == 4) {
-        qint32 x = headerItems.takeFirst().toInt();
-        qint32 y = headerItems.takeFirst().toInt();
+        x = headerItems.takeFirst().toInt();
+        y = headerItems.takeFirst().toInt();
         QString compressionName = headerItems.takeFirst();
         qint32 dataSize = headerItems.takeFirst().toInt();
 
         Q_ASSERT(headerItems.isEmpty());
-        Q_ASSERT(compressionName == m_compressionName);
 
-        qint32 row = yToRow(dm, y);
-        qint32 col = xToCol(dm, x);
+        if (dataSize <= 0 || dataSize > maxDataSize) {
+            warnTiles << "Wrong size of the compressed tile data:" << dataSize;
+            return false;
+        }
 
-        KisTileSP tile = dm->getTile(col, row, true);
+        if (!flagForCompressionName(compressionName)) {
+            warnTiles << "Unsupported tile compression:" << compressionName;
+            stream->read(dataSize);
+            return false;
+        }
 
-        stream->read(m_streamingBuffer.data(), dataSize);
+        buffer.resize(dataSize);
+        stream->read(buffer.data(), dataSize);
 
-        tile->lockForWrite();
-        bool res = decompressTileData((quint8*)m_streamingBuffer.data(), dataSize, tile->tileData());
-        tile->unlockForWrite();
-        return res;
+        return true;
     }
     return false;
 }
 
+bool KisTileCompressor2::decompressTile(KisTileSP tile, QByteArray &buffer)
+{
+    tile->lockForWrite();
+    bool res = decompressTileData((quint8*)buffer.data(), buffer.size(), tile->tileData());
+    tile->unlockForWrite();
+    return res;
+}
+
 void KisTileCompressor2::prepareStreamingBuffer(qint32 tileDataSize)
 {
     /**
@@ -107,8 +288,13 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
                                           qint32 bufferSize,
                                           qint32 &bytesWritten)
 {
+    /**
+     * The colors are linearized by the actual size of the pixel,
+     * so that the tiles of the data managers with big tiles can be
+     * read by data managers with any other tile size
+     */
     const qint32 pixelSize = tileData->pixelSize();
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
+    const qint32 tileDataSize = tileData->dataSize();
     qint32 compressedBytes;
 
     Q_UNUSED(bufferSize);
@@ -122,8 +308,8 @@ void KisTileCompressor2::compressTileData(KisTileData *tileData,
     compressedBytes = m_compression->compress((quint8*)m_linearizationBuffer.data(), tileDataSize,
                                               (quint8*)m_compressionBuffer.data(), m_compressionBuffer.size());
 
-    if(compressedBytes < tileDataSize) {
-        buffer[0] = COMPRESSED_DATA_FLAG;
+    if(compressedBytes > 0 && compressedBytes < tileDataSize) {
+        buffer[0] = m_compressionFlag;
         memcpy(buffer + 1, m_compressionBuffer.data(), compressedBytes);
         bytesWritten = compressedBytes + 1;
     }
@@ -139,24 +325,38 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
                                             KisTileData *tileData)
 {
     const qint32 pixelSize = tileData->pixelSize();
-    const qint32 tileDataSize = TILE_DATA_SIZE(pixelSize);
+    const qint32 tileDataSize = tileData->dataSize();
+
+    return decompressData(buffer, bufferSize, tileData->data(), tileDataSize, pixelSize);
+}
+
+bool KisTileCompressor2::decompressData(quint8 *buffer, qint32 bufferSize,
+                                        quint8 *data, qint32 tileDataSize, qint32 pixelSize)
+{
+    if(buffer[0] != RAW_DATA_FLAG) {
+        KisAbstractCompression *compression = compressionForFlag(buffer[0]);
+        if (!compression) {
+            warnTiles << "Unsupported tile compression flag:" << buffer[0];
+            return false;
+        }
 
-    if(buffer[0] == COMPRESSED_DATA_FLAG) {
         prepareWorkBuffers(tileDataSize);
 
         qint32 bytesWritten;
-        bytesWritten = m_compression->decompress(buffer + 1, bufferSize - 1,
+        bytesWritten = compression->decompress(buffer + 1, bufferSize - 1,
                                                  (quint8*)m_linearizationBuffer.data(), tileDataSize);
         if (bytesWritten == tileDataSize) {
             KisAbstractCompression::delinearizeColors((quint8*)m_linearizationBuffer.data(),
-                                                      tileData->data(),
+                                                      data,
                                                       tileDataSize, pixelSize);
             return true;
         }
         return false;
     }
     else {
-        memcpy(tileData->data(), buffer + 1, tileDataSize);
+        if (bufferSize - 1 < tileDataSize) return false;
+
+        memcpy(data, buffer + 1, tileDataSize);
         return true;
     }
     return false;
@@ -165,7 +365,7 @@ bool KisTileCompressor2::decompressTileData(quint8 *buffer,
 
 qint32 KisTileCompressor2::tileDataBufferSize(KisTileData *tileData)
 {
-    return TILE_DATA_SIZE(tileData->pixelSize()) + 1;
+    return tileData->dataSize() + 1;
 }
 
 inline qint32 KisTileCompressor2::maxHeaderLength()
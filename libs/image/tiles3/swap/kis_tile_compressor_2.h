@@ -9,17 +9,59 @@
 
 #include "kis_abstract_tile_compressor.h"
 
+#include <QStringList>
+
 class KisAbstractCompression;
 
+/**
+ * The compressor stores the name of the codec in the header of every
+ * tile, so the tiles compressed with any of the supported codecs can
+ * be read back. The codec used for writing is passed to the
+ * constructor. Since the tiles compressed with codecs other than LZF
+ * cannot be read by the older versions of Krita, the data manager
+ * bumps the version of the tiles block to 3 in such a case.
+ */
 class KRITAIMAGE_EXPORT KisTileCompressor2 : public KisAbstractTileCompressor
 {
 public:
-    KisTileCompressor2();
+    KisTileCompressor2(const QString &compressionName = defaultCompressionName());
     ~KisTileCompressor2() override;
 
+    /**
+     * \return the name of the codec used for writing the tiles
+     */
+    QString compressionName() const;
+
+    /**
+     * The codec that is guaranteed to be available on every platform
+     * and is readable by all the versions of Krita (LZF)
+     */
+    static QString defaultCompressionName();
+
+    /**
+     * \return the names of the codecs Krita was compiled with,
+     * e.g. "LZF", "LZ4" and "ZSTD"
+     */
+    static QStringList supportedCompressions();
+
+    /**
+     * Creates a compression object for a \p name codec. Returns
+     * nullptr if the codec is not supported. The caller owns
+     * the object.
+     */
+    static KisAbstractCompression* createCompression(const QString &name);
+
     bool writeTile(KisTileSP tile, KisPaintDeviceWriter &store) override;
     bool readTile(QIODevice *io, KisTiledDataManager *dm) override;
 
+    bool compressTile(KisTileSP tile, QByteArray &buffer) override;
+    bool readRawTile(QIODevice *stream, KisTiledDataManager *dm,
+                     KisTileSP &tile, QByteArray &buffer) override;
+    bool decompressTile(KisTileSP tile, QByteArray &buffer) override;
+    bool readTileOfSize(QIODevice *stream, qint32 pixelSize,
+                        const QSize &tileSize,
+                        QRect &tileRect, QByteArray &pixels) override;
+
 
     void compressTileData(KisTileData *tileData,quint8 *buffer,
                           qint32 bufferSize, qint32 &bytesWritten) override;
@@ -32,21 +74,54 @@ private:
      */
     qint32 maxHeaderLength();
 
+    /**
+     * Returns a (cached) codec for decompression of the data marked
+     * with \p flag
+     */
+    KisAbstractCompression* compressionForFlag(qint8 flag);
+
     QString getHeader(KisTileSP tile, qint32 compressedSize);
 
+    /**
+     * Reads the header of the next tile and its still compressed
+     * data. Returns the position of the tile in \p x and \p y.
+     */
+    bool readHeaderAndData(QIODevice *stream, qint32 maxDataSize,
+                           qint32 &x, qint32 &y, QByteArray &buffer);
+
+    bool decompressData(quint8 *buffer, qint32 bufferSize,
+                        quint8 *data, qint32 dataSize, qint32 pixelSize);
+
     void prepareWorkBuffers(qint32 tileDataSize);
     void prepareStreamingBuffer(qint32 tileDataSize);
 
 private:
+    /**
+     * The first byte of every compressed tile defines how the rest
+     * of the data should be decoded. LZF_DATA_FLAG is the flag used
+     * by the older versions of Krita for all the compressed tiles.
+     */
     static const qint8 RAW_DATA_FLAG = 0;
-    static const qint8 COMPRESSED_DATA_FLAG = 1;
+    static const qint8 LZF_DATA_FLAG = 1;
+    static const qint8 LZ4_DATA_FLAG = 2;
+    static const qint8 ZSTD_DATA_FLAG = 3;
+    static const qint8 NUM_DATA_FLAGS = 4;
+
+    static qint8 flagForCompressionName(const QString &name);
 
 private:
     QByteArray m_linearizationBuffer;
     QByteArray m_compressionBuffer;
     QByteArray m_streamingBuffer;
     KisAbstractCompression *m_compression;
-    static const QString m_compressionName;
+    QString m_compressionName;
+    qint8 m_compressionFlag;
+
+    /**
+     * The codecs indexed by the data flag. They are created lazily,
+     * when the tile compressed with the corresponding codec is met.
+     */
+    KisAbstractCompression *m_compressions[NUM_DATA_FLAGS];
 };
 
 #endif /* __KIS_TILE_COMPRESSOR_2_H */
@@ -13,7 +13,13 @@
 class KRITAIMAGE_EXPORT KisTileCompressorFactory
 {
 public:
-    static KisAbstractTileCompressorSP create(qint32 version) {
+    /**
+     * Creates a compressor for the tiles of \p version. The
+     * \p compressionName codec is used for writing the tiles
+     * of version 3, the other versions ignore it.
+     */
+    static KisAbstractTileCompressorSP create(qint32 version,
+                                              const QString &compressionName = QString()) {
         switch(version) {
         case 1:
             return KisAbstractTileCompressorSP(new KisLegacyTileCompressor());
@@ -21,6 +27,12 @@ public:
         case 2:
             return KisAbstractTileCompressorSP(new KisTileCompressor2());
             break;
+        case 3:
+            return KisAbstractTileCompressorSP(
+                new KisTileCompressor2(compressionName.isEmpty() ?
+                                       KisTileCompressor2::defaultCompressionName() :
+                                       compressionName));
+            break;
         default:
             qFatal("Unknown version of the tiles");
             return KisAbstractTileCompressorSP();
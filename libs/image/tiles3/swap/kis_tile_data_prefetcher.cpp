@@ -0,0 +1,128 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include <QSemaphore>
+#include <QMutex>
+#include <QQueue>
+
+#include "tiles3/swap/kis_tile_data_prefetcher.h"
+#include "tiles3/kis_tile_data.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "kis_debug.h"
+
+const qint32 KisTileDataPrefetcher::MAX_QUEUE_SIZE = 4096;
+
+
+struct Q_DECL_HIDDEN KisTileDataPrefetcher::Private
+{
+public:
+    QSemaphore semaphore;
+    QAtomicInt shouldExitFlag;
+    QAtomicInt numPendingTiles;
+    KisTileDataStore *store;
+
+    QMutex queueLock;
+    QQueue<KisTileData*> queue;
+};
+
+KisTileDataPrefetcher::KisTileDataPrefetcher(KisTileDataStore *store)
+    : QThread(),
+      m_d(new Private())
+{
+    m_d->shouldExitFlag = 0;
+    m_d->numPendingTiles = 0;
+    m_d->store = store;
+}
+
+KisTileDataPrefetcher::~KisTileDataPrefetcher()
+{
+    releaseQueue();
+    delete m_d;
+}
+
+void KisTileDataPrefetcher::prefetch(const QVector<KisTileData*> &tileData)
+{
+    if (tileData.isEmpty()) return;
+
+    int numQueued = 0;
+
+    {
+        QMutexLocker locker(&m_d->queueLock);
+
+        Q_FOREACH (KisTileData *td, tileData) {
+            if (m_d->queue.size() >= MAX_QUEUE_SIZE) {
+                td->deref();
+                continue;
+            }
+
+            m_d->queue.enqueue(td);
+            numQueued++;
+        }
+
+        m_d->numPendingTiles.fetchAndAddOrdered(numQueued);
+    }
+
+    if (numQueued) {
+        m_d->semaphore.release(numQueued);
+    }
+}
+
+void KisTileDataPrefetcher::terminatePrefetcher()
+{
+    unsigned long exitTimeout = 100;
+    do {
+        m_d->shouldExitFlag = true;
+        m_d->semaphore.release();
+    } while(!wait(exitTimeout));
+
+    releaseQueue();
+}
+
+qint32 KisTileDataPrefetcher::numPendingTiles() const
+{
+    return m_d->numPendingTiles.loadAcquire();
+}
+
+void KisTileDataPrefetcher::releaseQueue()
+{
+    QMutexLocker locker(&m_d->queueLock);
+
+    while (!m_d->queue.isEmpty()) {
+        m_d->queue.dequeue()->deref();
+        m_d->numPendingTiles.deref();
+    }
+}
+
+void KisTileDataPrefetcher::run()
+{
+    while (1) {
+        m_d->semaphore.acquire();
+
+        if (m_d->shouldExitFlag)
+            return;
+
+        KisTileData *td = 0;
+
+        {
+            QMutexLocker locker(&m_d->queueLock);
+            if (m_d->queue.isEmpty()) continue;
+            td = m_d->queue.dequeue();
+        }
+
+        /**
+         * The data might have already been loaded by the job
+         * itself, so just don't touch it in such a case.
+         * blockSwapping() takes care of all the locking.
+         */
+        if (!td->data()) {
+            td->blockSwapping();
+            td->unblockSwapping();
+        }
+
+        td->deref();
+        m_d->numPendingTiles.deref();
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+#ifndef KIS_TILE_DATA_PREFETCHER_H_
+#define KIS_TILE_DATA_PREFETCHER_H_
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+
+#include "kritaimage_export.h"
+
+
+class KisTileDataStore;
+class KisTileData;
+
+/**
+ * A background thread that loads swapped-out tile data objects
+ * back into memory before someone actually needs them.
+ *
+ * The update and stroke jobs know the areas they are going to
+ * read in advance, so they can announce these areas to the data
+ * manager (KisTiledDataManager::prefetchTiles()), which passes
+ * the swapped-out tile data to the prefetcher. When the job
+ * starts, the data is (hopefully) already in memory and the
+ * worker thread doesn't stall on decompression from the swap
+ * file.
+ *
+ * Prefetching is just a hint: if the job reaches the tile before
+ * the prefetcher does, the tile is loaded by the job itself as
+ * usual and the prefetcher just skips it later.
+ */
+class KRITAIMAGE_EXPORT KisTileDataPrefetcher : public QThread
+{
+    Q_OBJECT
+
+public:
+
+    KisTileDataPrefetcher(KisTileDataStore *store);
+    ~KisTileDataPrefetcher() override;
+
+    /**
+     * Queues the tile data for loading. The caller should pass
+     * an extra reference (KisTileData::ref()) for every tile data
+     * object, the prefetcher takes ownership over it and releases
+     * it when the data is loaded. When the queue is overfull, the
+     * objects are released immediately without loading.
+     */
+    void prefetch(const QVector<KisTileData*> &tileData);
+
+    void terminatePrefetcher();
+
+    /**
+     * The number of tile data objects that have been queued but
+     * not yet processed
+     */
+    qint32 numPendingTiles() const;
+
+private:
+    void run() override;
+    void releaseQueue();
+
+private:
+    /**
+     * The maximum number of tile data objects waiting in the queue.
+     * Prefetching more than that makes little sense, because the
+     * swapper will most probably swap the data out again before
+     * it is used.
+     */
+    static const qint32 MAX_QUEUE_SIZE;
+
+private:
+    struct Private;
+    Private * const m_d;
+};
+
+
+
+#endif /* KIS_TILE_DATA_PREFETCHER_H_ */
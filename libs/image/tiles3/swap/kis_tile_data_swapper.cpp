@@ -91,7 +91,7 @@ void KisTileDataSwapper::run()
 void KisTileDataSwapper::checkFreeMemory()
 {
 //    dbgKrita <<"check memory: high limit -" << m_d->limits.emergencyThreshold() <<"in mem -" << m_d->store->numTilesInMemory();
-    if(m_d->store->memoryMetric() > m_d->limits.emergencyThreshold())
+    if(m_d->store->residentMemoryMetric() > m_d->limits.emergencyThreshold())
         doJob();
 }
 
@@ -103,7 +103,13 @@ void KisTileDataSwapper::doJob()
      */
     QMutexLocker locker(&m_d->cycleLock);
 
-    qint32 memoryMetric = m_d->store->memoryMetric();
+    /**
+     * The compressed swap tier lives in memory, so it is counted
+     * against the limits as well. Swapping out a tile into that tier
+     * frees less than its metric, so the metric is reread after every
+     * pass instead of subtracting the freed amount.
+     */
+    qint32 memoryMetric = m_d->store->residentMemoryMetric();
 
     DEBUG_ACTION("Started swap cycle");
     DEBUG_VALUE(m_d->store->numTiles());
@@ -118,14 +124,24 @@ void KisTileDataSwapper::doJob()
         qint32 softFree =  memoryMetric - m_d->limits.softLimit();
         DEBUG_VALUE(softFree);
         DEBUG_ACTION("\t pass0");
-        memoryMetric -= pass<SoftSwapStrategy>(softFree);
+        pass<SoftSwapStrategy>(softFree);
+        memoryMetric = m_d->store->residentMemoryMetric();
         DEBUG_VALUE(memoryMetric);
 
         if(memoryMetric > m_d->limits.hardLimitThreshold()) {
             qint32 hardFree =  memoryMetric - m_d->limits.hardLimit();
             DEBUG_VALUE(hardFree);
             DEBUG_ACTION("\t pass1");
-            memoryMetric -= pass<AggressiveSwapStrategy>(hardFree);
+            pass<AggressiveSwapStrategy>(hardFree);
+            memoryMetric = m_d->store->residentMemoryMetric();
+            DEBUG_VALUE(memoryMetric);
+        }
+
+        if(memoryMetric > m_d->limits.hardLimitThreshold()) {
+            qint32 spillFree =  memoryMetric - m_d->limits.hardLimit();
+            DEBUG_VALUE(spillFree);
+            DEBUG_ACTION("\t pass2");
+            memoryMetric -= m_d->store->spillCompressedSwap(spillFree);
             DEBUG_VALUE(memoryMetric);
         }
     }
@@ -200,7 +216,7 @@ qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
 
         if (strategy::swapOutFirst(item)) {
             if (iter->trySwapOut(item)) {
-                freedMetric += item->pixelSize();
+                freedMetric += item->memoryMetric();
             }
         }
         else {
@@ -214,7 +230,7 @@ qint64 KisTileDataSwapper::pass(qint64 needToFreeMetric)
         if (freedMetric >= needToFreeMetric) break;
 
         if (iter->trySwapOut(item)) {
-            freedMetric += item->pixelSize();
+            freedMetric += item->memoryMetric();
         }
     }
 
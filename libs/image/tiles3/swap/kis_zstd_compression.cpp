@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "kis_zstd_compression.h"
+
+#include <zstd.h>
+
+
+struct KisZstdCompression::Private
+{
+    ZSTD_CCtx *compressionContext = nullptr;
+    ZSTD_DCtx *decompressionContext = nullptr;
+    int compressionLevel = 3;
+};
+
+KisZstdCompression::KisZstdCompression(int compressionLevel)
+    : m_d(new Private)
+{
+    m_d->compressionLevel = compressionLevel;
+}
+
+KisZstdCompression::~KisZstdCompression()
+{
+    ZSTD_freeCCtx(m_d->compressionContext);
+    ZSTD_freeDCtx(m_d->decompressionContext);
+}
+
+qint32 KisZstdCompression::compress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    if (!m_d->compressionContext) {
+        m_d->compressionContext = ZSTD_createCCtx();
+    }
+
+    const size_t result =
+        ZSTD_compressCCtx(m_d->compressionContext,
+                          output, outputLength,
+                          input, inputLength,
+                          m_d->compressionLevel);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::decompress(const quint8* input, qint32 inputLength, quint8* output, qint32 outputLength)
+{
+    if (!m_d->decompressionContext) {
+        m_d->decompressionContext = ZSTD_createDCtx();
+    }
+
+    const size_t result =
+        ZSTD_decompressDCtx(m_d->decompressionContext,
+                            output, outputLength,
+                            input, inputLength);
+
+    return ZSTD_isError(result) ? 0 : qint32(result);
+}
+
+qint32 KisZstdCompression::outputBufferSize(qint32 dataSize)
+{
+    return ZSTD_compressBound(dataSize);
+}
@@ -42,6 +42,65 @@ void KisMemoryWindowTest::testWindow()
     QVERIFY(!memcmp(ptr, oddBuf, chunkLength));
 }
 
+void KisMemoryWindowTest::testMultipleWindows()
+{
+    QTemporaryDir swapDir;
+    KisMemoryWindow memory(swapDir.path(), 1024, 2);
+
+    const quint8 chunkLength = 10;
+
+    quint8 buf1[chunkLength];
+    memset(buf1, 0xee, chunkLength);
+
+    quint8 buf2[chunkLength];
+    memset(buf2, 0xdd, chunkLength);
+
+    KisChunkData chunk1(0, chunkLength);
+    KisChunkData chunk2(10240, chunkLength);
+    KisChunkData chunk3(20480, chunkLength);
+
+    quint8 *ptr;
+
+    ptr = memory.getWriteChunkPtr(chunk1);
+    memcpy(ptr, buf1, chunkLength);
+
+    ptr = memory.getWriteChunkPtr(chunk2);
+    memcpy(ptr, buf2, chunkLength);
+
+    QCOMPARE(memory.statistics().numMisses, qint64(2));
+
+    /**
+     * Alternating between two distant chunks should
+     * not cause any remapping
+     */
+    for (int i = 0; i < 10; i++) {
+        ptr = memory.getReadChunkPtr(chunk1);
+        QVERIFY(!memcmp(ptr, buf1, chunkLength));
+
+        ptr = memory.getReadChunkPtr(chunk2);
+        QVERIFY(!memcmp(ptr, buf2, chunkLength));
+    }
+
+    QCOMPARE(memory.statistics().numMisses, qint64(2));
+    QCOMPARE(memory.statistics().numHits, qint64(20));
+
+    // the third chunk evicts the least recently used window (chunk1)
+    ptr = memory.getWriteChunkPtr(chunk3);
+    memcpy(ptr, buf1, chunkLength);
+    QCOMPARE(memory.statistics().numMisses, qint64(3));
+
+    ptr = memory.getReadChunkPtr(chunk2);
+    QVERIFY(!memcmp(ptr, buf2, chunkLength));
+    QCOMPARE(memory.statistics().numMisses, qint64(3));
+
+    ptr = memory.getReadChunkPtr(chunk1);
+    QVERIFY(!memcmp(ptr, buf1, chunkLength));
+    QCOMPARE(memory.statistics().numMisses, qint64(4));
+
+    QCOMPARE(memory.statistics().mappedSize, qint64(2 * 1024));
+    QVERIFY(memory.statistics().fileSize > 20480);
+}
+
 void KisMemoryWindowTest::testTopReports()
 {
 
@@ -15,6 +15,7 @@ class KisMemoryWindowTest : public QObject
 
 private Q_SLOTS:
     void testWindow();
+    void testMultipleWindows();
 
 private:
     // disabled since long-running
@@ -119,5 +119,86 @@ void KisSwappedDataStoreTest::testRandomAccess()
         delete tileDataList[i];
 }
 
+void KisSwappedDataStoreTest::testCompressedTier()
+{
+    const qint32 pixelSize = 1;
+    const quint8 defaultPixel = 128;
+    const qint32 NUM_TILES = 100;
+
+    KisImageConfig config(false);
+    config.setMaxSwapSize(4);
+    config.setSwapSlabSize(1);
+    config.setSwapWindowSize(1);
+
+    KisSwappedDataStore store;
+
+    QList<KisTileData*> tileDataList;
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        tileDataList.append(new KisTileData(pixelSize, &defaultPixel, KisTileDataStore::instance()));
+
+    // uniform tiles compress well, so they should be kept in memory
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        memset(td->data(), COLUMN2COLOR(i), TILESIZE);
+        QVERIFY(store.trySwapOutTileData(td));
+    }
+
+    KisSwappedDataStore::CompressedTierStatistics stats = store.compressedTierStatistics();
+    QCOMPARE(stats.numTiles, qint64(NUM_TILES));
+    QCOMPARE(stats.memoryMetric, qint64(NUM_TILES * pixelSize));
+    QVERIFY(stats.compressedSize < NUM_TILES * TILESIZE / 2);
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+
+    // the oldest half of the tiles should be moved to the swap file
+    store.testingSetCompressedTierLimit(stats.compressedSize / 2);
+
+    stats = store.compressedTierStatistics();
+    QVERIFY(stats.numTiles > 0);
+    QVERIFY(stats.numTiles <= NUM_TILES / 2);
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+    QCOMPARE(store.totalMemoryMetric(), qint64(NUM_TILES * pixelSize));
+    QCOMPARE(store.compressedTierMemoryMetric(),
+             stats.compressedSize / (KisTileData::WIDTH * KisTileData::HEIGHT));
+
+    // the swapper can ask for the rest of the tier to be spilled
+    store.spillCompressedTier(NUM_TILES * pixelSize);
+
+    stats = store.compressedTierStatistics();
+    QCOMPARE(stats.numTiles, qint64(0));
+    QCOMPARE(stats.compressedSize, qint64(0));
+    QCOMPARE(store.compressedTierMemoryMetric(), qint64(0));
+    QCOMPARE(store.numTiles(), quint64(NUM_TILES));
+
+    for(qint32 i = 0; i < NUM_TILES; i++) {
+        KisTileData *td = tileDataList[i];
+        QVERIFY(!td->data());
+
+        store.swapInTileData(td);
+        QVERIFY(memoryIsFilled(COLUMN2COLOR(i), td->data(), TILESIZE));
+    }
+
+    stats = store.compressedTierStatistics();
+    QCOMPARE(stats.numTiles, qint64(0));
+    QCOMPARE(stats.compressedSize, qint64(0));
+    QCOMPARE(store.numTiles(), quint64(0));
+
+    // noise doesn't compress, so it goes directly to the swap file
+    KisTileData *td = tileDataList.first();
+    for(qint32 i = 0; i < TILESIZE; i++) {
+        td->data()[i] = qrand() & 0xff;
+    }
+    const QByteArray noise((const char*)td->data(), TILESIZE);
+
+    QVERIFY(store.trySwapOutTileData(td));
+    QCOMPARE(store.compressedTierStatistics().numTiles, qint64(0));
+    QCOMPARE(store.numTiles(), quint64(1));
+
+    store.swapInTileData(td);
+    QVERIFY(QByteArray((const char*)td->data(), TILESIZE) == noise);
+
+    for(qint32 i = 0; i < NUM_TILES; i++)
+        delete tileDataList[i];
+}
+
 SIMPLE_TEST_MAIN(KisSwappedDataStoreTest)
 
@@ -16,6 +16,7 @@
 
 #include "tiles3/kis_tile_data_store.h"
 #include "tiles3/kis_tile_data_store_iterators.h"
+#include "tiles3/kis_tile_data_arena.h"
 
 
 void KisTileDataStoreTest::testClockIterator()
@@ -135,6 +136,33 @@ void KisTileDataStoreTest::testLeaks()
     QCOMPARE(KisTileDataStore::instance()->numTiles(), 0);
 }
 
+void KisTileDataStoreTest::testBigTileData()
+{
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugClear();
+
+    const qint32 pixelSize = 4;
+    const quint8 defaultPixel[pixelSize] = {1, 2, 3, 4};
+
+    KisTileData *td = store->createDefaultTileData(pixelSize, defaultPixel, 128, 128);
+
+    QCOMPARE(td->pixelSize(), quint32(pixelSize));
+    QCOMPARE(td->tileWidth(), 128);
+    QCOMPARE(td->tileHeight(), 128);
+    QCOMPARE(td->dataSize(), pixelSize * 128 * 128);
+
+    // the store counts the tile as four tiles of the usual size
+    QCOMPARE(td->memoryMetric(), 4 * pixelSize);
+    QCOMPARE(store->memoryMetric(), qint64(4 * pixelSize));
+
+    const quint8 *lastPixel = td->data() + td->dataSize() - pixelSize;
+    QVERIFY(!memcmp(lastPixel, defaultPixel, pixelSize));
+
+    store->freeTileData(td);
+
+    QCOMPARE(store->memoryMetric(), qint64(0));
+}
+
 #define COLUMN2COLOR(col) (col%255)
 
 void KisTileDataStoreTest::testSwapping()
@@ -176,5 +204,79 @@ void KisTileDataStoreTest::testSwapping()
     }
 }
 
+void KisTileDataStoreTest::testArenaStatistics()
+{
+    // the pooler should not allocate clones while we are measuring
+    KisTileDataStore::instance()->testingSuspendPooler();
+
+    const KisTileDataArena::Statistics initialStats = KisTileDataArena::statistics();
+
+    const KisTileDataArena::size_type blockSize = 3 * 1024 * 1024 + 17;
+    char *block = KisTileDataArena::malloc(blockSize);
+    QVERIFY(block);
+
+    // the whole block should be writable
+    memset(block, 0xAB, blockSize);
+
+    KisTileDataArena::Statistics stats = KisTileDataArena::statistics();
+    QCOMPARE(stats.numBlocks, initialStats.numBlocks + 1);
+    QVERIFY(stats.arenaSize >= initialStats.arenaSize + qint64(blockSize));
+    QVERIFY(stats.hugePagesSize <= stats.arenaSize);
+
+    KisTileDataArena::free(block);
+
+    stats = KisTileDataArena::statistics();
+    QCOMPARE(stats.numBlocks, initialStats.numBlocks);
+    QCOMPARE(stats.arenaSize, initialStats.arenaSize);
+    QCOMPARE(stats.hugePagesSize, initialStats.hugePagesSize);
+
+    {
+        quint8 defaultPixel[4] = {0, 0, 0, 0};
+        KisTiledDataManager dm(4, defaultPixel);
+
+        for (int i = 0; i < 16; i++) {
+            KisTileSP tile = dm.getTile(i, 0, true);
+            tile->lockForWrite();
+            tile->unlockForWrite();
+        }
+
+        stats = KisTileDataArena::statistics();
+        QVERIFY(stats.usedSize >= 16 * 4 * KisTileData::WIDTH * KisTileData::HEIGHT);
+        QVERIFY(stats.usedSize <= stats.arenaSize);
+
+        KisTileDataStore::MemoryStatistics storeStats =
+            KisTileDataStore::instance()->memoryStatistics();
+        QVERIFY(storeStats.arenaSize >= stats.arenaSize);
+    }
+
+    {
+        // RGBA F32 tiles and the tiles of the scaled data managers
+        // are cut from the arena as well
+        const KisTileDataArena::Statistics initialUsedStats = KisTileDataArena::statistics();
+
+        quint8 defaultPixel[16] = {0};
+        KisTiledDataManager dm(16, defaultPixel);
+        KisTiledDataManager scaledDm(4, defaultPixel, 4 * KisTileData::WIDTH);
+
+        for (int i = 0; i < 4; i++) {
+            KisTileSP tile = dm.getTile(i, 0, true);
+            tile->lockForWrite();
+            tile->unlockForWrite();
+
+            KisTileSP scaledTile = scaledDm.getTile(i, 0, true);
+            scaledTile->lockForWrite();
+            scaledTile->unlockForWrite();
+        }
+
+        stats = KisTileDataArena::statistics();
+        QVERIFY(stats.usedSize >= initialUsedStats.usedSize +
+                4 * 16 * KisTileData::WIDTH * KisTileData::HEIGHT +
+                4 * 4 * 16 * KisTileData::WIDTH * KisTileData::HEIGHT);
+        QVERIFY(stats.usedSize <= stats.arenaSize);
+    }
+
+    KisTileDataStore::instance()->testingResumePooler();
+}
+
 SIMPLE_TEST_MAIN(KisTileDataStoreTest)
 
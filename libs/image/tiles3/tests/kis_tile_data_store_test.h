@@ -17,7 +17,9 @@ private:
 private Q_SLOTS:
     void testClockIterator();
     void testLeaks();
+    void testBigTileData();
     void testSwapping();
+    void testArenaStatistics();
 };
 
 #endif /* KIS_TILE_DATA_STORE_TEST_H */
@@ -8,6 +8,14 @@
 #include <simpletest.h>
 
 #include "tiles3/kis_tiled_data_manager.h"
+#include "kis_datamanager.h"
+#include "kis_image_config.h"
+#include "tiles3/kis_tile_data_store.h"
+#include "tiles3/kis_tile_data_deduplicator.h"
+#include "tiles3/swap/kis_tile_compressor_2.h"
+
+#include <QBuffer>
+#include <QThread>
 
 #include "tiles_test_utils.h"
 #include "config-limit-long-tests.h"
@@ -527,6 +535,440 @@ void KisTiledDataManagerTest::testUndoSetDefaultPixel()
     QVERIFY(memoryIsFilled(oddPixel2, tile10->data(), TILESIZE));
 }
 
+void KisTiledDataManagerTest::testParallelSerialization()
+{
+    quint8 defaultPixel = 0;
+    KisDataManager srcDM(1, &defaultPixel);
+
+    const QRect rc(-100, -100, 2000, 1000);
+    QByteArray bytes(rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 7) % 251);
+    }
+    srcDM.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    auto roundTrip = [&] (int writeThreads, int readThreads) {
+        KoStoreFake fakeStore;
+        KisFakePaintDeviceWriter writer(&fakeStore);
+
+        KisTiledDataManager::setSerializationThreadsLimit(writeThreads);
+        bool retval = srcDM.write(writer);
+        QVERIFY(retval);
+
+        fakeStore.startReading();
+
+        KisDataManager dstDM(1, &defaultPixel);
+        KisTiledDataManager::setSerializationThreadsLimit(readThreads);
+        retval = dstDM.read(fakeStore.device());
+        QVERIFY(retval);
+
+        QCOMPARE(dstDM.extent(), srcDM.extent());
+
+        QByteArray result(bytes.size(), 0);
+        dstDM.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        QVERIFY(result == bytes);
+    };
+
+    roundTrip(1, 1);
+    roundTrip(4, 1);
+    roundTrip(1, 4);
+    roundTrip(3, 5);
+
+    KisTiledDataManager::setSerializationThreadsLimit(0);
+}
+
+namespace {
+
+/**
+ * Restores the configured tile compression when the test
+ * finishes, even if one of the checks fails
+ */
+struct ScopedTileCompression
+{
+    ScopedTileCompression()
+        : m_oldCompression(KisImageConfig(true).tileCompression())
+    {
+    }
+
+    ~ScopedTileCompression() {
+        KisImageConfig(false).setTileCompression(m_oldCompression);
+    }
+
+    void set(const QString &compressionName) {
+        KisImageConfig(false).setTileCompression(compressionName);
+    }
+
+private:
+    QString m_oldCompression;
+};
+
+}
+
+void KisTiledDataManagerTest::testTileCompressionCodecs()
+{
+    quint8 defaultPixel = 0;
+    KisDataManager srcDM(4, &defaultPixel);
+
+    const QRect rc(0, 0, 300, 200);
+    QByteArray bytes(4 * rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 13) % 97);
+    }
+    srcDM.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    ScopedTileCompression compression;
+
+    Q_FOREACH (const QString &compressionName, KisTileCompressor2::supportedCompressions()) {
+        compression.set(compressionName.toLower());
+
+        KoStoreFake fakeStore;
+        KisFakePaintDeviceWriter writer(&fakeStore);
+        QVERIFY(srcDM.write(writer));
+
+        fakeStore.startReading();
+
+        KisDataManager dstDM(4, &defaultPixel);
+        QVERIFY(dstDM.read(fakeStore.device()));
+
+        QByteArray result(bytes.size(), 0);
+        dstDM.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        QVERIFY(result == bytes);
+    }
+}
+
+void KisTiledDataManagerTest::testReadForeignTileSize_data()
+{
+    QTest::addColumn<int>("tileWidth");
+    QTest::addColumn<int>("tileHeight");
+
+    QTest::newRow("32x32") << 32 << 32;
+    QTest::newRow("128x128") << 128 << 128;
+    QTest::newRow("256x64") << 256 << 64;
+    QTest::newRow("100x70") << 100 << 70;
+}
+
+void KisTiledDataManagerTest::testReadForeignTileSize()
+{
+    QFETCH(int, tileWidth);
+    QFETCH(int, tileHeight);
+
+    auto pixelValue = [] (int x, int y) {
+        return char((qAbs(x) * 3 + qAbs(y) * 7) % 251);
+    };
+
+    /**
+     * Generate tiles data, as if it was written by a data
+     * manager with different tile dimensions
+     */
+    const QRect tilesRect(-1, -1, 4, 3);
+    const int numTiles = tilesRect.width() * tilesRect.height();
+
+    QByteArray data;
+    data += QString("VERSION 2\n"
+                    "TILEWIDTH %1\n"
+                    "TILEHEIGHT %2\n"
+                    "PIXELSIZE 1\n"
+                    "DATA %3\n")
+        .arg(tileWidth).arg(tileHeight).arg(numTiles).toLatin1();
+
+    for (int row = tilesRect.top(); row <= tilesRect.bottom(); row++) {
+        for (int col = tilesRect.left(); col <= tilesRect.right(); col++) {
+            const int x = col * tileWidth;
+            const int y = row * tileHeight;
+
+            data += QString("%1,%2,LZF,%3\n")
+                .arg(x).arg(y).arg(tileWidth * tileHeight + 1).toLatin1();
+
+            data += char(0); // raw data flag
+
+            for (int j = 0; j < tileHeight; j++) {
+                for (int i = 0; i < tileWidth; i++) {
+                    data += pixelValue(x + i, y + j);
+                }
+            }
+        }
+    }
+
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    quint8 defaultPixel = 0;
+    KisDataManager dm(1, &defaultPixel);
+    QVERIFY(dm.read(&buffer));
+
+    const QRect rc(tilesRect.x() * tileWidth, tilesRect.y() * tileHeight,
+                   tilesRect.width() * tileWidth, tilesRect.height() * tileHeight);
+
+    QVERIFY(dm.extent().contains(rc));
+
+    QByteArray result(rc.width() * rc.height(), 0);
+    dm.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    for (int j = 0; j < rc.height(); j++) {
+        for (int i = 0; i < rc.width(); i++) {
+            QCOMPARE(result[j * rc.width() + i], pixelValue(rc.x() + i, rc.y() + j));
+        }
+    }
+}
+
+void KisTiledDataManagerTest::testBigTiles_data()
+{
+    QTest::addColumn<int>("tileSize");
+
+    QTest::newRow("128") << 128;
+    QTest::newRow("256") << 256;
+}
+
+void KisTiledDataManagerTest::testBigTiles()
+{
+    QFETCH(int, tileSize);
+
+    const int pixelSize = 4;
+    const quint8 defaultPixel[pixelSize] = {1, 2, 3, 4};
+
+    // KisDataManager::bitBlt() accepts a shared pointer only
+    KisSharedPtr<KisDataManager> dm = new KisDataManager(pixelSize, defaultPixel, tileSize);
+    QCOMPARE(dm->tileWidth(), tileSize);
+    QCOMPARE(dm->tileHeight(), tileSize);
+
+    const QRect rc(-100, -70, 3 * tileSize, 2 * tileSize);
+    QByteArray bytes(pixelSize * rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 5) % 241);
+    }
+
+    auto checkContent = [&] (KisDataManager *checkedDM) {
+        QByteArray result(bytes.size(), 0);
+        checkedDM->readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        return result == bytes;
+    };
+
+    auto checkDefaultPixel = [&] (KisDataManager *checkedDM, const QRect &area) {
+        QByteArray result(pixelSize * area.width() * area.height(), 0);
+        checkedDM->readBytes((quint8*)result.data(), area.x(), area.y(), area.width(), area.height());
+
+        for (int i = 0; i < result.size(); i++) {
+            if (quint8(result[i]) != defaultPixel[i % pixelSize]) return false;
+        }
+        return true;
+    };
+
+    KisMementoSP memento = dm->getMemento();
+    dm->writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    dm->commit();
+
+    QVERIFY(checkContent(dm.data()));
+    QVERIFY(checkDefaultPixel(dm.data(), QRect(rc.right() + 1, rc.top(), 10, 10)));
+
+    QCOMPARE(dm->extent(), QRect(-tileSize, -tileSize, 4 * tileSize, 3 * tileSize));
+    QCOMPARE(memento->extent(), dm->extent());
+    QCOMPARE(dm->getTile(1, 1, false)->extent(), QRect(tileSize, tileSize, tileSize, tileSize));
+
+    // the tiles are handled by the swapper as usual
+    KisTileDataStore::instance()->debugSwapAll();
+    QVERIFY(checkContent(dm.data()));
+
+    // copying into the data managers with the same and different tile sizes
+    Q_FOREACH (int dstTileSize, QVector<int>({tileSize, 64})) {
+        KisDataManager dstDM(pixelSize, defaultPixel, dstTileSize);
+        dstDM.bitBlt(dm, rc);
+        QVERIFY(checkContent(&dstDM));
+
+        KisDataManager roughDM(pixelSize, defaultPixel, dstTileSize);
+        roughDM.bitBltRough(dm, rc);
+        QVERIFY(checkContent(&roughDM));
+    }
+
+    // loading the tiles into the data managers with the same and different tile sizes
+    Q_FOREACH (int dstTileSize, QVector<int>({tileSize, 64})) {
+        KoStoreFake fakeStore;
+        KisFakePaintDeviceWriter writer(&fakeStore);
+        QVERIFY(dm->write(writer));
+
+        fakeStore.startReading();
+
+        KisDataManager dstDM(pixelSize, defaultPixel, dstTileSize);
+        QVERIFY(dstDM.read(fakeStore.device()));
+        QVERIFY(checkContent(&dstDM));
+    }
+
+    // loading the usual tiles into the data manager with big tiles
+    {
+        KisDataManager srcDM(pixelSize, defaultPixel);
+        srcDM.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+        KoStoreFake fakeStore;
+        KisFakePaintDeviceWriter writer(&fakeStore);
+        QVERIFY(srcDM.write(writer));
+
+        fakeStore.startReading();
+
+        KisDataManager dstDM(pixelSize, defaultPixel, tileSize);
+        QVERIFY(dstDM.read(fakeStore.device()));
+        QVERIFY(checkContent(&dstDM));
+    }
+
+    dm->rollback(memento);
+    QVERIFY(checkDefaultPixel(dm.data(), rc));
+    QCOMPARE(dm->extent(), QRect());
+}
+
+void KisTiledDataManagerTest::testPrefetchTiles()
+{
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm(1, &defaultPixel);
+
+    const QRect rc(0, 0, 256, 256);
+    QByteArray bytes(rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 3) % 83);
+    }
+    dm.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    KisTileDataStore *store = KisTileDataStore::instance();
+    store->debugSwapAll();
+
+    auto isSwapped = [&dm] (qint32 col, qint32 row) {
+        KisTileSP tile = dm.getOldTile(col, row);
+        return !tile->tileData()->data();
+    };
+
+    QVERIFY(isSwapped(0, 0));
+    QVERIFY(isSwapped(1, 1));
+    QVERIFY(isSwapped(3, 3));
+
+    dm.prefetchTiles(QRect(10, 10, 100, 100));
+    QVERIFY(store->testingWaitForPrefetcher());
+
+    QVERIFY(!isSwapped(0, 0));
+    QVERIFY(!isSwapped(1, 0));
+    QVERIFY(!isSwapped(0, 1));
+    QVERIFY(!isSwapped(1, 1));
+    QVERIFY(isSwapped(2, 2));
+    QVERIFY(isSwapped(3, 3));
+
+    // prefetching of non-existent tiles should do nothing
+    dm.prefetchTiles(QRect(1000, 1000, 100, 100));
+    QVERIFY(store->testingWaitForPrefetcher());
+
+    QByteArray result(bytes.size(), 0);
+    dm.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    QVERIFY(result == bytes);
+}
+
+void KisTiledDataManagerTest::testDeduplication()
+{
+    KisTileDataDeduplicator *deduplicator = KisTileDataDeduplicator::instance();
+
+    // only the data managers created after enabling are registered
+    const bool wasEnabled = deduplicator->isEnabled();
+    deduplicator->setEnabled(true);
+
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm1(1, &defaultPixel);
+    KisTiledDataManager dm2(1, &defaultPixel);
+
+    deduplicator->setEnabled(wasEnabled);
+
+    const QRect rc(0, 0, 128, 64);
+    QByteArray bytes(rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 3) % 83);
+    }
+    dm1.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    dm2.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+    // the second tile of dm2 differs from the one of dm1
+    const quint8 otherPixel = 250;
+    dm2.setPixel(100, 10, &otherPixel);
+
+    QVERIFY(dm1.getOldTile(0, 0)->tileData() != dm2.getOldTile(0, 0)->tileData());
+
+    const KisTileDataDeduplicator::Statistics statsBefore = deduplicator->statistics();
+
+    QVERIFY(deduplicator->deduplicate() >= 1);
+
+    QCOMPARE(dm1.getOldTile(0, 0)->tileData(), dm2.getOldTile(0, 0)->tileData());
+    QVERIFY(dm1.getOldTile(1, 0)->tileData() != dm2.getOldTile(1, 0)->tileData());
+    QVERIFY(deduplicator->statistics().numMergedTiles > statsBefore.numMergedTiles);
+
+    // writing into the shared tile should not affect the other device
+    const quint8 newPixel = 200;
+    dm2.setPixel(5, 5, &newPixel);
+
+    QVERIFY(dm1.getOldTile(0, 0)->tileData() != dm2.getOldTile(0, 0)->tileData());
+
+    QByteArray result(bytes.size(), 0);
+    dm1.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+    QVERIFY(result == bytes);
+
+    quint8 pixel = 0;
+    dm2.readBytes(&pixel, 5, 5, 1, 1);
+    QCOMPARE(pixel, newPixel);
+}
+
+void KisTiledDataManagerTest::testDeduplicationWhileCopying()
+{
+    KisTileDataDeduplicator *deduplicator = KisTileDataDeduplicator::instance();
+
+    const bool wasEnabled = deduplicator->isEnabled();
+    deduplicator->setEnabled(true);
+
+    quint8 defaultPixel = 0;
+    KisTiledDataManager dm1(1, &defaultPixel);
+    KisTiledDataManager dm2(1, &defaultPixel);
+
+    const QRect rc(0, 0, 512, 512);
+    QByteArray bytes(rc.width() * rc.height(), 0);
+    for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char((i / 3) % 83);
+    }
+
+    QAtomicInt stop(0);
+    QAtomicInt numPasses(0);
+
+    QScopedPointer<QThread> deduplicationThread(
+        QThread::create([&] () {
+            while (!stop.loadAcquire()) {
+                deduplicator->deduplicate();
+                numPasses.ref();
+            }
+        }));
+
+    deduplicationThread->start();
+
+    // the thread should be stopped before leaving the test, so don't
+    // QVERIFY inside the loop
+    bool contentIsCorrect = true;
+
+    for (int i = 0; i < 200 && contentIsCorrect; i++) {
+        /**
+         * Rewrite the devices, so that the deduplicator has to merge
+         * their tiles again, while the devices are being copied
+         */
+        dm1.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        dm2.writeBytes((quint8*)bytes.data(), rc.x(), rc.y(), rc.width(), rc.height());
+
+        KisTiledDataManager copy1(dm1);
+        KisTiledDataManager copy2(dm2);
+
+        QByteArray result(bytes.size(), 0);
+        copy1.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        contentIsCorrect &= result == bytes;
+
+        copy2.readBytes((quint8*)result.data(), rc.x(), rc.y(), rc.width(), rc.height());
+        contentIsCorrect &= result == bytes;
+    }
+
+    stop.storeRelease(1);
+    deduplicationThread->wait();
+
+    deduplicator->setEnabled(wasEnabled);
+
+    QVERIFY(contentIsCorrect);
+    QVERIFY(numPasses.loadAcquire() > 0);
+}
+
 //#include <valgrind/callgrind.h>
 
 void KisTiledDataManagerTest::benchmarkReadOnlyTileLazy()
@@ -40,6 +40,15 @@ private Q_SLOTS:
     void testTransactions();
     void testPurgeHistory();
     void testUndoSetDefaultPixel();
+    void testParallelSerialization();
+    void testTileCompressionCodecs();
+    void testReadForeignTileSize_data();
+    void testReadForeignTileSize();
+    void testBigTiles_data();
+    void testBigTiles();
+    void testPrefetchTiles();
+    void testDeduplication();
+    void testDeduplicationWhileCopying();
 
     void benchmarkReadOnlyTileLazy();
     void benchmarkSharedPointers();
@@ -10,8 +10,13 @@
 #include "xsimd_generic_details.hpp"
 
 #include <array>
+#include <limits>
 #include <type_traits>
 
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
 namespace xsimd
 {
 /***********************
@@ -127,6 +132,103 @@ inline batch<T, A> pow2 (batch<T, A> const& self) noexcept
 {
     return self * self;
 }
+
+/**************************
+ * Half-float conversions *
+ **************************/
+
+namespace kernel
+{
+namespace detail
+{
+// Branchless versions of the "fast" conversions by F. Giesen, they are
+// exact and don't depend on the denormals flushing mode of the FPU
+template<typename A, typename Enable = void>
+struct half_converter {
+    using int_v = batch<int32_t, A>;
+    using float_v = batch<float, A>;
+
+    static inline float_v load(const uint16_t *src) noexcept
+    {
+        const int_v h = int_v::load_unaligned(src);
+
+        const int_v shiftedExp(0x7c00 << 13);
+        const int_v magic(113 << 23);
+
+        int_v o = (h & int_v(0x7fff)) << 13;
+        const int_v exp = o & shiftedExp;
+        o += int_v((127 - 15) << 23);
+
+        // Inf/NaN
+        o = select(exp == shiftedExp, o + int_v((128 - 16) << 23), o);
+
+        // zero/denormal, renormalize through the float arithmetic
+        const int_v denormal = bitwise_cast<int_v>(bitwise_cast<float_v>(o + int_v(1 << 23)) - bitwise_cast<float_v>(magic));
+        o = select(exp == int_v(0), denormal, o);
+
+        return bitwise_cast<float_v>(o | ((h & int_v(0x8000)) << 16));
+    }
+
+    static inline void store(uint16_t *dst, float_v const &self) noexcept
+    {
+        const int_v f32infty(255 << 23);
+        const int_v f16max((127 + 16) << 23);
+        const int_v f16minNormal(113 << 23);
+        const int_v denormMagic(((127 - 15) + (23 - 10) + 1) << 23);
+
+        int_v f = bitwise_cast<int_v>(self);
+        const int_v sign = f & int_v(std::numeric_limits<int32_t>::min());
+        f = f ^ sign;
+
+        // NaN becomes a quiet NaN, too big values become Inf
+        const int_v infNan = select(f > f32infty, int_v(0x7e00), int_v(0x7c00));
+
+        // zero/denormal, let the float adder do the rounding
+        const int_v denormal = bitwise_cast<int_v>(bitwise_cast<float_v>(f) + bitwise_cast<float_v>(denormMagic)) - denormMagic;
+
+        // normal, rebias the exponent and round to the nearest even
+        const int_v mantissaOdd = (f >> 13) & int_v(1);
+        const int_v normal = (f + int_v(0xfff - (112 << 23)) + mantissaOdd) >> 13;
+
+        int_v o = select(f < f16minNormal, denormal, normal);
+        o = select(f >= f16max, infNan, o);
+        o = o | ((sign >> 16) & int_v(0x8000));
+
+        o.store_unaligned(dst);
+    }
+};
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+// All the CPUs supporting AVX2 also support F16C
+template<typename A>
+struct half_converter<A, typename std::enable_if<std::is_base_of<avx, A>::value>::type> {
+    using float_v = batch<float, A>;
+
+    static inline float_v load(const uint16_t *src) noexcept
+    {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)));
+    }
+
+    static inline void store(uint16_t *dst, float_v const &self) noexcept
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm256_cvtps_ph(self, _MM_FROUND_TO_NEAREST_INT));
+    }
+};
+#endif
+} // namespace detail
+} // namespace kernel
+
+template<typename A>
+inline batch<float, A> load_half_unaligned(const uint16_t *src) noexcept
+{
+    return kernel::detail::half_converter<A>::load(src);
+}
+
+template<typename A>
+inline void store_half_unaligned(uint16_t *dst, batch<float, A> const &self) noexcept
+{
+    kernel::detail::half_converter<A>::store(dst, self);
+}
 }; // namespace xsimd
 
 #endif
@@ -68,6 +68,20 @@ inline std::pair<V, V> interleave(const V &a, const V &b) noexcept;
 template<typename T, typename A>
 inline xsimd::batch<T, A> pow2(xsimd::batch<T, A> const &self) noexcept;
 
+/**************************
+ * Half-float conversions *
+ **************************/
+
+// Load `batch<float, A>::size` IEEE 754 half floats, passed as their raw
+// bits, and convert them into floats.
+template<typename A>
+inline batch<float, A> load_half_unaligned(const uint16_t *src) noexcept;
+
+// Convert the floats into IEEE 754 half floats with rounding to the nearest
+// even and store their raw bits.
+template<typename A>
+inline void store_half_unaligned(uint16_t *dst, batch<float, A> const &self) noexcept;
+
 namespace kernel
 {
 namespace detail
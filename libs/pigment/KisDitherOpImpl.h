@@ -18,12 +18,16 @@
 #endif
 
 #include <KoColorModelStandardIds.h>
+#include <KoColorModelStandardIdsUtils.h>
 #include <KoColorSpace.h>
 #include <KoColorSpaceMaths.h>
 #include <KoColorSpaceTraits.h>
 
 #include "KisDitherOp.h"
 #include "KisDitherMaths.h"
+#include "KisDitherRowKernelBase.h"
+#include "KisDitherRowKernelFactory.h"
+#include "KoOptimizedPixelDataScalerF16ToF32Factory.h"
 
 template<typename srcCSTraits, typename dstCSTraits, DitherType dType> class KisDitherOpImpl : public KisDitherOp
 {
@@ -34,6 +38,8 @@ public:
     KisDitherOpImpl(const KoID &srcId, const KoID &dstId)
         : m_srcDepthId(srcId)
         , m_dstDepthId(dstId)
+        , m_rowKernel(createRowKernel())
+        , m_halfScaler(createHalfScaler())
     {
     }
 
@@ -64,6 +70,46 @@ public:
 
 private:
     const KoID m_srcDepthId, m_dstDepthId;
+    const QScopedPointer<KisDitherRowKernelBase> m_rowKernel;
+    const QScopedPointer<KoOptimizedPixelDataScalerF16ToF32Base> m_halfScaler;
+
+    /**
+     * The most common conversions (16- and 32-bit RGBA and GrayA into
+     * 8-bit, including F16) have vectorized row kernels
+     */
+    static KisDitherRowKernelBase *createRowKernel()
+    {
+        if (dType == DITHER_NONE
+            || !std::is_same<dstChannelsType, quint8>::value
+            || srcCSTraits::channels_nb != dstCSTraits::channels_nb) {
+
+            return nullptr;
+        }
+
+        return KisDitherRowKernelFactory::create(colorDepthIdForChannelType<srcChannelsType>(),
+                                                 srcCSTraits::channels_nb,
+                                                 dType);
+    }
+
+    /**
+     * Undithered conversions between F16 and F32 are done in bulk
+     * by a vectorized scaler
+     */
+    static KoOptimizedPixelDataScalerF16ToF32Base *createHalfScaler()
+    {
+#ifdef HAVE_OPENEXR
+        constexpr bool isHalfToFloat = std::is_same<srcChannelsType, half>::value && std::is_same<dstChannelsType, float>::value;
+        constexpr bool isFloatToHalf = std::is_same<srcChannelsType, float>::value && std::is_same<dstChannelsType, half>::value;
+
+        if (dType == DITHER_NONE
+            && (isHalfToFloat || isFloatToHalf)
+            && srcCSTraits::channels_nb == dstCSTraits::channels_nb) {
+
+            return KoOptimizedPixelDataScalerF16ToF32Factory::createScaler(srcCSTraits::channels_nb);
+        }
+#endif
+        return nullptr;
+    }
 
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr> inline void ditherImpl(const quint8 *src, quint8 *dst, int, int) const
     {
@@ -113,6 +159,15 @@ private:
     template<DitherType t = dType, typename std::enable_if<t == DITHER_NONE && !std::is_same<srcCSTraits, dstCSTraits>::value, void>::type * = nullptr>
     inline void ditherImpl(const quint8 *srcRowStart, int srcRowStride, quint8 *dstRowStart, int dstRowStride, int, int, int columns, int rows) const
     {
+        if (m_halfScaler) {
+            if (std::is_same<srcChannelsType, float>::value) {
+                m_halfScaler->convertF32ToF16(srcRowStart, srcRowStride, dstRowStart, dstRowStride, rows, columns);
+            } else {
+                m_halfScaler->convertF16ToF32(srcRowStart, srcRowStride, dstRowStart, dstRowStride, rows, columns);
+            }
+            return;
+        }
+
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
@@ -140,6 +195,16 @@ private:
         const quint8 *nativeSrc = srcRowStart;
         quint8 *nativeDst = dstRowStart;
 
+        if (m_rowKernel) {
+            for (int a = 0; a < rows; ++a) {
+                m_rowKernel->ditherRow(nativeSrc, nativeDst, x, y + a, columns);
+
+                nativeSrc += srcRowStride;
+                nativeDst += dstRowStride;
+            }
+            return;
+        }
+
         float s = scale();
 
         for (int a = 0; a < rows; ++a) {
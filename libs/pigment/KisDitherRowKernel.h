@@ -0,0 +1,186 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDITHERROWKERNEL_H
+#define KISDITHERROWKERNEL_H
+
+#include "KisDitherRowKernelBase.h"
+
+#include <KoColorSpaceMaths.h>
+#include <KoMultiArchBuildSupport.h>
+
+#include "KisDitherOp.h"
+#include "KisDitherMaths.h"
+
+namespace KisDitherRowKernelDetail
+{
+template<DitherType dType>
+inline float factor(int x, int y);
+
+template<>
+inline float factor<DITHER_BAYER>(int x, int y)
+{
+    return KisDitherMaths::dither_factor_bayer_8(x, y);
+}
+
+template<>
+inline float factor<DITHER_BLUE_NOISE>(int x, int y)
+{
+    return KisDitherMaths::dither_factor_blue_noise_64(x, y);
+}
+
+/**
+ * The same as KisDitherOpImpl::scale() for 8-bit destination
+ */
+constexpr float scale()
+{
+    return 1.f / static_cast<float>(1 << 8);
+}
+
+template<typename srcChannelsType>
+inline quint8 ditherChannel(srcChannelsType value, float f)
+{
+    float c = KoColorSpaceMaths<srcChannelsType, float>::scaleToA(value);
+    c = KisDitherMaths::apply_dither(c, f, scale());
+    return KoColorSpaceMaths<float, quint8>::scaleToA(c);
+}
+} // namespace KisDitherRowKernelDetail
+
+template<typename srcChannelsType,
+         int numChannels,
+         DitherType dType,
+         typename _impl,
+         typename EnableDummyType = void>
+class KisDitherRowKernel : public KisDitherRowKernelBase
+{
+public:
+    void ditherRow(const quint8 *src, quint8 *dst, int x, int y, int columns) const override
+    {
+        const srcChannelsType *srcPtr = reinterpret_cast<const srcChannelsType *>(src);
+
+        for (int i = 0; i < columns; i++) {
+            const float f = KisDitherRowKernelDetail::factor<dType>(x + i, y);
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                dst[ch] = KisDitherRowKernelDetail::ditherChannel(srcPtr[ch], f);
+            }
+
+            srcPtr += numChannels;
+            dst += numChannels;
+        }
+    }
+};
+
+#ifdef HAVE_XSIMD
+
+#include "KoStreamedMath.h"
+
+/**
+ * The channels of the row are processed as a flat array, so the dither
+ * factor of a pixel is repeated for every of its channels. The factors are
+ * precomputed for one period of the dither pattern (64 pixels for blue
+ * noise, 8 for Bayer), which is small enough to be rebuilt for every row.
+ *
+ * The arithmetic repeats KisDitherMaths::apply_dither() and
+ * KoColorSpaceMaths::scaleToA() operation by operation. The dither scale is
+ * a power of two, so the product in apply_dither() is exact and the result
+ * doesn't depend on whether the compiler fuses it into an FMA or not.
+ */
+template<typename srcChannelsType, int numChannels, DitherType dType, typename _impl>
+class KisDitherRowKernel<srcChannelsType,
+                         numChannels,
+                         dType,
+                         _impl,
+                         typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KisDitherRowKernelBase
+{
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+    static constexpr int periodPixels = 64;
+    static constexpr int periodChannels = periodPixels * numChannels;
+
+    static_assert(periodChannels % vectorSize == 0,
+                  "a vector should never cross the period of the dither pattern");
+
+public:
+    void ditherRow(const quint8 *src, quint8 *dst, int x, int y, int columns) const override
+    {
+        alignas(64) float factors[periodChannels];
+
+        const int numPatternPixels = qMin(columns, static_cast<int>(periodPixels));
+
+        for (int i = 0; i < numPatternPixels; i++) {
+            const float f = KisDitherRowKernelDetail::factor<dType>(x + i, y);
+
+            for (int ch = 0; ch < numChannels; ch++) {
+                factors[i * numChannels + ch] = f;
+            }
+        }
+
+        const srcChannelsType *srcPtr = reinterpret_cast<const srcChannelsType *>(src);
+
+        const int numValues = columns * numChannels;
+        const int numBlocks = numValues / vectorSize;
+        const int numTailValues = numValues % vectorSize;
+
+        const float_v scale(KisDitherRowKernelDetail::scale());
+        const float_v zero(0.0f);
+        const float_v unitValue(255.0f);
+        const float_v half(0.5f);
+
+        int factorIndex = 0;
+
+        for (int i = 0; i < numBlocks; i++) {
+            float_v c = loadNormalized(srcPtr);
+            const float_v f = float_v::load_aligned(factors + factorIndex);
+
+            c = c + (f - c) * scale;
+
+            float_v v = c * unitValue;
+            v = xsimd::min(xsimd::max(v, zero), unitValue);
+
+            const int_v result = xsimd::batch_cast<int>(v + half);
+            result.store_unaligned(dst);
+
+            srcPtr += vectorSize;
+            dst += vectorSize;
+
+            factorIndex += vectorSize;
+            if (factorIndex >= periodChannels) {
+                factorIndex = 0;
+            }
+        }
+
+        for (int i = 0; i < numTailValues; i++) {
+            dst[i] = KisDitherRowKernelDetail::ditherChannel(srcPtr[i], factors[factorIndex + i]);
+        }
+    }
+
+private:
+    static ALWAYS_INLINE float_v loadNormalized(const quint16 *ptr)
+    {
+        // KoLuts::Uint16ToFloat uses a true division as well
+        return xsimd::to_float(int_v::load_unaligned(ptr)) / float_v(65535.0f);
+    }
+
+    static ALWAYS_INLINE float_v loadNormalized(const float *ptr)
+    {
+        return float_v::load_unaligned(ptr);
+    }
+
+#ifdef HAVE_OPENEXR
+    static ALWAYS_INLINE float_v loadNormalized(const half *ptr)
+    {
+        return xsimd::load_half_unaligned<_impl>(reinterpret_cast<const quint16 *>(ptr));
+    }
+#endif
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KISDITHERROWKERNEL_H
@@ -0,0 +1,11 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDitherRowKernelBase.h"
+
+KisDitherRowKernelBase::~KisDitherRowKernelBase()
+{
+}
@@ -0,0 +1,30 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDITHERROWKERNELBASE_H
+#define KISDITHERROWKERNELBASE_H
+
+#include "kritapigment_export.h"
+#include <QtGlobal>
+
+/**
+ * Dithers rows of pixels with 16- or 32-bit channels into pixels with
+ * 8-bit channels. Used by KisDitherOpImpl for the most common pairs of
+ * color depths, the result is exactly the same as the one of the scalar
+ * KisDitherOpImpl::dither().
+ */
+class KRITAPIGMENT_EXPORT KisDitherRowKernelBase
+{
+public:
+    virtual ~KisDitherRowKernelBase();
+
+    /**
+     * Dithers \p columns pixels of the row starting at \p x, \p y
+     */
+    virtual void ditherRow(const quint8 *src, quint8 *dst, int x, int y, int columns) const = 0;
+};
+
+#endif // KISDITHERROWKERNELBASE_H
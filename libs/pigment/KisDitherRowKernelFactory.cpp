@@ -0,0 +1,61 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDitherRowKernelFactory.h"
+
+#include <KoColorModelStandardIds.h>
+#include <KoConfig.h>
+
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+#include "KisDitherRowKernelFactoryImpl.h"
+
+namespace {
+template<typename srcChannelsType, int numChannels>
+KisDitherRowKernelBase* createForType(DitherType type, bool forceScalar)
+{
+    if (type == DITHER_BAYER) {
+        return createOptimizedClass<
+                KisDitherRowKernelFactoryImpl<
+                    srcChannelsType, numChannels, DITHER_BAYER>>(0, forceScalar);
+    } else if (type == DITHER_BLUE_NOISE) {
+        return createOptimizedClass<
+                KisDitherRowKernelFactoryImpl<
+                    srcChannelsType, numChannels, DITHER_BLUE_NOISE>>(0, forceScalar);
+    }
+
+    return nullptr;
+}
+
+template<typename srcChannelsType>
+KisDitherRowKernelBase* createForChannels(int numChannels, DitherType type, bool forceScalar)
+{
+    if (numChannels == 4) {
+        return createForType<srcChannelsType, 4>(type, forceScalar);
+    } else if (numChannels == 2) {
+        return createForType<srcChannelsType, 2>(type, forceScalar);
+    }
+
+    return nullptr;
+}
+}
+
+KisDitherRowKernelBase *KisDitherRowKernelFactory::create(const KoID &srcDepthId, int numChannels, DitherType type, bool forceScalar)
+{
+    if (srcDepthId == Integer16BitsColorDepthID) {
+        return createForChannels<quint16>(numChannels, type, forceScalar);
+    } else if (srcDepthId == Float32BitsColorDepthID) {
+        return createForChannels<float>(numChannels, type, forceScalar);
+#ifdef HAVE_OPENEXR
+    } else if (srcDepthId == Float16BitsColorDepthID) {
+        return createForChannels<half>(numChannels, type, forceScalar);
+#endif
+    }
+
+    return nullptr;
+}
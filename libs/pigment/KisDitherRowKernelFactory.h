@@ -0,0 +1,33 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDITHERROWKERNELFACTORY_H
+#define KISDITHERROWKERNELFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+#include <KisDitherOp.h>
+
+class KisDitherRowKernelBase;
+
+class KRITAPIGMENT_EXPORT KisDitherRowKernelFactory
+{
+public:
+    /**
+     * Creates a kernel dithering rows of pixels with \p numChannels
+     * channels of \p srcDepthId into 8-bit pixels. Only U16, F16 and F32
+     * sources with 2 (GrayA) or 4 (RGBA, LabA, ...) channels and Bayer
+     * or blue noise dithering are supported, for everything else nullptr
+     * is returned.
+     *
+     * \p forceScalar forces the generic (non-vectorized) implementation,
+     * used for benchmarking and testing.
+     */
+    static KisDitherRowKernelBase* create(const KoID &srcDepthId, int numChannels, DitherType type, bool forceScalar = false);
+};
+
+#endif // KISDITHERROWKERNELFACTORY_H
@@ -0,0 +1,39 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDitherRowKernelFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KisDitherRowKernel.h"
+
+template<typename srcChannelsType,
+         int numChannels,
+         DitherType dType>
+template<typename _impl>
+KisDitherRowKernelBase*
+KisDitherRowKernelFactoryImpl<srcChannelsType, numChannels, dType>::create(int)
+{
+    return new KisDitherRowKernel<srcChannelsType, numChannels, dType, _impl>();
+}
+
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<quint16, 4, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<quint16, 4, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<float,   4, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<float,   4, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<quint16, 2, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<quint16, 2, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<float,   2, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<float,   2, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+
+#ifdef HAVE_OPENEXR
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<half,    4, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<half,    4, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<half,    2, DITHER_BAYER>::create<xsimd::current_arch>(int);
+template KisDitherRowKernelBase* KisDitherRowKernelFactoryImpl<half,    2, DITHER_BLUE_NOISE>::create<xsimd::current_arch>(int);
+#endif
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
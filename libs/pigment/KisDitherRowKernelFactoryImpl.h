@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KISDITHERROWKERNELFACTORYIMPL_H
+#define KISDITHERROWKERNELFACTORYIMPL_H
+
+#include <KisDitherRowKernelBase.h>
+#include <KisDitherOp.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename srcChannelsType,
+         int numChannels,
+         DitherType dType>
+class KRITAPIGMENT_EXPORT KisDitherRowKernelFactoryImpl
+{
+public:
+    using ParamType = int;
+    using ReturnType = KisDitherRowKernelBase *;
+
+    template<typename _impl>
+    static KisDitherRowKernelBase* create(int);
+};
+
+#endif // KISDITHERROWKERNELFACTORYIMPL_H
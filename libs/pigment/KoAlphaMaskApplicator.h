@@ -153,6 +153,238 @@ struct KoAlphaMaskApplicator<
     }
 };
 
+namespace KoAlphaMaskApplicatorDetail
+{
+
+/**
+ * Vector arithmetic on the alpha channel that repeats the scalar
+ * KoColorSpaceMaths functions bit-exactly. The integer channels are
+ * processed in 32-bit lanes, which is enough to hold the intermediate
+ * products of both 8- and 16-bit multiplication.
+ */
+template<typename channels_type, typename _impl>
+struct VectorAlphaOps;
+
+template<typename _impl>
+struct VectorAlphaOps<quint8, _impl>
+{
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using value_v = typename KoStreamedMath<_impl>::uint_v;
+    using value_type = quint32;
+
+    static ALWAYS_INLINE value_v fromFloat(float_v value)
+    {
+        // the same truncation as in channels_type(float) conversion
+        return xsimd::bitwise_cast<value_v>(xsimd::batch_cast<int>(value));
+    }
+
+    static ALWAYS_INLINE value_v multiply(value_v a, value_v b)
+    {
+        // UINT8_MULT()
+        const value_v c = a * b + 0x80u;
+        return ((c >> 8) + c) >> 8;
+    }
+};
+
+template<typename _impl>
+struct VectorAlphaOps<quint16, _impl>
+{
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using value_v = typename KoStreamedMath<_impl>::uint_v;
+    using value_type = quint32;
+
+    static ALWAYS_INLINE value_v fromFloat(float_v value)
+    {
+        return xsimd::bitwise_cast<value_v>(xsimd::batch_cast<int>(value));
+    }
+
+    static ALWAYS_INLINE value_v multiply(value_v a, value_v b)
+    {
+        // UINT16_MULT(), 0xFFFF * 0xFFFF + 0x8000 still fits into 32 bits
+        const value_v c = a * b + 0x8000u;
+        return ((c >> 16) + c) >> 16;
+    }
+};
+
+template<typename _impl>
+struct VectorAlphaOps<float, _impl>
+{
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using value_v = float_v;
+    using value_type = float;
+
+    static ALWAYS_INLINE value_v fromFloat(float_v value)
+    {
+        return value;
+    }
+
+    static ALWAYS_INLINE value_v multiply(value_v a, value_v b)
+    {
+        // KoColorSpaceMaths<float>::multiply() does it in doubles, but the
+        // product of two floats is exact there, so the rounding is the same
+        return a * b;
+    }
+};
+
+template<typename channels_type>
+struct HasVectorAlphaOps
+    : std::integral_constant<bool,
+                             std::is_same<channels_type, quint8>::value
+                                 || std::is_same<channels_type, quint16>::value
+                                 || std::is_same<channels_type, float>::value> {
+};
+
+} // namespace KoAlphaMaskApplicatorDetail
+
+/**
+ * A generic version of the applicator for all the other color spaces
+ * (Gray, CMYK, Lab, XYZ, YCbCr and 16-bit/float RGB). The pixels are not
+ * packed into a vector as in RGBA8 version, instead the alpha channels of
+ * a block of pixels are collected into a buffer, processed in a vector and
+ * spread back. The color channels in fill* methods are written with one
+ * copy of a pre-filled block of pixels.
+ *
+ * Half float channels are not handled here, they keep using the scalar
+ * loops of KoColorSpaceTrait.
+ */
+template<typename _channels_type_, int _channels_nb_, int _alpha_pos_, typename _impl>
+struct KoAlphaMaskApplicator<
+        _channels_type_, _channels_nb_, _alpha_pos_, _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value
+                                && KoAlphaMaskApplicatorDetail::HasVectorAlphaOps<_channels_type_>::value
+                                && !(std::is_same<_channels_type_, quint8>::value
+                                     && _channels_nb_ == 4 && _alpha_pos_ == 3)>::type>
+    : public KoAlphaMaskApplicatorBase
+{
+    using channels_type = _channels_type_;
+    using Trait = KoColorSpaceTrait<_channels_type_, _channels_nb_, _alpha_pos_>;
+    using AlphaOps = KoAlphaMaskApplicatorDetail::VectorAlphaOps<_channels_type_, _impl>;
+
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using uint_v = typename KoStreamedMath<_impl>::uint_v;
+    using value_v = typename AlphaOps::value_v;
+    using value_type = typename AlphaOps::value_type;
+
+    static constexpr int numChannels = _channels_nb_;
+    static constexpr int alphaPos = _alpha_pos_;
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+    static constexpr int pixelSize = static_cast<int>(Trait::pixelSize);
+
+    void applyInverseNormedFloatMask(quint8 *pixels,
+                                     const float *alpha,
+                                     qint32 nPixels) const override
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        const float_v unitValue(static_cast<float>(KoColorSpaceMathsTraits<channels_type>::unitValue));
+
+        alignas(64) value_type buf[vectorSize];
+
+        for (int i = 0; i < block1; i++) {
+            channels_type *alphaPtr = Trait::nativeArray(pixels) + alphaPos;
+
+            for (int j = 0; j < vectorSize; j++) {
+                buf[j] = alphaPtr[j * numChannels];
+            }
+
+            const float_v maskAlpha = float_v::load_unaligned(alpha);
+            const value_v valpha = AlphaOps::fromFloat(unitValue * (float_v(1.0f) - maskAlpha));
+            const value_v pixelAlpha = value_v::load_aligned(buf);
+
+            AlphaOps::multiply(pixelAlpha, valpha).store_aligned(buf);
+
+            for (int j = 0; j < vectorSize; j++) {
+                alphaPtr[j * numChannels] = static_cast<channels_type>(buf[j]);
+            }
+
+            pixels += vectorSize * pixelSize;
+            alpha += vectorSize;
+        }
+
+        Trait::applyInverseAlphaNormedFloatMask(pixels, alpha, block2);
+    }
+
+    void fillInverseAlphaNormedFloatMaskWithColor(quint8 * pixels,
+                                                  const float * alpha,
+                                                  const quint8 *brushColor,
+                                                  qint32 nPixels) const override
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        if (block1 > 0) {
+            const float_v unitValue(static_cast<float>(KoColorSpaceMathsTraits<channels_type>::unitValue));
+
+            alignas(64) quint8 colorBlock[vectorSize * pixelSize];
+            alignas(64) value_type buf[vectorSize];
+
+            for (int j = 0; j < vectorSize; j++) {
+                memcpy(colorBlock + j * pixelSize, brushColor, pixelSize);
+            }
+
+            for (int i = 0; i < block1; i++) {
+                memcpy(pixels, colorBlock, vectorSize * pixelSize);
+
+                const float_v maskAlpha = float_v::load_unaligned(alpha);
+                AlphaOps::fromFloat(unitValue * (float_v(1.0f) - maskAlpha)).store_aligned(buf);
+
+                channels_type *alphaPtr = Trait::nativeArray(pixels) + alphaPos;
+                for (int j = 0; j < vectorSize; j++) {
+                    alphaPtr[j * numChannels] = static_cast<channels_type>(buf[j]);
+                }
+
+                pixels += vectorSize * pixelSize;
+                alpha += vectorSize;
+            }
+        }
+
+        Trait::fillInverseAlphaNormedFloatMaskWithColor(pixels, alpha, brushColor, block2);
+    }
+
+    void fillGrayBrushWithColor(quint8 *dst, const QRgb *brush, quint8 *brushColor, qint32 nPixels) const override
+    {
+        const int block1 = nPixels / vectorSize;
+        const int block2 = nPixels % vectorSize;
+
+        if (block1 > 0) {
+            alignas(64) quint8 colorBlock[vectorSize * pixelSize];
+            alignas(64) quint32 buf[vectorSize];
+
+            for (int j = 0; j < vectorSize; j++) {
+                memcpy(colorBlock + j * pixelSize, brushColor, pixelSize);
+            }
+
+            const uint_v redChannelMask(0xFF);
+
+            for (int i = 0; i < block1; i++) {
+                memcpy(dst, colorBlock, vectorSize * pixelSize);
+
+                const auto maskPixels = uint_v::load_unaligned(reinterpret_cast<const quint32*>(brush));
+
+                const uint_v pixelAlpha = maskPixels >> 24;
+                const uint_v pixelRed = maskPixels & redChannelMask;
+
+                KoAlphaMaskApplicatorDetail::VectorAlphaOps<quint8, _impl>::multiply(redChannelMask - pixelRed, pixelAlpha)
+                    .store_aligned(buf);
+
+                channels_type *alphaPtr = Trait::nativeArray(dst) + alphaPos;
+                for (int j = 0; j < vectorSize; j++) {
+                    alphaPtr[j * numChannels] =
+                        KoColorSpaceMaths<quint8, channels_type>::scaleToA(static_cast<quint8>(buf[j]));
+                }
+
+                dst += vectorSize * pixelSize;
+                brush += vectorSize;
+            }
+        }
+
+        Trait::fillGrayBrushWithColor(dst, brush, brushColor, block2);
+    }
+};
+
 #endif /* HAVE_XSIMD */
 
 #endif // KOALPHAMASKAPPLICATOR_H
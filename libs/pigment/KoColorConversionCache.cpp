@@ -7,8 +7,8 @@
 #include "KoColorConversionCache.h"
 
 #include <QHash>
-#include <QList>
 #include <QMutex>
+#include <QSet>
 #include <QThreadStorage>
 
 #include <KoColorSpace.h>
@@ -32,6 +32,16 @@ struct KoColorConversionCacheKey {
                 && (conversionFlags == rhs.conversionFlags);
     }
 
+    /**
+     * Used by the thread-local cache, doesn't access the color
+     * spaces themselves
+     */
+    bool isSameAs(const KoColorConversionCacheKey& rhs) const {
+        return src == rhs.src && dst == rhs.dst
+                && renderingIntent == rhs.renderingIntent
+                && conversionFlags == rhs.conversionFlags;
+    }
+
     const KoColorSpace* src;
     const KoColorSpace* dst;
     KoColorConversionTransformation::Intent renderingIntent;
@@ -43,6 +53,13 @@ uint qHash(const KoColorConversionCacheKey& key)
     return qHash(key.src) + qHash(key.dst) + qHash(key.renderingIntent) + qHash(key.conversionFlags);
 }
 
+/**
+ * The transformation is reference-counted: the shared cache, every
+ * thread-local cache and every KoCachedColorConversionTransformation
+ * holding it own a reference. The transformation is deleted when the
+ * last reference is released, so the shared cache can drop it even
+ * when some threads still use it.
+ */
 struct KoColorConversionCache::CachedTransformation {
 
     CachedTransformation(KoColorConversionTransformation* _transfo)
@@ -53,23 +70,196 @@ struct KoColorConversionCache::CachedTransformation {
         delete transfo;
     }
 
-    bool isNotInUse() {
-        return !use;
+    void ref() {
+        use.ref();
+    }
+
+    void release() {
+        if (!use.deref()) {
+            delete this;
+        }
+    }
+
+    /**
+     * \return true if the only owner of the transformation is the
+     * shared cache. Should be called under the cache lock only.
+     */
+    bool isReferencedByCacheOnly() {
+        return use.loadAcquire() == 1;
     }
 
     KoColorConversionTransformation* transfo;
     QAtomicInt use;
+
+    // guarded by Private::cacheMutex
+    quint64 lastUsed = 0;
 };
 
-typedef QPair<KoColorConversionCacheKey, KoCachedColorConversionTransformation> FastPathCacheItem;
+struct KoColorConversionCache::LocalCache {
+    struct Item {
+        Item() : key(nullptr, nullptr, KoColorConversionTransformation::IntentPerceptual, KoColorConversionTransformation::Empty) {}
+
+        KoColorConversionCacheKey key;
+        CachedTransformation *transfo = nullptr;
+    };
+
+    LocalCache(KoColorConversionCache::Private *_owner, int _generation);
+    ~LocalCache();
+
+    CachedTransformation* find(const KoColorConversionCacheKey &key);
+    void add(const KoColorConversionCacheKey &key, CachedTransformation *transfo);
+    void clear();
+
+    KoColorConversionCache::Private *owner;
+    int generation;
+
+    // the most recently used item comes first
+    Item items[LocalCacheSize];
+    int numItems = 0;
+
+    /**
+     * The counters are written by the owning thread only, so
+     * they don't need any read-modify-write operations
+     */
+    QAtomicInteger<qint64> hits;
+    QAtomicInteger<qint64> misses;
+};
 
 struct KoColorConversionCache::Private {
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*> cache;
+    QHash<KoColorConversionCacheKey, CachedTransformation*> cache;
     QMutex cacheMutex;
 
-    QThreadStorage<FastPathCacheItem*> fastStorage;
+    QThreadStorage<LocalCache*> localCache;
+
+    /**
+     * Incremented every time a color space is destroyed, the thread-local
+     * caches with an older generation drop all their items
+     */
+    QAtomicInt generation;
+
+    // guarded by cacheMutex
+    quint64 tick = 0;
+    QSet<LocalCache*> localCaches;
+    Statistics totals;
+
+    LocalCache* currentLocalCache();
+    void unregisterLocalCache(LocalCache *local);
+    void evictUnusedTransformations();
 };
 
+KoColorConversionCache::LocalCache::LocalCache(KoColorConversionCache::Private *_owner, int _generation)
+    : owner(_owner),
+      generation(_generation)
+{
+}
+
+KoColorConversionCache::LocalCache::~LocalCache()
+{
+    clear();
+
+    if (owner) {
+        owner->unregisterLocalCache(this);
+    }
+}
+
+KoColorConversionCache::CachedTransformation*
+KoColorConversionCache::LocalCache::find(const KoColorConversionCacheKey &key)
+{
+    for (int i = 0; i < numItems; i++) {
+        if (items[i].key.isSameAs(key)) {
+            Item item = items[i];
+
+            for (int j = i; j > 0; j--) {
+                items[j] = items[j - 1];
+            }
+            items[0] = item;
+
+            return item.transfo;
+        }
+    }
+
+    return nullptr;
+}
+
+void KoColorConversionCache::LocalCache::add(const KoColorConversionCacheKey &key, CachedTransformation *transfo)
+{
+    if (numItems == LocalCacheSize) {
+        items[numItems - 1].transfo->release();
+        numItems--;
+    }
+
+    for (int j = numItems; j > 0; j--) {
+        items[j] = items[j - 1];
+    }
+
+    transfo->ref();
+    items[0].key = key;
+    items[0].transfo = transfo;
+    numItems++;
+}
+
+void KoColorConversionCache::LocalCache::clear()
+{
+    for (int i = 0; i < numItems; i++) {
+        items[i].transfo->release();
+        items[i] = Item();
+    }
+    numItems = 0;
+}
+
+KoColorConversionCache::LocalCache* KoColorConversionCache::Private::currentLocalCache()
+{
+    LocalCache *local = localCache.localData();
+
+    if (!local) {
+        local = new LocalCache(this, generation.loadAcquire());
+        localCache.setLocalData(local);
+
+        QMutexLocker lock(&cacheMutex);
+        localCaches.insert(local);
+    }
+
+    const int currentGeneration = generation.loadAcquire();
+
+    if (local->generation != currentGeneration) {
+        local->clear();
+        local->generation = currentGeneration;
+    }
+
+    return local;
+}
+
+void KoColorConversionCache::Private::unregisterLocalCache(LocalCache *local)
+{
+    QMutexLocker lock(&cacheMutex);
+
+    totals.hits += local->hits.load();
+    totals.misses += local->misses.load();
+    localCaches.remove(local);
+}
+
+void KoColorConversionCache::Private::evictUnusedTransformations()
+{
+    while (cache.size() > SharedCacheSize) {
+        auto victim = cache.end();
+
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if (it.value()->isReferencedByCacheOnly() &&
+                (victim == cache.end() || it.value()->lastUsed < victim.value()->lastUsed)) {
+
+                victim = it;
+            }
+        }
+
+        // all the transformations are still in use
+        if (victim == cache.end()) break;
+
+        victim.value()->release();
+        cache.erase(victim);
+        totals.evictions++;
+    }
+}
+
 
 KoColorConversionCache::KoColorConversionCache() : d(new Private)
 {
@@ -77,8 +267,13 @@ KoColorConversionCache::KoColorConversionCache() : d(new Private)
 
 KoColorConversionCache::~KoColorConversionCache()
 {
+    Q_FOREACH (LocalCache *local, d->localCaches) {
+        local->clear();
+        local->owner = nullptr;
+    }
+
     Q_FOREACH (CachedTransformation* transfo, d->cache) {
-        delete transfo;
+        transfo->release();
     }
     delete d;
 }
@@ -90,49 +285,54 @@ KoCachedColorConversionTransformation KoColorConversionCache::cachedConverter(co
 {
     KoColorConversionCacheKey key(src, dst, _renderingIntent, _conversionFlags);
 
-    FastPathCacheItem *cacheItem =
-        d->fastStorage.localData();
+    LocalCache *local = d->currentLocalCache();
 
-    if (cacheItem) {
-        if (cacheItem->first == key) {
-            return cacheItem->second;
-        }
+    CachedTransformation *ct = local->find(key);
+    if (ct) {
+        local->hits.store(local->hits.load() + 1);
+        return KoCachedColorConversionTransformation(ct);
     }
 
-    cacheItem = 0;
+    local->misses.store(local->misses.load() + 1);
 
     QMutexLocker lock(&d->cacheMutex);
-    QList< CachedTransformation* > cachedTransfos = d->cache.values(key);
-    if (cachedTransfos.size() != 0) {
-        Q_FOREACH (CachedTransformation* ct, cachedTransfos) {
-            ct->transfo->setSrcColorSpace(src);
-            ct->transfo->setDstColorSpace(dst);
-
-            cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(this, ct));
-            break;
-        }
-    }
-    if (!cacheItem) {
+
+    ct = d->cache.value(key, nullptr);
+
+    if (ct) {
+        ct->transfo->setSrcColorSpace(src);
+        ct->transfo->setDstColorSpace(dst);
+    } else {
         KoColorConversionTransformation* transfo = src->createColorConverter(dst, _renderingIntent, _conversionFlags);
-        CachedTransformation* ct = new CachedTransformation(transfo);
+        ct = new CachedTransformation(transfo);
+        ct->ref(); // the reference of the shared cache
         d->cache.insert(key, ct);
-        cacheItem = new FastPathCacheItem(key, KoCachedColorConversionTransformation(this, ct));
+        d->totals.creations++;
     }
 
-    d->fastStorage.setLocalData(cacheItem);
-    return cacheItem->second;
+    ct->lastUsed = ++d->tick;
+    local->add(key, ct);
+
+    d->evictUnusedTransformations();
+
+    return KoCachedColorConversionTransformation(ct);
 }
 
 void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
 {
-    d->fastStorage.setLocalData(0);
+    /**
+     * The thread-local caches are not accessible from here, so we just
+     * ask them to drop all their items on the next lookup. The shared
+     * cache releases its own references, the transformations still
+     * referenced by the thread-local caches are deleted when dropped.
+     */
+    d->generation.ref();
 
     QMutexLocker lock(&d->cacheMutex);
-    QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = d->cache.end();
-    for (QMultiHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = d->cache.begin(); it != endIt;) {
+    QHash< KoColorConversionCacheKey, CachedTransformation*>::iterator endIt = d->cache.end();
+    for (QHash< KoColorConversionCacheKey, CachedTransformation*>::iterator it = d->cache.begin(); it != endIt;) {
         if (it.key().src == cs || it.key().dst == cs) {
-            Q_ASSERT(it.value()->isNotInUse()); // That's terribely evil, if that assert fails, that means that someone is using a color transformation with a color space which is currently being deleted
-            delete it.value();
+            it.value()->release();
             it = d->cache.erase(it);
         } else {
             ++it;
@@ -140,35 +340,63 @@ void KoColorConversionCache::colorSpaceIsDestroyed(const KoColorSpace* cs)
     }
 }
 
-//--------- KoCachedColorConversionTransformation ----------//
+KoColorConversionCache::Statistics KoColorConversionCache::statistics() const
+{
+    QMutexLocker lock(&d->cacheMutex);
 
-struct KoCachedColorConversionTransformation::Private {
-    KoColorConversionCache* cache;
-    KoColorConversionCache::CachedTransformation* transfo;
-};
+    Statistics stats = d->totals;
 
+    Q_FOREACH (LocalCache *local, d->localCaches) {
+        stats.hits += local->hits.load();
+        stats.misses += local->misses.load();
+    }
+
+    return stats;
+}
 
-KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(KoColorConversionCache* cache, KoColorConversionCache::CachedTransformation* transfo) : d(new Private)
+void KoColorConversionCache::resetStatistics()
 {
-    d->cache = cache;
-    d->transfo = transfo;
-    d->transfo->use.ref();
+    QMutexLocker lock(&d->cacheMutex);
+
+    d->totals = Statistics();
+
+    Q_FOREACH (LocalCache *local, d->localCaches) {
+        local->hits.store(0);
+        local->misses.store(0);
+    }
+}
+
+//--------- KoCachedColorConversionTransformation ----------//
+
+KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(KoColorConversionCache::CachedTransformation* transfo)
+    : m_transfo(transfo)
+{
+    m_transfo->ref();
 }
 
-KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation& rhs) : d(new Private(*rhs.d))
+KoCachedColorConversionTransformation::KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation& rhs)
+    : m_transfo(rhs.m_transfo)
 {
-    d->transfo->use.ref();
+    m_transfo->ref();
+}
+
+KoCachedColorConversionTransformation& KoCachedColorConversionTransformation::operator=(const KoCachedColorConversionTransformation& rhs)
+{
+    if (m_transfo != rhs.m_transfo) {
+        rhs.m_transfo->ref();
+        m_transfo->release();
+        m_transfo = rhs.m_transfo;
+    }
+    return *this;
 }
 
 KoCachedColorConversionTransformation::~KoCachedColorConversionTransformation()
 {
-    Q_ASSERT(d->transfo->use > 0);
-    d->transfo->use.deref();
-    delete d;
+    Q_ASSERT(m_transfo->use > 0);
+    m_transfo->release();
 }
 
 const KoColorConversionTransformation* KoCachedColorConversionTransformation::transformation() const
 {
-    return d->transfo->transfo;
+    return m_transfo->transfo;
 }
-
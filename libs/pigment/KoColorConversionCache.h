@@ -11,16 +11,62 @@ class KoCachedColorConversionTransformation;
 class KoColorSpace;
 
 #include "KoColorConversionTransformation.h"
+#include "kritapigment_export.h"
 
 /**
  * This class holds a cache of KoColorConversionTransformations.
  *
+ * The cache has two levels. Every thread has a small private cache
+ * of the most recently used transformations, which is looked up
+ * without any locks (the color spaces are compared by pointers
+ * there). Only when the transformation is not found in it, the
+ * shared cache is looked up under the mutex.
+ *
+ * Eviction policy:
+ *
+ * - the thread-local cache keeps LocalCacheSize most recently used
+ *   transformations of the thread, the least recently used one is
+ *   dropped when a new one is added
+ *
+ * - the shared cache keeps SharedCacheSize transformations. When
+ *   the limit is exceeded, the least recently used transformations
+ *   not referenced by any thread-local cache or by any user are
+ *   deleted
+ *
+ * - the transformations of a destroyed color space are removed from
+ *   the shared cache immediately, the thread-local caches drop them
+ *   on their next lookup
+ *
  * This class is not part of public API, and can be changed without notice.
  */
-class KoColorConversionCache
+class KRITAPIGMENT_EXPORT KoColorConversionCache
 {
 public:
     struct CachedTransformation;
+
+    static const int LocalCacheSize = 8;
+    static const int SharedCacheSize = 64;
+
+    /**
+     * Counters of the cache lookups, used for profiling
+     */
+    struct Statistics {
+        /// the transformation has been found in the thread-local cache
+        qint64 hits = 0;
+
+        /// the transformation has not been found in the thread-local
+        /// cache, so the shared cache has been looked up
+        qint64 misses = 0;
+
+        /// the transformation has not been found in the shared cache
+        /// either, so it has been created
+        qint64 creations = 0;
+
+        /// the transformations deleted from the shared cache to keep
+        /// it under SharedCacheSize
+        qint64 evictions = 0;
+    };
+
 public:
     KoColorConversionCache();
     ~KoColorConversionCache();
@@ -45,7 +91,17 @@ public:
      * @param src source color space
      */
     void colorSpaceIsDestroyed(const KoColorSpace* src);
+
+    /**
+     * The counters are collected by every thread separately, so the
+     * values are exact only when no conversions happen concurrently
+     * with the call.
+     */
+    Statistics statistics() const;
+    void resetStatistics();
+
 private:
+    struct LocalCache;
     struct Private;
     Private* const d;
 };
@@ -55,22 +111,24 @@ private:
  * by the cache and when it's deleted it return the transformation to
  * the pool of available color conversion transformation.
  *
+ * Copying the object costs a single atomic increment, no allocations
+ * happen.
+ *
  * This class is not part of public API, and can be changed without notice.
  */
-class KoCachedColorConversionTransformation
+class KRITAPIGMENT_EXPORT KoCachedColorConversionTransformation
 {
     friend class KoColorConversionCache;
 private:
-    KoCachedColorConversionTransformation(KoColorConversionCache* cache,
-                                          KoColorConversionCache::CachedTransformation* transfo);
+    KoCachedColorConversionTransformation(KoColorConversionCache::CachedTransformation* transfo);
 public:
     KoCachedColorConversionTransformation(const KoCachedColorConversionTransformation&);
+    KoCachedColorConversionTransformation& operator=(const KoCachedColorConversionTransformation&);
     ~KoCachedColorConversionTransformation();
 public:
     const KoColorConversionTransformation* transformation() const;
 private:
-    struct Private;
-    Private* const d;
+    KoColorConversionCache::CachedTransformation* m_transfo;
 };
 
 
@@ -304,6 +304,19 @@ QBitArray KoColorSpace::channelFlags(bool color, bool alpha) const
     return ba;
 }
 
+void KoColorSpace::addPixelsToU8Histograms(const quint8 *pixels, quint32 nPixels, quint32 *bins) const
+{
+    const quint32 numChannels = channelCount();
+    const quint32 pixelSize = this->pixelSize();
+
+    for (quint32 i = 0; i < nPixels; i++) {
+        for (quint32 channel = 0; channel < numChannels; channel++) {
+            bins[channel * 256 + scaleToU8(pixels, channel)]++;
+        }
+        pixels += pixelSize;
+    }
+}
+
 void KoColorSpace::addChannel(KoChannelInfo * ci)
 {
     d->channels.push_back(ci);
@@ -178,6 +178,18 @@ public:
      */
     virtual quint8 scaleToU8(const quint8 * srcPixel, qint32 channelPos) const = 0;
 
+    /**
+     * Add \p nPixels pixels to the 8-bit histograms of all the channels
+     * of the color space at once. \p bins is an array of channelCount()
+     * histograms of 256 bins each, the histogram of a channel starts at
+     * offset channelPos * 256, where channelPos is the same as in
+     * scaleToU8().
+     *
+     * The default implementation calls scaleToU8() for every channel of
+     * every pixel, color spaces are expected to provide a faster version.
+     */
+    virtual void addPixelsToU8Histograms(const quint8 *pixels, quint32 nPixels, quint32 *bins) const;
+
     /**
      * Set dstPixel to the pixel containing only the given channel of srcPixel. The remaining channels
      * should be set to whatever makes sense for 'empty' channels of this color space,
@@ -22,6 +22,8 @@
 #include "KoConvolutionOpImpl.h"
 #include "KoInvertColorTransformation.h"
 #include "KoAlphaMaskApplicatorFactory.h"
+#include "KoOptimizedMixColorsOpFactory.h"
+#include "KoOptimizedPixelDataScalerF16ToF32Factory.h"
 #include "KoColorModelStandardIdsUtils.h"
 
 /**
@@ -42,8 +44,9 @@ public:
 
 public:
     KoColorSpaceAbstract(const QString &id, const QString &name)
-        : KoColorSpace(id, name, new KoMixColorsOpImpl< _CSTrait>(), new KoConvolutionOpImpl< _CSTrait>()),
-          m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos))
+        : KoColorSpace(id, name, createMixColorsOp(), new KoConvolutionOpImpl< _CSTrait>()),
+          m_alphaMaskApplicator(KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(), _CSTrait::channels_nb, _CSTrait::alpha_pos)),
+          m_halfScaler(createHalfScaler())
     {
     }
 
@@ -88,6 +91,19 @@ public:
         return KoColorSpaceMaths<typename _CSTrait::channels_type, quint8>::scaleToA(c);
     }
 
+    void addPixelsToU8Histograms(const quint8 *pixels, quint32 nPixels, quint32 *bins) const override {
+        typedef typename _CSTrait::channels_type channels_type;
+
+        for (quint32 i = 0; i < nPixels; i++) {
+            const channels_type *nativePixel = _CSTrait::nativeArray(pixels);
+
+            for (int channel = 0; channel < int(_CSTrait::channels_nb); channel++) {
+                bins[channel * 256 + KoColorSpaceMaths<channels_type, quint8>::scaleToA(nativePixel[channel])]++;
+            }
+            pixels += _CSTrait::pixelSize;
+        }
+    }
+
     void singleChannelPixel(quint8 *dstPixel, const quint8 *srcPixel, quint32 channelIndex) const override {
         _CSTrait::singleChannelPixel(dstPixel, srcPixel, channelIndex);
     }
@@ -193,6 +209,18 @@ public:
             case KoChannelInfo::UINT32:
                 scalePixels<_CSTrait::pixelSize, 4, channels_type, quint32>(src, dst, numPixels);
                 return true;
+            case KoChannelInfo::FLOAT16:
+                if (m_halfScaler && std::is_same<channels_type, float>::value) {
+                    m_halfScaler->convertF32ToF16(src, 0, dst, 0, 1, numPixels);
+                    return true;
+                }
+                break;
+            case KoChannelInfo::FLOAT32:
+                if (m_halfScaler && !std::is_same<channels_type, float>::value) {
+                    m_halfScaler->convertF16ToF32(src, 0, dst, 0, 1, numPixels);
+                    return true;
+                }
+                break;
             default:
                 break;
             }
@@ -246,8 +274,32 @@ private:
         }
     }
 
+    static KoMixColorsOp* createMixColorsOp() {
+        KoMixColorsOp *op =
+            KoOptimizedMixColorsOpFactory::create(colorDepthIdForChannelType<typename _CSTrait::channels_type>(),
+                                                  _CSTrait::channels_nb, _CSTrait::alpha_pos);
+
+        return op ? op : new KoMixColorsOpImpl<_CSTrait>();
+    }
+
+    /**
+     * F16 and F32 color spaces convert their pixels between each other
+     * in bulk, when only the depth differs, see convertPixelsTo()
+     */
+    static KoOptimizedPixelDataScalerF16ToF32Base* createHalfScaler() {
+#ifdef HAVE_OPENEXR
+        if (std::is_same<typename _CSTrait::channels_type, half>::value ||
+            std::is_same<typename _CSTrait::channels_type, float>::value) {
+
+            return KoOptimizedPixelDataScalerF16ToF32Factory::createScaler(_CSTrait::channels_nb);
+        }
+#endif
+        return nullptr;
+    }
+
 private:
     QScopedPointer<KoAlphaMaskApplicatorBase> m_alphaMaskApplicator;
+    QScopedPointer<KoOptimizedPixelDataScalerF16ToF32Base> m_halfScaler;
 };
 
 #endif // KOCOLORSPACEABSTRACT_H
@@ -0,0 +1,139 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOLUT3DINTERPOLATOR_H
+#define KOLUT3DINTERPOLATOR_H
+
+#include "KoLut3DInterpolatorBase.h"
+#include "KoMultiArchBuildSupport.h"
+
+template<typename _impl, typename EnableDummyType = void>
+struct KoLut3DInterpolator : public KoLut3DInterpolatorBase
+{
+    void interpolate(const float *lut, int gridSize,
+                     const float *src, float *dst,
+                     int numPixels, int numDstChannels) const override
+    {
+        interpolateScalar(lut, gridSize, src, dst, 0, numPixels, numDstChannels);
+    }
+};
+
+#ifdef HAVE_XSIMD
+
+#include "KoStreamedMath.h"
+
+/**
+ * Every lane of the vector processes its own pixel. The weights and
+ * the offsets of the tetrahedron nodes are calculated with vector
+ * instructions and the values of the nodes are gathered from the
+ * table lane-by-lane.
+ */
+template<typename _impl>
+struct KoLut3DInterpolator<
+        _impl,
+        typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type> : public KoLut3DInterpolatorBase
+{
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+
+    void interpolate(const float *lut, int gridSize,
+                     const float *src, float *dst,
+                     int numPixels, int numDstChannels) const override
+    {
+        constexpr int vectorSize = static_cast<int>(float_v::size);
+        const int block1 = numPixels / vectorSize;
+
+        const float_v zero(0.0f);
+        const float_v one(1.0f);
+        const float_v maxIndex(gridSize - 1);
+        const float_v maxBaseIndex(gridSize - 2);
+
+        const float strideB = NodeSize;
+        const float strideG = NodeSize * gridSize;
+        const float strideR = NodeSize * gridSize * gridSize;
+        const float strideRGB = strideR + strideG + strideB;
+
+        const float *srcR = src;
+        const float *srcG = src + numPixels;
+        const float *srcB = src + 2 * numPixels;
+
+        alignas(64) int index0[vectorSize];
+        alignas(64) int index1[vectorSize];
+        alignas(64) int index2[vectorSize];
+
+        alignas(64) float value0[vectorSize];
+        alignas(64) float value1[vectorSize];
+        alignas(64) float value2[vectorSize];
+        alignas(64) float value3[vectorSize];
+
+        for (int i = 0; i < block1 * vectorSize; i += vectorSize) {
+            const float_v r = xsimd::min(xsimd::max(float_v::load_unaligned(srcR + i), zero), one) * maxIndex;
+            const float_v g = xsimd::min(xsimd::max(float_v::load_unaligned(srcG + i), zero), one) * maxIndex;
+            const float_v b = xsimd::min(xsimd::max(float_v::load_unaligned(srcB + i), zero), one) * maxIndex;
+
+            const float_v r0 = xsimd::min(xsimd::floor(r), maxBaseIndex);
+            const float_v g0 = xsimd::min(xsimd::floor(g), maxBaseIndex);
+            const float_v b0 = xsimd::min(xsimd::floor(b), maxBaseIndex);
+
+            const float_v fr = r - r0;
+            const float_v fg = g - g0;
+            const float_v fb = b - b0;
+
+            const auto rGreaterG = fr >= fg;
+            const auto gGreaterB = fg >= fb;
+            const auto rGreaterB = fr >= fb;
+
+            // see KoLut3DInterpolatorBase::interpolateScalar()
+            const float_v offsetMax =
+                xsimd::select(rGreaterG & rGreaterB, float_v(strideR),
+                              xsimd::select(gGreaterB, float_v(strideG), float_v(strideB)));
+
+            const float_v offsetMin =
+                xsimd::select(rGreaterB & gGreaterB, float_v(strideB),
+                              xsimd::select(rGreaterG, float_v(strideG), float_v(strideR)));
+
+            const float_v fMax = xsimd::max(fr, xsimd::max(fg, fb));
+            const float_v fMin = xsimd::min(fr, xsimd::min(fg, fb));
+            const float_v fMid = fr + fg + fb - fMax - fMin;
+
+            const float_v w0 = one - fMax;
+            const float_v w1 = fMax - fMid;
+            const float_v w2 = fMid - fMin;
+            const float_v w3 = fMin;
+
+            // the offsets are small enough to be represented exactly in floats
+            const float_v base = r0 * float_v(strideR) + g0 * float_v(strideG) + b0 * float_v(strideB);
+
+            xsimd::batch_cast<int>(base).store_aligned(index0);
+            xsimd::batch_cast<int>(base + offsetMax).store_aligned(index1);
+            xsimd::batch_cast<int>(base + float_v(strideRGB) - offsetMin).store_aligned(index2);
+
+            const int offset3 = static_cast<int>(strideRGB);
+
+            for (int ch = 0; ch < numDstChannels; ch++) {
+                for (int k = 0; k < vectorSize; k++) {
+                    value0[k] = lut[index0[k] + ch];
+                    value1[k] = lut[index1[k] + ch];
+                    value2[k] = lut[index2[k] + ch];
+                    value3[k] = lut[index0[k] + offset3 + ch];
+                }
+
+                const float_v result =
+                    w0 * float_v::load_aligned(value0) +
+                    w1 * float_v::load_aligned(value1) +
+                    w2 * float_v::load_aligned(value2) +
+                    w3 * float_v::load_aligned(value3);
+
+                result.store_unaligned(dst + ch * numPixels + i);
+            }
+        }
+
+        interpolateScalar(lut, gridSize, src, dst, block1 * vectorSize, numPixels, numDstChannels);
+    }
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KOLUT3DINTERPOLATOR_H
@@ -0,0 +1,82 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoLut3DInterpolatorBase.h"
+
+#include <algorithm>
+#include <cmath>
+
+KoLut3DInterpolatorBase::KoLut3DInterpolatorBase()
+{
+}
+
+KoLut3DInterpolatorBase::~KoLut3DInterpolatorBase()
+{
+}
+
+void KoLut3DInterpolatorBase::interpolateScalar(const float *lut, int gridSize,
+                                                const float *src, float *dst,
+                                                int begin, int numPixels, int numDstChannels)
+{
+    const float maxIndex = gridSize - 1;
+
+    const int strideB = NodeSize;
+    const int strideG = NodeSize * gridSize;
+    const int strideR = NodeSize * gridSize * gridSize;
+    const int strideRGB = strideR + strideG + strideB;
+
+    const float *srcR = src;
+    const float *srcG = src + numPixels;
+    const float *srcB = src + 2 * numPixels;
+
+    for (int i = begin; i < numPixels; i++) {
+        const float r = qBound(0.0f, srcR[i], 1.0f) * maxIndex;
+        const float g = qBound(0.0f, srcG[i], 1.0f) * maxIndex;
+        const float b = qBound(0.0f, srcB[i], 1.0f) * maxIndex;
+
+        // the last cell is used for the values lying exactly on the upper border
+        const float r0 = std::min(std::floor(r), maxIndex - 1);
+        const float g0 = std::min(std::floor(g), maxIndex - 1);
+        const float b0 = std::min(std::floor(b), maxIndex - 1);
+
+        const float fr = r - r0;
+        const float fg = g - g0;
+        const float fb = b - b0;
+
+        /**
+         * Select the tetrahedron of the cell the point falls into:
+         * we walk from the origin of the cell to its opposite corner,
+         * first along the axis with the largest fraction, then along
+         * the middle one.
+         */
+        const int offsetMax =
+            fr >= fg && fr >= fb ? strideR :
+            fg >= fb ? strideG : strideB;
+
+        const int offsetMin =
+            fr >= fb && fg >= fb ? strideB :
+            fr >= fg ? strideG : strideR;
+
+        const float fMax = std::max(fr, std::max(fg, fb));
+        const float fMin = std::min(fr, std::min(fg, fb));
+        const float fMid = fr + fg + fb - fMax - fMin;
+
+        const float w0 = 1.0f - fMax;
+        const float w1 = fMax - fMid;
+        const float w2 = fMid - fMin;
+        const float w3 = fMin;
+
+        const float *c0 = lut + int(r0) * strideR + int(g0) * strideG + int(b0) * strideB;
+        const float *c1 = c0 + offsetMax;
+        const float *c2 = c0 + strideRGB - offsetMin;
+        const float *c3 = c0 + strideRGB;
+
+        for (int ch = 0; ch < numDstChannels; ch++) {
+            dst[ch * numPixels + i] =
+                w0 * c0[ch] + w1 * c1[ch] + w2 * c2[ch] + w3 * c3[ch];
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOLUT3DINTERPOLATORBASE_H
+#define KOLUT3DINTERPOLATORBASE_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Tetrahedral interpolation in a precomputed 3D lookup table
+ *
+ * The table is a cubic lattice of `gridSize^3` nodes, the red
+ * (first) coordinate changing the slowest. Every node holds
+ * `NodeSize` floats, the unused ones are just padding that keeps
+ * the nodes aligned.
+ *
+ * The source pixels are passed as three planes of `numPixels` floats
+ * each (the first, the second and the third coordinate), the values
+ * are clamped into [0, 1]. The result is written into
+ * `numDstChannels` planes of `numPixels` floats.
+ *
+ * The actual implementation is placed in class `KoLut3DInterpolator`,
+ * use KoLut3DInterpolatorFactory to create a version optimized for
+ * your CPU architecture.
+ */
+class KRITAPIGMENT_EXPORT KoLut3DInterpolatorBase
+{
+public:
+    static const int NodeSize = 4;
+
+    KoLut3DInterpolatorBase();
+    virtual ~KoLut3DInterpolatorBase();
+
+    virtual void interpolate(const float *lut, int gridSize,
+                             const float *src, float *dst,
+                             int numPixels, int numDstChannels) const = 0;
+
+protected:
+    /**
+     * Interpolates pixels [\p begin, \p numPixels) of the planes
+     * without any vectorization. Used for the tails of the vectorized
+     * implementations and as the generic implementation itself.
+     */
+    static void interpolateScalar(const float *lut, int gridSize,
+                                  const float *src, float *dst,
+                                  int begin, int numPixels, int numDstChannels);
+};
+
+#endif // KOLUT3DINTERPOLATORBASE_H
@@ -0,0 +1,14 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoLut3DInterpolatorFactory.h"
+
+#include "KoLut3DInterpolatorFactoryImpl.h"
+
+KoLut3DInterpolatorBase *KoLut3DInterpolatorFactory::create()
+{
+    return createOptimizedClass<KoLut3DInterpolatorFactoryImpl>(0);
+}
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOLUT3DINTERPOLATORFACTORY_H
+#define KOLUT3DINTERPOLATORFACTORY_H
+
+#include "KoLut3DInterpolatorBase.h"
+
+/**
+ * \see KoLut3DInterpolatorBase
+ */
+class KRITAPIGMENT_EXPORT KoLut3DInterpolatorFactory
+{
+public:
+    static KoLut3DInterpolatorBase* create();
+};
+
+#endif // KOLUT3DINTERPOLATORFACTORY_H
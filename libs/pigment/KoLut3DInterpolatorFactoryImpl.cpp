@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoLut3DInterpolatorFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoLut3DInterpolator.h"
+
+template<typename _impl>
+KoLut3DInterpolatorBase *KoLut3DInterpolatorFactoryImpl::create(int)
+{
+    return new KoLut3DInterpolator<_impl>();
+}
+
+template KoLut3DInterpolatorBase *
+KoLut3DInterpolatorFactoryImpl::create<xsimd::current_arch>(int);
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
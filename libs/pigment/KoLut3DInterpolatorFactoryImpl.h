@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOLUT3DINTERPOLATORFACTORYIMPL_H
+#define KOLUT3DINTERPOLATORFACTORYIMPL_H
+
+#include <KoLut3DInterpolatorBase.h>
+#include <KoMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoLut3DInterpolatorFactoryImpl
+{
+public:
+    using ParamType = int;
+    using ReturnType = KoLut3DInterpolatorBase *;
+
+    template<typename _impl>
+    static KoLut3DInterpolatorBase* create(int);
+};
+
+#endif // KOLUT3DINTERPOLATORFACTORYIMPL_H
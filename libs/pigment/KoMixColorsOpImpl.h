@@ -95,7 +95,7 @@ public:
         }
     }
 
-private:
+protected:
     class MixerImpl;
 
     struct ArrayOfPointers {
@@ -256,6 +256,21 @@ private:
             }
         }
 
+        /**
+         * Adds the per-channel sums accumulated outside of
+         * accumulateColors(), e.g. by a vectorized implementation
+         * of the op. The sum of the weights is not touched.
+         */
+        void addTotals(const mix_type *colorTotals, mix_type alphaTotal) {
+            for (int i = 0; i < (int)_CSTrait::channels_nb; i++) {
+                if (i != _CSTrait::alpha_pos) {
+                    totals[i] += colorTotals[i];
+                }
+            }
+
+            totalAlpha += alphaTotal;
+        }
+
         template<class AbstractSource, class WeightsWrapper>
         void accumulateColors(AbstractSource source, WeightsWrapper weightsWrapper, int nColors) {
             // Compute the total for each channel by summing each colors multiplied by the weightlabcache
@@ -0,0 +1,435 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOP_H
+#define KOOPTIMIZEDMIXCOLORSOP_H
+
+#include "KoMixColorsOpImpl.h"
+#include "KoColorSpaceTraits.h"
+#include "KoMultiArchBuildSupport.h"
+
+/**
+ * Mixing op for color spaces with four channels and alpha stored in the
+ * last one (RGBA, LABA, XYZA, YCbCrA). The generic version just falls back
+ * to KoMixColorsOpImpl.
+ */
+template<typename channels_type,
+         typename _impl,
+         typename EnableDummyType = void>
+class KoOptimizedMixColorsOp : public KoMixColorsOpImpl<KoColorSpaceTrait<channels_type, 4, 3>>
+{
+};
+
+#ifdef HAVE_XSIMD
+
+#include <cstring>
+#include <limits>
+#include "KoStreamedMath.h"
+
+/**
+ * Accumulates the sums of the pixels in the vector registers, one pixel per
+ * lane. The result of the integer version is exactly the same as the one of
+ * KoMixColorsOpImpl.
+ *
+ * Both alpha * weight and the color channels fit into 32-bit integers, but
+ * their product doesn't. So alpha * weight is split into \p numParts bit
+ * ranges of \p partBits bits each, which are multiplied by the color and
+ * summed separately. The sums are flushed into 64-bit totals often enough
+ * to avoid overflows.
+ */
+template<typename channels_type, typename _impl>
+struct KoMixColorsOpVectorAccumulator
+{
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using uint_v = typename KoStreamedMath<_impl>::uint_v;
+    using mix_type = typename KoColorSpaceMathsTraits<channels_type>::mixtype;
+
+    static_assert(std::is_same<channels_type, quint8>::value ||
+                  std::is_same<channels_type, quint16>::value,
+                  "the integer accumulator supports quint8 and quint16 channels only");
+
+    static constexpr int numParts = sizeof(channels_type) == 1 ? 2 : 3;
+    static constexpr int partBits = sizeof(channels_type) == 1 ? 16 : 11;
+    static constexpr int partMask = (1 << partBits) - 1;
+
+    static constexpr qint64 maxPartProduct =
+        qint64(std::numeric_limits<channels_type>::max()) << partBits;
+
+    static constexpr int flushInterval =
+        static_cast<int>(std::numeric_limits<qint32>::max() / maxPartProduct);
+
+    KoMixColorsOpVectorAccumulator()
+    {
+        for (int i = 0; i < numParts; i++) {
+            for (int ch = 0; ch < 4; ch++) {
+                m_parts[ch][i] = int_v(0);
+            }
+        }
+    }
+
+    template<bool useWeights>
+    ALWAYS_INLINE void accumulate(const quint8 *pixels, const qint16 *weights)
+    {
+        int_v channels[4];
+        read(pixels, channels);
+
+        int_v alphaTimesWeight = channels[3];
+
+        if (useWeights) {
+            alphaTimesWeight *= int_v::load_unaligned(weights);
+        }
+
+        for (int i = 0; i < numParts; i++) {
+            int_v part = alphaTimesWeight >> (i * partBits);
+
+            if (i < numParts - 1) {
+                part &= int_v(partMask);
+            }
+
+            for (int ch = 0; ch < 3; ch++) {
+                m_parts[ch][i] += channels[ch] * part;
+            }
+            m_parts[3][i] += part;
+        }
+
+        if (++m_numIterations >= flushInterval) {
+            flush();
+        }
+    }
+
+    template<class MixDataResult>
+    void addToResult(MixDataResult &result)
+    {
+        flush();
+        result.addTotals(m_totals, m_totals[3]);
+    }
+
+private:
+    ALWAYS_INLINE void read(const quint8 *pixels, int_v *channels)
+    {
+        if (std::is_same<channels_type, quint8>::value) {
+            const uint_v data = uint_v::load_unaligned(reinterpret_cast<const quint32 *>(pixels));
+            const uint_v mask(quint32(0xFF));
+
+            channels[0] = xsimd::bitwise_cast<int_v>(data & mask);
+            channels[1] = xsimd::bitwise_cast<int_v>((data >> 8) & mask);
+            channels[2] = xsimd::bitwise_cast<int_v>((data >> 16) & mask);
+            channels[3] = xsimd::bitwise_cast<int_v>(data >> 24);
+        } else {
+            uint_v c1c2;
+            uint_v c3alpha;
+            KoRgbaInterleavers<16>::deinterleave(pixels, c1c2, c3alpha);
+            const uint_v mask(quint32(0xFFFF));
+
+            channels[0] = xsimd::bitwise_cast<int_v>(c1c2 & mask);
+            channels[1] = xsimd::bitwise_cast<int_v>(c1c2 >> 16);
+            channels[2] = xsimd::bitwise_cast<int_v>(c3alpha & mask);
+            channels[3] = xsimd::bitwise_cast<int_v>(c3alpha >> 16);
+        }
+    }
+
+    void flush()
+    {
+        alignas(64) qint32 values[int_v::size];
+
+        for (int ch = 0; ch < 4; ch++) {
+            for (int i = 0; i < numParts; i++) {
+                m_parts[ch][i].store_aligned(values);
+
+                qint64 sum = 0;
+                for (size_t j = 0; j < int_v::size; j++) {
+                    sum += values[j];
+                }
+
+                m_totals[ch] += sum * (qint64(1) << (i * partBits));
+                m_parts[ch][i] = int_v(0);
+            }
+        }
+
+        m_numIterations = 0;
+    }
+
+private:
+    int_v m_parts[4][numParts];
+    mix_type m_totals[4] = {0, 0, 0, 0};
+    int m_numIterations = 0;
+};
+
+/**
+ * The floating point version sums the values in single precision and
+ * flushes them into double precision totals every few iterations, so
+ * its result may differ from the one of KoMixColorsOpImpl in the last
+ * bits of the mantissa.
+ */
+template<typename _impl>
+struct KoMixColorsOpVectorAccumulator<float, _impl>
+{
+    using int_v = typename KoStreamedMath<_impl>::int_v;
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+    using mix_type = typename KoColorSpaceMathsTraits<float>::mixtype;
+
+    static constexpr int flushInterval = 16;
+
+    KoMixColorsOpVectorAccumulator()
+    {
+        for (int ch = 0; ch < 4; ch++) {
+            m_sums[ch] = float_v(0.0f);
+        }
+    }
+
+    template<bool useWeights>
+    ALWAYS_INLINE void accumulate(const quint8 *pixels, const qint16 *weights)
+    {
+        float_v channels[4];
+        KoRgbaInterleavers<32>::deinterleave(pixels, channels[0], channels[1], channels[2], channels[3]);
+
+        float_v alphaTimesWeight = channels[3];
+
+        if (useWeights) {
+            alphaTimesWeight *= xsimd::to_float(int_v::load_unaligned(weights));
+        }
+
+        for (int ch = 0; ch < 3; ch++) {
+            m_sums[ch] += channels[ch] * alphaTimesWeight;
+        }
+        m_sums[3] += alphaTimesWeight;
+
+        if (++m_numIterations >= flushInterval) {
+            flush();
+        }
+    }
+
+    template<class MixDataResult>
+    void addToResult(MixDataResult &result)
+    {
+        flush();
+        result.addTotals(m_totals, m_totals[3]);
+    }
+
+private:
+    void flush()
+    {
+        alignas(64) float values[float_v::size];
+
+        for (int ch = 0; ch < 4; ch++) {
+            m_sums[ch].store_aligned(values);
+
+            for (size_t j = 0; j < float_v::size; j++) {
+                m_totals[ch] += values[j];
+            }
+
+            m_sums[ch] = float_v(0.0f);
+        }
+
+        m_numIterations = 0;
+    }
+
+private:
+    float_v m_sums[4];
+    mix_type m_totals[4] = {0, 0, 0, 0};
+    int m_numIterations = 0;
+};
+
+#ifdef HAVE_OPENEXR
+/**
+ * Half-float pixels are converted into floats and summed by the floating
+ * point version of the accumulator. The totals of both versions have the
+ * same type (double), so they are passed to the result as they are.
+ */
+template<typename _impl>
+struct KoMixColorsOpVectorAccumulator<half, _impl> : public KoMixColorsOpVectorAccumulator<float, _impl>
+{
+    using base_class = KoMixColorsOpVectorAccumulator<float, _impl>;
+    using float_v = typename KoStreamedMath<_impl>::float_v;
+
+    static_assert(std::is_same<typename KoColorSpaceMathsTraits<half>::mixtype,
+                               typename KoColorSpaceMathsTraits<float>::mixtype>::value,
+                  "the totals of half and float pixels should have the same type");
+
+    template<bool useWeights>
+    ALWAYS_INLINE void accumulate(const quint8 *pixels, const qint16 *weights)
+    {
+        const quint16 *srcPtr = reinterpret_cast<const quint16 *>(pixels);
+
+        for (size_t i = 0; i < 4; i++) {
+            xsimd::load_half_unaligned<_impl>(srcPtr + i * float_v::size).store_aligned(m_buffer + i * float_v::size);
+        }
+
+        base_class::template accumulate<useWeights>(reinterpret_cast<const quint8 *>(m_buffer), weights);
+    }
+
+private:
+    alignas(64) float m_buffer[float_v::size * 4];
+};
+#endif
+
+/**
+ * Processes the pixels in blocks of float_v::size pixels, one pixel per
+ * vector lane. The pixels that do not fill a full block are mixed by the
+ * scalar code of KoMixColorsOpImpl.
+ *
+ * Mixing of two arrays of colors (mixTwoColorArrays() and mixArrayWithColor())
+ * mixes only two pixels at a time, so it is left scalar.
+ */
+template<typename channels_type, typename _impl>
+class KoOptimizedMixColorsOp<channels_type,
+                             _impl,
+                             typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoMixColorsOpImpl<KoColorSpaceTrait<channels_type, 4, 3>>
+{
+    using Trait = KoColorSpaceTrait<channels_type, 4, 3>;
+    using base_class = KoMixColorsOpImpl<Trait>;
+    using MixDataResult = typename base_class::MixDataResult;
+    using ArrayOfPointers = typename base_class::ArrayOfPointers;
+    using PointerToArray = typename base_class::PointerToArray;
+    using WeightsWrapper = typename base_class::WeightsWrapper;
+    using NoWeightsSurrogate = typename base_class::NoWeightsSurrogate;
+    using Accumulator = KoMixColorsOpVectorAccumulator<channels_type, _impl>;
+
+    static constexpr int vectorSize = static_cast<int>(KoStreamedMath<_impl>::float_v::size);
+    static constexpr int pixelSize = static_cast<int>(Trait::pixelSize);
+
+public:
+    KoMixColorsOp::Mixer* createMixer() const override;
+
+    void mixColors(const quint8 * const* colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum = 255) const override {
+        MixDataResult result;
+        accumulateColors<true>(result, colors, weights, weightSum, nColors);
+        result.computeMixedColor(dst);
+    }
+
+    void mixColors(const quint8 *colors, const qint16 *weights, int nColors, quint8 *dst, int weightSum = 255) const override {
+        MixDataResult result;
+        accumulateColors<true>(result, colors, weights, weightSum, nColors);
+        result.computeMixedColor(dst);
+    }
+
+    void mixColors(const quint8 * const* colors, int nColors, quint8 *dst) const override {
+        MixDataResult result;
+        accumulateColors<false>(result, colors, nullptr, 0, nColors);
+        result.computeMixedColor(dst);
+    }
+
+    void mixColors(const quint8 *colors, int nColors, quint8 *dst) const override {
+        MixDataResult result;
+        accumulateColors<false>(result, colors, nullptr, 0, nColors);
+        result.computeMixedColor(dst);
+    }
+
+private:
+    class MixerImpl;
+
+    template<bool useWeights>
+    static void accumulateColors(MixDataResult &result, const quint8 *colors, const qint16 *weights, int weightSum, int nColors)
+    {
+        const int numBlocks = nColors / vectorSize;
+
+        if (numBlocks) {
+            Accumulator accumulator;
+
+            for (int i = 0; i < numBlocks; i++) {
+                accumulator.template accumulate<useWeights>(colors, weights);
+
+                colors += vectorSize * pixelSize;
+                if (useWeights) {
+                    weights += vectorSize;
+                }
+            }
+
+            accumulator.addToResult(result);
+        }
+
+        accumulateTail<useWeights>(result, PointerToArray(colors, pixelSize), weights, weightSum, nColors);
+    }
+
+    template<bool useWeights>
+    static void accumulateColors(MixDataResult &result, const quint8 * const *colors, const qint16 *weights, int weightSum, int nColors)
+    {
+        const int numBlocks = nColors / vectorSize;
+
+        if (numBlocks) {
+            Accumulator accumulator;
+            alignas(64) quint8 buffer[vectorSize * pixelSize];
+
+            for (int i = 0; i < numBlocks; i++) {
+                for (int j = 0; j < vectorSize; j++) {
+                    memcpy(buffer + j * pixelSize, colors[j], pixelSize);
+                }
+
+                accumulator.template accumulate<useWeights>(buffer, weights);
+
+                colors += vectorSize;
+                if (useWeights) {
+                    weights += vectorSize;
+                }
+            }
+
+            accumulator.addToResult(result);
+        }
+
+        accumulateTail<useWeights>(result, ArrayOfPointers(colors), weights, weightSum, nColors);
+    }
+
+    /**
+     * Mixes the rest of the pixels and adds the sum of the weights
+     * of **all** the pixels to the result
+     */
+    template<bool useWeights, class AbstractSource>
+    static void accumulateTail(MixDataResult &result, AbstractSource source, const qint16 *weights, int weightSum, int nColors)
+    {
+        const int numTailPixels = nColors % vectorSize;
+
+        if (useWeights) {
+            result.accumulateColors(source, WeightsWrapper(weights, weightSum), numTailPixels);
+        } else {
+            result.accumulateColors(source, NoWeightsSurrogate(nColors), numTailPixels);
+        }
+    }
+};
+
+template<typename channels_type, typename _impl>
+class KoOptimizedMixColorsOp<channels_type,
+                             _impl,
+                             typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>::MixerImpl
+    : public KoMixColorsOp::Mixer
+{
+public:
+    void accumulate(const quint8 *data, const qint16 *weights, int weightSum, int nPixels) override
+    {
+        accumulateColors<true>(result, data, weights, weightSum, nPixels);
+    }
+
+    void accumulateAverage(const quint8 *data, int nPixels) override
+    {
+        accumulateColors<false>(result, data, nullptr, 0, nPixels);
+    }
+
+    void computeMixedColor(quint8 *data) override
+    {
+        result.computeMixedColor(data);
+    }
+
+    qint64 currentWeightsSum() const override
+    {
+        return result.currentWeightsSum();
+    }
+
+private:
+    MixDataResult result;
+};
+
+template<typename channels_type, typename _impl>
+KoMixColorsOp::Mixer *
+KoOptimizedMixColorsOp<channels_type,
+                       _impl,
+                       typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>::createMixer() const
+{
+    return new MixerImpl();
+}
+
+#endif /* HAVE_XSIMD */
+
+#endif // KOOPTIMIZEDMIXCOLORSOP_H
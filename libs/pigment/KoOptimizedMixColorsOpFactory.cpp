@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedMixColorsOpFactory.h"
+
+#include <KoColorModelStandardIdsUtils.h>
+
+#include "KoOptimizedMixColorsOpFactoryImpl.h"
+
+template <typename channels_type>
+struct CreateMixColorsOp
+{
+    KoMixColorsOp *operator() (bool forceScalar) {
+        return createOptimizedClass<
+                KoOptimizedMixColorsOpFactoryImpl<channels_type>>(0, forceScalar);
+    }
+};
+
+KoMixColorsOp *KoOptimizedMixColorsOpFactory::create(KoID depthId, int numChannels, int alphaPos, bool forceScalar)
+{
+    if (numChannels != 4 || alphaPos != 3) return nullptr;
+
+    return channelTypeForColorDepthId<CreateMixColorsOp>(depthId, forceScalar);
+}
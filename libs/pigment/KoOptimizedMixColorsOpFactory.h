@@ -0,0 +1,32 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORY_H
+
+#include "kritapigment_export.h"
+
+#include <KoID.h>
+
+class KoMixColorsOp;
+
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactory
+{
+public:
+    /**
+     * Creates a vectorized mixing op for the pixel layout defined by
+     * \p depthId, \p numChannels and \p alphaPos. Only four-channel
+     * layouts with alpha in the last channel and U8, U16, F16 or F32 channels
+     * are supported. For all the other layouts nullptr is returned and
+     * the caller should use KoMixColorsOpImpl instead.
+     *
+     * \p forceScalar forces the generic (non-vectorized) implementation,
+     * used for benchmarking and testing.
+     */
+    static KoMixColorsOp* create(KoID depthId, int numChannels, int alphaPos, bool forceScalar = false);
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORY_H
@@ -0,0 +1,27 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoOptimizedMixColorsOpFactoryImpl.h"
+
+#if XSIMD_UNIVERSAL_BUILD_PASS
+#include "KoOptimizedMixColorsOp.h"
+
+template<typename _channels_type_>
+template<typename _impl>
+KoMixColorsOp*
+KoOptimizedMixColorsOpFactoryImpl<_channels_type_>::create(int)
+{
+    return new KoOptimizedMixColorsOp<_channels_type_, _impl>();
+}
+
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint8>::create<xsimd::current_arch>(int);
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<quint16>::create<xsimd::current_arch>(int);
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<float>::create<xsimd::current_arch>(int);
+#ifdef HAVE_OPENEXR
+template KoMixColorsOp* KoOptimizedMixColorsOpFactoryImpl<half>::create<xsimd::current_arch>(int);
+#endif
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -0,0 +1,24 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+#define KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
+
+#include <KoMixColorsOp.h>
+#include <KoMultiArchBuildSupport.h>
+
+template<typename _channels_type_>
+class KRITAPIGMENT_EXPORT KoOptimizedMixColorsOpFactoryImpl
+{
+public:
+    using ParamType = int;
+    using ReturnType = KoMixColorsOp *;
+
+    template<typename _impl>
+    static KoMixColorsOp* create(int);
+};
+
+#endif // KOOPTIMIZEDMIXCOLORSOPFACTORYIMPL_H
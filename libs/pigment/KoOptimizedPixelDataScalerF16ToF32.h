@@ -0,0 +1,147 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerF16ToF32_H
+#define KoOptimizedPixelDataScalerF16ToF32_H
+
+#include "KoOptimizedPixelDataScalerF16ToF32Base.h"
+
+#include "KoMultiArchBuildSupport.h"
+
+#include <half.h>
+#include <type_traits>
+#include <xsimd_extensions/xsimd.hpp>
+
+/**
+ * The generic version converts the channels one by one
+ */
+template<typename _impl = xsimd::current_arch,
+         typename EnableDummyType = void>
+class KoOptimizedPixelDataScalerF16ToF32 : public KoOptimizedPixelDataScalerF16ToF32Base
+{
+public:
+    KoOptimizedPixelDataScalerF16ToF32(int channelsPerPixel)
+        : KoOptimizedPixelDataScalerF16ToF32Base(channelsPerPixel)
+    {
+    }
+
+    void convertF16ToF32(const quint8 *src, int srcRowStride, quint8 *dst, int dstRowStride, int numRows, int numColumns) const override
+    {
+        const int numChannels = m_channelsPerPixel * numColumns;
+
+        for (int row = 0; row < numRows; row++) {
+            const half *srcPtr = reinterpret_cast<const half *>(src);
+            float *dstPtr = reinterpret_cast<float *>(dst);
+
+            for (int i = 0; i < numChannels; i++) {
+                dstPtr[i] = float(srcPtr[i]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+
+    void convertF32ToF16(const quint8 *src, int srcRowStride, quint8 *dst, int dstRowStride, int numRows, int numColumns) const override
+    {
+        const int numChannels = m_channelsPerPixel * numColumns;
+
+        for (int row = 0; row < numRows; row++) {
+            const float *srcPtr = reinterpret_cast<const float *>(src);
+            half *dstPtr = reinterpret_cast<half *>(dst);
+
+            for (int i = 0; i < numChannels; i++) {
+                dstPtr[i] = half(srcPtr[i]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+};
+
+#ifdef HAVE_XSIMD
+
+/**
+ * The channels of a row are processed as a flat array, float_v::size
+ * channels at a time. The channels that do not fill a full vector are
+ * converted by the scalar code.
+ */
+template<typename _impl>
+class KoOptimizedPixelDataScalerF16ToF32<_impl,
+                                         typename std::enable_if<!std::is_same<_impl, xsimd::generic>::value>::type>
+    : public KoOptimizedPixelDataScalerF16ToF32Base
+{
+    using float_v = xsimd::batch<float, _impl>;
+
+    static constexpr int vectorSize = static_cast<int>(float_v::size);
+
+public:
+    KoOptimizedPixelDataScalerF16ToF32(int channelsPerPixel)
+        : KoOptimizedPixelDataScalerF16ToF32Base(channelsPerPixel)
+    {
+    }
+
+    void convertF16ToF32(const quint8 *src, int srcRowStride, quint8 *dst, int dstRowStride, int numRows, int numColumns) const override
+    {
+        const int numChannels = m_channelsPerPixel * numColumns;
+        const int numBlocks = numChannels / vectorSize;
+        const int numTailChannels = numChannels % vectorSize;
+
+        for (int row = 0; row < numRows; row++) {
+            const quint16 *srcPtr = reinterpret_cast<const quint16 *>(src);
+            float *dstPtr = reinterpret_cast<float *>(dst);
+
+            for (int i = 0; i < numBlocks; i++) {
+                xsimd::load_half_unaligned<_impl>(srcPtr).store_unaligned(dstPtr);
+
+                srcPtr += vectorSize;
+                dstPtr += vectorSize;
+            }
+
+            const half *srcHalfPtr = reinterpret_cast<const half *>(srcPtr);
+
+            for (int i = 0; i < numTailChannels; i++) {
+                dstPtr[i] = float(srcHalfPtr[i]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+
+    void convertF32ToF16(const quint8 *src, int srcRowStride, quint8 *dst, int dstRowStride, int numRows, int numColumns) const override
+    {
+        const int numChannels = m_channelsPerPixel * numColumns;
+        const int numBlocks = numChannels / vectorSize;
+        const int numTailChannels = numChannels % vectorSize;
+
+        for (int row = 0; row < numRows; row++) {
+            const float *srcPtr = reinterpret_cast<const float *>(src);
+            quint16 *dstPtr = reinterpret_cast<quint16 *>(dst);
+
+            for (int i = 0; i < numBlocks; i++) {
+                xsimd::store_half_unaligned<_impl>(dstPtr, float_v::load_unaligned(srcPtr));
+
+                srcPtr += vectorSize;
+                dstPtr += vectorSize;
+            }
+
+            half *dstHalfPtr = reinterpret_cast<half *>(dstPtr);
+
+            for (int i = 0; i < numTailChannels; i++) {
+                dstHalfPtr[i] = half(srcPtr[i]);
+            }
+
+            src += srcRowStride;
+            dst += dstRowStride;
+        }
+    }
+};
+
+#endif /* HAVE_XSIMD */
+
+#endif // KoOptimizedPixelDataScalerF16ToF32_H
@@ -0,0 +1,21 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerF16ToF32Base.h"
+
+KoOptimizedPixelDataScalerF16ToF32Base::KoOptimizedPixelDataScalerF16ToF32Base(int channelsPerPixel)
+    : m_channelsPerPixel(channelsPerPixel)
+{
+}
+
+KoOptimizedPixelDataScalerF16ToF32Base::~KoOptimizedPixelDataScalerF16ToF32Base()
+{
+}
+
+int KoOptimizedPixelDataScalerF16ToF32Base::channelsPerPixel() const
+{
+    return m_channelsPerPixel;
+}
@@ -0,0 +1,63 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerF16ToF32Base_H
+#define KoOptimizedPixelDataScalerF16ToF32Base_H
+
+#include <QtGlobal>
+#include "kritapigment_export.h"
+
+/**
+ * @brief Converts the channels of pixels between F16 and F32 formats
+ *
+ * The conversion between half and single precision floats is needed
+ * when the depth of F16 color spaces changes, e.g. when the pixels
+ * are converted into F32 for mixing and back. Doing that channel by
+ * channel through half::operator float() is slow, so the scaler
+ * converts the whole rows with F16C instructions (on AVX2) or with
+ * their vectorized emulation (on older architectures). The result
+ * is exactly the same as the one of the scalar conversion.
+ *
+ * The actual implementation is placed in class
+ * `KoOptimizedPixelDataScalerF16ToF32`.
+ *
+ * \code{.cpp}
+ * QScopedPointer<KoOptimizedPixelDataScalerF16ToF32Base> scaler(
+ *     KoOptimizedPixelDataScalerF16ToF32Factory::createScaler(4));
+ *
+ * // convert the data from F16 to F32
+ * scaler->convertF16ToF32(src, srcRowStride,
+ *                         dst, dstRowStride,
+ *                         numRows, numColumns);
+ *
+ * // convert the data back from F32 to F16
+ * scaler->convertF32ToF16(src, srcRowStride,
+ *                         dst, dstRowStride,
+ *                         numRows, numColumns);
+ * \endcode
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerF16ToF32Base
+{
+public:
+    KoOptimizedPixelDataScalerF16ToF32Base(int channelsPerPixel);
+
+    virtual ~KoOptimizedPixelDataScalerF16ToF32Base();
+
+    virtual void convertF16ToF32(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+
+    virtual void convertF32ToF16(const quint8 *src, int srcRowStride,
+                                 quint8 *dst, int dstRowStride,
+                                 int numRows, int numColumns) const = 0;
+
+    int channelsPerPixel() const;
+
+protected:
+    int m_channelsPerPixel;
+};
+
+#endif // KoOptimizedPixelDataScalerF16ToF32Base_H
@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerF16ToF32Factory.h"
+
+#include <KoConfig.h>
+
+#include "KoOptimizedPixelDataScalerF16ToF32FactoryImpl.h"
+
+KoOptimizedPixelDataScalerF16ToF32Base *KoOptimizedPixelDataScalerF16ToF32Factory::createScaler(int channelsPerPixel, bool forceScalar)
+{
+#ifdef HAVE_OPENEXR
+    return createOptimizedClass<
+            KoOptimizedPixelDataScalerF16ToF32FactoryImpl>(channelsPerPixel, forceScalar);
+#else
+    Q_UNUSED(channelsPerPixel);
+    Q_UNUSED(forceScalar);
+    return nullptr;
+#endif
+}
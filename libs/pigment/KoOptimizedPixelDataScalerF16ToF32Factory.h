@@ -0,0 +1,29 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerF16ToF32FACTORY_H
+#define KoOptimizedPixelDataScalerF16ToF32FACTORY_H
+
+#include "KoOptimizedPixelDataScalerF16ToF32Base.h"
+
+/**
+ * \see KoOptimizedPixelDataScalerF16ToF32Base
+ */
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerF16ToF32Factory
+{
+public:
+    /**
+     * Creates a scaler for pixels with \p channelsPerPixel channels.
+     * Returns nullptr if Krita is built without OpenEXR, i.e. without
+     * F16 color spaces.
+     *
+     * \p forceScalar forces the generic (non-vectorized) implementation,
+     * used for benchmarking and testing.
+     */
+    static KoOptimizedPixelDataScalerF16ToF32Base* createScaler(int channelsPerPixel, bool forceScalar = false);
+};
+
+#endif // KoOptimizedPixelDataScalerF16ToF32FACTORY_H
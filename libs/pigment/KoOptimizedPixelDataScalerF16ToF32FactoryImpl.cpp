@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KoOptimizedPixelDataScalerF16ToF32FactoryImpl.h"
+
+#include <KoConfig.h>
+
+#if XSIMD_UNIVERSAL_BUILD_PASS && defined(HAVE_OPENEXR)
+#include "KoOptimizedPixelDataScalerF16ToF32.h"
+
+template<typename _impl>
+KoOptimizedPixelDataScalerF16ToF32Base *KoOptimizedPixelDataScalerF16ToF32FactoryImpl::create(int channelsPerPixel)
+{
+    return new KoOptimizedPixelDataScalerF16ToF32<_impl>(channelsPerPixel);
+}
+
+template KoOptimizedPixelDataScalerF16ToF32Base *
+KoOptimizedPixelDataScalerF16ToF32FactoryImpl::create<xsimd::current_arch>(int);
+
+#endif // XSIMD_UNIVERSAL_BUILD_PASS && defined(HAVE_OPENEXR)
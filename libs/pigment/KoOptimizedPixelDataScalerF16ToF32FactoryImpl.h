@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KoOptimizedPixelDataScalerF16ToF32FACTORYIMPL_H
+#define KoOptimizedPixelDataScalerF16ToF32FACTORYIMPL_H
+
+#include <KoOptimizedPixelDataScalerF16ToF32Base.h>
+#include <KoMultiArchBuildSupport.h>
+
+class KRITAPIGMENT_EXPORT KoOptimizedPixelDataScalerF16ToF32FactoryImpl
+{
+public:
+    using ParamType = int;
+    using ReturnType = KoOptimizedPixelDataScalerF16ToF32Base *;
+
+    template<typename _impl>
+    static KoOptimizedPixelDataScalerF16ToF32Base* create(int);
+};
+
+#endif // KoOptimizedPixelDataScalerF16ToF32FACTORYIMPL_H
@@ -0,0 +1,94 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "KisDitherOpBenchmark.h"
+
+#include <KoColorModelStandardIds.h>
+#include <KisDitherRowKernelBase.h>
+#include <KisDitherRowKernelFactory.h>
+#include <KoConfig.h>
+
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+#include <simpletest.h>
+
+const int NUM_COLUMNS = 4096;
+const int NUM_ROWS = 256;
+
+void KisDitherOpBenchmark::benchmarkDitherRow_data()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<int>("ditherType");
+    QTest::addColumn<bool>("forceScalar");
+
+    QList<KoID> depthIds({Integer16BitsColorDepthID, Float32BitsColorDepthID});
+#ifdef HAVE_OPENEXR
+    depthIds << Float16BitsColorDepthID;
+#endif
+
+    Q_FOREACH (const KoID &depthId, depthIds) {
+        for (int i = 0; i < 4; i++) {
+            const bool forceScalar = i & 0x1;
+            const DitherType type = i & 0x2 ? DITHER_BLUE_NOISE : DITHER_BAYER;
+
+            QTest::addRow("%s, %s, %s",
+                          depthId.id().toLatin1().data(),
+                          type == DITHER_BAYER ? "bayer" : "blue-noise",
+                          forceScalar ? "scalar" : "vector")
+                << depthId.id() << int(type) << forceScalar;
+        }
+    }
+}
+
+void KisDitherOpBenchmark::benchmarkDitherRow()
+{
+    QFETCH(QString, depthId);
+    QFETCH(int, ditherType);
+    QFETCH(bool, forceScalar);
+
+    QScopedPointer<KisDitherRowKernelBase> kernel(
+        KisDitherRowKernelFactory::create(KoID(depthId), 4, DitherType(ditherType), forceScalar));
+    QVERIFY(kernel);
+
+    const int channelSize = depthId == Float32BitsColorDepthID.id() ? 4 : 2;
+    const int srcRowStride = NUM_COLUMNS * 4 * channelSize;
+    const int dstRowStride = NUM_COLUMNS * 4;
+
+    QVector<quint8> src(srcRowStride * NUM_ROWS);
+    QVector<quint8> dst(dstRowStride * NUM_ROWS);
+
+    qsrand(42);
+
+    if (depthId == Float32BitsColorDepthID.id()) {
+        float *ptr = reinterpret_cast<float*>(src.data());
+        for (int i = 0; i < NUM_COLUMNS * NUM_ROWS * 4; i++) {
+            ptr[i] = float(qrand() & 0xFFFF) / 65535.0f;
+        }
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID.id()) {
+        half *ptr = reinterpret_cast<half*>(src.data());
+        for (int i = 0; i < NUM_COLUMNS * NUM_ROWS * 4; i++) {
+            ptr[i] = half(float(qrand() & 0xFFFF) / 65535.0f);
+        }
+#endif
+    } else {
+        for (int i = 0; i < src.size(); i++) {
+            src[i] = qrand() & 0xFF;
+        }
+    }
+
+    QBENCHMARK {
+        for (int row = 0; row < NUM_ROWS; row++) {
+            kernel->ditherRow(src.constData() + row * srcRowStride,
+                              dst.data() + row * dstRowStride,
+                              0, row, NUM_COLUMNS);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(KisDitherOpBenchmark)
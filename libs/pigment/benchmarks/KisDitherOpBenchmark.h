@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef KIS_DITHER_OP_BENCHMARK_H_
+#define KIS_DITHER_OP_BENCHMARK_H_
+
+#include <QObject>
+
+class KisDitherOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkDitherRow_data();
+    void benchmarkDitherRow();
+};
+
+#endif
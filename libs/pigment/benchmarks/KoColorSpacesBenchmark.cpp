@@ -7,8 +7,13 @@
 #include "KoColorSpacesBenchmark.h"
 
 #include <simpletest.h>
+
+#include <QThread>
+#include <QtConcurrent>
+
 #include <KoColorSpaceRegistry.h>
 #include <KoColorSpace.h>
+#include <KoColorConversionCache.h>
 
 #define NB_PIXELS 1000000
 
@@ -134,4 +139,59 @@ void KoColorSpacesBenchmark::benchmarkSetAlpha2IndividualCall()
     END_BENCHMARK
 }
 
+void KoColorSpacesBenchmark::benchmarkConversionCacheLookup_data()
+{
+    QTest::addColumn<int>("numThreads");
+
+    QTest::newRow("single-threaded") << 1;
+    QTest::newRow("multi-threaded") << QThread::idealThreadCount();
+}
+
+/**
+ * Converts single pixels between several pairs of color spaces
+ * from many threads at once, like the color pickers and the brush
+ * engines do, so the time is dominated by the conversion cache lookups
+ */
+void KoColorSpacesBenchmark::benchmarkConversionCacheLookup()
+{
+    QFETCH(int, numThreads);
+
+    const int numConversions = 200000;
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+
+    QVector<QPair<const KoColorSpace*, const KoColorSpace*>> pairs;
+    pairs << qMakePair(registry->rgb8(), registry->rgb16());
+    pairs << qMakePair(registry->rgb16(), registry->rgb8());
+    pairs << qMakePair(registry->rgb8(), registry->lab16());
+    pairs << qMakePair(registry->lab16(), registry->rgb8());
+
+    KoColorConversionCache *cache = registry->colorConversionCache();
+    cache->resetStatistics();
+
+    auto convertPixels = [&] (int &) {
+        quint8 src[64] = {0};
+        quint8 dst[64] = {0};
+
+        for (int i = 0; i < numConversions; i++) {
+            const auto &pair = pairs[i % pairs.size()];
+            pair.first->convertPixelsTo(src, dst, pair.second, 1,
+                                        KoColorConversionTransformation::internalRenderingIntent(),
+                                        KoColorConversionTransformation::internalConversionFlags());
+        }
+    };
+
+    QVector<int> threads(numThreads);
+
+    QBENCHMARK {
+        QtConcurrent::blockingMap(threads, convertPixels);
+    }
+
+    const KoColorConversionCache::Statistics stats = cache->statistics();
+    qDebug() << "Conversion cache: hits" << stats.hits
+             << "misses" << stats.misses
+             << "creations" << stats.creations
+             << "evictions" << stats.evictions;
+}
+
 SIMPLE_TEST_MAIN(KoColorSpacesBenchmark)
@@ -12,6 +12,8 @@
 
 #include <KoColorSpaceTraits.h>
 #include <KoColorSpaceRegistry.h>
+#include <KoCompositeOpRegistry.h>
+#include <KoColorSpace.h>
 
 #include <simpletest.h>
 
@@ -23,6 +25,9 @@ const int IMG_HEIGHT = 2048;
 
 const quint8 OPACITY_HALF = 128;
 
+// the largest pixel size used by the benchmarks, that is RGBA F32
+const int MAX_PIXEL_SIZE = 16;
+
 const int TILES_IN_WIDTH = IMG_WIDTH / TILE_WIDTH;
 const int TILES_IN_HEIGHT = IMG_HEIGHT / TILE_HEIGHT;
 
@@ -42,7 +47,7 @@ const int TILES_IN_HEIGHT = IMG_HEIGHT / TILE_HEIGHT;
 
 void KoCompositeOpsBenchmark::initTestCase()
 {
-    const int bufLen = IMG_HEIGHT * IMG_WIDTH * KoBgrU8Traits::pixelSize;
+    const int bufLen = IMG_HEIGHT * IMG_WIDTH * MAX_PIXEL_SIZE;
 
     m_dstBuffer = new quint8[bufLen];
     m_srcBuffer = new quint8[bufLen];
@@ -54,7 +59,7 @@ void KoCompositeOpsBenchmark::init()
 {
     qsrand(42);
 
-    for (int i = 0; i < int(IMG_WIDTH * IMG_HEIGHT * KoBgrU8Traits::pixelSize); i++) {
+    for (int i = 0; i < int(IMG_WIDTH * IMG_HEIGHT * MAX_PIXEL_SIZE); i++) {
         const int randVal = qrand();
 
         m_srcBuffer[i] = randVal & 0x0000FF;
@@ -96,5 +101,78 @@ void KoCompositeOpsBenchmark::benchmarkCompositeAlphaDarkenCreamy()
     }
 }
 
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericSC_data()
+{
+    QTest::addColumn<QString>("compositeOpId");
+    QTest::addColumn<QString>("colorDepthId");
+
+    const QStringList compositeOpIds = {
+        COMPOSITE_MULT,
+        COMPOSITE_SCREEN,
+        COMPOSITE_OVERLAY,
+        COMPOSITE_SOFT_LIGHT_PHOTOSHOP,
+        COMPOSITE_DODGE,
+        COMPOSITE_BURN,
+        COMPOSITE_ADD,
+        COMPOSITE_SUBTRACT
+    };
+
+    const QStringList colorDepthIds = {"U8", "U16", "F32"};
+
+    Q_FOREACH (const QString &compositeOpId, compositeOpIds) {
+        Q_FOREACH (const QString &colorDepthId, colorDepthIds) {
+            const QString name = QString("%1-%2").arg(compositeOpId).arg(colorDepthId);
+            QTest::newRow(name.toLatin1().data()) << compositeOpId << colorDepthId;
+        }
+    }
+}
+
+void KoCompositeOpsBenchmark::benchmarkCompositeGenericSC()
+{
+    QFETCH(QString, compositeOpId);
+    QFETCH(QString, colorDepthId);
+
+    const KoColorSpace *cs = KoColorSpaceRegistry::instance()->colorSpace("RGBA", colorDepthId, "");
+    QVERIFY(cs);
+
+    const int pixelSize = cs->pixelSize();
+
+    KoCompositeOp *compositeOp =
+        pixelSize == 4 ? KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, compositeOpId) :
+        pixelSize == 8 ? KoOptimizedCompositeOpFactory::createGenericSCOpU64(cs, compositeOpId) :
+        KoOptimizedCompositeOpFactory::createGenericSCOp128(cs, compositeOpId);
+
+    QVERIFY(compositeOp);
+
+    if (colorDepthId == "F32") {
+        // random bytes are not valid floating point pixels
+        float *src = reinterpret_cast<float*>(m_srcBuffer);
+        float *dst = reinterpret_cast<float*>(m_dstBuffer);
+
+        for (int i = 0; i < IMG_WIDTH * IMG_HEIGHT * 4; i++) {
+            src[i] = float(qrand() & 0xFF) / 255.0f;
+            dst[i] = float(qrand() & 0xFF) / 255.0f;
+        }
+    }
+
+    const int rowStride = IMG_WIDTH * pixelSize;
+
+    QBENCHMARK {
+        for (int y = 0; y < TILES_IN_HEIGHT; y++) {
+            for (int x = 0; x < TILES_IN_WIDTH; x++) {
+                const int bufOffset = y * TILE_HEIGHT * rowStride + x * TILE_WIDTH * pixelSize;
+                const int maskOffset = y * TILE_HEIGHT * IMG_WIDTH + x * TILE_WIDTH;
+
+                compositeOp->composite(m_dstBuffer + bufOffset, rowStride,
+                                       m_srcBuffer + bufOffset, rowStride,
+                                       m_mskBuffer + maskOffset, IMG_WIDTH,
+                                       TILE_HEIGHT, TILE_WIDTH,
+                                       OPACITY_HALF);
+            }
+        }
+    }
+
+    delete compositeOp;
+}
 
 QTEST_GUILESS_MAIN(KoCompositeOpsBenchmark)
@@ -22,6 +22,9 @@ private Q_SLOTS:
     void benchmarkCompositeAlphaDarkenHard();
     void benchmarkCompositeAlphaDarkenCreamy();
 
+    void benchmarkCompositeGenericSC_data();
+    void benchmarkCompositeGenericSC();
+
 private:
     quint8 * m_dstBuffer;
     quint8 * m_srcBuffer;
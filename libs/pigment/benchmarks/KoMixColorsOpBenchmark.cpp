@@ -0,0 +1,185 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "KoMixColorsOpBenchmark.h"
+
+#include <KoColorModelStandardIds.h>
+#include <KoMixColorsOp.h>
+#include <KoOptimizedMixColorsOpFactory.h>
+#include <KoConfig.h>
+
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
+
+#include <simpletest.h>
+
+// the largest pixel size used by the benchmarks, that is RGBA F32
+const int MAX_PIXEL_SIZE = 16;
+
+// the number of pixels mixed by a single call, e.g. the size of a filter kernel
+const int NUM_COLORS = 64;
+const int NUM_CALLS = 10000;
+
+namespace {
+
+void addBenchmarkRows()
+{
+    QTest::addColumn<QString>("depthId");
+    QTest::addColumn<bool>("forceScalar");
+    QTest::addColumn<bool>("useWeights");
+
+    QList<KoID> depthIds({Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID});
+#ifdef HAVE_OPENEXR
+    depthIds << Float16BitsColorDepthID;
+#endif
+
+    Q_FOREACH (const KoID &depthId, depthIds) {
+        for (int i = 0; i < 4; i++) {
+            const bool forceScalar = i & 0x1;
+            const bool useWeights = i & 0x2;
+
+            QTest::addRow("%s, %s, %s",
+                          depthId.id().toLatin1().data(),
+                          forceScalar ? "scalar" : "vector",
+                          useWeights ? "weighted" : "average")
+                << depthId.id() << forceScalar << useWeights;
+        }
+    }
+}
+
+struct BenchmarkData
+{
+    BenchmarkData(const QString &depthId, bool forceScalar)
+        : op(KoOptimizedMixColorsOpFactory::create(KoID(depthId), 4, 3, forceScalar)),
+          pixelSize(depthId == Float32BitsColorDepthID.id() ? 16 :
+                    depthId == Integer16BitsColorDepthID.id() ||
+                    depthId == Float16BitsColorDepthID.id() ? 8 : 4),
+          colors(NUM_COLORS * MAX_PIXEL_SIZE),
+          weights(NUM_COLORS)
+    {
+        qsrand(42);
+
+        if (depthId == Float32BitsColorDepthID.id()) {
+            float *ptr = reinterpret_cast<float*>(colors.data());
+            for (int i = 0; i < NUM_COLORS * 4; i++) {
+                ptr[i] = float(qrand() & 0xFF) / 255.0f;
+            }
+#ifdef HAVE_OPENEXR
+        } else if (depthId == Float16BitsColorDepthID.id()) {
+            half *ptr = reinterpret_cast<half*>(colors.data());
+            for (int i = 0; i < NUM_COLORS * 4; i++) {
+                ptr[i] = half(float(qrand() & 0xFF) / 255.0f);
+            }
+#endif
+        } else {
+            for (int i = 0; i < colors.size(); i++) {
+                colors[i] = qrand() & 0xFF;
+            }
+        }
+
+        int weightSum = 0;
+        for (int i = 0; i < NUM_COLORS; i++) {
+            weights[i] = qrand() & 0xFF;
+            weightSum += weights[i];
+        }
+        sumOfWeights = weightSum;
+    }
+
+    QScopedPointer<KoMixColorsOp> op;
+    const int pixelSize;
+    QVector<quint8> colors;
+    QVector<qint16> weights;
+    int sumOfWeights = 0;
+};
+
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixColors_data()
+{
+    addBenchmarkRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixColors()
+{
+    QFETCH(QString, depthId);
+    QFETCH(bool, forceScalar);
+    QFETCH(bool, useWeights);
+
+    BenchmarkData data(depthId, forceScalar);
+    quint8 result[MAX_PIXEL_SIZE];
+
+    QBENCHMARK {
+        for (int i = 0; i < NUM_CALLS; i++) {
+            if (useWeights) {
+                data.op->mixColors(data.colors.constData(), data.weights.constData(), NUM_COLORS, result, data.sumOfWeights);
+            } else {
+                data.op->mixColors(data.colors.constData(), NUM_COLORS, result);
+            }
+        }
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixColorsPointers_data()
+{
+    addBenchmarkRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixColorsPointers()
+{
+    QFETCH(QString, depthId);
+    QFETCH(bool, forceScalar);
+    QFETCH(bool, useWeights);
+
+    BenchmarkData data(depthId, forceScalar);
+    quint8 result[MAX_PIXEL_SIZE];
+
+    QVector<const quint8*> colorPointers(NUM_COLORS);
+    for (int i = 0; i < NUM_COLORS; i++) {
+        colorPointers[i] = data.colors.constData() + i * data.pixelSize;
+    }
+
+    QBENCHMARK {
+        for (int i = 0; i < NUM_CALLS; i++) {
+            if (useWeights) {
+                data.op->mixColors(colorPointers.constData(), data.weights.constData(), NUM_COLORS, result, data.sumOfWeights);
+            } else {
+                data.op->mixColors(colorPointers.constData(), NUM_COLORS, result);
+            }
+        }
+    }
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixer_data()
+{
+    addBenchmarkRows();
+}
+
+void KoMixColorsOpBenchmark::benchmarkMixer()
+{
+    QFETCH(QString, depthId);
+    QFETCH(bool, forceScalar);
+    QFETCH(bool, useWeights);
+
+    BenchmarkData data(depthId, forceScalar);
+    quint8 result[MAX_PIXEL_SIZE];
+
+    QBENCHMARK {
+        QScopedPointer<KoMixColorsOp::Mixer> mixer(data.op->createMixer());
+
+        for (int i = 0; i < NUM_CALLS; i++) {
+            if (useWeights) {
+                mixer->accumulate(data.colors.constData(), data.weights.constData(), data.sumOfWeights, NUM_COLORS);
+            } else {
+                mixer->accumulateAverage(data.colors.constData(), NUM_COLORS);
+            }
+        }
+
+        mixer->computeMixedColor(result);
+    }
+}
+
+QTEST_GUILESS_MAIN(KoMixColorsOpBenchmark)
@@ -0,0 +1,26 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KO_MIX_COLORS_OP_BENCHMARK_H_
+#define KO_MIX_COLORS_OP_BENCHMARK_H_
+
+#include <QObject>
+
+class KoMixColorsOpBenchmark : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkMixColors_data();
+    void benchmarkMixColors();
+
+    void benchmarkMixColorsPointers_data();
+    void benchmarkMixColorsPointers();
+
+    void benchmarkMixer_data();
+    void benchmarkMixer();
+};
+
+#endif
@@ -53,6 +53,12 @@ struct OptimizedOpsSelector
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return new KoCompositeOpCopy2<Traits>(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        Q_UNUSED(cs);
+        Q_UNUSED(id);
+        return nullptr;
+    }
 };
 
 template<>
@@ -70,6 +76,10 @@ struct OptimizedOpsSelector<KoBgrU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, id);
+    }
 };
 
 template<>
@@ -86,6 +96,10 @@ struct OptimizedOpsSelector<KoLabU8Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp32(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp32(cs, id);
+    }
 };
 
 template<>
@@ -103,6 +117,10 @@ struct OptimizedOpsSelector<KoRgbF32Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOp128(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOp128(cs, id);
+    }
 };
 
 template<>
@@ -120,8 +138,46 @@ struct OptimizedOpsSelector<KoBgrU16Traits>
     static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
         return KoOptimizedCompositeOpFactory::createCopyOpU64(cs);
     }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        return KoOptimizedCompositeOpFactory::createGenericSCOpU64(cs, id);
+    }
 };
 
+#ifdef HAVE_OPENEXR
+template<>
+struct OptimizedOpsSelector<KoRgbF16Traits>
+{
+    static KoCompositeOp* createAlphaDarkenOp(const KoColorSpace *cs) {
+        return useCreamyAlphaDarken() ?
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(cs) :
+            KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(cs);
+
+    }
+    static KoCompositeOp* createOverOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createOverOpF16(cs);
+    }
+    static KoCompositeOp* createCopyOp(const KoColorSpace *cs) {
+        return KoOptimizedCompositeOpFactory::createCopyOpF16(cs);
+    }
+
+    static KoCompositeOp* createGenericSCOp(const KoColorSpace *cs, const QString &id) {
+        Q_UNUSED(cs);
+        Q_UNUSED(id);
+        return nullptr;
+    }
+};
+
+/**
+ * XYZA F16 pixels have the same layout as RGBA F16 ones and the color
+ * channels are composited independently, so the ops are shared
+ */
+template<>
+struct OptimizedOpsSelector<KoXyzF16Traits> : public OptimizedOpsSelector<KoRgbF16Traits>
+{
+};
+#endif
+
 
 template<class Traits>
 struct AddGeneralOps<Traits, true>
@@ -132,7 +188,13 @@ struct AddGeneralOps<Traits, true>
 
      template<CompositeFunc func>
      static void add(KoColorSpace* cs, const QString& id, const QString& category) {
-         cs->addCompositeOp(new KoCompositeOpGenericSC<Traits, func>(cs, id, category));
+         KoCompositeOp *op = OptimizedOpsSelector<Traits>::createGenericSCOp(cs, id);
+
+         if (!op) {
+             op = new KoCompositeOpGenericSC<Traits, func>(cs, id, category);
+         }
+
+         cs->addCompositeOp(op);
      }
 
      static void add(KoColorSpace* cs) {
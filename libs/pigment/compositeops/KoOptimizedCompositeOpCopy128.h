@@ -253,9 +253,9 @@ struct CopyCompositor128 {
                     } else {
                         // Precondition: dstAlpha == 0 && !alphaLocked
                         const QBitArray &channelFlags = oparams.channelFlags;
-                        d[0] = channelFlags.at(0) ? dst_c1 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
-                        d[1] = channelFlags.at(1) ? dst_c2 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
-                        d[2] = channelFlags.at(2) ? dst_c3 : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[0] = channelFlags.at(0) ? static_cast<channels_type>(dst_c1) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[1] = channelFlags.at(1) ? static_cast<channels_type>(dst_c2) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
+                        d[2] = channelFlags.at(2) ? static_cast<channels_type>(dst_c3) : KoColorSpaceMathsTraits<channels_type>::zeroValue;
                     }
                 }
 
@@ -362,6 +362,52 @@ public:
 };
 
 
+#ifdef HAVE_OPENEXR
+template<typename _impl>
+class KoOptimizedCompositeOpCopyF16 : public KoCompositeOp
+{
+public:
+    KoOptimizedCompositeOpCopyF16(const KoColorSpace* cs)
+        : KoCompositeOp(cs, COMPOSITE_COPY, KoCompositeOp::categoryMix()) {}
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite64<haveMask, false, CopyCompositor128<half, false, true> >(params);
+        } else {
+            const bool allChannelsFlag =
+                params.channelFlags.at(0) &&
+                params.channelFlags.at(1) &&
+                params.channelFlags.at(2);
+
+            const bool alphaLocked =
+                !params.channelFlags.at(3);
+
+            if (allChannelsFlag && alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, true, true> >(params);
+            } else if (!allChannelsFlag && !alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, false, false> >(params);
+            } else /*if (!allChannelsFlag && alphaLocked) */{
+                KoStreamedMath<_impl>::template genericComposite64_novector<haveMask, false, CopyCompositor128<half, true, false> >(params);
+            }
+        }
+    }
+};
+#endif
+
 template<typename _impl>
 class KoOptimizedCompositeOpCopy32 : public KoCompositeOp
 {
@@ -7,6 +7,8 @@
 #include "KoOptimizedCompositeOpFactoryPerArch.h"
 #include "KoOptimizedCompositeOpFactory.h"
 
+#include <KoCompositeOpRegistry.h>
+
 KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHard32(const KoColorSpace *cs)
 {
     return createOptimizedClass<
@@ -78,3 +80,104 @@ KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpU64(const KoColorSpace
 {
     return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyU64> >(cs);
 }
+
+#ifdef HAVE_OPENEXR
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpHardF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenHardF16>>(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createAlphaDarkenOpCreamyF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<
+        KoOptimizedCompositeOpFactoryPerArch<
+            KoOptimizedCompositeOpAlphaDarkenCreamyF16>>(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createOverOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16> >(cs);
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createCopyOpF16(const KoColorSpace *cs)
+{
+    return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16> >(cs);
+}
+#endif
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp32(const KoColorSpace *cs, const QString &id)
+{
+    if (id == COMPOSITE_MULT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply32> >(cs);
+    } else if (id == COMPOSITE_SCREEN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen32> >(cs);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay32> >(cs);
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight32> >(cs);
+    } else if (id == COMPOSITE_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge32> >(cs);
+    } else if (id == COMPOSITE_BURN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn32> >(cs);
+    } else if (id == COMPOSITE_ADD) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAddition32> >(cs);
+    } else if (id == COMPOSITE_LINEAR_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge32> >(cs);
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract32> >(cs);
+    }
+
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOpU64(const KoColorSpace *cs, const QString &id)
+{
+    if (id == COMPOSITE_MULT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiplyU64> >(cs);
+    } else if (id == COMPOSITE_SCREEN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreenU64> >(cs);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlayU64> >(cs);
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLightU64> >(cs);
+    } else if (id == COMPOSITE_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodgeU64> >(cs);
+    } else if (id == COMPOSITE_BURN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurnU64> >(cs);
+    } else if (id == COMPOSITE_ADD) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAdditionU64> >(cs);
+    } else if (id == COMPOSITE_LINEAR_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodgeU64> >(cs);
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtractU64> >(cs);
+    }
+
+    return nullptr;
+}
+
+KoCompositeOp* KoOptimizedCompositeOpFactory::createGenericSCOp128(const KoColorSpace *cs, const QString &id)
+{
+    if (id == COMPOSITE_MULT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpMultiply128> >(cs);
+    } else if (id == COMPOSITE_SCREEN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpScreen128> >(cs);
+    } else if (id == COMPOSITE_OVERLAY) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverlay128> >(cs);
+    } else if (id == COMPOSITE_SOFT_LIGHT_PHOTOSHOP) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSoftLight128> >(cs);
+    } else if (id == COMPOSITE_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorDodge128> >(cs);
+    } else if (id == COMPOSITE_BURN) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpColorBurn128> >(cs);
+    } else if (id == COMPOSITE_ADD) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAddition128> >(cs);
+    } else if (id == COMPOSITE_LINEAR_DODGE) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpLinearDodge128> >(cs);
+    } else if (id == COMPOSITE_SUBTRACT) {
+        return createOptimizedClass<KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpSubtract128> >(cs);
+    }
+
+    return nullptr;
+}
@@ -8,9 +8,11 @@
 #define KOOPTIMIZEDCOMPOSITEOPFACTORY_H
 
 #include "kritapigment_export.h"
+#include <KoConfig.h>
 
 class KoCompositeOp;
 class KoColorSpace;
+class QString;
 
 /**
  * The creation of the optimized composite ops is moved into a separate
@@ -39,6 +41,23 @@ public:
     static KoCompositeOp* createCopyOp32(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpHardU64(const KoColorSpace *cs);
     static KoCompositeOp* createAlphaDarkenOpCreamyU64(const KoColorSpace *cs);
+
+#ifdef HAVE_OPENEXR
+    static KoCompositeOp* createAlphaDarkenOpHardF16(const KoColorSpace *cs);
+    static KoCompositeOp* createAlphaDarkenOpCreamyF16(const KoColorSpace *cs);
+    static KoCompositeOp* createOverOpF16(const KoColorSpace *cs);
+    static KoCompositeOp* createCopyOpF16(const KoColorSpace *cs);
+#endif
+
+    /**
+     * Create an optimized version of a separable blending mode with
+     * composite op id \p id, e.g. COMPOSITE_MULT or COMPOSITE_SCREEN.
+     * Returns nullptr if the blending mode has no optimized version,
+     * in which case the caller should fall back to KoCompositeOpGenericSC.
+     */
+    static KoCompositeOp* createGenericSCOp32(const KoColorSpace *cs, const QString &id);
+    static KoCompositeOp* createGenericSCOpU64(const KoColorSpace *cs, const QString &id);
+    static KoCompositeOp* createGenericSCOp128(const KoColorSpace *cs, const QString &id);
 };
 
 #endif /* KOOPTIMIZEDCOMPOSITEOPFACTORY_H */
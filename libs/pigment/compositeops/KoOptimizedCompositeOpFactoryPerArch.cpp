@@ -13,6 +13,7 @@
 #include "KoOptimizedCompositeOpOver32.h"
 #include "KoOptimizedCompositeOpOver128.h"
 #include "KoOptimizedCompositeOpCopy128.h"
+#include "KoOptimizedCompositeOpGenericSC.h"
 
 #include <KoCompositeOpRegistry.h>
 
@@ -114,4 +115,62 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
     return new KoOptimizedCompositeOpAlphaDarkenCreamyU64<xsimd::current_arch>(param);
 }
 
+#ifdef HAVE_OPENEXR
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<xsimd::current_arch>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenHardF16<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<xsimd::current_arch>(ParamType param)
+{
+    return new KoOptimizedCompositeOpAlphaDarkenCreamyF16<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<xsimd::current_arch>(ParamType param)
+{
+    return new KoOptimizedCompositeOpOverF16<xsimd::current_arch>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<xsimd::current_arch>(ParamType param)
+{
+    return new KoOptimizedCompositeOpCopyF16<xsimd::current_arch>(param);
+}
+#endif
+
+#define DEFINE_GENERIC_SC_FACTORY(CompositeOp) \
+    template<> \
+    template<> \
+    KoOptimizedCompositeOpFactoryPerArch<CompositeOp>::ReturnType \
+    KoOptimizedCompositeOpFactoryPerArch<CompositeOp>::create<xsimd::current_arch>(ParamType param) \
+    { \
+        return new CompositeOp<xsimd::current_arch>(param); \
+    }
+
+#define DEFINE_GENERIC_SC_FACTORIES(Name) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##32) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##U64) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##128)
+
+DEFINE_GENERIC_SC_FACTORIES(Multiply)
+DEFINE_GENERIC_SC_FACTORIES(Screen)
+DEFINE_GENERIC_SC_FACTORIES(Overlay)
+DEFINE_GENERIC_SC_FACTORIES(SoftLight)
+DEFINE_GENERIC_SC_FACTORIES(ColorDodge)
+DEFINE_GENERIC_SC_FACTORIES(ColorBurn)
+DEFINE_GENERIC_SC_FACTORIES(Addition)
+DEFINE_GENERIC_SC_FACTORIES(LinearDodge)
+DEFINE_GENERIC_SC_FACTORIES(Subtract)
+
 #endif // XSIMD_UNIVERSAL_BUILD_PASS
@@ -9,6 +9,8 @@
 #define KOOPTIMIZEDCOMPOSITEOPFACTORYPERARCH_H
 
 #include <compositeops/KoMultiArchBuildSupport.h>
+#include <KoConfig.h>
+
 class KoCompositeOp;
 class KoColorSpace;
 
@@ -48,6 +50,40 @@ class KoOptimizedCompositeOpCopyU64;
 template<typename _impl>
 class KoOptimizedCompositeOpCopy32;
 
+#ifdef HAVE_OPENEXR
+template<typename _impl>
+class KoOptimizedCompositeOpAlphaDarkenHardF16;
+
+template<typename _impl>
+class KoOptimizedCompositeOpAlphaDarkenCreamyF16;
+
+template<typename _impl>
+class KoOptimizedCompositeOpOverF16;
+
+template<typename _impl>
+class KoOptimizedCompositeOpCopyF16;
+#endif
+
+/**
+ * Optimized versions of KoCompositeOpGenericSC, \see KoOptimizedCompositeOpGenericSC.h
+ */
+#define KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Name) \
+    template<typename _impl> class KoOptimizedCompositeOp##Name##32; \
+    template<typename _impl> class KoOptimizedCompositeOp##Name##U64; \
+    template<typename _impl> class KoOptimizedCompositeOp##Name##128;
+
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Multiply)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Screen)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Overlay)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(SoftLight)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(ColorDodge)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(ColorBurn)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Addition)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(LinearDodge)
+KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Subtract)
+
+#undef KO_FORWARD_DECLARE_OPTIMIZED_GENERIC_SC_OPS
+
 template<template<typename I> class CompositeOp>
 struct KoOptimizedCompositeOpFactoryPerArch {
     using ParamType = const KoColorSpace *;
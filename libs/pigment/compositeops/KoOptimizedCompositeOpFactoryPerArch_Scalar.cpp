@@ -12,6 +12,8 @@
 #include "KoAlphaDarkenParamsWrapper.h"
 #include "KoCompositeOpOver.h"
 #include "KoCompositeOpCopy2.h"
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpRegistry.h"
 
 template<>
 template<>
@@ -110,3 +112,60 @@ KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyU64>
     return new KoCompositeOpAlphaDarken<KoBgrU16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
 }
 
+#ifdef HAVE_OPENEXR
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenHardF16>::create<xsimd::generic>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperHard>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpAlphaDarkenCreamyF16>::create<xsimd::generic>(ParamType param)
+{
+    return new KoCompositeOpAlphaDarken<KoRgbF16Traits, KoAlphaDarkenParamsWrapperCreamy>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpOverF16>::create<xsimd::generic>(ParamType param)
+{
+    return new KoCompositeOpOver<KoRgbF16Traits>(param);
+}
+
+template<>
+template<>
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::ReturnType
+KoOptimizedCompositeOpFactoryPerArch<KoOptimizedCompositeOpCopyF16>::create<xsimd::generic>(ParamType param)
+{
+    return new KoCompositeOpCopy2<KoRgbF16Traits>(param);
+}
+#endif
+
+#define DEFINE_GENERIC_SC_FACTORY(CompositeOp, Traits, compositeFunc, id, category) \
+    template<> \
+    template<> \
+    KoOptimizedCompositeOpFactoryPerArch<CompositeOp>::ReturnType \
+    KoOptimizedCompositeOpFactoryPerArch<CompositeOp>::create<xsimd::generic>(ParamType param) \
+    { \
+        return new KoCompositeOpGenericSC<Traits, &compositeFunc<Traits::channels_type>>(param, id, category); \
+    }
+
+#define DEFINE_GENERIC_SC_FACTORIES(Name, compositeFunc, id, category) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##32, KoBgrU8Traits, compositeFunc, id, category) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##U64, KoBgrU16Traits, compositeFunc, id, category) \
+    DEFINE_GENERIC_SC_FACTORY(KoOptimizedCompositeOp##Name##128, KoRgbF32Traits, compositeFunc, id, category)
+
+DEFINE_GENERIC_SC_FACTORIES(Multiply, cfMultiply, COMPOSITE_MULT, KoCompositeOp::categoryArithmetic())
+DEFINE_GENERIC_SC_FACTORIES(Screen, cfScreen, COMPOSITE_SCREEN, KoCompositeOp::categoryLight())
+DEFINE_GENERIC_SC_FACTORIES(Overlay, cfOverlay, COMPOSITE_OVERLAY, KoCompositeOp::categoryMix())
+DEFINE_GENERIC_SC_FACTORIES(SoftLight, cfSoftLight, COMPOSITE_SOFT_LIGHT_PHOTOSHOP, KoCompositeOp::categoryLight())
+DEFINE_GENERIC_SC_FACTORIES(ColorDodge, cfColorDodge, COMPOSITE_DODGE, KoCompositeOp::categoryLight())
+DEFINE_GENERIC_SC_FACTORIES(ColorBurn, cfColorBurn, COMPOSITE_BURN, KoCompositeOp::categoryDark())
+DEFINE_GENERIC_SC_FACTORIES(Addition, cfAddition, COMPOSITE_ADD, KoCompositeOp::categoryArithmetic())
+DEFINE_GENERIC_SC_FACTORIES(LinearDodge, cfAddition, COMPOSITE_LINEAR_DODGE, KoCompositeOp::categoryLight())
+DEFINE_GENERIC_SC_FACTORIES(Subtract, cfSubtract, COMPOSITE_SUBTRACT, KoCompositeOp::categoryArithmetic())
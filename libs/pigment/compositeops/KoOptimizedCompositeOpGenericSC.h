@@ -0,0 +1,440 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ * SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+#define KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
+
+#include <type_traits>
+
+#include "KoColorSpaceTraits.h"
+#include "KoCompositeOpGeneric.h"
+#include "KoCompositeOpRegistry.h"
+#include "KoStreamedMath.h"
+
+/**
+ * Vectorized versions of the most used separable blending functions
+ * from KoCompositeOpFunctions.h. Every functor provides two versions of
+ * the function:
+ *
+ * 1) scalar() is the original per-channel function, it is used for the
+ *    pixels that don't fit into a vector and for non-default channel
+ *    flags.
+ *
+ * 2) vector() does the same for a batch of channel values normalized
+ *    into [0; 1] range (in unit values of \p channels_type). Integer
+ *    results are clamped just like the scalar version does it.
+ */
+
+struct KoOptimizedBlendMultiply {
+    static QString id() { return COMPOSITE_MULT; }
+    static QString category() { return KoCompositeOp::categoryArithmetic(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfMultiply<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        return src * dst;
+    }
+};
+
+struct KoOptimizedBlendScreen {
+    static QString id() { return COMPOSITE_SCREEN; }
+    static QString category() { return KoCompositeOp::categoryLight(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfScreen<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        return src + dst - src * dst;
+    }
+};
+
+struct KoOptimizedBlendOverlay {
+    static QString id() { return COMPOSITE_OVERLAY; }
+    static QString category() { return KoCompositeOp::categoryMix(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfOverlay<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        // overlay is a hard light with swapped arguments
+        const float_v halfValue(float(KoColorSpaceMathsTraits<channels_type>::halfValue) /
+                                float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const float_v oneValue(1.0f);
+
+        const float_v dst2 = dst + dst;
+        const float_v screened = (dst2 - oneValue) + src - (dst2 - oneValue) * src;
+        const float_v multiplied = dst2 * src;
+
+        return xsimd::select(dst > halfValue, screened, multiplied);
+    }
+};
+
+struct KoOptimizedBlendSoftLight {
+    static QString id() { return COMPOSITE_SOFT_LIGHT_PHOTOSHOP; }
+    static QString category() { return KoCompositeOp::categoryLight(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfSoftLight<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        const float_v halfValue(0.5f);
+        const float_v oneValue(1.0f);
+
+        const float_v src2 = src + src;
+        const float_v lighten = dst + (src2 - oneValue) * (xsimd::sqrt(dst) - dst);
+        const float_v darken = dst - (oneValue - src2) * dst * (oneValue - dst);
+
+        return xsimd::select(src > halfValue, lighten, darken);
+    }
+};
+
+struct KoOptimizedBlendColorDodge {
+    static QString id() { return COMPOSITE_DODGE; }
+    static QString category() { return KoCompositeOp::categoryLight(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfColorDodge<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        const bool isInteger = std::numeric_limits<channels_type>::is_integer;
+        const float_v zeroValue(0.0f);
+        const float_v oneValue(1.0f);
+        const float_v maxValue(isInteger ? 1.0f : float(KoColorSpaceMathsTraits<channels_type>::max));
+
+        // \see colorDodgeHelper() for the explanation of the special cases
+        float_v result = dst / (oneValue - src);
+
+        if (isInteger) {
+            result = xsimd::min(result, oneValue);
+        } else {
+            result = xsimd::select(xsimd::isfinite(result), result, maxValue);
+        }
+
+        const float_v srcIsUnit = xsimd::select(dst == zeroValue, zeroValue, maxValue);
+        return xsimd::select(src == oneValue, srcIsUnit, result);
+    }
+};
+
+struct KoOptimizedBlendColorBurn {
+    static QString id() { return COMPOSITE_BURN; }
+    static QString category() { return KoCompositeOp::categoryDark(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfColorBurn<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        const bool isInteger = std::numeric_limits<channels_type>::is_integer;
+        const float_v zeroValue(0.0f);
+        const float_v oneValue(1.0f);
+        const float_v maxValue(isInteger ? 1.0f : float(KoColorSpaceMathsTraits<channels_type>::max));
+
+        // \see colorBurnHelper() for the explanation of the special cases
+        float_v helper = (oneValue - dst) / src;
+        helper = xsimd::select(src == zeroValue,
+                               xsimd::select(dst == oneValue, zeroValue, maxValue),
+                               helper);
+
+        if (isInteger) {
+            helper = xsimd::min(helper, oneValue);
+        } else {
+            helper = xsimd::select(xsimd::isfinite(helper), helper, maxValue);
+        }
+
+        return oneValue - helper;
+    }
+};
+
+struct KoOptimizedBlendAddition {
+    static QString id() { return COMPOSITE_ADD; }
+    static QString category() { return KoCompositeOp::categoryArithmetic(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfAddition<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        const float_v result = src + dst;
+        return std::numeric_limits<channels_type>::is_integer ? xsimd::min(result, float_v(1.0f)) : result;
+    }
+};
+
+/**
+ * Linear Dodge uses the same function as Addition, but it is
+ * registered under a different id in a different category
+ */
+struct KoOptimizedBlendLinearDodge : public KoOptimizedBlendAddition {
+    static QString id() { return COMPOSITE_LINEAR_DODGE; }
+    static QString category() { return KoCompositeOp::categoryLight(); }
+};
+
+struct KoOptimizedBlendSubtract {
+    static QString id() { return COMPOSITE_SUBTRACT; }
+    static QString category() { return KoCompositeOp::categoryArithmetic(); }
+
+    template<typename T>
+    static T scalar(T src, T dst) { return cfSubtract<T>(src, dst); }
+
+    template<typename channels_type, typename float_v>
+    static ALWAYS_INLINE float_v vector(const float_v &src, const float_v &dst)
+    {
+        const float_v result = dst - src;
+        return std::numeric_limits<channels_type>::is_integer ? xsimd::max(result, float_v(0.0f)) : result;
+    }
+};
+
+template<typename channels_type>
+struct KoOptimizedGenericSCTraits;
+
+template<>
+struct KoOptimizedGenericSCTraits<quint8> {
+    using type = KoBgrU8Traits;
+};
+
+template<>
+struct KoOptimizedGenericSCTraits<quint16> {
+    using type = KoBgrU16Traits;
+};
+
+template<>
+struct KoOptimizedGenericSCTraits<float> {
+    using type = KoRgbF32Traits;
+};
+
+/**
+ * A compositor for KoStreamedMath implementing exactly the same
+ * compositing formula as KoCompositeOpGenericSC does, but with the
+ * blending function and the alpha math vectorized.
+ *
+ * The vector version is used for the default channel flags only,
+ * everything else goes through KoCompositeOpGenericSC pixel-by-pixel.
+ */
+template<typename channels_type, class BlendFunc, bool alphaLocked, bool allChannelsFlag>
+struct GenericSCCompositor {
+    using Traits = typename KoOptimizedGenericSCTraits<channels_type>::type;
+    using ScalarOp = KoCompositeOpGenericSC<Traits, &BlendFunc::template scalar<channels_type>>;
+
+    struct ParamsWrapper {
+        ParamsWrapper(const KoCompositeOp::ParameterInfo& params)
+            : channelFlags(params.channelFlags),
+              opacity(Arithmetic::scale<channels_type>(params.opacity))
+        {
+        }
+        const QBitArray &channelFlags;
+        const channels_type opacity;
+    };
+
+    template<typename float_v>
+    static ALWAYS_INLINE void blendChannel(const float_v &src, float_v &dst,
+                                           const float_v &dstWeight,
+                                           const float_v &srcWeight,
+                                           const float_v &blendWeight,
+                                           const float_v &newAlphaRec,
+                                           const typename float_v::batch_bool_type &isTransparent)
+    {
+        const float_v unitValue(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const float_v unitValueRec(1.0f / float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+
+        const float_v blended =
+            BlendFunc::template vector<channels_type>(src * unitValueRec, dst * unitValueRec);
+
+        float_v result = (dstWeight * dst + srcWeight * src + blendWeight * blended) * newAlphaRec;
+
+        if (std::numeric_limits<channels_type>::is_integer) {
+            result = xsimd::min(xsimd::max(result, float_v(0.0f)), unitValue);
+        }
+
+        // KoCompositeOpGenericSC doesn't touch the color of fully transparent pixels
+        dst = xsimd::select(isTransparent, dst, result);
+    }
+
+    // \see docs in AlphaDarkenCompositor32
+    template<bool haveMask, bool src_aligned, typename _impl>
+    static ALWAYS_INLINE void compositeVector(const quint8 *src, quint8 *dst, const quint8 *mask, float opacity, const ParamsWrapper &oparams)
+    {
+        using float_v = typename KoStreamedMath<_impl>::float_v;
+        using float_m = typename float_v::batch_bool_type;
+
+        Q_UNUSED(oparams);
+
+        float_v src_alpha;
+        float_v dst_alpha;
+
+        float_v src_c1;
+        float_v src_c2;
+        float_v src_c3;
+
+        PixelWrapper<channels_type, _impl> dataWrapper;
+        dataWrapper.read(src, src_c1, src_c2, src_c3, src_alpha);
+
+        src_alpha *= float_v(opacity);
+
+        if (haveMask) {
+            const float_v uint8MaxRec1(1.0f / 255.0f);
+            const float_v mask_vec = KoStreamedMath<_impl>::fetch_mask_8(mask);
+            src_alpha *= mask_vec * uint8MaxRec1;
+        }
+
+        const float_v zeroValue(0.0f);
+
+        // The source cannot change the colors in the destination,
+        // since it is fully transparent
+        if (xsimd::all(src_alpha == zeroValue)) {
+            return;
+        }
+
+        float_v dst_c1;
+        float_v dst_c2;
+        float_v dst_c3;
+
+        dataWrapper.read(dst, dst_c1, dst_c2, dst_c3, dst_alpha);
+
+        const float_v oneValue(1.0f);
+        const float_v srcDstAlpha = src_alpha * dst_alpha;
+
+        const float_v new_alpha = src_alpha + dst_alpha - srcDstAlpha;
+        const float_m isTransparent = new_alpha == zeroValue;
+
+        // the weights of the components of KoCompositeOpGenericSC's blend()
+        const float_v dstWeight = dst_alpha - srcDstAlpha;
+        const float_v srcWeight = src_alpha - srcDstAlpha;
+        const float_v blendWeight = srcDstAlpha * float_v(float(KoColorSpaceMathsTraits<channels_type>::unitValue));
+        const float_v newAlphaRec = oneValue / xsimd::select(isTransparent, oneValue, new_alpha);
+
+        blendChannel(src_c1, dst_c1, dstWeight, srcWeight, blendWeight, newAlphaRec, isTransparent);
+        blendChannel(src_c2, dst_c2, dstWeight, srcWeight, blendWeight, newAlphaRec, isTransparent);
+        blendChannel(src_c3, dst_c3, dstWeight, srcWeight, blendWeight, newAlphaRec, isTransparent);
+
+        dataWrapper.write(dst, dst_c1, dst_c2, dst_c3, new_alpha);
+    }
+
+    template<bool haveMask, typename _impl>
+    static ALWAYS_INLINE void compositeOnePixelScalar(const quint8 *src,
+                                                      quint8 *dst,
+                                                      const quint8 *mask,
+                                                      float opacity,
+                                                      const ParamsWrapper &oparams)
+    {
+        using namespace Arithmetic;
+        const qint32 alpha_pos = 3;
+
+        Q_UNUSED(opacity);
+
+        const auto *s = reinterpret_cast<const channels_type*>(src);
+        auto *d = reinterpret_cast<channels_type*>(dst);
+
+        const channels_type srcAlpha = s[alpha_pos];
+        const channels_type dstAlpha = d[alpha_pos];
+        const channels_type mskAlpha = haveMask ? scale<channels_type>(*mask) : unitValue<channels_type>();
+
+        // \see KoCompositeOpBase::genericComposite()
+        if (!allChannelsFlag && dstAlpha == zeroValue<channels_type>()) {
+            KoStreamedMathFunctions::clearPixel<4 * sizeof(channels_type)>(dst);
+        }
+
+        const channels_type newDstAlpha =
+            ScalarOp::template composeColorChannels<alphaLocked, allChannelsFlag>(
+                s, srcAlpha, d, dstAlpha, mskAlpha, oparams.opacity, oparams.channelFlags);
+
+        d[alpha_pos] = alphaLocked ? dstAlpha : newDstAlpha;
+    }
+};
+
+/**
+ * An optimized version of KoCompositeOpGenericSC for RGBA colorspaces
+ * with the alpha channel placed at the last position of the pixel:
+ * C1_C2_C3_A. The channels are stored as \p channels_type, that is
+ * quint8, quint16 or float.
+ */
+template<typename channels_type, class BlendFunc, typename _impl>
+class KoOptimizedCompositeOpGenericSC : public KoCompositeOp
+{
+    static const int pixelSize = 4 * sizeof(channels_type);
+
+public:
+    KoOptimizedCompositeOpGenericSC(const KoColorSpace* cs)
+        : KoCompositeOp(cs, BlendFunc::id(), BlendFunc::category()) {}
+
+    using KoCompositeOp::composite;
+
+    void composite(const KoCompositeOp::ParameterInfo& params) const override
+    {
+        if(params.maskRowStart) {
+            composite<true>(params);
+        } else {
+            composite<false>(params);
+        }
+    }
+
+    template <bool haveMask>
+    inline void composite(const KoCompositeOp::ParameterInfo& params) const {
+        if (params.channelFlags.isEmpty() ||
+            params.channelFlags == QBitArray(4, true)) {
+
+            KoStreamedMath<_impl>::template genericComposite<haveMask, false, GenericSCCompositor<channels_type, BlendFunc, false, true>, pixelSize>(params);
+        } else {
+            /**
+             * KoCompositeOpBase treats every non-default set of channel
+             * flags as a partial one, so do we, to get exactly the same
+             * result in the corner cases.
+             */
+            const bool alphaLocked = !params.channelFlags.at(3);
+
+            if (alphaLocked) {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSCCompositor<channels_type, BlendFunc, true, false>, pixelSize>(params);
+            } else {
+                KoStreamedMath<_impl>::template genericComposite_novector<haveMask, false, GenericSCCompositor<channels_type, BlendFunc, false, false>, pixelSize>(params);
+            }
+        }
+    }
+};
+
+/**
+ * KoOptimizedCompositeOpFactoryPerArch needs a template with a single
+ * argument, so declare a separate class for every blending function
+ * and pixel format.
+ */
+#define KO_DECLARE_OPTIMIZED_GENERIC_SC_OP(ClassName, channels_type, BlendFunc)                          \
+    template<typename _impl>                                                                             \
+    class ClassName : public KoOptimizedCompositeOpGenericSC<channels_type, BlendFunc, _impl>           \
+    {                                                                                                    \
+    public:                                                                                              \
+        ClassName(const KoColorSpace *cs)                                                                \
+            : KoOptimizedCompositeOpGenericSC<channels_type, BlendFunc, _impl>(cs) {}                   \
+    };
+
+#define KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Name)                                                        \
+    KO_DECLARE_OPTIMIZED_GENERIC_SC_OP(KoOptimizedCompositeOp##Name##32, quint8, KoOptimizedBlend##Name) \
+    KO_DECLARE_OPTIMIZED_GENERIC_SC_OP(KoOptimizedCompositeOp##Name##U64, quint16, KoOptimizedBlend##Name) \
+    KO_DECLARE_OPTIMIZED_GENERIC_SC_OP(KoOptimizedCompositeOp##Name##128, float, KoOptimizedBlend##Name)
+
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Multiply)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Screen)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Overlay)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(SoftLight)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(ColorDodge)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(ColorBurn)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Addition)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(LinearDodge)
+KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS(Subtract)
+
+#undef KO_DECLARE_OPTIMIZED_GENERIC_SC_OPS
+#undef KO_DECLARE_OPTIMIZED_GENERIC_SC_OP
+
+#endif // KOOPTIMIZEDCOMPOSITEOPGENERICSC_H
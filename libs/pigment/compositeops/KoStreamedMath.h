@@ -15,6 +15,11 @@
 #include <KoAlwaysInline.h>
 #include <KoColorSpaceMaths.h>
 #include <KoCompositeOp.h>
+#include <KoConfig.h>
+
+#ifdef HAVE_OPENEXR
+#include <half.h>
+#endif
 
 #define BLOCKDEBUG 0
 
@@ -551,6 +556,19 @@ private:
     const float_v m_orig_c3;
 };
 
+#ifdef HAVE_OPENEXR
+template<class _impl>
+struct PixelStateRecoverHelper<half, _impl> : public PixelStateRecoverHelper<float, _impl> {
+    using float_v = xsimd::batch<float, _impl>;
+
+    ALWAYS_INLINE
+    PixelStateRecoverHelper(const float_v &c1, const float_v &c2, const float_v &c3)
+        : PixelStateRecoverHelper<float, _impl>(c1, c2, c3)
+    {
+    }
+};
+#endif
+
 template<typename channels_type, class _impl>
 struct PixelWrapper
 {
@@ -795,6 +813,90 @@ struct PixelWrapper<float, _impl> {
     }
 };
 
+#ifdef HAVE_OPENEXR
+/**
+ * Half-float pixels are converted into floats on load and back on store,
+ * the rest of the math is the same as for PixelWrapper<float>. On AVX2
+ * the conversion is done by F16C instructions, on older architectures
+ * with a bit-exact integer emulation of them.
+ */
+template<typename _impl>
+struct PixelWrapper<half, _impl> {
+    using int_v = xsimd::batch<int, _impl>;
+    using uint_v = xsimd::batch<unsigned int, _impl>;
+    using float_v = xsimd::batch<float, _impl>;
+
+    static_assert(int_v::size == uint_v::size, "the selected architecture does not guarantee vector size equality!");
+    static_assert(uint_v::size == float_v::size, "the selected architecture does not guarantee vector size equality!");
+
+    ALWAYS_INLINE
+    static half lerpMixedUintFloat(half a, half b, float alpha)
+    {
+        return half(Arithmetic::lerp(float(a), float(b), alpha));
+    }
+
+    ALWAYS_INLINE
+    static half roundFloatToUint(float x)
+    {
+        return half(x);
+    }
+
+    ALWAYS_INLINE
+    static void normalizeAlpha(float &alpha)
+    {
+        Q_UNUSED(alpha);
+    }
+
+    ALWAYS_INLINE
+    static void denormalizeAlpha(float &alpha)
+    {
+        Q_UNUSED(alpha);
+    }
+
+    PixelWrapper() = default;
+
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    ALWAYS_INLINE void read(const void *src, float_v &dst_c1, float_v &dst_c2, float_v &dst_c3, float_v &dst_alpha)
+    {
+        const auto *srcPtr = static_cast<const uint16_t *>(src);
+
+        for (size_t i = 0; i < 4; i++) {
+            xsimd::load_half_unaligned<_impl>(srcPtr + i * float_v::size).store_aligned(buffer + i * float_v::size);
+        }
+
+        KoRgbaInterleavers<32>::deinterleave(buffer, dst_c1, dst_c2, dst_c3, dst_alpha);
+    }
+
+    ALWAYS_INLINE void
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    write(void *dst, const float_v &src_c1, const float_v &src_c2, const float_v &src_c3, const float_v &src_alpha)
+    {
+        KoRgbaInterleavers<32>::interleave(buffer, src_c1, src_c2, src_c3, src_alpha);
+
+        auto *dstPtr = static_cast<uint16_t *>(dst);
+
+        for (size_t i = 0; i < 4; i++) {
+            xsimd::store_half_unaligned<_impl>(dstPtr + i * float_v::size,
+                                               float_v::load_aligned(buffer + i * float_v::size));
+        }
+    }
+
+    ALWAYS_INLINE
+    void clearPixels(quint8 *dataDst)
+    {
+        memset(dataDst, 0, float_v::size * sizeof(half) * 4);
+    }
+
+    ALWAYS_INLINE
+    void copyPixels(const quint8 *dataSrc, quint8 *dataDst)
+    {
+        memcpy(dataDst, dataSrc, float_v::size * sizeof(half) * 4);
+    }
+
+    alignas(_impl::alignment()) float buffer[float_v::size * 4];
+};
+#endif
+
 namespace KoStreamedMathFunctions
 {
 template<int pixelSize>
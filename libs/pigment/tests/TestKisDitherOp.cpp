@@ -0,0 +1,114 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKisDitherOp.h"
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+
+#include <kis_debug.h>
+
+#include "KoColorSpaceTraits.h"
+#include "KoRgbColorSpaceTraits.h"
+#include "KoGrayColorSpaceTraits.h"
+#include "KoColorModelStandardIdsUtils.h"
+#include "KisDitherOpImpl.h"
+
+namespace {
+
+template<typename channels_type>
+void fillRandom(QVector<channels_type> &data, QRandomGenerator &gen)
+{
+    for (int i = 0; i < data.size(); i++) {
+        const float value = float(gen.bounded(1.0));
+        data[i] = std::is_integral<channels_type>::value ?
+            channels_type(value * KoColorSpaceMathsTraits<channels_type>::unitValue) :
+            channels_type(value);
+    }
+}
+
+template<typename srcCSTraits, typename dstCSTraits, DitherType dType>
+void testRowMatchesPixelsImpl(int x, int y, int columns, int rows)
+{
+    using srcChannelsType = typename srcCSTraits::channels_type;
+
+    KisDitherOpImpl<srcCSTraits, dstCSTraits, dType> op(colorDepthIdForChannelType<srcChannelsType>(),
+                                                         Integer8BitsColorDepthID);
+
+    QRandomGenerator gen(42);
+
+    const int srcRowStride = columns * srcCSTraits::pixelSize;
+    const int dstRowStride = columns * dstCSTraits::pixelSize;
+
+    QVector<srcChannelsType> src(columns * rows * srcCSTraits::channels_nb);
+    fillRandom(src, gen);
+
+    // the exactly representable values should not be changed by dithering
+    src[0] = KoColorSpaceMathsTraits<srcChannelsType>::unitValue;
+    src[1] = KoColorSpaceMathsTraits<srcChannelsType>::zeroValue;
+
+    const quint8 *srcPtr = reinterpret_cast<const quint8*>(src.constData());
+
+    QVector<quint8> rowResult(dstRowStride * rows);
+    QVector<quint8> pixelResult(dstRowStride * rows);
+
+    op.dither(srcPtr, srcRowStride, rowResult.data(), dstRowStride, x, y, columns, rows);
+
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            op.dither(srcPtr + row * srcRowStride + col * srcCSTraits::pixelSize,
+                      pixelResult.data() + row * dstRowStride + col * dstCSTraits::pixelSize,
+                      x + col, y + row);
+        }
+    }
+
+    for (int i = 0; i < rowResult.size(); i++) {
+        if (rowResult[i] != pixelResult[i]) {
+            qDebug() << "Failed at" << i << ppVar(rowResult[i]) << ppVar(pixelResult[i]);
+            QFAIL("row-based dithering differs from the pixel-based one");
+        }
+    }
+}
+
+template<typename srcCSTraits, typename dstCSTraits>
+void testRowMatchesPixelsForTraits(int x, int y, int columns, int rows)
+{
+    testRowMatchesPixelsImpl<srcCSTraits, dstCSTraits, DITHER_BAYER>(x, y, columns, rows);
+    testRowMatchesPixelsImpl<srcCSTraits, dstCSTraits, DITHER_BLUE_NOISE>(x, y, columns, rows);
+}
+
+}
+
+void TestKisDitherOp::testRowMatchesPixels_data()
+{
+    QTest::addColumn<int>("x");
+    QTest::addColumn<int>("y");
+    QTest::addColumn<int>("columns");
+    QTest::addColumn<int>("rows");
+
+    QTest::newRow("single-pixel") << 0 << 0 << 1 << 1;
+    QTest::newRow("short-row") << 3 << 5 << 7 << 3;
+    QTest::newRow("full-period") << 0 << 0 << 64 << 4;
+    QTest::newRow("unaligned-period") << 37 << 61 << 64 << 4;
+    QTest::newRow("long-row") << 13 << 100 << 203 << 5;
+    QTest::newRow("negative-offset") << -70 << -3 << 150 << 3;
+}
+
+void TestKisDitherOp::testRowMatchesPixels()
+{
+    QFETCH(int, x);
+    QFETCH(int, y);
+    QFETCH(int, columns);
+    QFETCH(int, rows);
+
+    testRowMatchesPixelsForTraits<KoBgrU16Traits, KoBgrU8Traits>(x, y, columns, rows);
+    testRowMatchesPixelsForTraits<KoRgbF32Traits, KoBgrU8Traits>(x, y, columns, rows);
+    testRowMatchesPixelsForTraits<KoGrayU16Traits, KoGrayU8Traits>(x, y, columns, rows);
+    testRowMatchesPixelsForTraits<KoGrayF32Traits, KoGrayU8Traits>(x, y, columns, rows);
+}
+
+QTEST_GUILESS_MAIN(TestKisDitherOp)
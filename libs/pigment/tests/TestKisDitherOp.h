@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKISDITHEROP_H
+#define TESTKISDITHEROP_H
+
+#include <QObject>
+
+class TestKisDitherOp : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRowMatchesPixels_data();
+    void testRowMatchesPixels();
+};
+
+#endif // TESTKISDITHEROP_H
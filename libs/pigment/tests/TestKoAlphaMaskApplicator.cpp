@@ -0,0 +1,142 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoAlphaMaskApplicator.h"
+
+#include <simpletest.h>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include <KoConfig.h>
+#include <kis_debug.h>
+
+#include "KoColorSpaceTraits.h"
+#include "KoColorModelStandardIdsUtils.h"
+#include "KoAlphaMaskApplicatorFactory.h"
+
+namespace {
+
+template<typename channels_type>
+void fillRandomPixels(QVector<quint8> &data, QRandomGenerator &gen)
+{
+    channels_type *ptr = reinterpret_cast<channels_type*>(data.data());
+    const int numValues = data.size() / int(sizeof(channels_type));
+
+    for (int i = 0; i < numValues; i++) {
+        const float value = float(gen.bounded(1.0));
+        ptr[i] = std::is_integral<channels_type>::value ?
+            channels_type(value * KoColorSpaceMathsTraits<channels_type>::unitValue) :
+            channels_type(value);
+    }
+}
+
+template<typename Traits>
+void testMatchesScalarImpl(int numPixels)
+{
+    using channels_type = typename Traits::channels_type;
+
+    QScopedPointer<KoAlphaMaskApplicatorBase> applicator(
+        KoAlphaMaskApplicatorFactory::create(colorDepthIdForChannelType<channels_type>(),
+                                             Traits::channels_nb, Traits::alpha_pos));
+
+    QRandomGenerator gen(42);
+
+    QVector<float> mask(numPixels);
+    for (int i = 0; i < numPixels; i++) {
+        mask[i] = float(gen.bounded(1.0));
+    }
+    // the edge cases of the mask
+    mask[0] = 0.0f;
+    if (numPixels > 1) {
+        mask[numPixels - 1] = 1.0f;
+    }
+
+    QVector<QRgb> grayBrush(numPixels);
+    for (int i = 0; i < numPixels; i++) {
+        grayBrush[i] = gen.generate();
+    }
+
+    QVector<quint8> brushColor(Traits::pixelSize);
+    fillRandomPixels<channels_type>(brushColor, gen);
+
+    QVector<quint8> pixels(numPixels * Traits::pixelSize);
+    fillRandomPixels<channels_type>(pixels, gen);
+
+    auto compare = [] (const QVector<quint8> &result, const QVector<quint8> &reference, const char *method) {
+        for (int i = 0; i < result.size(); i++) {
+            if (result[i] != reference[i]) {
+                qDebug() << "Failed at byte" << i << ppVar(result[i]) << ppVar(reference[i]);
+                QFAIL(QString("%1 differs from the scalar version").arg(method).toLatin1());
+            }
+        }
+    };
+
+    {
+        QVector<quint8> result = pixels;
+        QVector<quint8> reference = pixels;
+
+        applicator->applyInverseNormedFloatMask(result.data(), mask.constData(), numPixels);
+        Traits::applyInverseAlphaNormedFloatMask(reference.data(), mask.constData(), numPixels);
+
+        compare(result, reference, "applyInverseNormedFloatMask");
+    }
+
+    {
+        QVector<quint8> result(pixels.size());
+        QVector<quint8> reference(pixels.size());
+
+        applicator->fillInverseAlphaNormedFloatMaskWithColor(result.data(), mask.constData(), brushColor.constData(), numPixels);
+        Traits::fillInverseAlphaNormedFloatMaskWithColor(reference.data(), mask.constData(), brushColor.constData(), numPixels);
+
+        compare(result, reference, "fillInverseAlphaNormedFloatMaskWithColor");
+    }
+
+    {
+        QVector<quint8> result(pixels.size());
+        QVector<quint8> reference(pixels.size());
+
+        applicator->fillGrayBrushWithColor(result.data(), grayBrush.constData(), brushColor.data(), numPixels);
+        Traits::fillGrayBrushWithColor(reference.data(), grayBrush.constData(), brushColor.data(), numPixels);
+
+        compare(result, reference, "fillGrayBrushWithColor");
+    }
+}
+
+template<typename channels_type>
+void testMatchesScalarForDepth(int numPixels)
+{
+    testMatchesScalarImpl<KoColorSpaceTrait<channels_type, 1, 0>>(numPixels);
+    testMatchesScalarImpl<KoColorSpaceTrait<channels_type, 2, 1>>(numPixels);
+    testMatchesScalarImpl<KoColorSpaceTrait<channels_type, 4, 3>>(numPixels);
+    testMatchesScalarImpl<KoColorSpaceTrait<channels_type, 5, 4>>(numPixels);
+}
+
+}
+
+void TestKoAlphaMaskApplicator::testMatchesScalar_data()
+{
+    QTest::addColumn<int>("numPixels");
+
+    QTest::newRow("single-pixel") << 1;
+    QTest::newRow("short-row") << 7;
+    QTest::newRow("vector-multiple") << 64;
+    QTest::newRow("long-row") << 203;
+}
+
+void TestKoAlphaMaskApplicator::testMatchesScalar()
+{
+    QFETCH(int, numPixels);
+
+    testMatchesScalarForDepth<quint8>(numPixels);
+    testMatchesScalarForDepth<quint16>(numPixels);
+#ifdef HAVE_OPENEXR
+    testMatchesScalarForDepth<half>(numPixels);
+#endif
+    testMatchesScalarForDepth<float>(numPixels);
+}
+
+QTEST_GUILESS_MAIN(TestKoAlphaMaskApplicator)
@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOALPHAMASKAPPLICATOR_H
+#define TESTKOALPHAMASKAPPLICATOR_H
+
+#include <QObject>
+
+class TestKoAlphaMaskApplicator : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testMatchesScalar_data();
+    void testMatchesScalar();
+};
+
+#endif // TESTKOALPHAMASKAPPLICATOR_H
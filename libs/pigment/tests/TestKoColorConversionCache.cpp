@@ -0,0 +1,358 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "TestKoColorConversionCache.h"
+
+#include <simpletest.h>
+
+#include <QAtomicInt>
+#include <QRandomGenerator>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+#include "KoColorConversionCache.h"
+#include "KoColorConversionTransformation.h"
+#include "KoColorSpace.h"
+#include "KoColorSpaceRegistry.h"
+
+namespace {
+
+struct ConverterKey {
+    const KoColorSpace *src;
+    const KoColorSpace *dst;
+    KoColorConversionTransformation::Intent intent;
+    KoColorConversionTransformation::ConversionFlags flags;
+};
+
+/**
+ * Returns more distinct keys than the shared cache can hold
+ */
+QVector<ConverterKey> generateKeys()
+{
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+    const QVector<const KoColorSpace*> colorSpaces({registry->rgb8(), registry->rgb16(), registry->lab16()});
+
+    const QVector<KoColorConversionTransformation::Intent> intents({
+        KoColorConversionTransformation::IntentPerceptual,
+        KoColorConversionTransformation::IntentRelativeColorimetric,
+        KoColorConversionTransformation::IntentSaturation,
+        KoColorConversionTransformation::IntentAbsoluteColorimetric});
+
+    const QVector<KoColorConversionTransformation::ConversionFlags> flags({
+        KoColorConversionTransformation::Empty,
+        KoColorConversionTransformation::BlackpointCompensation,
+        KoColorConversionTransformation::NoOptimization,
+        KoColorConversionTransformation::NoWhiteOnWhiteFixup});
+
+    QVector<ConverterKey> keys;
+
+    Q_FOREACH (const KoColorSpace *src, colorSpaces) {
+        Q_FOREACH (const KoColorSpace *dst, colorSpaces) {
+            if (src == dst) continue;
+
+            Q_FOREACH (KoColorConversionTransformation::Intent intent, intents) {
+                Q_FOREACH (KoColorConversionTransformation::ConversionFlags flag, flags) {
+                    keys.append({src, dst, intent, flag});
+                }
+            }
+        }
+    }
+
+    return keys;
+}
+
+KoCachedColorConversionTransformation fetch(KoColorConversionCache &cache, const ConverterKey &key)
+{
+    return cache.cachedConverter(key.src, key.dst, key.intent, key.flags);
+}
+
+bool isValidConverter(const KoCachedColorConversionTransformation &converter, const ConverterKey &key)
+{
+    const KoColorConversionTransformation *transfo = converter.transformation();
+
+    if (!transfo ||
+        !(*transfo->srcColorSpace() == *key.src) ||
+        !(*transfo->dstColorSpace() == *key.dst)) {
+
+        return false;
+    }
+
+    QVector<quint8> src(key.src->pixelSize(), 0x80);
+    QVector<quint8> dst(key.dst->pixelSize(), 0);
+    transfo->transform(src.constData(), dst.data(), 1);
+
+    return true;
+}
+
+}
+
+void TestKoColorConversionCache::testLocalCacheHits()
+{
+    KoColorConversionCache cache;
+    const QVector<ConverterKey> keys = generateKeys();
+
+    {
+        KoCachedColorConversionTransformation converter = fetch(cache, keys[0]);
+        QVERIFY(isValidConverter(converter, keys[0]));
+    }
+
+    KoColorConversionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(1));
+    QCOMPARE(stats.misses, qint64(1));
+    QCOMPARE(stats.hits, qint64(0));
+
+    // the second lookup is served by the thread-local cache
+    {
+        KoCachedColorConversionTransformation converter = fetch(cache, keys[0]);
+        QVERIFY(isValidConverter(converter, keys[0]));
+
+        // copies share the same transformation
+        KoCachedColorConversionTransformation copy = converter;
+        QCOMPARE(copy.transformation(), converter.transformation());
+    }
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(1));
+    QCOMPARE(stats.misses, qint64(1));
+    QCOMPARE(stats.hits, qint64(1));
+
+    cache.resetStatistics();
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(0));
+    QCOMPARE(stats.hits, qint64(0));
+}
+
+void TestKoColorConversionCache::testLruEviction()
+{
+    KoColorConversionCache cache;
+    const QVector<ConverterKey> keys = generateKeys();
+    const int cacheSize = KoColorConversionCache::SharedCacheSize;
+
+    QVERIFY(keys.size() > cacheSize + KoColorConversionCache::LocalCacheSize);
+
+    // fill the shared cache up to its limit
+    for (int i = 0; i < cacheSize; i++) {
+        fetch(cache, keys[i]);
+    }
+
+    KoColorConversionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize));
+    QCOMPARE(stats.evictions, qint64(0));
+
+    // the next transformation pushes out the least recently used one
+    fetch(cache, keys[cacheSize]);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize + 1));
+    QCOMPARE(stats.evictions, qint64(1));
+
+    // the second oldest one has survived, so it is not recreated...
+    fetch(cache, keys[1]);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize + 1));
+    QCOMPARE(stats.evictions, qint64(1));
+
+    // ...but the oldest one has been evicted; now keys[2] is the oldest
+    // one since keys[1] has just been used
+    fetch(cache, keys[0]);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize + 2));
+    QCOMPARE(stats.evictions, qint64(2));
+
+    fetch(cache, keys[1]);
+    fetch(cache, keys[3]);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize + 2));
+
+    fetch(cache, keys[2]);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(cacheSize + 3));
+}
+
+void TestKoColorConversionCache::testReferencedTransformationsAreNotEvicted()
+{
+    KoColorConversionCache cache;
+    const QVector<ConverterKey> keys = generateKeys();
+
+    KoCachedColorConversionTransformation heldConverter = fetch(cache, keys[0]);
+    const KoColorConversionTransformation *heldTransfo = heldConverter.transformation();
+
+    // flush the thread-local cache and overflow the shared one
+    for (int i = 1; i < keys.size(); i++) {
+        fetch(cache, keys[i]);
+    }
+
+    KoColorConversionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(keys.size()));
+    QCOMPARE(stats.evictions, qint64(keys.size() - KoColorConversionCache::SharedCacheSize));
+
+    // the transformation is still alive and usable
+    QVERIFY(isValidConverter(heldConverter, keys[0]));
+
+    // and it has been kept in the shared cache, because it was in use
+    KoCachedColorConversionTransformation converter = fetch(cache, keys[0]);
+    QCOMPARE(converter.transformation(), heldTransfo);
+    QCOMPARE(cache.statistics().creations, qint64(keys.size()));
+}
+
+void TestKoColorConversionCache::testColorSpaceIsDestroyed()
+{
+    KoColorConversionCache cache;
+
+    KoColorSpaceRegistry *registry = KoColorSpaceRegistry::instance();
+    const ConverterKey key8to16 = {registry->rgb8(), registry->rgb16(), KoColorConversionTransformation::IntentPerceptual, KoColorConversionTransformation::Empty};
+    const ConverterKey key16to8 = {registry->rgb16(), registry->rgb8(), KoColorConversionTransformation::IntentPerceptual, KoColorConversionTransformation::Empty};
+    const ConverterKey key16toLab = {registry->rgb16(), registry->lab16(), KoColorConversionTransformation::IntentPerceptual, KoColorConversionTransformation::Empty};
+
+    KoCachedColorConversionTransformation heldConverter = fetch(cache, key8to16);
+    fetch(cache, key16to8);
+    fetch(cache, key16toLab);
+
+    KoColorConversionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(3));
+    QCOMPARE(stats.misses, qint64(3));
+
+    // the cache is just notified, the color space itself stays alive
+    cache.colorSpaceIsDestroyed(registry->rgb8());
+
+    // the users still holding the transformation can continue using it
+    QVERIFY(isValidConverter(heldConverter, key8to16));
+
+    // the transformations of other color spaces are not purged from the
+    // shared cache, but the thread-local cache drops all of them
+    fetch(cache, key16toLab);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(3));
+    QCOMPARE(stats.misses, qint64(4));
+    QCOMPARE(stats.hits, qint64(0));
+
+    // the transformations of the destroyed color space are recreated
+    KoCachedColorConversionTransformation converter = fetch(cache, key8to16);
+    QVERIFY(converter.transformation() != heldConverter.transformation());
+    QVERIFY(isValidConverter(converter, key8to16));
+
+    fetch(cache, key16to8);
+
+    stats = cache.statistics();
+    QCOMPARE(stats.creations, qint64(5));
+    QCOMPARE(stats.misses, qint64(6));
+}
+
+namespace {
+
+struct CacheUser : public QRunnable
+{
+    CacheUser(KoColorConversionCache &cache, const QVector<ConverterKey> &keys,
+              int numLookups, quint32 seed, QAtomicInt &numFailures)
+        : m_cache(cache),
+          m_keys(keys),
+          m_numLookups(numLookups),
+          m_seed(seed),
+          m_numFailures(numFailures)
+    {
+    }
+
+    void run() override {
+        QRandomGenerator gen(m_seed);
+
+        // a few converters are held for a while, so the shared cache
+        // meets referenced transformations while evicting
+        QVector<KoCachedColorConversionTransformation> held;
+        QVector<int> heldKeys;
+
+        for (int i = 0; i < m_numLookups; i++) {
+            const int index = gen.bounded(m_keys.size());
+
+            KoCachedColorConversionTransformation converter = fetch(m_cache, m_keys[index]);
+            if (!isValidConverter(converter, m_keys[index])) {
+                m_numFailures.ref();
+            }
+
+            if (held.size() < 4) {
+                held.append(converter);
+                heldKeys.append(index);
+            } else if (gen.bounded(8) == 0) {
+                const int slot = gen.bounded(held.size());
+                held[slot] = converter;
+                heldKeys[slot] = index;
+            }
+        }
+
+        for (int i = 0; i < held.size(); i++) {
+            if (!isValidConverter(held[i], m_keys[heldKeys[i]])) {
+                m_numFailures.ref();
+            }
+        }
+    }
+
+private:
+    KoColorConversionCache &m_cache;
+    const QVector<ConverterKey> &m_keys;
+    const int m_numLookups;
+    const quint32 m_seed;
+    QAtomicInt &m_numFailures;
+};
+
+struct CacheNotifier : public QRunnable
+{
+    CacheNotifier(KoColorConversionCache &cache, const KoColorSpace *cs, int numNotifications)
+        : m_cache(cache),
+          m_cs(cs),
+          m_numNotifications(numNotifications)
+    {
+    }
+
+    void run() override {
+        for (int i = 0; i < m_numNotifications; i++) {
+            m_cache.colorSpaceIsDestroyed(m_cs);
+            QThread::yieldCurrentThread();
+        }
+    }
+
+private:
+    KoColorConversionCache &m_cache;
+    const KoColorSpace *m_cs;
+    const int m_numNotifications;
+};
+
+}
+
+void TestKoColorConversionCache::testConcurrentUsers()
+{
+    KoColorConversionCache cache;
+    const QVector<ConverterKey> keys = generateKeys();
+
+    const int numUsers = 8;
+    const int numLookups = 2000;
+
+    QAtomicInt numFailures;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(numUsers + 1);
+
+    for (int i = 0; i < numUsers; i++) {
+        pool.start(new CacheUser(cache, keys, numLookups, 1000 + i, numFailures));
+    }
+    pool.start(new CacheNotifier(cache, KoColorSpaceRegistry::instance()->rgb8(), 200));
+
+    pool.waitForDone();
+
+    QCOMPARE(int(numFailures), 0);
+
+    // the counters of all the threads are collected
+    const KoColorConversionCache::Statistics stats = cache.statistics();
+    QCOMPARE(stats.hits + stats.misses, qint64(numUsers * numLookups));
+    QVERIFY(stats.creations >= KoColorConversionCache::SharedCacheSize);
+    QVERIFY(stats.creations <= stats.misses);
+}
+
+QTEST_GUILESS_MAIN(TestKoColorConversionCache)
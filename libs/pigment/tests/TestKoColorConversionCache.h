@@ -0,0 +1,23 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TESTKOCOLORCONVERSIONCACHE_H
+#define TESTKOCOLORCONVERSIONCACHE_H
+
+#include <QObject>
+
+class TestKoColorConversionCache : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLocalCacheHits();
+    void testLruEviction();
+    void testReferencedTransformationsAreNotEvicted();
+    void testColorSpaceIsDestroyed();
+    void testConcurrentUsers();
+};
+
+#endif // TESTKOCOLORCONVERSIONCACHE_H
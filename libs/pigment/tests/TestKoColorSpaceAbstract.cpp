@@ -6,8 +6,13 @@
 
 #include "KoColorSpaceAbstract.h"
 #include "KoColorSpaceTraits.h"
+#include "KoOptimizedMixColorsOpFactory.h"
+#include "KoOptimizedPixelDataScalerF16ToF32Factory.h"
+#include "KoColorModelStandardIds.h"
 
 #include <cfloat>
+#include <limits>
+#include <random>
 
 #include <simpletest.h>
 
@@ -398,5 +403,235 @@ void TestKoColorSpaceAbstract::testMixColorsOpU8NoAlphaLinear()
     QCOMPARE(outputPixel[COLOR_CHANNEL_2], mixOpNoAlphaExpectedColor(pixel1[COLOR_CHANNEL_2], pixel2[COLOR_CHANNEL_2], weights));
 }
 
+template <typename channels_type>
+void fillRandomPixels(QVector<channels_type> &pixels, std::mt19937 &gen)
+{
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    for (int i = 0; i < pixels.size(); i++) {
+        const float value = dist(gen);
+        pixels[i] = std::is_integral<channels_type>::value ?
+            channels_type(qRound(value * KoColorSpaceMathsTraits<channels_type>::unitValue)) :
+            channels_type(value);
+
+        // make sure the extreme values are covered as well
+        if (i % 17 == 0) {
+            pixels[i] = KoColorSpaceMathsTraits<channels_type>::unitValue;
+        }
+    }
+}
+
+template <typename channels_type>
+void compareMixedPixels(const channels_type *pixel, const channels_type *expectedPixel)
+{
+    for (int i = 0; i < 4; i++) {
+        if (std::is_integral<channels_type>::value) {
+            QCOMPARE(pixel[i], expectedPixel[i]);
+        } else {
+            // the sums of half pixels are rounded to half precision in the end
+            const float tolerance = std::is_same<channels_type, float>::value ? 1e-5f : 1e-3f;
+            QVERIFY(qAbs(float(pixel[i]) - float(expectedPixel[i])) < tolerance);
+        }
+    }
+}
+
+template <typename channels_type>
+void testOptimizedMixColorsOpImpl(const KoID &depthId, int numColors)
+{
+    using Trait = KoColorSpaceTrait<channels_type, 4, 3>;
+
+    QScopedPointer<KoMixColorsOp> optimizedOp(KoOptimizedMixColorsOpFactory::create(depthId, 4, 3));
+    QVERIFY(optimizedOp);
+    KoMixColorsOpImpl<Trait> referenceOp;
+
+    std::mt19937 gen(42);
+
+    QVector<channels_type> pixels(4 * numColors);
+    fillRandomPixels(pixels, gen);
+
+    QVector<qint16> weights(numColors);
+    std::uniform_int_distribution<int> weightsDist(-64, 255);
+    int weightSum = 0;
+    for (int i = 0; i < numColors; i++) {
+        weights[i] = weightsDist(gen);
+        weightSum += weights[i];
+    }
+    // the weights of the brush masks are not normalized
+    weights[0] = 32767;
+    weightSum += 32767;
+
+    const quint8 *colors = reinterpret_cast<const quint8*>(pixels.constData());
+
+    QVector<const quint8*> colorPointers(numColors);
+    for (int i = 0; i < numColors; i++) {
+        colorPointers[i] = colors + i * Trait::pixelSize;
+    }
+
+    channels_type result[4];
+    channels_type expectedResult[4];
+
+    quint8 *resultPtr = reinterpret_cast<quint8*>(result);
+    quint8 *expectedResultPtr = reinterpret_cast<quint8*>(expectedResult);
+
+    optimizedOp->mixColors(colors, weights.constData(), numColors, resultPtr, weightSum);
+    referenceOp.mixColors(colors, weights.constData(), numColors, expectedResultPtr, weightSum);
+    compareMixedPixels(result, expectedResult);
+
+    optimizedOp->mixColors(colorPointers.constData(), weights.constData(), numColors, resultPtr, weightSum);
+    referenceOp.mixColors(colorPointers.constData(), weights.constData(), numColors, expectedResultPtr, weightSum);
+    compareMixedPixels(result, expectedResult);
+
+    optimizedOp->mixColors(colors, numColors, resultPtr);
+    referenceOp.mixColors(colors, numColors, expectedResultPtr);
+    compareMixedPixels(result, expectedResult);
+
+    optimizedOp->mixColors(colorPointers.constData(), numColors, resultPtr);
+    referenceOp.mixColors(colorPointers.constData(), numColors, expectedResultPtr);
+    compareMixedPixels(result, expectedResult);
+
+    QScopedPointer<KoMixColorsOp::Mixer> mixer(optimizedOp->createMixer());
+    QScopedPointer<KoMixColorsOp::Mixer> referenceMixer(referenceOp.createMixer());
+
+    mixer->accumulate(colors, weights.constData(), weightSum, numColors);
+    mixer->accumulateAverage(colors, numColors);
+    referenceMixer->accumulate(colors, weights.constData(), weightSum, numColors);
+    referenceMixer->accumulateAverage(colors, numColors);
+
+    QCOMPARE(mixer->currentWeightsSum(), referenceMixer->currentWeightsSum());
+
+    mixer->computeMixedColor(resultPtr);
+    referenceMixer->computeMixedColor(expectedResultPtr);
+    compareMixedPixels(result, expectedResult);
+}
+
+void TestKoColorSpaceAbstract::testOptimizedMixColorsOp_data()
+{
+    QTest::addColumn<QString>("depthIdString");
+    QTest::addColumn<int>("numColors");
+
+    QList<KoID> depthIds({Integer8BitsColorDepthID, Integer16BitsColorDepthID, Float32BitsColorDepthID});
+#ifdef HAVE_OPENEXR
+    depthIds << Float16BitsColorDepthID;
+#endif
+    QList<int> numColors({1, 7, 64, 1023, 10000});
+
+    Q_FOREACH (const KoID &depthId, depthIds) {
+        Q_FOREACH (int num, numColors) {
+            QTest::addRow("%s, %d", depthId.id().toLatin1().data(), num) << depthId.id() << num;
+        }
+    }
+}
+
+void TestKoColorSpaceAbstract::testOptimizedMixColorsOp()
+{
+    QFETCH(QString, depthIdString);
+    QFETCH(int, numColors);
+
+    const KoID depthId(depthIdString);
+
+    if (depthId == Integer8BitsColorDepthID) {
+        testOptimizedMixColorsOpImpl<quint8>(depthId, numColors);
+    } else if (depthId == Integer16BitsColorDepthID) {
+        testOptimizedMixColorsOpImpl<quint16>(depthId, numColors);
+#ifdef HAVE_OPENEXR
+    } else if (depthId == Float16BitsColorDepthID) {
+        testOptimizedMixColorsOpImpl<half>(depthId, numColors);
+#endif
+    } else {
+        testOptimizedMixColorsOpImpl<float>(depthId, numColors);
+    }
+}
+
+void TestKoColorSpaceAbstract::testHalfFloatScaler_data()
+{
+    QTest::addColumn<bool>("forceScalar");
+    QTest::addColumn<int>("numColumns");
+
+    QList<int> numColumns({1, 7, 64, 1023});
+
+    Q_FOREACH (int num, numColumns) {
+        QTest::addRow("scalar, %d", num) << true << num;
+        QTest::addRow("vector, %d", num) << false << num;
+    }
+}
+
+void TestKoColorSpaceAbstract::testHalfFloatScaler()
+{
+#ifdef HAVE_OPENEXR
+    QFETCH(bool, forceScalar);
+    QFETCH(int, numColumns);
+
+    const int numChannels = 4;
+    const int numRows = 3;
+    const int numValues = numColumns * numChannels;
+
+    QScopedPointer<KoOptimizedPixelDataScalerF16ToF32Base> scaler(
+        KoOptimizedPixelDataScalerF16ToF32Factory::createScaler(numChannels, forceScalar));
+    QVERIFY(scaler);
+
+    // the rows are padded to check that the strides are respected
+    const int halfRowStride = (numValues + 3) * sizeof(half);
+    const int floatRowStride = (numValues + 5) * sizeof(float);
+
+    QVector<quint8> halfPixels(halfRowStride * numRows);
+    QVector<quint8> floatPixels(floatRowStride * numRows);
+    QVector<quint8> resultPixels(halfRowStride * numRows);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-2.0f, 2.0f);
+
+    // cover denormals, infinities and the values not representable in half
+    const float specialValues[] = {0.0f, -0.0f, 1e-7f, -3e-5f, 65504.0f, 70000.0f,
+                                   std::numeric_limits<float>::infinity(), 1.0f / 3.0f};
+    const int numSpecialValues = sizeof(specialValues) / sizeof(float);
+
+    for (int row = 0; row < numRows; row++) {
+        float *floatPtr = reinterpret_cast<float*>(floatPixels.data() + row * floatRowStride);
+
+        for (int i = 0; i < numValues; i++) {
+            floatPtr[i] = i % 5 == 0 ? specialValues[(i / 5) % numSpecialValues] : dist(gen);
+        }
+    }
+
+    scaler->convertF32ToF16(floatPixels.constData(), floatRowStride,
+                            halfPixels.data(), halfRowStride,
+                            numRows, numColumns);
+
+    for (int row = 0; row < numRows; row++) {
+        const float *floatPtr = reinterpret_cast<const float*>(floatPixels.constData() + row * floatRowStride);
+        const half *halfPtr = reinterpret_cast<const half*>(halfPixels.constData() + row * halfRowStride);
+
+        for (int i = 0; i < numValues; i++) {
+            QCOMPARE(halfPtr[i].bits(), half(floatPtr[i]).bits());
+        }
+    }
+
+    scaler->convertF16ToF32(halfPixels.constData(), halfRowStride,
+                            floatPixels.data(), floatRowStride,
+                            numRows, numColumns);
+
+    for (int row = 0; row < numRows; row++) {
+        const float *floatPtr = reinterpret_cast<const float*>(floatPixels.constData() + row * floatRowStride);
+        const half *halfPtr = reinterpret_cast<const half*>(halfPixels.constData() + row * halfRowStride);
+
+        for (int i = 0; i < numValues; i++) {
+            QCOMPARE(floatPtr[i], float(halfPtr[i]));
+        }
+    }
+
+    // the round trip through F32 is lossless
+    scaler->convertF32ToF16(floatPixels.constData(), floatRowStride,
+                            resultPixels.data(), halfRowStride,
+                            numRows, numColumns);
+
+    for (int row = 0; row < numRows; row++) {
+        QVERIFY(!memcmp(resultPixels.constData() + row * halfRowStride,
+                        halfPixels.constData() + row * halfRowStride,
+                        numValues * sizeof(half)));
+    }
+#else
+    QSKIP("Krita is built without OpenEXR");
+#endif
+}
 
 QTEST_GUILESS_MAIN(TestKoColorSpaceAbstract)
@@ -15,6 +15,10 @@ private Q_SLOTS:
     void testMixColorsOpF32();
     void testMixColorsOpU8NoAlpha();
     void testMixColorsOpU8NoAlphaLinear();
+    void testOptimizedMixColorsOp_data();
+    void testOptimizedMixColorsOp();
+    void testHalfFloatScaler_data();
+    void testHalfFloatScaler();
 };
 
 #endif
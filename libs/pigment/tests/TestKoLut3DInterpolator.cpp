@@ -0,0 +1,123 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "TestKoLut3DInterpolator.h"
+
+#include <simpletest.h>
+
+#include <cmath>
+
+#include <QRandomGenerator>
+#include <QScopedPointer>
+
+#include "KoLut3DInterpolatorFactoryImpl.h"
+
+namespace {
+const int GridSize = 17;
+const int NumPixels = 1027; // not a multiple of the vector size
+
+template<typename Func>
+QVector<float> generateLut(Func func)
+{
+    const int nodeSize = KoLut3DInterpolatorBase::NodeSize;
+    const float maxIndex = GridSize - 1;
+
+    QVector<float> lut(GridSize * GridSize * GridSize * nodeSize);
+
+    float *node = lut.data();
+    for (int r = 0; r < GridSize; r++) {
+        for (int g = 0; g < GridSize; g++) {
+            for (int b = 0; b < GridSize; b++) {
+                func(r / maxIndex, g / maxIndex, b / maxIndex, node);
+                node += nodeSize;
+            }
+        }
+    }
+
+    return lut;
+}
+
+QVector<float> generatePixels()
+{
+    QRandomGenerator random(1);
+
+    QVector<float> pixels(3 * NumPixels);
+    for (int i = 0; i < pixels.size(); i++) {
+        // a few values are intentionally out of range
+        pixels[i] = random.bounded(1.2) - 0.1;
+    }
+
+    // the corners of the cube
+    for (int i = 0; i < 8; i++) {
+        pixels[i] = i & 0x1;
+        pixels[NumPixels + i] = (i >> 1) & 0x1;
+        pixels[2 * NumPixels + i] = (i >> 2) & 0x1;
+    }
+
+    return pixels;
+}
+}
+
+void TestKoLut3DInterpolator::testLinearFunction()
+{
+    // tetrahedral interpolation of a linear function is exact
+    QVector<float> lut = generateLut(
+        [] (float r, float g, float b, float *node) {
+            node[0] = r;
+            node[1] = 0.5f * g + 0.25f * b;
+            node[2] = 1.0f - b;
+        });
+
+    QVector<float> src = generatePixels();
+    QVector<float> dst(3 * NumPixels);
+
+    QScopedPointer<KoLut3DInterpolatorBase> interpolator(
+        createOptimizedClass<KoLut3DInterpolatorFactoryImpl>(0));
+
+    interpolator->interpolate(lut.constData(), GridSize, src.constData(), dst.data(), NumPixels, 3);
+
+    for (int i = 0; i < NumPixels; i++) {
+        const float r = qBound(0.0f, src[i], 1.0f);
+        const float g = qBound(0.0f, src[NumPixels + i], 1.0f);
+        const float b = qBound(0.0f, src[2 * NumPixels + i], 1.0f);
+
+        QVERIFY(qAbs(dst[i] - r) < 1e-5);
+        QVERIFY(qAbs(dst[NumPixels + i] - (0.5f * g + 0.25f * b)) < 1e-5);
+        QVERIFY(qAbs(dst[2 * NumPixels + i] - (1.0f - b)) < 1e-5);
+    }
+}
+
+void TestKoLut3DInterpolator::testVectorizedMatchesScalar()
+{
+    QVector<float> lut = generateLut(
+        [] (float r, float g, float b, float *node) {
+            node[0] = std::pow(r, 2.2f) * g;
+            node[1] = std::sqrt(g) + 0.1f * r * b;
+            node[2] = b * b * (1.0f - r);
+            node[3] = r * g * b;
+        });
+
+    QVector<float> src = generatePixels();
+    QVector<float> dstScalar(4 * NumPixels);
+    QVector<float> dstVector(4 * NumPixels);
+
+    QScopedPointer<KoLut3DInterpolatorBase> scalarInterpolator(
+        createOptimizedClass<KoLut3DInterpolatorFactoryImpl>(0, true));
+    QScopedPointer<KoLut3DInterpolatorBase> vectorInterpolator(
+        createOptimizedClass<KoLut3DInterpolatorFactoryImpl>(0));
+
+    scalarInterpolator->interpolate(lut.constData(), GridSize, src.constData(), dstScalar.data(), NumPixels, 4);
+    vectorInterpolator->interpolate(lut.constData(), GridSize, src.constData(), dstVector.data(), NumPixels, 4);
+
+    for (int i = 0; i < dstScalar.size(); i++) {
+        if (qAbs(dstScalar[i] - dstVector[i]) > 1e-5) {
+            QFAIL(QString("Vectorized interpolation differs at %1: %2 vs %3")
+                  .arg(i).arg(dstVector[i]).arg(dstScalar[i]).toLatin1());
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestKoLut3DInterpolator)
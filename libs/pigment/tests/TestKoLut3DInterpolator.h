@@ -0,0 +1,20 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef TESTKOLUT3DINTERPOLATOR_H
+#define TESTKOLUT3DINTERPOLATOR_H
+
+#include <QObject>
+
+class TestKoLut3DInterpolator : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testLinearFunction();
+    void testVectorizedMatchesScalar();
+};
+
+#endif // TESTKOLUT3DINTERPOLATOR_H
@@ -702,6 +702,16 @@ void KisConfig::setAllowLCMSOptimization(bool allowLCMSOptimization)
     m_cfg.writeEntry("allowLCMSOptimization", allowLCMSOptimization);
 }
 
+bool KisConfig::useLutForDisplayConversion(bool defaultValue) const
+{
+    return (defaultValue ? false : m_cfg.readEntry("useLutForDisplayConversion", false));
+}
+
+void KisConfig::setUseLutForDisplayConversion(bool value)
+{
+    m_cfg.writeEntry("useLutForDisplayConversion", value);
+}
+
 bool KisConfig::forcePaletteColors(bool defaultValue) const
 {
     return (defaultValue ? false : m_cfg.readEntry("colorsettings/forcepalettecolors", false));
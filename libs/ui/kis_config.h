@@ -165,6 +165,13 @@ public:
     bool allowLCMSOptimization(bool defaultValue = false) const;
     void setAllowLCMSOptimization(bool allowLCMSOptimization);
 
+    /**
+     * Approximate the conversion to the display profile with a
+     * precomputed 3D LUT, see KoColorConversionTransformation::ApproximateWithLut
+     */
+    bool useLutForDisplayConversion(bool defaultValue = false) const;
+    void setUseLutForDisplayConversion(bool value);
+
     bool forcePaletteColors(bool defaultValue = false) const;
     void setForcePaletteColors(bool forcePaletteColors);
 
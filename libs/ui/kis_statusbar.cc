@@ -305,6 +305,54 @@ void KisStatusBar::updateMemoryStatus()
 
     QString longStats = imageStatsMsg + "\n" + memoryStatsMsg;
 
+    if (stats.swapFileSize > 0) {
+        const QString swapStatsMsg =
+                i18nc("tooltip on statusbar memory reporting button (swap file stats)",
+                      "\n"
+                      "  swap file:\t %1\n"
+                      "  mapped:\t %2\n"
+                      "  window hits:\t %3 / %4",
+                      format.formatByteSize(stats.swapFileSize),
+                      format.formatByteSize(stats.swapMappedSize),
+                      stats.swapWindowHits,
+                      stats.swapWindowHits + stats.swapWindowMisses);
+
+        longStats += swapStatsMsg;
+    }
+
+    if (stats.compressedSwapDataSize > 0) {
+        const qreal ratio =
+            qreal(stats.compressedSwapDataSize) / qMax(stats.compressedSwapSize, qint64(1));
+
+        const QString compressedStatsMsg =
+                i18nc("tooltip on statusbar memory reporting button (compressed swap stats)",
+                      "\n"
+                      "  compressed in RAM:\t %1 / %2\n"
+                      "  compression ratio:\t %3x",
+                      format.formatByteSize(stats.compressedSwapSize),
+                      format.formatByteSize(stats.compressedSwapLimit),
+                      QString::number(ratio, 'f', 1));
+
+        longStats += compressedStatsMsg;
+    }
+
+    if (stats.arenaSize > 0) {
+        const qint64 fragmentation =
+            100 * (stats.arenaSize - stats.arenaUsedSize) / stats.arenaSize;
+
+        const QString arenaStatsMsg =
+                i18nc("tooltip on statusbar memory reporting button (tile arena stats)",
+                      "\n"
+                      "  tile arena:\t %1\n"
+                      "  in huge pages:\t %2\n"
+                      "  fragmentation:\t %3%",
+                      format.formatByteSize(stats.arenaSize),
+                      format.formatByteSize(stats.arenaHugePagesSize),
+                      fragmentation);
+
+        longStats += arenaStatsMsg;
+    }
+
     QString shortStats = format.formatByteSize(stats.imageSize);
     QIcon icon;
     const qint64 warnLevel = stats.tilesHardLimit - stats.tilesHardLimit / 8;
@@ -75,13 +75,18 @@ KisOpenGLUpdateInfoSP KisOpenGLUpdateInfoBuilder::buildUpdateInfo(const QRect &r
                                                                                              m_d->proofingConfig->proofingDepth,
                                                                                              m_d->proofingConfig->proofingProfile);
 
+            // the proofing transform is as precise as the display one
+            KoColorConversionTransformation::ConversionFlags proofingFlags = m_d->proofingConfig->conversionFlags;
+            proofingFlags.setFlag(KoColorConversionTransformation::ApproximateWithLut,
+                                  m_d->conversionOptions.m_conversionFlags.testFlag(KoColorConversionTransformation::ApproximateWithLut));
+
             m_d->proofingTransform.reset(KisTextureTileUpdateInfo::generateProofingTransform(
                                              projection->colorSpace(),
                                              m_d->conversionOptions.m_destinationColorSpace,
                                              proofingSpace,
                                              m_d->conversionOptions.m_renderingIntent,
                                              m_d->proofingConfig->intent,
-                                             m_d->proofingConfig->conversionFlags,
+                                             proofingFlags,
                                              m_d->proofingConfig->warningColor,
                                              m_d->proofingConfig->adaptationState));
         }
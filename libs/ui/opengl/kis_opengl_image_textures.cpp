@@ -77,6 +77,7 @@ KisOpenGLImageTextures::KisOpenGLImageTextures()
     m_conversionFlags = KoColorConversionTransformation::HighQuality;
     if (cfg.useBlackPointCompensation()) m_conversionFlags |= KoColorConversionTransformation::BlackpointCompensation;
     if (!cfg.allowLCMSOptimization()) m_conversionFlags |= KoColorConversionTransformation::NoOptimization;
+    if (cfg.useLutForDisplayConversion()) m_conversionFlags |= KoColorConversionTransformation::ApproximateWithLut;
     m_useOcio = cfg.useOcio();
 }
 
@@ -7,11 +7,18 @@
 
 #include "IccColorSpaceEngine.h"
 
+#include <functional>
+
+#include <QHash>
+#include <QMutex>
+#include <QWeakPointer>
+
 #include "KoColorModelStandardIds.h"
 
 #include <klocalizedstring.h>
 
 #include "LcmsColorSpace.h"
+#include "LcmsLutColorTransformer.h"
 
 // -- KoLcmsColorConversionTransformation --
 
@@ -39,6 +46,7 @@ public:
             }
         }
         conversionFlags |= KoColorConversionTransformation::CopyAlpha;
+        conversionFlags.setFlag(KoColorConversionTransformation::ApproximateWithLut, false);
 
         m_transform = cmsCreateTransform(srcProfile->lcmsProfile(),
                                          srcColorSpaceType,
@@ -97,6 +105,7 @@ public:
             }
         }
         conversionFlags |= KoColorConversionTransformation::CopyAlpha;
+        conversionFlags.setFlag(KoColorConversionTransformation::ApproximateWithLut, false);
 
         quint16 alarm[cmsMAXCHANNELS];//this seems to be bgr???
         alarm[0] = (cmsUInt16Number)gamutWarning[2]*256;
@@ -136,9 +145,129 @@ private:
     mutable cmsHTRANSFORM m_transform;
 };
 
+// -- KoLcmsLutColorConversionTransformation --
+
+class KoLcmsLutColorConversionTransformation : public KoColorConversionTransformation
+{
+public:
+    KoLcmsLutColorConversionTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                           Intent renderingIntent,
+                                           ConversionFlags conversionFlags,
+                                           LcmsLutColorTransformer::LutSP lut, int gridSize)
+        : KoColorConversionTransformation(srcCs, dstCs, renderingIntent, conversionFlags)
+        , m_transformer(srcCs, dstCs, lut, gridSize)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 numPixels) const override
+    {
+        m_transformer.transform(src, dst, numPixels);
+    }
+
+private:
+    LcmsLutColorTransformer m_transformer;
+};
+
+class KoLcmsLutColorProofingConversionTransformation : public KoColorProofingConversionTransformation
+{
+public:
+    KoLcmsLutColorProofingConversionTransformation(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                                   const KoColorSpace *proofingSpace,
+                                                   Intent renderingIntent,
+                                                   Intent proofingIntent,
+                                                   ConversionFlags conversionFlags,
+                                                   quint8 *gamutWarning,
+                                                   double adaptationState,
+                                                   LcmsLutColorTransformer::LutSP lut, int gridSize)
+        : KoColorProofingConversionTransformation(srcCs, dstCs, proofingSpace, renderingIntent, proofingIntent, conversionFlags, gamutWarning, adaptationState)
+        , m_transformer(srcCs, dstCs, lut, gridSize)
+    {
+    }
+
+    void transform(const quint8 *src, quint8 *dst, qint32 numPixels) const override
+    {
+        m_transformer.transform(src, dst, numPixels);
+    }
+
+private:
+    LcmsLutColorTransformer m_transformer;
+};
+
 struct IccColorSpaceEngine::Private {
+    /**
+     * The baked tables are shared between all the transformations
+     * with the same profiles, intents and flags, whatever the bit
+     * depth of their color spaces is. The table is released when
+     * the last transformation using it is destroyed, the expired
+     * entries are pruned on every insertion.
+     */
+    QMutex lutCacheLock;
+    QHash<QByteArray, QWeakPointer<const QVector<float>>> lutCache;
+
+    LcmsLutColorTransformer::LutSP fetchLut(const QByteArray &key,
+                                            std::function<LcmsLutColorTransformer::LutSP()> bakeFunc);
 };
 
+LcmsLutColorTransformer::LutSP IccColorSpaceEngine::Private::fetchLut(const QByteArray &key,
+                                                                      std::function<LcmsLutColorTransformer::LutSP()> bakeFunc)
+{
+    {
+        QMutexLocker l(&lutCacheLock);
+
+        LcmsLutColorTransformer::LutSP lut = lutCache.value(key).toStrongRef();
+        if (lut) return lut;
+    }
+
+    /**
+     * Baking takes a while, so it is done without holding the lock,
+     * the lookups of other tables should not wait for it. If another
+     * thread has baked the same table in the meantime, its table is
+     * used and ours is dropped.
+     */
+    LcmsLutColorTransformer::LutSP bakedLut = bakeFunc();
+    if (!bakedLut) return bakedLut;
+
+    QMutexLocker l(&lutCacheLock);
+
+    LcmsLutColorTransformer::LutSP lut = lutCache.value(key).toStrongRef();
+    if (lut) return lut;
+
+    for (auto it = lutCache.begin(); it != lutCache.end();) {
+        if (it.value().isNull()) {
+            it = lutCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    lutCache.insert(key, bakedLut);
+
+    return bakedLut;
+}
+
+namespace {
+QByteArray lutCacheKey(const KoColorSpace *srcColorSpace,
+                       const KoColorSpace *dstColorSpace,
+                       const KoColorSpace *proofingSpace,
+                       KoColorConversionTransformation::Intent renderingIntent,
+                       KoColorConversionTransformation::Intent proofingIntent,
+                       KoColorConversionTransformation::ConversionFlags conversionFlags,
+                       int gridSize)
+{
+    QByteArray key;
+    key += srcColorSpace->profile()->uniqueId();
+    key += dstColorSpace->profile()->uniqueId();
+    if (proofingSpace) {
+        key += proofingSpace->profile()->uniqueId();
+    }
+    key += QByteArray::number(renderingIntent) + ':' +
+        QByteArray::number(proofingIntent) + ':' +
+        QByteArray::number(uint(conversionFlags)) + ':' +
+        QByteArray::number(gridSize);
+    return key;
+}
+}
+
 IccColorSpaceEngine::IccColorSpaceEngine() : KoColorSpaceEngine("icc", i18n("ICC Engine")), d(new Private)
 {
 }
@@ -245,6 +374,39 @@ KoColorConversionTransformation *IccColorSpaceEngine::createColorTransformation(
     Q_ASSERT(srcColorSpace);
     Q_ASSERT(dstColorSpace);
 
+    if (conversionFlags.testFlag(KoColorConversionTransformation::ApproximateWithLut) &&
+        LcmsLutColorTransformer::isSupported(srcColorSpace, dstColorSpace)) {
+
+        LcmsColorProfileContainer *srcProfile = dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms();
+        LcmsColorProfileContainer *dstProfile = dynamic_cast<const IccColorProfile *>(dstColorSpace->profile())->asLcms();
+        const int gridSize = LcmsLutColorTransformer::gridSize(conversionFlags);
+
+        LcmsLutColorTransformer::LutSP lut =
+            d->fetchLut(lutCacheKey(srcColorSpace, dstColorSpace, nullptr,
+                                    renderingIntent, renderingIntent, conversionFlags, gridSize),
+                        [&] () {
+                            LcmsLutColorTransformer::LutSP bakedLut;
+
+                            cmsHTRANSFORM transform =
+                                cmsCreateTransform(srcProfile->lcmsProfile(), TYPE_RGB_FLT,
+                                                   dstProfile->lcmsProfile(), TYPE_RGB_FLT,
+                                                   renderingIntent,
+                                                   LcmsLutColorTransformer::lcmsFlags(conversionFlags));
+                            if (transform) {
+                                bakedLut = LcmsLutColorTransformer::bakeLut(transform, gridSize);
+                                cmsDeleteTransform(transform);
+                            }
+
+                            return bakedLut;
+                        });
+
+        if (lut) {
+            return new KoLcmsLutColorConversionTransformation(srcColorSpace, dstColorSpace,
+                                                              renderingIntent, conversionFlags,
+                                                              lut, gridSize);
+        }
+    }
+
     return new KoLcmsColorConversionTransformation(
                 srcColorSpace, computeColorSpaceType(srcColorSpace),
                 dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(), dstColorSpace, computeColorSpaceType(dstColorSpace),
@@ -263,6 +425,64 @@ KoColorProofingConversionTransformation *IccColorSpaceEngine::createColorProofin
     Q_ASSERT(srcColorSpace);
     Q_ASSERT(dstColorSpace);
 
+    /**
+     * LCMS float transforms mark out-of-gamut pixels with -1.0 instead of
+     * the alarm codes, and the interpolation would smear the warning color
+     * over the neighbouring pixels anyway, so the gamut check is always
+     * done by LCMS.
+     */
+    if (conversionFlags.testFlag(KoColorConversionTransformation::ApproximateWithLut) &&
+        !conversionFlags.testFlag(KoColorConversionTransformation::GamutCheck) &&
+        LcmsLutColorTransformer::isSupported(srcColorSpace, dstColorSpace)) {
+
+        LcmsColorProfileContainer *srcProfile = dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms();
+        LcmsColorProfileContainer *dstProfile = dynamic_cast<const IccColorProfile *>(dstColorSpace->profile())->asLcms();
+        LcmsColorProfileContainer *proofingProfile = dynamic_cast<const IccColorProfile *>(proofingSpace->profile())->asLcms();
+        const int gridSize = LcmsLutColorTransformer::gridSize(conversionFlags);
+
+        QByteArray key = lutCacheKey(srcColorSpace, dstColorSpace, proofingSpace,
+                                     renderingIntent, proofingIntent, conversionFlags, gridSize);
+        key += ':' + QByteArray(reinterpret_cast<const char*>(gamutWarning), 3) +
+            ':' + QByteArray::number(adaptationState);
+
+        LcmsLutColorTransformer::LutSP lut =
+            d->fetchLut(key,
+                        [&] () {
+                            LcmsLutColorTransformer::LutSP bakedLut;
+
+                            // see KoLcmsColorProofingConversionTransformation
+                            quint16 alarm[cmsMAXCHANNELS];
+                            alarm[0] = (cmsUInt16Number)gamutWarning[2]*256;
+                            alarm[1] = (cmsUInt16Number)gamutWarning[1]*256;
+                            alarm[2] = (cmsUInt16Number)gamutWarning[0]*256;
+                            cmsSetAlarmCodes(alarm);
+                            cmsSetAdaptationState(adaptationState);
+
+                            cmsHTRANSFORM transform =
+                                cmsCreateProofingTransform(srcProfile->lcmsProfile(), TYPE_RGB_FLT,
+                                                           dstProfile->lcmsProfile(), TYPE_RGB_FLT,
+                                                           proofingProfile->lcmsProfile(),
+                                                           renderingIntent,
+                                                           proofingIntent,
+                                                           LcmsLutColorTransformer::lcmsFlags(conversionFlags));
+                            cmsSetAdaptationState(1);
+
+                            if (transform) {
+                                bakedLut = LcmsLutColorTransformer::bakeLut(transform, gridSize);
+                                cmsDeleteTransform(transform);
+                            }
+
+                            return bakedLut;
+                        });
+
+        if (lut) {
+            return new KoLcmsLutColorProofingConversionTransformation(srcColorSpace, dstColorSpace, proofingSpace,
+                                                                      renderingIntent, proofingIntent, conversionFlags,
+                                                                      gamutWarning, adaptationState,
+                                                                      lut, gridSize);
+        }
+    }
+
     return new KoLcmsColorProofingConversionTransformation(
                 srcColorSpace, computeColorSpaceType(srcColorSpace),
                 dynamic_cast<const IccColorProfile *>(srcColorSpace->profile())->asLcms(), dstColorSpace, computeColorSpaceType(dstColorSpace),
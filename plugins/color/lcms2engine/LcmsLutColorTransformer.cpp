@@ -0,0 +1,194 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#include "LcmsLutColorTransformer.h"
+
+#include <KoBgrColorSpaceTraits.h>
+#include <KoRgbColorSpaceTraits.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorProfile.h>
+#include <KoColorSpace.h>
+#include <KoColorSpaceMaths.h>
+#include <KoLut3DInterpolatorFactory.h>
+
+#include <kis_assert.h>
+
+namespace {
+
+/**
+ * The number of pixels converted in one go, the planes of
+ * the chunk should fit into L1 cache
+ */
+const int ChunkSize = 256;
+
+typedef void (*LutTransformFunc)(const float *lut, int gridSize,
+                                 const KoLut3DInterpolatorBase *interpolator,
+                                 const quint8 *src, quint8 *dst, qint32 numPixels);
+
+template<class SrcTraits, class DstTraits>
+void lutTransform(const float *lut, int gridSize,
+                  const KoLut3DInterpolatorBase *interpolator,
+                  const quint8 *src, quint8 *dst, qint32 numPixels)
+{
+    using src_channel_type = typename SrcTraits::channels_type;
+    using dst_channel_type = typename DstTraits::channels_type;
+
+    float srcPlanes[3 * ChunkSize];
+    float dstPlanes[3 * ChunkSize];
+
+    const src_channel_type *srcPixel = reinterpret_cast<const src_channel_type*>(src);
+    dst_channel_type *dstPixel = reinterpret_cast<dst_channel_type*>(dst);
+
+    while (numPixels > 0) {
+        const int chunkSize = qMin(numPixels, ChunkSize);
+
+        const src_channel_type *s = srcPixel;
+        for (int i = 0; i < chunkSize; i++) {
+            srcPlanes[i] = KoColorSpaceMaths<src_channel_type, float>::scaleToA(s[SrcTraits::red_pos]);
+            srcPlanes[chunkSize + i] = KoColorSpaceMaths<src_channel_type, float>::scaleToA(s[SrcTraits::green_pos]);
+            srcPlanes[2 * chunkSize + i] = KoColorSpaceMaths<src_channel_type, float>::scaleToA(s[SrcTraits::blue_pos]);
+            s += SrcTraits::channels_nb;
+        }
+
+        interpolator->interpolate(lut, gridSize, srcPlanes, dstPlanes, chunkSize, 3);
+
+        dst_channel_type *d = dstPixel;
+        for (int i = 0; i < chunkSize; i++) {
+            d[DstTraits::red_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstPlanes[i]);
+            d[DstTraits::green_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstPlanes[chunkSize + i]);
+            d[DstTraits::blue_pos] = KoColorSpaceMaths<float, dst_channel_type>::scaleToA(dstPlanes[2 * chunkSize + i]);
+            d[DstTraits::alpha_pos] = KoColorSpaceMaths<src_channel_type, dst_channel_type>::scaleToA(srcPixel[SrcTraits::alpha_pos]);
+
+            srcPixel += SrcTraits::channels_nb;
+            d += DstTraits::channels_nb;
+        }
+        dstPixel = d;
+
+        numPixels -= chunkSize;
+    }
+}
+
+template<class SrcTraits>
+LutTransformFunc selectTransformFunc(const KoID &dstDepth)
+{
+    if (dstDepth == Integer8BitsColorDepthID) {
+        return &lutTransform<SrcTraits, KoBgrU8Traits>;
+    } else if (dstDepth == Integer16BitsColorDepthID) {
+        return &lutTransform<SrcTraits, KoBgrU16Traits>;
+    } else if (dstDepth == Float32BitsColorDepthID) {
+        return &lutTransform<SrcTraits, KoRgbF32Traits>;
+    }
+
+    return nullptr;
+}
+
+bool isSupportedDepth(const KoID &depth)
+{
+    return depth == Integer8BitsColorDepthID ||
+        depth == Integer16BitsColorDepthID ||
+        depth == Float32BitsColorDepthID;
+}
+
+}
+
+LcmsLutColorTransformer::LcmsLutColorTransformer(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                                                 LutSP lut, int gridSize)
+    : m_lut(lut),
+      m_gridSize(gridSize),
+      m_interpolator(KoLut3DInterpolatorFactory::create()),
+      m_transformFunc(nullptr)
+{
+    KIS_SAFE_ASSERT_RECOVER_NOOP(isSupported(srcCs, dstCs));
+    KIS_SAFE_ASSERT_RECOVER_NOOP(m_lut->size() == gridSize * gridSize * gridSize * KoLut3DInterpolatorBase::NodeSize);
+
+    const KoID srcDepth = srcCs->colorDepthId();
+    const KoID dstDepth = dstCs->colorDepthId();
+
+    if (srcDepth == Integer8BitsColorDepthID) {
+        m_transformFunc = selectTransformFunc<KoBgrU8Traits>(dstDepth);
+    } else if (srcDepth == Integer16BitsColorDepthID) {
+        m_transformFunc = selectTransformFunc<KoBgrU16Traits>(dstDepth);
+    } else if (srcDepth == Float32BitsColorDepthID) {
+        m_transformFunc = selectTransformFunc<KoRgbF32Traits>(dstDepth);
+    }
+}
+
+LcmsLutColorTransformer::~LcmsLutColorTransformer()
+{
+}
+
+void LcmsLutColorTransformer::transform(const quint8 *src, quint8 *dst, qint32 numPixels) const
+{
+    KIS_SAFE_ASSERT_RECOVER_RETURN(m_transformFunc);
+    m_transformFunc(m_lut->constData(), m_gridSize, m_interpolator.data(), src, dst, numPixels);
+}
+
+bool LcmsLutColorTransformer::isSupported(const KoColorSpace *srcCs, const KoColorSpace *dstCs)
+{
+    /**
+     * A uniform lattice in linear space has too few nodes in the
+     * shadows, so linear sources are always converted by LCMS.
+     * The same is true for unbounded float-to-float conversions,
+     * we would have clamped the values otherwise.
+     */
+    return srcCs->colorModelId() == RGBAColorModelID &&
+        dstCs->colorModelId() == RGBAColorModelID &&
+        isSupportedDepth(srcCs->colorDepthId()) &&
+        isSupportedDepth(dstCs->colorDepthId()) &&
+        !(srcCs->colorDepthId() == Float32BitsColorDepthID &&
+          dstCs->colorDepthId() == Float32BitsColorDepthID) &&
+        srcCs->profile() && !srcCs->profile()->isLinear();
+}
+
+int LcmsLutColorTransformer::gridSize(KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    return conversionFlags.testFlag(KoColorConversionTransformation::HighQuality) ? 65 :
+        conversionFlags.testFlag(KoColorConversionTransformation::LowQuality) ? 17 : 33;
+}
+
+LcmsLutColorTransformer::LutSP LcmsLutColorTransformer::bakeLut(cmsHTRANSFORM floatTransform, int gridSize)
+{
+    const int numNodes = gridSize * gridSize * gridSize;
+    const float maxIndex = gridSize - 1;
+
+    QVector<float> input(3 * numNodes);
+    QVector<float> output(3 * numNodes);
+
+    float *ptr = input.data();
+    for (int r = 0; r < gridSize; r++) {
+        for (int g = 0; g < gridSize; g++) {
+            for (int b = 0; b < gridSize; b++) {
+                *ptr++ = r / maxIndex;
+                *ptr++ = g / maxIndex;
+                *ptr++ = b / maxIndex;
+            }
+        }
+    }
+
+    cmsDoTransform(floatTransform, input.constData(), output.data(), numNodes);
+
+    QVector<float> *lut = new QVector<float>(KoLut3DInterpolatorBase::NodeSize * numNodes, 0.0f);
+
+    const float *srcNode = output.constData();
+    float *dstNode = lut->data();
+    for (int i = 0; i < numNodes; i++) {
+        dstNode[0] = srcNode[0];
+        dstNode[1] = srcNode[1];
+        dstNode[2] = srcNode[2];
+
+        srcNode += 3;
+        dstNode += KoLut3DInterpolatorBase::NodeSize;
+    }
+
+    return LutSP(lut);
+}
+
+cmsUInt32Number LcmsLutColorTransformer::lcmsFlags(KoColorConversionTransformation::ConversionFlags conversionFlags)
+{
+    return cmsUInt32Number(conversionFlags) &
+        ~cmsUInt32Number(KoColorConversionTransformation::ApproximateWithLut |
+                         KoColorConversionTransformation::CopyAlpha);
+}
@@ -0,0 +1,88 @@
+/*
+ *  SPDX-FileCopyrightText: 2026 Krita developers
+ *
+ *  SPDX-License-Identifier: LGPL-2.1-or-later
+ */
+
+#ifndef LCMSLUTCOLORTRANSFORMER_H
+#define LCMSLUTCOLORTRANSFORMER_H
+
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QVector>
+
+#include <lcms2.h>
+
+#include <KoColorConversionTransformation.h>
+
+class KoColorSpace;
+class KoLut3DInterpolatorBase;
+
+/**
+ * A color conversion baked into a 3D lookup table
+ *
+ * For float and 16-bit pipelines with LUT-based profiles
+ * cmsDoTransform() evaluates the whole pipeline for every pixel,
+ * which is too slow for the display conversion. When the
+ * ApproximateWithLut flag is set, IccColorSpaceEngine evaluates the
+ * pipeline only once per node of a lattice and the pixels are
+ * converted with tetrahedral interpolation in it.
+ *
+ * The table doesn't depend on the bit depth of the color spaces, so
+ * all the transformations between the same profiles with the same
+ * intent and flags share a single table. After construction the
+ * transformer is immutable, so it is safe to use it from several
+ * threads at once.
+ *
+ * Only RGBA color spaces with non-linear profiles are supported,
+ * the source values are clamped into [0, 1] range and alpha is
+ * copied as is.
+ */
+class LcmsLutColorTransformer
+{
+public:
+    typedef QSharedPointer<const QVector<float>> LutSP;
+
+    LcmsLutColorTransformer(const KoColorSpace *srcCs, const KoColorSpace *dstCs,
+                            LutSP lut, int gridSize);
+    ~LcmsLutColorTransformer();
+
+    void transform(const quint8 *src, quint8 *dst, qint32 numPixels) const;
+
+    /**
+     * \return true if the conversion between \p srcCs and \p dstCs
+     * can be approximated with a lookup table
+     */
+    static bool isSupported(const KoColorSpace *srcCs, const KoColorSpace *dstCs);
+
+    /**
+     * \return the size of the lattice for the quality requested by
+     * \p conversionFlags
+     */
+    static int gridSize(KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+    /**
+     * Evaluates \p floatTransform in every node of the lattice. The
+     * transform should convert TYPE_RGB_FLT pixels into TYPE_RGB_FLT.
+     */
+    static LutSP bakeLut(cmsHTRANSFORM floatTransform, int gridSize);
+
+    /**
+     * \return the flags that should be passed to LCMS when baking the
+     * table, that is \p conversionFlags without the ones LCMS doesn't
+     * know about
+     */
+    static cmsUInt32Number lcmsFlags(KoColorConversionTransformation::ConversionFlags conversionFlags);
+
+private:
+    typedef void (*TransformFunc)(const float *lut, int gridSize,
+                                  const KoLut3DInterpolatorBase *interpolator,
+                                  const quint8 *src, quint8 *dst, qint32 numPixels);
+
+    LutSP m_lut;
+    int m_gridSize;
+    QScopedPointer<KoLut3DInterpolatorBase> m_interpolator;
+    TransformFunc m_transformFunc;
+};
+
+#endif // LCMSLUTCOLORTRANSFORMER_H
@@ -160,6 +160,16 @@ quint8 LabU16ColorSpace::scaleToU8(const quint8 *srcPixel, qint32 channelIndex)
     return KoColorSpaceMaths<qreal, quint8>::scaleToA(b);
 }
 
+void LabU16ColorSpace::addPixelsToU8Histograms(const quint8 *pixels, quint32 nPixels, quint32 *bins) const
+{
+    for (quint32 i = 0; i < nPixels; i++) {
+        for (qint32 channel = 0; channel < qint32(ColorSpaceTraits::channels_nb); channel++) {
+            bins[channel * 256 + LabU16ColorSpace::scaleToU8(pixels, channel)]++;
+        }
+        pixels += ColorSpaceTraits::pixelSize;
+    }
+}
+
 void LabU16ColorSpace::convertChannelToVisualRepresentation(const quint8 *src, quint8 *dst, quint32 nPixels, const qint32 selectedChannelIndex) const
 {
     for (uint pixelIndex = 0; pixelIndex < nPixels; ++pixelIndex) {
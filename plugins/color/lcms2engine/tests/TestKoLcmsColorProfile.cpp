@@ -8,6 +8,10 @@
 #include <LcmsColorProfileContainer.h>
 
 #include <KoColor.h>
+#include <KoColorModelStandardIds.h>
+#include <KoColorConversionTransformation.h>
+
+#include <QScopedPointer>
 
 #include <simpletest.h>
 
@@ -104,4 +108,71 @@ void TestKoLcmsColorProfile::testProofingConversion()
     Q_ASSERT((dst[0] == alarm[0]) && (dst[1] == alarm[1]) && (dst[2] == alarm[2]));
 
 }
+void TestKoLcmsColorProfile::testLutProofingWithGamutCheck()
+{
+    const KoColorSpace *sRgb = KoColorSpaceRegistry::instance()->rgb16("sRGB built-in");
+    QVERIFY(sRgb);
+
+    // a profile with a very narrow gamut, so that pure red is out of it
+    cmsCIExyY whitePoint;
+    cmsWhitePointFromTemp(&whitePoint, 6504);
+    cmsCIExyYTRIPLE primaries = {{0.38, 0.34, 1.0}, {0.30, 0.38, 1.0}, {0.28, 0.28, 1.0}};
+    cmsToneCurve *curve = cmsBuildGamma(0, 2.2);
+    cmsToneCurve *curves[3] = {curve, curve, curve};
+    cmsHPROFILE narrowProfile = cmsCreateRGBProfile(&whitePoint, &primaries, curves);
+    cmsFreeToneCurve(curve);
+
+    cmsUInt32Number size = 0;
+    cmsSaveProfileToMem(narrowProfile, 0, &size);
+    QByteArray rawData(size, 0);
+    cmsSaveProfileToMem(narrowProfile, rawData.data(), &size);
+    cmsCloseProfile(narrowProfile);
+
+    const KoColorProfile *proofingProfile =
+        KoColorSpaceRegistry::instance()->createColorProfile(RGBAColorModelID.id(), Integer16BitsColorDepthID.id(), rawData);
+    QVERIFY(proofingProfile);
+
+    const KoColorSpace *proofingSpace =
+        KoColorSpaceRegistry::instance()->colorSpace(RGBAColorModelID.id(), Integer16BitsColorDepthID.id(), proofingProfile);
+    QVERIFY(proofingSpace);
+
+    quint8 gamutWarning[4] = {0, 255, 0, 255};
+
+    const KoColorConversionTransformation::ConversionFlags flags =
+        KoColorConversionTransformation::SoftProofing |
+        KoColorConversionTransformation::GamutCheck;
+
+    QScopedPointer<KoColorConversionTransformation> reference(
+        sRgb->createProofingTransform(sRgb, proofingSpace,
+                                      KoColorConversionTransformation::IntentRelativeColorimetric,
+                                      KoColorConversionTransformation::IntentRelativeColorimetric,
+                                      flags, gamutWarning, 1.0));
+
+    QScopedPointer<KoColorConversionTransformation> approximated(
+        sRgb->createProofingTransform(sRgb, proofingSpace,
+                                      KoColorConversionTransformation::IntentRelativeColorimetric,
+                                      KoColorConversionTransformation::IntentRelativeColorimetric,
+                                      flags | KoColorConversionTransformation::ApproximateWithLut,
+                                      gamutWarning, 1.0));
+
+    QVERIFY(reference);
+    QVERIFY(approximated);
+
+    // pure red and a neutral gray, the latter is always in gamut
+    const quint16 src[8] = {0, 0, 65535, 65535,
+                            32768, 32768, 32768, 65535};
+    quint16 expected[8] = {0};
+    quint16 result[8] = {0};
+
+    reference->transform((const quint8*)src, (quint8*)expected, 2);
+    approximated->transform((const quint8*)src, (quint8*)result, 2);
+
+    // the warning color should survive, not turn into black
+    QVERIFY(result[0] || result[1] || result[2]);
+
+    for (int i = 0; i < 8; i++) {
+        QCOMPARE(result[i], expected[i]);
+    }
+}
+
 SIMPLE_TEST_MAIN(TestKoLcmsColorProfile)
@@ -52,12 +52,14 @@ void HistogramDockerDock::setCanvas(KoCanvasBase * canvas)
     }
 
     m_canvas = dynamic_cast<KisCanvas2*>(canvas);
+    m_histogramWidget->resetHistogram();
+
     if (m_canvas) {
 
         m_imageIdleWatcher->setTrackedImage(m_canvas->image());
         connect(m_imageIdleWatcher, &KisIdleWatcher::startedIdleMode, this, &HistogramDockerDock::updateHistogram, Qt::UniqueConnection);
 
-        connect(m_canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(startUpdateCanvasProjection()), Qt::UniqueConnection);
+        connect(m_canvas->image(), SIGNAL(sigImageUpdated(QRect)), this, SLOT(startUpdateCanvasProjection(QRect)), Qt::UniqueConnection);
         connect(m_canvas->image(), SIGNAL(sigColorSpaceChanged(const KoColorSpace*)), this, SLOT(sigColorSpaceChanged(const KoColorSpace*)), Qt::UniqueConnection);
         m_imageIdleWatcher->startCountdown();
     }
@@ -70,8 +72,11 @@ void HistogramDockerDock::unsetCanvas()
     m_imageIdleWatcher->startCountdown();
 }
 
-void HistogramDockerDock::startUpdateCanvasProjection()
+void HistogramDockerDock::startUpdateCanvasProjection(const QRect &rc)
 {
+    // the changes should be tracked even when the docker is hidden
+    m_histogramWidget->addDirtyRect(rc);
+
     if (isVisible()) {
         m_imageIdleWatcher->startCountdown();
     }
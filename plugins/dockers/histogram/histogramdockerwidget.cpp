@@ -18,30 +18,28 @@
 #include "KoChannelInfo.h"
 #include "kis_paint_device.h"
 #include "KoColorSpace.h"
-#include "kis_iterator_ng.h"
-#include "krita_utils.h"
 #include "kis_canvas2.h"
+#include "KisTiledHistogram.h"
 
 struct HistogramComputationStrokeStrategy::Private {
 
     class ProcessData : public KisStrokeJobData
     {
     public:
-        ProcessData(QRect rect, int _jobId)
+        ProcessData(int _tileIndex)
             : KisStrokeJobData(CONCURRENT)
-            , rectToCalculate(rect)
-            , jobId(_jobId)
+            , tileIndex(_tileIndex)
         {}
 
-        QRect rectToCalculate;
-        int jobId; // id in the list of results
+        int tileIndex; // index of the tile in KisTiledHistogram
     };
 };
 
 
-HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageWSP image)
+HistogramComputationStrokeStrategy::HistogramComputationStrokeStrategy(KisImageWSP image, QSharedPointer<KisTiledHistogram> histogram)
     : KisSimpleStrokeStrategy(QLatin1String("ComputeHistogram")),
-      m_image(image)
+      m_image(image),
+      m_histogram(histogram)
 {
     enableJob(KisSimpleStrokeStrategy::JOB_INIT, true, KisStrokeJobData::BARRIER, KisStrokeJobData::EXCLUSIVE);
     enableJob(KisSimpleStrokeStrategy::JOB_DOSTROKE);
@@ -60,13 +58,18 @@ HistogramComputationStrokeStrategy::~HistogramComputationStrokeStrategy()
 
 void HistogramComputationStrokeStrategy::initStrokeCallback()
 {
+    const QRect imageBounds = m_image->bounds();
+
+    quint32 imageSize = imageBounds.width() * imageBounds.height();
+    quint32 nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
+
+    // resets the histogram if the projection, its color space or the image size has changed
+    m_histogram->prepare(m_image->projection(), imageBounds, nSkip);
+
+    // only the tiles changed since the previous computation are rescanned
     QVector<KisStrokeJobData*> jobsData;
-    int i = 0;
-    QVector<QRect> tileRects = KritaUtils::splitRectIntoPatches(m_image->bounds(), KritaUtils::optimalPatchSize());
-    m_results.resize(tileRects.size());
-    Q_FOREACH (const QRect &tileRectangle, tileRects) {
-        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileRectangle, i);
-        i++;
+    Q_FOREACH (int tileIndex, m_histogram->dirtyTiles()) {
+        jobsData << new HistogramComputationStrokeStrategy::Private::ProcessData(tileIndex);
     }
     addMutatedJobs(jobsData);
 }
@@ -75,42 +78,8 @@ void HistogramComputationStrokeStrategy::doStrokeCallback(KisStrokeJobData *data
 {
     Private::ProcessData *d_pd = dynamic_cast<Private::ProcessData*>(data);
     KIS_SAFE_ASSERT_RECOVER_RETURN(d_pd);
-    QRect calculate = d_pd->rectToCalculate;
-
-    KisPaintDeviceSP m_dev = m_image->projection();
-    QRect imageBounds = m_image->bounds();
-
-    const KoColorSpace *cs = m_dev->colorSpace();
-    quint32 channelCount = m_dev->channelCount();
-    quint32 pixelSize = m_dev->pixelSize();
-
-    quint32 imageSize = imageBounds.width() * imageBounds.height();
-    quint32 nSkip = 1 + (imageSize >> 20); //for speed use about 1M pixels for computing histograms
-
-    if (calculate.isEmpty())
-        return;
-
-    initiateVector(m_results[d_pd->jobId], cs);
-
-    quint32 toSkip = nSkip;
 
-    KisSequentialConstIterator it(m_dev, calculate);
-
-    int numConseqPixels = it.nConseqPixels();
-    while (it.nextPixels(numConseqPixels)) {
-
-        numConseqPixels = it.nConseqPixels();
-        const quint8* pixel = it.rawDataConst();
-        for (int k = 0; k < numConseqPixels; ++k) {
-            if (--toSkip == 0) {
-                for (int chan = 0; chan < (int)channelCount; ++chan) {
-                    m_results[d_pd->jobId][chan][cs->scaleToU8(pixel, chan)]++;
-                }
-                toSkip = nSkip;
-            }
-            pixel += pixelSize;
-        }
-    }
+    m_histogram->updateTile(m_image->projection(), d_pd->tileIndex);
 }
 
 void HistogramComputationStrokeStrategy::finishStrokeCallback()
@@ -120,46 +89,27 @@ void HistogramComputationStrokeStrategy::finishStrokeCallback()
     }
 
     HistogramData hisData;
-    hisData.colorSpace = m_image->projection()->colorSpace();
-
-    if (m_results.size() == 1) {
-        hisData.bins = m_results[0];
-        emit computationResultReady(hisData);
-    } else {
+    hisData.colorSpace = m_histogram->colorSpace();
 
-        quint32 channelCount = m_image->projection()->channelCount();
-
-        initiateVector(hisData.bins, hisData.colorSpace);
+    if (!hisData.colorSpace) {
+        return;
+    }
 
-        for (int chan = 0; chan < (int)channelCount; chan++) {
-            int bsize = hisData.bins[chan].size();
+    const int channelCount = hisData.colorSpace->channelCount();
+    hisData.bins.resize(channelCount);
 
-            for (int bi = 0; bi < bsize; bi++) {
-                hisData.bins[chan][bi] = 0;
-                for (int i = 0; i < (int)m_results.size(); i++) {
-                    hisData.bins[chan][bi] += m_results[i][chan][bi];
-                }
-            }
-        }
-
-        emit computationResultReady(hisData);
+    for (int chan = 0; chan < channelCount; chan++) {
+        const QVector<quint32> bins = m_histogram->channelBins(chan);
+        hisData.bins[chan].assign(bins.constBegin(), bins.constEnd());
     }
 
+    emit computationResultReady(hisData);
 }
 
 void HistogramComputationStrokeStrategy::cancelStrokeCallback()
 {
 }
 
-void HistogramComputationStrokeStrategy::initiateVector(HistVector &vec, const KoColorSpace *colorSpace)
-{
-    int channelCount = colorSpace->channelCount();
-    vec.resize((int)channelCount);
-    for (auto &bin : vec) {
-        bin.resize(std::numeric_limits<quint8>::max() + 1);
-    }
-}
-
 
 
 HistogramDockerWidget::HistogramDockerWidget(QWidget *parent, const char *name, Qt::WindowFlags f)
@@ -168,6 +118,8 @@ HistogramDockerWidget::HistogramDockerWidget(QWidget *parent, const char *name,
     setObjectName(name);
     qRegisterMetaType<HistogramData>();
 
+    m_histogram.reset(new KisTiledHistogram());
+
 }
 
 HistogramDockerWidget::~HistogramDockerWidget()
@@ -178,18 +130,8 @@ HistogramDockerWidget::~HistogramDockerWidget()
 void HistogramDockerWidget::updateHistogram(KisCanvas2* canvas)
 {
     if (canvas) {
-        KisPaintDeviceSP paintDevice = canvas->image()->projection();
-        QRect bounds = canvas->image()->bounds();
-
-        // remember to save the color space to paint the histogram data!
-        m_colorSpace = paintDevice->colorSpace();
-
-        KisPaintDeviceSP m_devClone = new KisPaintDevice(paintDevice->colorSpace());
-
-        m_devClone->makeCloneFrom(paintDevice, bounds);
-
         HistogramComputationStrokeStrategy* stroke;
-        stroke = new HistogramComputationStrokeStrategy(canvas->image());
+        stroke = new HistogramComputationStrokeStrategy(canvas->image(), m_histogram);
 
         connect(stroke, SIGNAL(computationResultReady(HistogramData)), this, SLOT(receiveNewHistogram(HistogramData)));
 
@@ -203,6 +145,16 @@ void HistogramDockerWidget::updateHistogram(KisCanvas2* canvas)
     }
 }
 
+void HistogramDockerWidget::addDirtyRect(const QRect &rc)
+{
+    m_histogram->addDirtyRect(rc);
+}
+
+void HistogramDockerWidget::resetHistogram()
+{
+    m_histogram->invalidate();
+}
+
 void HistogramDockerWidget::receiveNewHistogram(HistVector* data)
 {
     m_histogramData = *data;
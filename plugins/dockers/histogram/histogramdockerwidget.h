@@ -12,12 +12,14 @@
 #include <QWidget>
 #include <QLabel>
 #include <QThread>
+#include <QSharedPointer>
 #include "kis_types.h"
 #include <vector>
 #include <kis_simple_stroke_strategy.h>
 
 class KisCanvas2;
 class KoColorSpace;
+class KisTiledHistogram;
 
 
 using HistVector = std::vector<std::vector<quint32> >; //Don't use QVector here - it's too slow for this purpose
@@ -37,7 +39,7 @@ class HistogramComputationStrokeStrategy : public QObject, public KisSimpleStrok
 {
     Q_OBJECT
 public:
-    HistogramComputationStrokeStrategy(KisImageWSP image);
+    HistogramComputationStrokeStrategy(KisImageWSP image, QSharedPointer<KisTiledHistogram> histogram);
     ~HistogramComputationStrokeStrategy() override;
 
 
@@ -47,8 +49,6 @@ private:
     void finishStrokeCallback() override;
     void cancelStrokeCallback() override;
 
-    void initiateVector(HistVector &vec, const KoColorSpace* colorSpace);
-
 Q_SIGNALS:
     //Emitted when thumbnail is updated and overviewImage is fully generated.
     void computationResultReady(HistogramData data);
@@ -58,7 +58,7 @@ private:
     struct Private;
     const QScopedPointer<Private> m_d;
     KisImageSP m_image;
-    std::vector<HistVector> m_results;
+    QSharedPointer<KisTiledHistogram> m_histogram;
 };
 
 
@@ -81,11 +81,24 @@ public Q_SLOTS:
      * Isolate Mode or when opening an image with a single layer.
      */
     void updateHistogram(KisCanvas2* canvas);
+
+    /**
+     * @brief addDirtyRect marks the area of the image that should be
+     * rescanned on the next call to updateHistogram()
+     */
+    void addDirtyRect(const QRect &rc);
+
+    /**
+     * @brief resetHistogram forces rescanning of the entire image on the
+     * next call to updateHistogram(), e.g. when the canvas changes
+     */
+    void resetHistogram();
     void receiveNewHistogram(HistVector*);
     void receiveNewHistogram(HistogramData data);
 
 
 private:
+    QSharedPointer<KisTiledHistogram> m_histogram;
     HistVector m_histogramData;
     const KoColorSpace* m_colorSpace {0};
     bool m_smoothHistogram {false};
@@ -38,13 +38,16 @@
 #include <kis_processing_information.h>
 #include <kis_paint_device.h>
 #include "widgets/kis_multi_integer_filter_widget.h"
+#include <KisSlidingWindowHistogram.h>
+#include <kis_painter.h>
+#include <krita_utils.h>
 #include <KisGlobalResourcesInterface.h>
 
 
 KisOilPaintFilter::KisOilPaintFilter() : KisFilter(id(), FiltersCategoryArtisticId, i18n("&Oilpaint..."))
 {
     setSupportsPainting(true);
-    setSupportsThreading(false);
+    setSupportsThreading(true);
     setSupportsAdjustmentLayers(true);
 }
 
@@ -80,109 +83,112 @@ void KisOilPaintFilter::processImpl(KisPaintDeviceSP device,
 void KisOilPaintFilter::OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
                                  int BrushSize, int Smoothness, KoUpdater* progressUpdater) const
 {
-    KisSequentialConstIteratorProgress it(src, applyRect, progressUpdater);
-    KisSequentialIterator dstIt(dst, applyRect);
+    /**
+     * The result is written into a temporary device first, because
+     * the filter may be applied in-place and the patches read the
+     * pixels of their neighbours.
+     */
+    KisPaintDeviceSP result = new KisPaintDevice(dst->colorSpace());
 
-    while (it.nextPixel() && dstIt.nextPixel()) {
-        MostFrequentColor(src, dstIt.rawData(), applyRect, it.x(), it.y(), BrushSize, Smoothness);
+    KisSlidingWindowHistogram histogram(Smoothness + 1, src->colorSpace()->channelCount(), BrushSize);
+
+    const QVector<QRect> patches =
+        KritaUtils::splitRectIntoPatches(applyRect, KritaUtils::optimalPatchSize());
+
+    qint64 processedPixels = 0;
+    const qint64 totalPixels = qint64(applyRect.width()) * applyRect.height();
+
+    Q_FOREACH (const QRect &patch, patches) {
+        MostFrequentColor(src, result, patch, histogram, Smoothness);
+
+        processedPixels += qint64(patch.width()) * patch.height();
+        if (progressUpdater) {
+            progressUpdater->setProgress(100 * processedPixels / totalPixels);
+        }
     }
+
+    KisPainter::copyAreaOptimized(applyRect.topLeft(), result, dst, applyRect);
 }
 
 // This method has been ported from Pieter Z. Voloshyn's algorithm code in Digikam.
 
 /* Function to determine the most frequent color in a matrix
  *
- * Bits             => Bits array
- * Width            => Image width
- * Height           => Image height
- * X                => Position horizontal
- * Y                => Position vertical
- * Radius           => Is the radius of the matrix to be analyzed
- * Intensity        => Intensity to calculate
+ * Theory           => For every pixel we take a matrix with the analyzed pixel in
+ *                     the center of this matrix and find the most frequent color
  *
- * Theory           => This function creates a matrix with the analyzed pixel in
- *                     the center of this matrix and find the most frequenty color
+ * The histogram of the matrix is not rebuilt for every pixel, it slides over
+ * the patch instead (see KisSlidingWindowHistogram), so the cost per pixel
+ * doesn't depend on the radius of the matrix.
  */
 
-void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& /*bounds*/, int X, int Y, int Radius, int Intensity) const
+void KisOilPaintFilter::MostFrequentColor(KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &rect,
+                                          KisSlidingWindowHistogram &histogram, int Intensity) const
 {
-    uint I;
-
-    double Scale = Intensity / 255.0;
-
-    // Alloc some arrays to be used
-    uchar *IntensityCount = new uchar[(Intensity + 1)];
-
     const KoColorSpace* cs = src->colorSpace();
+    const int numChannels = cs->channelCount();
+    const int Radius = histogram.radius();
 
-    QVector<float> channel(cs->channelCount());
-    QVector<float>* AverageChannels = new QVector<float>[(Intensity + 1)];
+    const double Scale = Intensity / 255.0;
 
-    // Erase the array
-    memset(IntensityCount, 0, (Intensity + 1) * sizeof(uchar));
+    const QRect srcRect = kisGrowRect(rect, Radius);
+    const int numSrcPixels = srcRect.width() * srcRect.height();
 
-    int startx = X - Radius;
-    int starty = Y - Radius;
-    int width = (2 * Radius) + 1;
-    int height = (2 * Radius) + 1;
+    std::vector<qint16> intensityBins(numSrcPixels);
+    std::vector<float> channels(numSrcPixels * numChannels);
+    std::vector<qreal> alphas(numSrcPixels);
 
-    qreal middlePointAlpha = 1;
     {
-        // if the current pixel is transparent, the result must be transparent, too.
-        KisSequentialConstIterator middlePointIt(src, QRect(X, Y, 1, 1));
-        middlePointIt.nextPixel();
-        middlePointAlpha = cs->opacityF(middlePointIt.oldRawData());
-    }
+        QVector<float> channel(numChannels);
 
+        KisSequentialConstIterator srcIt(src, srcRect);
 
-    KisSequentialConstIterator srcIt(src, QRect(startx, starty, width, height));
-    while (middlePointAlpha > 0 && srcIt.nextPixel()) {
+        int i = 0;
+        while (srcIt.nextPixel()) {
+            const quint8 *data = srcIt.oldRawData();
 
-        cs->normalisedChannelsValue(srcIt.oldRawData(), channel);
+            alphas[i] = cs->opacityF(data);
 
-        if (cs->opacityU8(srcIt.oldRawData()) == 0) {
             // if the pixel is transparent, it's not going to provide any useful information
-            continue;
-        }
+            if (cs->opacityU8(data) == 0) {
+                intensityBins[i] = -1;
+            } else {
+                intensityBins[i] = qint16(uint(cs->intensity8(data) * Scale));
 
-        I = (uint)(cs->intensity8(srcIt.oldRawData()) * Scale);
-
-        IntensityCount[I]++;
-
-        if (IntensityCount[I] == 1) {
-            AverageChannels[I] = channel;
-        } else {
-            for (int i = 0; i < channel.size(); i++) {
-                AverageChannels[I][i] += channel[i];
+                cs->normalisedChannelsValue(data, channel);
+                std::copy(channel.begin(), channel.end(), channels.begin() + i * numChannels);
             }
-        }
-    }
-
-    I = 0;
-    int MaxInstance = 0;
 
-    for (int i = 0 ; i <= Intensity ; ++i) {
-        if (IntensityCount[i] > MaxInstance) {
-            I = i;
-            MaxInstance = IntensityCount[i];
+            i++;
         }
     }
 
-    if (MaxInstance != 0) {
-        channel = AverageChannels[I];
-        for (int i = 0; i < channel.size(); i++) {
-            channel[i] /= MaxInstance;
-        }
-        cs->fromNormalisedChannelsValue(dst, channel);
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
-    } else {
-        memset(dst, 0, cs->pixelSize());
-        cs->setOpacity(dst, OPACITY_OPAQUE_U8, middlePointAlpha);
-    }
-
-
-    delete [] IntensityCount;        // free all the arrays
-    delete [] AverageChannels;
+    KisSequentialIterator dstIt(dst, rect);
+    QVector<float> channel(numChannels);
+
+    histogram.process(rect.size(), intensityBins.data(), channels.data(),
+        [&] (int x, int y) {
+            dstIt.nextPixel();
+            quint8 *dstPtr = dstIt.rawData();
+
+            // if the current pixel is transparent, the result must be transparent, too.
+            const qreal middlePointAlpha = alphas[(y + Radius) * srcRect.width() + x + Radius];
+            const int I = middlePointAlpha > 0 ? histogram.mostFrequentBin() : -1;
+
+            if (I >= 0) {
+                const int MaxInstance = histogram.count(I);
+                const double *sums = histogram.sums(I);
+
+                for (int i = 0; i < numChannels; i++) {
+                    channel[i] = sums[i] / MaxInstance;
+                }
+                cs->fromNormalisedChannelsValue(dstPtr, channel);
+                cs->setOpacity(dstPtr, OPACITY_OPAQUE_U8, middlePointAlpha);
+            } else {
+                memset(dstPtr, 0, cs->pixelSize());
+                cs->setOpacity(dstPtr, OPACITY_OPAQUE_U8, middlePointAlpha);
+            }
+        });
 }
 
 QRect KisOilPaintFilter::neededRect(const QRect & rect, const KisFilterConfigurationSP _config, int /*lod*/) const
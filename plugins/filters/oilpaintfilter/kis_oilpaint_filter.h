@@ -12,6 +12,8 @@
 #include "filter/kis_filter.h"
 #include "kis_config_widget.h"
 
+class KisSlidingWindowHistogram;
+
 class KisOilPaintFilter : public KisFilter
 {
 public:
@@ -37,7 +39,8 @@ public:
 private:
     void OilPaint(const KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &applyRect,
                   int BrushSize, int Smoothness, KoUpdater* progressUpdater) const;
-    void MostFrequentColor(KisPaintDeviceSP src, quint8* dst, const QRect& bounds, int X, int Y, int Radius, int Intensity) const;
+    void MostFrequentColor(KisPaintDeviceSP src, KisPaintDeviceSP dst, const QRect &rect,
+                           KisSlidingWindowHistogram &histogram, int Intensity) const;
 };
 
 #endif